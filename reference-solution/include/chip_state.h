@@ -1,6 +1,7 @@
 #ifndef CHIP_STATE_H
 #define CHIP_STATE_H
 
+#include <stdio.h>
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -47,6 +48,9 @@ void init_system_state(void);
 int add_chip_to_system(chip_state_t* chip);
 void update_system_statistics(void);
 void print_system_summary(void);
+const system_state_t* get_system_state(void);
+void restore_system_state(const system_state_t* saved);
+int restore_system_state_bytes(size_t offset, const void* data, size_t length);
 void demonstrate_chip_structures(void);
 void test_structure_arrays(void);
 
@@ -58,6 +62,150 @@ int validate_register_pointer(uint32_t* reg_ptr);
 void bulk_register_write(uint32_t start_addr, uint32_t* values, int count);
 void bulk_register_read(uint32_t start_addr, uint32_t* buffer, int count);
 uint32_t* find_register_by_value(uint32_t value, uint32_t start_addr, int range);
+void init_register_bank(void);
+uint32_t register_atomic_load(uint32_t address);
+int register_atomic_store(uint32_t address, uint32_t value);
+uint32_t register_atomic_set_bits(uint32_t address, uint32_t mask);
+uint32_t register_atomic_clear_bits(uint32_t address, uint32_t mask);
+uint32_t register_atomic_toggle_bits(uint32_t address, uint32_t mask);
+int register_atomic_compare_exchange(uint32_t address, uint32_t* expected, uint32_t desired);
+int register_atomic_update_field(uint32_t address, uint32_t mask, int shift,
+                                 uint32_t value, uint32_t* previous);
+int stress_test_register_bank(int readers, int writers, int ops);
+
+// One contiguous run of registers for register_readv()/register_writev()
+typedef struct {
+    uint32_t address;
+    int count;
+} register_segment_t;
+
+int register_gather(const uint32_t* addresses, int count, uint32_t* buffer);
+int register_scatter(const uint32_t* addresses, int count, const uint32_t* values);
+int register_readv(const register_segment_t* segments, int segment_count, uint32_t* buffer);
+int register_writev(const register_segment_t* segments, int segment_count, const uint32_t* values);
+void benchmark_register_vectored_access(void);
+
+// Pattern search over register images: (word & mask) == any of up to 8 candidates
+#define REGISTER_MATCH_MAX_VALUES 8
+int register_image_match_bitmap(const uint32_t* image, int count, uint32_t mask,
+                                const uint32_t* values, int value_count, uint64_t* bitmap);
+int register_image_match_indices(const uint32_t* image, int count, uint32_t mask,
+                                 const uint32_t* values, int value_count,
+                                 int* indices, int max_indices);
+int register_image_find_first(const uint32_t* image, int count, uint32_t mask,
+                              const uint32_t* values, int value_count);
+uint32_t* find_register_by_masked_value(uint32_t value, uint32_t mask, uint32_t start_addr, int range);
+int find_registers_matching(uint32_t start_addr, int range, uint32_t mask,
+                            const uint32_t* values, int value_count, uint64_t* bitmap);
+void benchmark_register_pattern_scan(void);
+
+// File- or POSIX-shm-backed register bank shared between processes.
+// The image starts with this header; registers follow at header_size.
+#define REGISTER_BANK_MAGIC 0x4B4E4252u   // "RBNK"
+#define REGISTER_BANK_VERSION_MAJOR 1
+#define REGISTER_BANK_VERSION_MINOR 0
+typedef struct {
+    uint32_t magic;            // REGISTER_BANK_MAGIC once the creator has finished
+    uint16_t version_major;    // Bumped for incompatible layout changes
+    uint16_t version_minor;    // Bumped for compatible additions
+    uint32_t header_size;      // Bytes before register 0 (page aligned)
+    uint32_t byte_order;       // 0x01020304 in the creator's byte order
+    uint32_t base_address;     // Bus address of register 0 (BASE_REGISTER_ADDR)
+    uint32_t register_stride;  // Bytes between registers
+    uint32_t register_count;   // Registers in the image
+    uint32_t attach_count;     // Processes currently attached
+    uint64_t total_size;       // header_size + register_count * register_stride
+} register_bank_header_t;
+
+int register_bank_attach_file(const char* path, uint32_t register_count);
+int register_bank_attach_shm(const char* name, uint32_t register_count);
+int register_bank_unlink_shm(const char* name);
+void register_bank_detach(void);
+uint32_t register_bank_size(void);
+const register_bank_header_t* register_bank_mapped_header(void);
+
+// Function declarations for register_shadow.c
+// Write-back shadow of the register bank: writes are cached and tracked in a
+// dirty bitmap, then flushed once per register in address order
+typedef struct {
+    uint32_t* shadow;              // Cached value of every register
+    uint64_t* dirty;               // One bit per register awaiting write-back
+    register_segment_t* runs;      // Commit scratch: contiguous dirty runs
+    uint32_t* packed;              // Commit scratch: run values back to back
+    uint32_t register_count;
+    uint32_t dirty_count;
+    uint32_t batch_limit;          // Auto-commit at this many dirty registers (0 = off)
+    uint32_t flush_interval_ms;    // Auto-commit once the oldest dirty write is this old (0 = off)
+    uint64_t first_dirty_ns;
+    uint64_t writes;               // Writes accepted
+    uint64_t coalesced_writes;     // Writes to an already dirty register
+    uint64_t flushed_registers;    // Registers written back to the bank
+    uint64_t flush_runs;           // register_writev() segments issued
+    uint64_t commits;
+} register_shadow_t;
+
+register_shadow_t* create_register_shadow(uint32_t batch_limit, uint32_t flush_interval_ms);
+void destroy_register_shadow(register_shadow_t* shadow);
+uint32_t register_shadow_read(const register_shadow_t* shadow, uint32_t address);
+int register_shadow_write(register_shadow_t* shadow, uint32_t address, uint32_t value);
+int register_shadow_update_field(register_shadow_t* shadow, uint32_t address,
+                                 uint32_t mask, int shift, uint32_t value);
+int register_shadow_commit(register_shadow_t* shadow);
+int register_shadow_poll(register_shadow_t* shadow);
+int register_shadow_refresh(register_shadow_t* shadow);
+void benchmark_register_shadow(int sequences);
+
+// Function declarations for register_trace.c
+// Binary trace of register accesses: lock-free ring, compact delta-coded file
+#define REGISTER_TRACE_READ  0
+#define REGISTER_TRACE_WRITE 1
+#define REGISTER_TRACE_RMW   2
+
+typedef struct {
+    uint64_t recorded;         // Records written to the file
+    uint64_t dropped;          // Records lost because the ring was full
+    uint64_t bytes_written;    // File size including header
+} register_trace_stats_t;
+
+typedef struct {
+    uint64_t records;
+    uint64_t reads;
+    uint64_t writes;           // Writes and read-modify-writes applied
+    uint64_t mismatches;       // Recorded old value differed from the bank
+    uint64_t out_of_range;     // Records beyond the current bank size
+    uint64_t trace_span_ns;    // Timestamp of the last record
+    uint64_t elapsed_ns;       // Wall time of the replay
+} register_replay_stats_t;
+
+int register_trace_start(const char* path, size_t ring_entries);
+int register_trace_stop(register_trace_stats_t* stats);
+bool register_trace_active(void);
+void register_trace_record(int op, uint32_t address, uint32_t old_value, uint32_t new_value);
+long long register_trace_replay(const char* path, bool paced, register_replay_stats_t* stats);
+void benchmark_register_trace(int accesses);
+
+// Function declarations for state_snapshot.c
+// Copy-on-write snapshots of the register bank and system state
+#define SNAPSHOT_REGION_REGISTERS 0
+#define SNAPSHOT_REGION_SYSTEM    1
+
+typedef struct state_snapshot state_snapshot_t;
+
+typedef struct {
+    int changed_registers;
+    int changed_chips;         // chips[] entries that differ
+    bool summary_changed;      // Counts, average temperature or status differ
+    int blocks_compared;       // 64-byte blocks written in between
+} snapshot_diff_t;
+
+state_snapshot_t* snapshot_take(void);
+void snapshot_release(state_snapshot_t* snapshot);
+int snapshot_restore(const state_snapshot_t* snapshot);
+int snapshot_diff(const state_snapshot_t* older, const state_snapshot_t* newer,
+                  snapshot_diff_t* diff, uint64_t* register_bitmap);
+int snapshot_read_register(const state_snapshot_t* snapshot, uint32_t address, uint32_t* value);
+void snapshot_before_write(int region, const void* address, size_t length);
+void benchmark_state_snapshot(int checkpoints);
 void demonstrate_pointer_operations(void);
 void test_pointer_validation(void);
 
@@ -75,10 +223,172 @@ void demonstrate_comprehensive_bit_ops(void);
 void test_bit_patterns(void);
 void demonstrate_advanced_bit_fields(void);
 
+// Function declarations for chip_slot_map.c
+// Growable slot map: chips stored densely, addressed by generational handles
+typedef uint64_t chip_handle_t;            // (generation << 32) | slot
+#define CHIP_HANDLE_INVALID ((chip_handle_t)0)
+#define CHIP_HANDLE_SLOT(handle)       ((uint32_t)(handle))
+#define CHIP_HANDLE_GENERATION(handle) ((uint32_t)((handle) >> 32))
+
+typedef struct {
+    chip_state_t* chips;        // Dense storage: chips[0 .. count) for iteration
+    uint32_t* dense_slot;       // Slot owning each dense entry
+    uint32_t* slot_index;       // Dense index of a live slot, next free slot otherwise
+    uint32_t* slot_generation;  // Bumped on remove so old handles go stale
+    uint32_t count;
+    uint32_t capacity;
+    uint32_t slot_count;        // Slots handed out so far
+    uint32_t free_head;
+} chip_slot_map_t;
+
+chip_slot_map_t* create_chip_slot_map(size_t initial_capacity);
+void destroy_chip_slot_map(chip_slot_map_t* map);
+chip_handle_t chip_slot_map_insert(chip_slot_map_t* map, const chip_state_t* chip);
+int chip_slot_map_remove(chip_slot_map_t* map, chip_handle_t handle);
+chip_state_t* chip_slot_map_get(const chip_slot_map_t* map, chip_handle_t handle);
+chip_handle_t chip_slot_map_handle_at(const chip_slot_map_t* map, size_t dense_index);
+void chip_slot_map_clear(chip_slot_map_t* map);
+void benchmark_chip_slot_map(int chip_count);
+
+// Function declarations for chip_worker_pool.c
+// Work-stealing thread pool and the parallel monitoring pass built on it
+#define CHIP_HEALTH_CRITICAL 50        // Health below this is critical
+#define CHIP_HEALTH_WARNING  80        // Health below this is a warning
+
+typedef struct chip_worker_pool chip_worker_pool_t;
+typedef void (*chip_parallel_fn_t)(void* context, size_t begin, size_t end, int worker);
+typedef int (*chip_health_fn_t)(chip_state_t* chip);
+
+typedef struct {
+    long total_health;
+    int chips;
+    int critical_chips;
+    int warning_chips;
+} chip_monitor_totals_t;
+
+chip_worker_pool_t* create_chip_worker_pool(int workers);
+void destroy_chip_worker_pool(chip_worker_pool_t* pool);
+int chip_worker_pool_size(const chip_worker_pool_t* pool);
+uint64_t chip_worker_pool_steals(const chip_worker_pool_t* pool);
+int chip_parallel_for(chip_worker_pool_t* pool, size_t count, size_t chunk,
+                      chip_parallel_fn_t fn, void* context);
+int chip_monitor_pass(chip_worker_pool_t* pool, chip_state_t* chips, size_t count,
+                      chip_health_fn_t health_fn, int* health, chip_monitor_totals_t* totals);
+
+// Function declarations for chip_timer_wheel.c
+// Hierarchical timer wheel driving periodic per-chip monitoring
+typedef struct chip_timer_wheel chip_timer_wheel_t;
+typedef void (*chip_timer_fn_t)(void* context, uint64_t data);
+
+typedef struct {
+    uint64_t fired;
+    uint64_t missed;               // Periods skipped because a poll ran too late
+    uint64_t total_lateness_ns;    // Sum of (fire time - due time)
+    uint64_t max_lateness_ns;
+    uint64_t max_drift_ns;         // Largest |interval between firings - period|
+    size_t max_tick_fires;         // Largest burst of timers on one tick
+    int active_timers;
+} chip_timer_stats_t;
+
+chip_timer_wheel_t* create_chip_timer_wheel(uint64_t tick_ns, uint64_t start_ns);
+void destroy_chip_timer_wheel(chip_timer_wheel_t* wheel);
+int chip_timer_schedule(chip_timer_wheel_t* wheel, uint64_t now_ns, uint64_t period_ns, uint64_t jitter_ns,
+                        chip_timer_fn_t fn, void* context, uint64_t data);
+int chip_timer_cancel(chip_timer_wheel_t* wheel, int timer_id);
+int chip_timer_set_period(chip_timer_wheel_t* wheel, int timer_id, uint64_t period_ns);
+size_t chip_timer_wheel_advance(chip_timer_wheel_t* wheel, uint64_t now_ns);
+uint64_t chip_timer_wheel_next_expiry(const chip_timer_wheel_t* wheel);
+void chip_timer_wheel_stats(const chip_timer_wheel_t* wheel, chip_timer_stats_t* stats);
+void print_chip_timer_report(const chip_timer_wheel_t* wheel);
+void benchmark_chip_timer_wheel(int timers);
+
+// Function declarations for chip_history.c
+// Per-chip ring buffer of timestamped samples with windowed aggregates
+#define CHIP_HISTORY_DEFAULT_CAPACITY 256
+
+typedef struct {
+    uint64_t timestamp_ns;
+    float temperature;
+    float voltage;
+    register_set_t registers;
+} chip_sample_t;                   // 32 bytes: two samples per cache line
+
+typedef enum {
+    CHIP_METRIC_TEMPERATURE = 0,
+    CHIP_METRIC_VOLTAGE,
+    CHIP_METRIC_COUNT
+} chip_metric_t;
+
+typedef struct {
+    size_t samples;
+    float min;
+    float max;
+    float mean;
+    uint64_t error_samples;        // Samples with a non-zero error register
+    uint64_t first_ns;             // Oldest and newest timestamp in the window
+    uint64_t last_ns;
+} chip_window_stats_t;
+
+typedef struct chip_history chip_history_t;
+
+chip_history_t* create_chip_history(size_t capacity);
+void destroy_chip_history(chip_history_t* history);
+void chip_history_reset(chip_history_t* history);
+int chip_history_record(chip_history_t* history, uint64_t timestamp_ns, const chip_state_t* chip);
+size_t chip_history_count(const chip_history_t* history);
+size_t chip_history_capacity(const chip_history_t* history);
+const chip_sample_t* chip_history_sample(const chip_history_t* history, size_t age);
+size_t chip_history_samples_since(const chip_history_t* history, uint64_t since_ns);
+int chip_history_window(const chip_history_t* history, chip_metric_t metric, size_t last_n,
+                        chip_window_stats_t* stats);
+int chip_history_percentile(chip_history_t* history, chip_metric_t metric, size_t last_n,
+                            double percentile, float* value);
+void benchmark_chip_history(int samples);
+
+// Function declarations for chip_telemetry.c
+// Compressed columnar telemetry: delta-of-delta timestamps, XOR floats,
+// XOR + varint registers, in independently decodable indexed blocks
+#define CHIP_TELEMETRY_DEFAULT_BLOCK_SAMPLES 512
+#define CHIP_TELEMETRY_COLUMNS 4       // Timestamp, temperature, voltage, registers
+
+typedef struct chip_telemetry chip_telemetry_t;
+
+typedef struct {
+    uint64_t samples;              // Retained samples
+    uint64_t dropped_samples;      // Discarded by chip_telemetry_set_retention()
+    size_t blocks;
+    size_t open_samples;           // Appended but not yet encoded
+    size_t encoded_bytes;
+    size_t index_bytes;
+    size_t raw_bytes;              // Sealed samples as chip_sample_t
+    size_t column_bytes[CHIP_TELEMETRY_COLUMNS];
+} chip_telemetry_stats_t;
+
+chip_telemetry_t* create_chip_telemetry(size_t block_samples);
+void destroy_chip_telemetry(chip_telemetry_t* store);
+void chip_telemetry_reset(chip_telemetry_t* store);
+int chip_telemetry_set_retention(chip_telemetry_t* store, size_t max_blocks);
+int chip_telemetry_append(chip_telemetry_t* store, const chip_sample_t* sample);
+int chip_telemetry_flush(chip_telemetry_t* store);
+long chip_telemetry_decode_block(chip_telemetry_t* store, size_t index, chip_sample_t* samples);
+long chip_telemetry_read_range(chip_telemetry_t* store, uint64_t from_ns, uint64_t to_ns,
+                               chip_sample_t* samples, size_t max_samples);
+int chip_telemetry_read_at(chip_telemetry_t* store, uint64_t timestamp_ns, chip_sample_t* sample);
+void chip_telemetry_stats(const chip_telemetry_t* store, chip_telemetry_stats_t* stats);
+void benchmark_chip_telemetry(int samples);
+
 // Function declarations for chip_monitor.c
 void init_chip_monitor(void);
-int add_chip_to_monitor(chip_state_t* chip);
-int remove_chip_from_monitor(int monitor_index);
+void shutdown_chip_monitor(void);
+chip_handle_t add_chip_to_monitor(const chip_state_t* chip);
+int remove_chip_from_monitor(chip_handle_t handle);
+chip_state_t* get_monitored_chip(chip_handle_t handle);
+int get_monitored_chip_count(void);
+int set_monitor_worker_count(int workers);
+int set_chip_monitor_interval(chip_handle_t handle, uint32_t interval_ms);
+int run_chip_monitor_scheduler(uint32_t duration_ms);
+chip_history_t* get_monitored_chip_history(chip_handle_t handle);
+chip_telemetry_t* get_monitored_chip_telemetry(chip_handle_t handle);
 void update_chip_status(chip_state_t* chip);
 int perform_health_check(chip_state_t* chip);
 void monitor_all_chips(void);
@@ -117,8 +427,35 @@ typedef struct {
     time_t alloc_time;
     uint32_t magic_header;
     uint32_t magic_footer;
+    double sample_weight;
+    void* guard_base;
+    size_t guard_size;
 } memory_allocation_t;
 
+// Which allocations get full canary and callsite tracking
+typedef enum {
+    MEMORY_SAMPLING_ALL = 0,
+    MEMORY_SAMPLING_EVERY_N,
+    MEMORY_SAMPLING_POISSON_BYTES
+} memory_sampling_mode_t;
+
+// Merged tracker statistics (see get_memory_safety_stats)
+typedef struct {
+    size_t malloc_calls;
+    size_t free_calls;
+    size_t live_allocations;
+    size_t current_bytes;
+    size_t peak_bytes;
+    size_t double_frees;
+    size_t corruptions;
+    size_t unsampled_malloc_calls;
+    size_t unsampled_free_calls;
+    double estimated_live_allocations;
+    double estimated_live_bytes;
+    size_t guard_mapped_bytes;
+    size_t quarantine_bytes;
+} memory_safety_stats_t;
+
 void init_memory_safety(void);
 void* safe_malloc(size_t size, const char* file, int line);
 void safe_free(void* ptr, const char* file, int line);
@@ -129,6 +466,17 @@ void simulate_corruption(void* ptr);
 void demonstrate_memory_safety(void);
 void test_memory_safety_with_structures(void);
 void stress_test_memory_system(void);
+size_t get_active_allocation_count(void);
+void set_memory_safety_tracing(bool enabled);
+void get_memory_safety_stats(memory_safety_stats_t* stats);
+void benchmark_memory_tracker_scaling(int max_threads);
+int set_memory_sampling(memory_sampling_mode_t mode, size_t parameter);
+memory_sampling_mode_t get_memory_sampling(size_t* parameter);
+void benchmark_memory_sampling_overhead(int iterations);
+int set_memory_guard_pages(bool enabled, size_t quarantine_bytes);
+int set_memory_guard_alignment(size_t alignment);
+bool memory_guard_pages_enabled(void);
+void benchmark_guard_page_overhead(int count);
 
 // Function declarations for ai_optimized_code.c
 typedef struct {
@@ -140,16 +488,172 @@ typedef struct {
 
 void start_performance_measurement(performance_metric_t* metric, const char* operation_name);
 void end_performance_measurement(performance_metric_t* metric);
+// CRC32 engines selectable at runtime (all bit-for-bit compatible)
+// The fastest supported engine is picked via cpuid on first use.
+typedef enum {
+    CRC32_ENGINE_BYTEWISE = 0,
+    CRC32_ENGINE_SLICE_BY_8,
+    CRC32_ENGINE_SLICE_BY_16,
+    CRC32_ENGINE_PCLMUL,
+    CRC32_ENGINE_COUNT
+} crc32_engine_t;
+
 uint32_t calculate_crc32_optimized(const uint8_t* data, size_t length);
 uint32_t calculate_crc32_naive(const uint8_t* data, size_t length);
+uint32_t calculate_crc32_with_engine(const uint8_t* data, size_t length, crc32_engine_t engine);
+void set_crc32_engine(crc32_engine_t engine);
+crc32_engine_t get_crc32_engine(void);
+const char* crc32_engine_name(crc32_engine_t engine);
+bool crc32_engine_supported(crc32_engine_t engine);
+
+// Streaming CRC32: init/update/final plus combine for split buffers
+typedef struct {
+    uint32_t state;     // Running CRC (pre-inverted)
+    uint64_t length;    // Total bytes processed
+} crc32_context_t;
+
+void crc32_init(crc32_context_t* ctx);
+void crc32_update(crc32_context_t* ctx, const uint8_t* data, size_t length);
+uint32_t crc32_final(const crc32_context_t* ctx);
+uint32_t crc32_combine(uint32_t crc_a, uint32_t crc_b, size_t len_b);
+
+uint32_t calculate_crc32c(const uint8_t* data, size_t length);
+uint32_t calculate_crc32c_software(const uint8_t* data, size_t length);
+bool crc32c_hardware_available(void);
 int validate_registers_optimized(const register_set_t* registers);
 int validate_registers_original(const register_set_t* registers);
 int process_chip_array_optimized(chip_state_t** chips, int count, float temperature_threshold);
 int process_chip_array_original(chip_state_t** chips, int count, float temperature_threshold);
 void optimized_memory_copy(void* dest, const void* src, size_t size);
+void set_memory_copy_nt_threshold(size_t threshold);
+size_t get_memory_copy_nt_threshold(void);
+void benchmark_memory_copy_sweep(size_t max_size);
 void compare_optimization_performance(void);
 void demonstrate_ai_optimizations(void);
 
+// Function declarations for chip_fleet.c
+// Structure-of-Arrays fleet: each hot field lives in its own 64-byte aligned array
+typedef struct {
+    int count;
+    int capacity;
+    float* temperatures;
+    float* voltages;
+    uint32_t* error_counts;
+    uint32_t* control_registers;
+    uint32_t* status_registers;
+    uint32_t* error_registers;
+    uint32_t* config_registers;
+} chip_fleet_t;
+
+chip_fleet_t* create_chip_fleet(int capacity);
+void destroy_chip_fleet(chip_fleet_t* fleet);
+int chip_fleet_add(chip_fleet_t* fleet, const chip_state_t* chip);
+int chip_fleet_load(chip_fleet_t* fleet, chip_state_t** chips, int count);
+uint32_t compute_chip_issue_flags(const chip_state_t* chip, float temperature_threshold);
+bool chip_fleet_simd_available(void);
+int chip_fleet_scan_issues(const chip_fleet_t* fleet, float temperature_threshold,
+                           uint8_t* issue_flags, float* avg_temperature, bool use_simd);
+void benchmark_chip_fleet_scan(int chip_count);
+
+// Function declarations for register_diff.c
+// Register deltas: only changed registers, as (index, old ^ new) pairs
+#define REGISTER_DELTA_MAX_COLUMNS 4   // Registers per register_set_t
+#define REGISTER_DELTA_CHIP(delta)     ((delta).index / REGISTER_DELTA_MAX_COLUMNS)
+#define REGISTER_DELTA_REGISTER(delta) ((delta).index % REGISTER_DELTA_MAX_COLUMNS)
+
+typedef struct {
+    uint32_t index;            // Register index, or chip * 4 + register for fleets
+    uint32_t changed_bits;     // old ^ new; applying XORs it back in
+} register_delta_t;
+
+long register_image_diff(const uint32_t* before, const uint32_t* after, size_t count,
+                         register_delta_t* deltas, size_t max_deltas, bool use_simd);
+long register_image_apply_delta(uint32_t* image, size_t count,
+                                const register_delta_t* deltas, size_t delta_count);
+long chip_fleet_diff(const chip_fleet_t* before, const chip_fleet_t* after,
+                     register_delta_t* deltas, size_t max_deltas, bool use_simd);
+long chip_fleet_apply_delta(chip_fleet_t* fleet, const register_delta_t* deltas, size_t delta_count);
+void benchmark_register_diff(int chip_count);
+
+// Function declarations for register_watch.c
+// Bit-transition and field-range watchpoints evaluated on the register write path
+#define REGISTER_WATCH_RISING  1
+#define REGISTER_WATCH_FALLING 2
+#define REGISTER_WATCH_BOTH    (REGISTER_WATCH_RISING | REGISTER_WATCH_FALLING)
+
+typedef struct {
+    uint32_t words;
+    uint32_t masks[];          // Bits any watch depends on, per register
+} register_watch_table_t;
+
+int register_watch_bit(uint32_t address, int bit, int edges,
+                       chip_event_callback_t callback, chip_state_t* chip, int event_type);
+int register_watch_field(uint32_t address, int position, int width, uint32_t min_value, uint32_t max_value,
+                         chip_event_callback_t callback, chip_state_t* chip, int event_type);
+int register_watch_remove(int watch_id);
+void register_watch_clear(void);
+uint64_t register_watch_hits(int watch_id);
+int register_watch_fire(uint32_t index, uint32_t old_value, uint32_t new_value);
+void benchmark_register_watch(int writes);
+
+// Function declarations for chip_log.c
+// Leveled diagnostics; deferred mode records raw arguments and formats off the hot path
+#define CHIP_LOG_ERROR 0
+#define CHIP_LOG_WARN  1
+#define CHIP_LOG_INFO  2
+#define CHIP_LOG_DEBUG 3
+
+// Messages above this level compile to nothing (release builds use CHIP_LOG_WARN)
+#ifndef CHIP_LOG_COMPILE_LEVEL
+#define CHIP_LOG_COMPILE_LEVEL CHIP_LOG_DEBUG
+#endif
+
+extern int g_chip_log_level;
+
+#define CHIP_LOG(level, ...) do { \
+    if ((level) <= CHIP_LOG_COMPILE_LEVEL && \
+        (level) <= __atomic_load_n(&g_chip_log_level, __ATOMIC_RELAXED)) \
+        chip_log_write((level), __VA_ARGS__); \
+} while (0)
+
+typedef struct {
+    uint64_t logged;            // Records written to the sink
+    uint64_t dropped;           // Records lost because the ring was full
+    uint64_t inline_formatted;  // Records formatted by the producer (unsupported conversions,
+                                // or %s arguments longer than the record's string area)
+    uint64_t truncated;         // Producer-formatted records cut short (out of memory)
+} chip_log_stats_t;
+
+void chip_log_write(int level, const char* format, ...) __attribute__((format(printf, 2, 3)));
+void chip_log_set_level(int level);
+int chip_log_get_level(void);
+int chip_log_start(FILE* sink, size_t ring_entries);
+int chip_log_stop(chip_log_stats_t* stats);
+void chip_log_flush(void);
+void benchmark_chip_log(int messages);
+
+// Function declarations for chip_pool.c
+// Slab pool of cache-line aligned chip_state_t slots with an intrusive free list
+typedef struct chip_pool_slab chip_pool_slab_t;
+
+typedef struct chip_pool {
+    chip_pool_slab_t* slabs;
+    union chip_pool_slot* free_list;
+    size_t slots_per_slab;
+    size_t slab_count;
+    size_t total_slots;
+    size_t live_count;
+    bool use_tracker;       // Slabs come from SAFE_MALLOC and frees are checked
+} chip_pool_t;
+
+chip_pool_t* create_chip_pool(size_t slots_per_slab, bool use_tracker);
+void destroy_chip_pool(chip_pool_t* pool);
+chip_state_t* chip_pool_alloc(chip_pool_t* pool);
+void chip_pool_free(chip_pool_t* pool, chip_state_t* chip);
+size_t chip_pool_alloc_bulk(chip_pool_t* pool, chip_state_t** chips, size_t count);
+void chip_pool_free_bulk(chip_pool_t* pool, chip_state_t** chips, size_t count);
+void benchmark_chip_pool(int chip_count);
+
 // Event types for callbacks
 #define EVENT_POWER_ON      1
 #define EVENT_POWER_OFF     2
@@ -3,6 +3,7 @@
 #include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
+#include <pthread.h>
 
 // Include chip state structure
 typedef struct {
@@ -50,6 +51,28 @@ typedef struct {
 // Global callback registry
 static callback_registry_t g_callback_registry = {0};
 
+// Chip slab pool (see chip_pool.c)
+typedef struct chip_pool chip_pool_t;
+chip_pool_t* create_chip_pool(size_t slots_per_slab, bool use_tracker);
+size_t chip_pool_alloc_bulk(chip_pool_t* pool, chip_state_t** chips, size_t count);
+void chip_pool_free_bulk(chip_pool_t* pool, chip_state_t** chips, size_t count);
+
+// Pool backing create_chip_array(), created once on first use. The pool
+// itself is not thread-safe, so every access holds g_chip_array_pool_lock.
+static chip_pool_t* g_chip_array_pool = NULL;
+static pthread_once_t g_chip_array_pool_once = PTHREAD_ONCE_INIT;
+static pthread_mutex_t g_chip_array_pool_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// Arrays larger than this are created and destroyed without per-chip output
+#define CHIP_ARRAY_VERBOSE_LIMIT 16
+
+/**
+ * Create the pool backing create_chip_array() (runs once)
+ */
+static void init_chip_array_pool(void) {
+    g_chip_array_pool = create_chip_pool(0, false);
+}
+
 /**
  * Validation function: Check power levels
  * @param chip Pointer to chip state
@@ -354,6 +377,8 @@ void trigger_chip_callbacks(chip_state_t* chip, int event_type) {
 
 /**
  * Create an array of chip pointers dynamically
+ * Chips come from a shared slab pool in one bulk allocation, so they are
+ * contiguous and cache-line aligned.
  * @param count Number of chips to create
  * @return Array of chip pointers or NULL if failed
  */
@@ -372,22 +397,22 @@ chip_state_t** create_chip_array(int count) {
         return NULL;
     }
 
-    // Allocate individual chips
-    for (int i = 0; i < count; i++) {
-        chip_array[i] = malloc(sizeof(chip_state_t));
-        if (chip_array[i] == NULL) {
-            printf("Error: Failed to allocate chip %d\n", i);
-
-            // Clean up previously allocated chips
-            for (int j = 0; j < i; j++) {
-                free(chip_array[j]);
-            }
-            free(chip_array);
-            return NULL;
-        }
+    // Allocate all chips from the pool (zeroed)
+    pthread_once(&g_chip_array_pool_once, init_chip_array_pool);
+    size_t allocated = 0;
+    if (g_chip_array_pool != NULL) {
+        pthread_mutex_lock(&g_chip_array_pool_lock);
+        allocated = chip_pool_alloc_bulk(g_chip_array_pool, chip_array, (size_t)count);
+        pthread_mutex_unlock(&g_chip_array_pool_lock);
+    }
+    if (allocated == 0) {
+        printf("Error: Failed to allocate %d chips\n", count);
+        free(chip_array);
+        return NULL;
+    }
 
+    for (int i = 0; i < count; i++) {
         // Initialize chip
-        memset(chip_array[i], 0, sizeof(chip_state_t));
         snprintf(chip_array[i]->chip_id, sizeof(chip_array[i]->chip_id),
                  "CHIP_%d", i);
         snprintf(chip_array[i]->part_number, sizeof(chip_array[i]->part_number),
@@ -399,7 +424,9 @@ chip_state_t** create_chip_array(int count) {
         chip_array[i]->registers.control_register = 0x00000001;
         chip_array[i]->registers.status_register = 0x80000001;
 
-        printf("  Initialized chip[%d]: %s\n", i, chip_array[i]->chip_id);
+        if (count <= CHIP_ARRAY_VERBOSE_LIMIT) {
+            printf("  Initialized chip[%d]: %s\n", i, chip_array[i]->chip_id);
+        }
     }
 
     printf("Successfully created chip array\n");
@@ -419,14 +446,20 @@ void destroy_chip_array(chip_state_t** chips, int count) {
 
     printf("Destroying chip array of %d chips\n", count);
 
-    // Free individual chips
-    for (int i = 0; i < count; i++) {
-        if (chips[i] != NULL) {
-            printf("  Freeing chip[%d]: %s\n", i, chips[i]->chip_id);
-            free(chips[i]);
-            chips[i] = NULL;
+    // Return the chips to the pool
+    if (count <= CHIP_ARRAY_VERBOSE_LIMIT) {
+        for (int i = 0; i < count; i++) {
+            if (chips[i] != NULL) {
+                printf("  Freeing chip[%d]: %s\n", i, chips[i]->chip_id);
+            }
         }
     }
+    if (count > 0) {
+        pthread_mutex_lock(&g_chip_array_pool_lock);
+        chip_pool_free_bulk(g_chip_array_pool, chips, (size_t)count);
+        pthread_mutex_unlock(&g_chip_array_pool_lock);
+        memset(chips, 0, (size_t)count * sizeof(chip_state_t*));
+    }
 
     // Free the array itself
     free(chips);
@@ -4,6 +4,12 @@
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include <pthread.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HAVE_X86_CRC_KERNELS 1
+#endif
 
 // Include chip structures
 typedef struct {
@@ -34,6 +40,69 @@ typedef struct {
     const char* operation_name;
 } performance_metric_t;
 
+// Structure-of-Arrays fleet benchmark (chip_fleet.c)
+void benchmark_chip_fleet_scan(int chip_count);
+
+// Slab pool setup/teardown benchmark (chip_pool.c)
+void benchmark_chip_pool(int chip_count);
+
+// Monitor slot map churn benchmark (chip_slot_map.c)
+void benchmark_chip_slot_map(int chip_count);
+
+// Monitor polling scheduler benchmark (chip_timer_wheel.c)
+void benchmark_chip_timer_wheel(int timers);
+
+// Sample history window benchmark (chip_history.c)
+void benchmark_chip_history(int samples);
+
+// Compressed telemetry codec benchmark (chip_telemetry.c)
+void benchmark_chip_telemetry(int samples);
+
+// Vectored register access and pattern scan benchmarks (pointer_registers.c)
+void benchmark_register_vectored_access(void);
+void benchmark_register_pattern_scan(void);
+
+// Write-back register shadow benchmark (register_shadow.c)
+void benchmark_register_shadow(int sequences);
+
+// Register access trace benchmark (register_trace.c)
+void benchmark_register_trace(int accesses);
+
+// Snapshot, diff and watchpoint benchmarks (state_snapshot.c, register_diff.c, register_watch.c)
+void benchmark_state_snapshot(int checkpoints);
+void benchmark_register_diff(int chip_count);
+void benchmark_register_watch(int writes);
+
+// Tracker scaling, sampling and guard-page overhead benchmarks (memory_safety.c)
+void benchmark_memory_tracker_scaling(int max_threads);
+void benchmark_memory_sampling_overhead(int iterations);
+void benchmark_guard_page_overhead(int count);
+
+// Leveled logging (chip_log.c); levels and CHIP_LOG() must match chip_state.h
+#define CHIP_LOG_ERROR 0
+#define CHIP_LOG_WARN  1
+#define CHIP_LOG_INFO  2
+#define CHIP_LOG_DEBUG 3
+#ifndef CHIP_LOG_COMPILE_LEVEL
+#define CHIP_LOG_COMPILE_LEVEL CHIP_LOG_DEBUG
+#endif
+extern int g_chip_log_level;
+void chip_log_write(int level, const char* format, ...) __attribute__((format(printf, 2, 3)));
+void chip_log_set_level(int level);
+int chip_log_get_level(void);
+void benchmark_chip_log(int messages);
+#define CHIP_LOG(level, ...) do { \
+    if ((level) <= CHIP_LOG_COMPILE_LEVEL && \
+        (level) <= __atomic_load_n(&g_chip_log_level, __ATOMIC_RELAXED)) \
+        chip_log_write((level), __VA_ARGS__); \
+} while (0)
+
+// Streaming CRC32 context (must match crc32_context_t in chip_state.h)
+typedef struct {
+    uint32_t state;
+    uint64_t length;
+} crc32_context_t;
+
 // AI-suggested optimization: Use lookup table for CRC calculation
 static const uint32_t crc32_table[256] = {
     0x00000000, 0x77073096, 0xEE0E612C, 0x990951BA, 0x076DC419, 0x706AF48F,
@@ -81,6 +150,52 @@ static const uint32_t crc32_table[256] = {
     0xB40BBE37, 0xC30C8EA1, 0x5A05DF1B, 0x2D02EF8D
 };
 
+// CRC32 engine selection (must match crc32_engine_t in chip_state.h)
+typedef enum {
+    CRC32_ENGINE_BYTEWISE = 0,
+    CRC32_ENGINE_SLICE_BY_8,
+    CRC32_ENGINE_SLICE_BY_16,
+    CRC32_ENGINE_PCLMUL,
+    CRC32_ENGINE_COUNT
+} crc32_engine_t;
+
+// Slicing tables: crc32_slice_table[k][i] is the CRC of byte i followed by k zero bytes.
+// Table 0 is identical to crc32_table; the rest are generated on first use.
+// One-time initializers run under pthread_once so concurrent first callers
+// never see half-built tables or features.
+static uint32_t crc32_slice_table[16][256];
+static pthread_once_t crc32_slice_tables_once = PTHREAD_ONCE_INIT;
+
+// Engine dispatch: the best supported engine is picked once via cpuid
+// (accessed atomically; set_crc32_engine() may race with calculations)
+static crc32_engine_t g_crc32_engine = CRC32_ENGINE_SLICE_BY_16;
+static pthread_once_t crc32_dispatch_once = PTHREAD_ONCE_INIT;
+
+// CPU features relevant to the CRC kernels (detected once)
+static pthread_once_t g_cpu_features_once = PTHREAD_ONCE_INIT;
+static bool g_cpu_has_pclmul = false;
+static bool g_cpu_has_sse42 = false;
+static bool g_cpu_has_avx2 = false;
+
+// Copies at or above this size use non-temporal (cache-bypassing) stores
+#define DEFAULT_NT_COPY_THRESHOLD (4u * 1024u * 1024u)
+static size_t g_nt_copy_threshold = DEFAULT_NT_COPY_THRESHOLD;
+
+// CRC32C (Castagnoli, reflected polynomial 0x82F63B78) slicing-by-8 tables
+#define CRC32C_POLYNOMIAL 0x82F63B78
+static uint32_t crc32c_slice_table[8][256];
+static pthread_once_t crc32c_tables_once = PTHREAD_ONCE_INIT;
+
+/**
+ * Compiler barrier for benchmark loops
+ * Tells the compiler that memory behind ptr may have changed, so pure
+ * computations over it cannot be hoisted out of the timing loop.
+ * @param ptr Buffer being benchmarked
+ */
+static inline void benchmark_barrier(const void* ptr) {
+    __asm__ __volatile__("" : : "r"(ptr) : "memory");
+}
+
 /**
  * Start performance measurement
  * @param metric Pointer to performance metric structure
@@ -108,10 +223,423 @@ void end_performance_measurement(performance_metric_t* metric) {
     printf("  Execution time: %.3f ms\n", metric->execution_time_ms);
 }
 
+/**
+ * Generate the slicing-by-8/16 lookup tables from the base CRC32 table
+ */
+static void build_crc32_slice_tables(void) {
+    for (int i = 0; i < 256; i++) {
+        crc32_slice_table[0][i] = crc32_table[i];
+    }
+
+    for (int k = 1; k < 16; k++) {
+        for (int i = 0; i < 256; i++) {
+            uint32_t prev = crc32_slice_table[k - 1][i];
+            crc32_slice_table[k][i] = (prev >> 8) ^ crc32_table[prev & 0xFF];
+        }
+    }
+}
+
+/**
+ * Make sure the slicing tables are built (thread-safe, runs once)
+ */
+static void init_crc32_slice_tables(void) {
+    pthread_once(&crc32_slice_tables_once, build_crc32_slice_tables);
+}
+
+/**
+ * Load a little-endian 32-bit word from an arbitrarily aligned buffer
+ * @param p Pointer to 4 bytes of data
+ * @return Word value
+ */
+static inline uint32_t load_le32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+           ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/**
+ * Byte-at-a-time CRC32 update (single 256-entry table)
+ * @param crc Running CRC state (pre-inverted)
+ * @param data Pointer to data
+ * @param length Length of data in bytes
+ * @return Updated CRC state
+ */
+static uint32_t crc32_update_bytewise(uint32_t crc, const uint8_t* data, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        uint8_t table_index = (crc ^ data[i]) & 0xFF;
+        crc = (crc >> 8) ^ crc32_table[table_index];
+    }
+    return crc;
+}
+
+/**
+ * Slicing-by-8 CRC32 update: 8 table lookups per 8 input bytes
+ * @param crc Running CRC state (pre-inverted)
+ * @param data Pointer to data
+ * @param length Length of data in bytes
+ * @return Updated CRC state
+ */
+static uint32_t crc32_update_slice8(uint32_t crc, const uint8_t* data, size_t length) {
+    const uint32_t (*t)[256] = crc32_slice_table;
+
+    while (length >= 8) {
+        uint32_t one = crc ^ load_le32(data);
+        uint32_t two = load_le32(data + 4);
+
+        crc = t[7][one & 0xFF] ^ t[6][(one >> 8) & 0xFF] ^
+              t[5][(one >> 16) & 0xFF] ^ t[4][one >> 24] ^
+              t[3][two & 0xFF] ^ t[2][(two >> 8) & 0xFF] ^
+              t[1][(two >> 16) & 0xFF] ^ t[0][two >> 24];
+
+        data += 8;
+        length -= 8;
+    }
+
+    return crc32_update_bytewise(crc, data, length);
+}
+
+/**
+ * Slicing-by-16 CRC32 update: 16 table lookups per 16 input bytes
+ * @param crc Running CRC state (pre-inverted)
+ * @param data Pointer to data
+ * @param length Length of data in bytes
+ * @return Updated CRC state
+ */
+static uint32_t crc32_update_slice16(uint32_t crc, const uint8_t* data, size_t length) {
+    const uint32_t (*t)[256] = crc32_slice_table;
+
+    while (length >= 16) {
+        uint32_t one = crc ^ load_le32(data);
+        uint32_t two = load_le32(data + 4);
+        uint32_t three = load_le32(data + 8);
+        uint32_t four = load_le32(data + 12);
+
+        crc = t[15][one & 0xFF] ^ t[14][(one >> 8) & 0xFF] ^
+              t[13][(one >> 16) & 0xFF] ^ t[12][one >> 24] ^
+              t[11][two & 0xFF] ^ t[10][(two >> 8) & 0xFF] ^
+              t[9][(two >> 16) & 0xFF] ^ t[8][two >> 24] ^
+              t[7][three & 0xFF] ^ t[6][(three >> 8) & 0xFF] ^
+              t[5][(three >> 16) & 0xFF] ^ t[4][three >> 24] ^
+              t[3][four & 0xFF] ^ t[2][(four >> 8) & 0xFF] ^
+              t[1][(four >> 16) & 0xFF] ^ t[0][four >> 24];
+
+        data += 16;
+        length -= 16;
+    }
+
+    return crc32_update_slice8(crc, data, length);
+}
+
+/**
+ * Query cpuid for the features used by the hardware CRC kernels
+ */
+static void probe_cpu_features(void) {
+#ifdef HAVE_X86_CRC_KERNELS
+    __builtin_cpu_init();
+    g_cpu_has_pclmul = __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1");
+    g_cpu_has_sse42 = __builtin_cpu_supports("sse4.2");
+    g_cpu_has_avx2 = __builtin_cpu_supports("avx2");
+#endif
+}
+
+/**
+ * Detect CPU features used by the hardware CRC kernels (thread-safe, cached)
+ */
+static void detect_cpu_features(void) {
+    pthread_once(&g_cpu_features_once, probe_cpu_features);
+}
+
+#ifdef HAVE_X86_CRC_KERNELS
+/**
+ * PCLMULQDQ folding CRC32 update for the IEEE polynomial (0xEDB88320)
+ * Folds four 128-bit lanes in parallel, then reduces to 32 bits with a
+ * Barrett reduction (Intel "Fast CRC Computation Using PCLMULQDQ").
+ * @param crc Running CRC state (pre-inverted)
+ * @param data Pointer to data
+ * @param length Length of data in bytes (at least 64, multiple of 16)
+ * @return Updated CRC state
+ */
+__attribute__((target("pclmul,sse4.1")))
+static uint32_t crc32_fold_pclmul(uint32_t crc, const uint8_t* data, size_t length) {
+    // Bit-reflected folding constants x^(n) mod P(x) and Barrett constants
+    static const uint64_t k1k2[2] __attribute__((aligned(16))) = { 0x0154442bd4, 0x01c6e41596 };
+    static const uint64_t k3k4[2] __attribute__((aligned(16))) = { 0x01751997d0, 0x00ccaa009e };
+    static const uint64_t k5k0[2] __attribute__((aligned(16))) = { 0x0163cd6124, 0x0000000000 };
+    static const uint64_t poly[2] __attribute__((aligned(16))) = { 0x01db710641, 0x01f7011641 };
+
+    __m128i x0, x1, x2, x3, x4, x5, x6, x7, x8, y5, y6, y7, y8;
+
+    x1 = _mm_loadu_si128((const __m128i*)(data + 0x00));
+    x2 = _mm_loadu_si128((const __m128i*)(data + 0x10));
+    x3 = _mm_loadu_si128((const __m128i*)(data + 0x20));
+    x4 = _mm_loadu_si128((const __m128i*)(data + 0x30));
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int)crc));
+
+    x0 = _mm_load_si128((const __m128i*)k1k2);
+    data += 64;
+    length -= 64;
+
+    // Fold 64 bytes per iteration across four independent lanes
+    while (length >= 64) {
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+        x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+        x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+
+        y5 = _mm_loadu_si128((const __m128i*)(data + 0x00));
+        y6 = _mm_loadu_si128((const __m128i*)(data + 0x10));
+        y7 = _mm_loadu_si128((const __m128i*)(data + 0x20));
+        y8 = _mm_loadu_si128((const __m128i*)(data + 0x30));
+
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), y5);
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), y6);
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), y7);
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), y8);
+
+        data += 64;
+        length -= 64;
+    }
+
+    // Fold the four lanes into one 128-bit value
+    x0 = _mm_load_si128((const __m128i*)k3k4);
+
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+    // Fold remaining 16-byte blocks
+    while (length >= 16) {
+        x2 = _mm_loadu_si128((const __m128i*)data);
+
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+
+        data += 16;
+        length -= 16;
+    }
+
+    // Fold 128 bits down to 64 bits
+    x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+    x3 = _mm_setr_epi32(~0, 0, ~0, 0);
+    x1 = _mm_srli_si128(x1, 8);
+    x1 = _mm_xor_si128(x1, x2);
+
+    x0 = _mm_loadl_epi64((const __m128i*)k5k0);
+
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, x3);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    // Barrett reduction to 32 bits
+    x0 = _mm_load_si128((const __m128i*)poly);
+
+    x2 = _mm_and_si128(x1, x3);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+    x2 = _mm_and_si128(x2, x3);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    return (uint32_t)_mm_extract_epi32(x1, 1);
+}
+
+/**
+ * SSE4.2 CRC32C update using the crc32 instruction
+ * @param crc Running CRC state (pre-inverted)
+ * @param data Pointer to data
+ * @param length Length of data in bytes
+ * @return Updated CRC state
+ */
+__attribute__((target("sse4.2")))
+static uint32_t crc32c_update_sse42(uint32_t crc, const uint8_t* data, size_t length) {
+#if defined(__x86_64__)
+    uint64_t crc64 = crc;
+    while (length >= 8) {
+        uint64_t word;
+        memcpy(&word, data, sizeof(word));
+        crc64 = _mm_crc32_u64(crc64, word);
+        data += 8;
+        length -= 8;
+    }
+    crc = (uint32_t)crc64;
+#endif
+    while (length >= 4) {
+        uint32_t word;
+        memcpy(&word, data, sizeof(word));
+        crc = _mm_crc32_u32(crc, word);
+        data += 4;
+        length -= 4;
+    }
+    while (length > 0) {
+        crc = _mm_crc32_u8(crc, *data++);
+        length--;
+    }
+    return crc;
+}
+#endif
+
+/**
+ * PCLMULQDQ CRC32 update with table-driven head/tail handling
+ * @param crc Running CRC state (pre-inverted)
+ * @param data Pointer to data
+ * @param length Length of data in bytes
+ * @return Updated CRC state
+ */
+static uint32_t crc32_update_pclmul(uint32_t crc, const uint8_t* data, size_t length) {
+#ifdef HAVE_X86_CRC_KERNELS
+    if (g_cpu_has_pclmul && length >= 64) {
+        size_t bulk = length & ~(size_t)15;
+        crc = crc32_fold_pclmul(crc, data, bulk);
+        data += bulk;
+        length -= bulk;
+    }
+#endif
+    return crc32_update_slice16(crc, data, length);
+}
+
+/**
+ * Get a printable name for a CRC32 engine
+ * @param engine Engine to describe
+ * @return Engine name
+ */
+const char* crc32_engine_name(crc32_engine_t engine) {
+    switch (engine) {
+        case CRC32_ENGINE_BYTEWISE:    return "Bytewise";
+        case CRC32_ENGINE_SLICE_BY_8:  return "Slice-by-8";
+        case CRC32_ENGINE_SLICE_BY_16: return "Slice-by-16";
+        case CRC32_ENGINE_PCLMUL:      return "PCLMULQDQ";
+        default:                       return "Unknown";
+    }
+}
+
+/**
+ * Check whether a CRC32 engine can run on this CPU
+ * @param engine Engine to check
+ * @return true if supported
+ */
+bool crc32_engine_supported(crc32_engine_t engine) {
+    if ((int)engine < 0 || engine >= CRC32_ENGINE_COUNT) {
+        return false;
+    }
+
+    if (engine == CRC32_ENGINE_PCLMUL) {
+        detect_cpu_features();
+        return g_cpu_has_pclmul;
+    }
+
+    return true;
+}
+
+/**
+ * Pick the fastest supported CRC32 engine
+ */
+static void select_crc32_engine(void) {
+    crc32_engine_t best = crc32_engine_supported(CRC32_ENGINE_PCLMUL) ?
+                          CRC32_ENGINE_PCLMUL : CRC32_ENGINE_SLICE_BY_16;
+    __atomic_store_n(&g_crc32_engine, best, __ATOMIC_RELAXED);
+}
+
+/**
+ * Run engine dispatch once (thread-safe)
+ */
+static void init_crc32_dispatch(void) {
+    pthread_once(&crc32_dispatch_once, select_crc32_engine);
+}
+
+/**
+ * Select the CRC32 engine used by calculate_crc32_optimized()
+ * @param engine Engine to use for subsequent calculations
+ */
+void set_crc32_engine(crc32_engine_t engine) {
+    if ((int)engine < 0 || engine >= CRC32_ENGINE_COUNT) {
+        printf("Error: Invalid CRC32 engine %d\n", (int)engine);
+        return;
+    }
+
+    if (!crc32_engine_supported(engine)) {
+        printf("Error: CRC32 engine %s not supported on this CPU\n", crc32_engine_name(engine));
+        return;
+    }
+
+    init_crc32_dispatch();
+    __atomic_store_n(&g_crc32_engine, engine, __ATOMIC_RELAXED);
+}
+
+/**
+ * Get the CRC32 engine currently used by calculate_crc32_optimized()
+ * @return Active engine
+ */
+crc32_engine_t get_crc32_engine(void) {
+    init_crc32_dispatch();
+    return __atomic_load_n(&g_crc32_engine, __ATOMIC_RELAXED);
+}
+
+/**
+ * Advance a running CRC32 state with the given engine
+ * @param crc Running CRC state (pre-inverted)
+ * @param data Pointer to data
+ * @param length Length of data in bytes
+ * @param engine Engine to use
+ * @return Updated CRC state
+ */
+static uint32_t crc32_update_engine(uint32_t crc, const uint8_t* data, size_t length,
+                                    crc32_engine_t engine) {
+    switch (engine) {
+        case CRC32_ENGINE_SLICE_BY_8:
+            init_crc32_slice_tables();
+            return crc32_update_slice8(crc, data, length);
+
+        case CRC32_ENGINE_SLICE_BY_16:
+            init_crc32_slice_tables();
+            return crc32_update_slice16(crc, data, length);
+
+        case CRC32_ENGINE_PCLMUL:
+            // Falls back to slicing-by-16 when the CPU lacks PCLMULQDQ
+            detect_cpu_features();
+            init_crc32_slice_tables();
+            return crc32_update_pclmul(crc, data, length);
+
+        case CRC32_ENGINE_BYTEWISE:
+        default:
+            return crc32_update_bytewise(crc, data, length);
+    }
+}
+
+/**
+ * CRC32 calculation with an explicitly chosen engine
+ * All engines produce bit-identical results.
+ * @param data Pointer to data to calculate CRC for
+ * @param length Length of data in bytes
+ * @param engine Engine to use
+ * @return CRC32 checksum (0 for NULL or empty input)
+ */
+uint32_t calculate_crc32_with_engine(const uint8_t* data, size_t length, crc32_engine_t engine) {
+    if (data == NULL || length == 0) {
+        return 0;
+    }
+
+    return crc32_update_engine(0xFFFFFFFF, data, length, engine) ^ 0xFFFFFFFF;
+}
+
 /**
  * AI-optimized CRC32 calculation using lookup table
  * Original AI suggestion: Use table-driven approach for faster CRC calculation
  * Human improvement: Added input validation and bounds checking
+ * Performance: Dispatches to the engine chosen with set_crc32_engine()
+ * (PCLMULQDQ folding when available, otherwise slicing-by-16)
  * @param data Pointer to data to calculate CRC for
  * @param length Length of data in bytes
  * @return CRC32 checksum
@@ -122,14 +650,229 @@ uint32_t calculate_crc32_optimized(const uint8_t* data, size_t length) {
         return 0;
     }
 
-    uint32_t crc = 0xFFFFFFFF;
+    init_crc32_dispatch();
+    return calculate_crc32_with_engine(data, length, __atomic_load_n(&g_crc32_engine, __ATOMIC_RELAXED));
+}
 
-    for (size_t i = 0; i < length; i++) {
-        uint8_t table_index = (crc ^ data[i]) & 0xFF;
-        crc = (crc >> 8) ^ crc32_table[table_index];
+/**
+ * Initialize a streaming CRC32 context
+ * The context starts at the CRC identity, so an empty stream finalizes to
+ * 0 (the CRC32 of an empty message) and empty updates are no-ops.
+ * @param ctx Context to initialize
+ */
+void crc32_init(crc32_context_t* ctx) {
+    if (ctx == NULL) return;
+
+    ctx->state = 0xFFFFFFFF;
+    ctx->length = 0;
+}
+
+/**
+ * Feed a chunk of data into a streaming CRC32 context
+ * @param ctx Context to update
+ * @param data Pointer to chunk data (may be NULL if length is 0)
+ * @param length Length of chunk in bytes
+ */
+void crc32_update(crc32_context_t* ctx, const uint8_t* data, size_t length) {
+    if (ctx == NULL || length == 0) return;
+
+    if (data == NULL) {
+        printf("Error: NULL data passed to crc32_update\n");
+        return;
     }
 
-    return crc ^ 0xFFFFFFFF;
+    init_crc32_dispatch();
+    ctx->state = crc32_update_engine(ctx->state, data, length,
+                                     __atomic_load_n(&g_crc32_engine, __ATOMIC_RELAXED));
+    ctx->length += length;
+}
+
+/**
+ * Get the CRC32 of everything fed into a context so far
+ * The context is not modified, so more data can still be appended.
+ * @param ctx Context to finalize
+ * @return CRC32 checksum
+ */
+uint32_t crc32_final(const crc32_context_t* ctx) {
+    if (ctx == NULL) return 0;
+
+    return ctx->state ^ 0xFFFFFFFF;
+}
+
+// x2n_table[k] = x^(2^k) mod P(x), used to shift a CRC past len_b zero bytes
+static uint32_t crc32_x2n_table[32];
+static pthread_once_t crc32_x2n_once = PTHREAD_ONCE_INIT;
+
+/**
+ * Multiply two polynomials modulo the CRC32 polynomial (bit-reflected)
+ * @param a First operand
+ * @param b Second operand
+ * @return a * b mod P(x)
+ */
+static uint32_t crc32_multmodp(uint32_t a, uint32_t b) {
+    uint32_t m = 1U << 31;
+    uint32_t product = 0;
+
+    while (m != 0) {
+        if (a & m) {
+            product ^= b;
+            if ((a & (m - 1)) == 0) break;
+        }
+        m >>= 1;
+        b = (b & 1) ? (b >> 1) ^ 0xEDB88320 : b >> 1;
+    }
+
+    return product;
+}
+
+/**
+ * Fill crc32_x2n_table by repeated squaring of x
+ */
+static void build_crc32_x2n_table(void) {
+    uint32_t p = 1U << 30;  // x^1
+    for (int k = 0; k < 32; k++) {
+        crc32_x2n_table[k] = p;
+        p = crc32_multmodp(p, p);
+    }
+}
+
+/**
+ * Compute x^(8 * n) mod P(x), i.e. the operator for appending n zero bytes
+ * @param n Number of bytes
+ * @return Shift operator
+ */
+static uint32_t crc32_x8nmodp(uint64_t n) {
+    pthread_once(&crc32_x2n_once, build_crc32_x2n_table);
+
+    uint32_t p = 1U << 31;  // x^0
+    int k = 3;              // n bytes = 2^3 * n bits
+    while (n != 0) {
+        if (n & 1) {
+            p = crc32_multmodp(crc32_x2n_table[k & 31], p);
+        }
+        n >>= 1;
+        k++;
+    }
+
+    return p;
+}
+
+/**
+ * Combine the CRC32s of two adjacent blocks into the CRC32 of A followed by B
+ * Runs in O(log len_b), so partial CRCs of a split buffer can be computed
+ * independently (e.g. one chunk per thread) and merged afterwards.
+ * @param crc_a CRC32 of the first block
+ * @param crc_b CRC32 of the second block
+ * @param len_b Length of the second block in bytes
+ * @return CRC32 of the concatenation
+ */
+uint32_t crc32_combine(uint32_t crc_a, uint32_t crc_b, size_t len_b) {
+    if (len_b == 0) return crc_a;
+
+    return crc32_multmodp(crc32_x8nmodp(len_b), crc_a) ^ crc_b;
+}
+
+/**
+ * Generate the CRC32C slicing-by-8 tables
+ */
+static void build_crc32c_tables(void) {
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t crc = i;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 1) ? (crc >> 1) ^ CRC32C_POLYNOMIAL : crc >> 1;
+        }
+        crc32c_slice_table[0][i] = crc;
+    }
+
+    for (int k = 1; k < 8; k++) {
+        for (int i = 0; i < 256; i++) {
+            uint32_t prev = crc32c_slice_table[k - 1][i];
+            crc32c_slice_table[k][i] = (prev >> 8) ^ crc32c_slice_table[0][prev & 0xFF];
+        }
+    }
+}
+
+/**
+ * Make sure the CRC32C tables are built (thread-safe, runs once)
+ */
+static void init_crc32c_tables(void) {
+    pthread_once(&crc32c_tables_once, build_crc32c_tables);
+}
+
+/**
+ * Table-driven CRC32C update (slicing-by-8)
+ * @param crc Running CRC state (pre-inverted)
+ * @param data Pointer to data
+ * @param length Length of data in bytes
+ * @return Updated CRC state
+ */
+static uint32_t crc32c_update_table(uint32_t crc, const uint8_t* data, size_t length) {
+    const uint32_t (*t)[256] = crc32c_slice_table;
+
+    while (length >= 8) {
+        uint32_t one = crc ^ load_le32(data);
+        uint32_t two = load_le32(data + 4);
+
+        crc = t[7][one & 0xFF] ^ t[6][(one >> 8) & 0xFF] ^
+              t[5][(one >> 16) & 0xFF] ^ t[4][one >> 24] ^
+              t[3][two & 0xFF] ^ t[2][(two >> 8) & 0xFF] ^
+              t[1][(two >> 16) & 0xFF] ^ t[0][two >> 24];
+
+        data += 8;
+        length -= 8;
+    }
+
+    while (length > 0) {
+        crc = (crc >> 8) ^ t[0][(crc ^ *data++) & 0xFF];
+        length--;
+    }
+
+    return crc;
+}
+
+/**
+ * Check whether CRC32C runs on the SSE4.2 crc32 instruction
+ * @return true if the hardware path is used
+ */
+bool crc32c_hardware_available(void) {
+    detect_cpu_features();
+    return g_cpu_has_sse42;
+}
+
+/**
+ * Software CRC32C (Castagnoli) calculation
+ * @param data Pointer to data to calculate CRC for
+ * @param length Length of data in bytes
+ * @return CRC32C checksum (0 for NULL or empty input)
+ */
+uint32_t calculate_crc32c_software(const uint8_t* data, size_t length) {
+    if (data == NULL || length == 0) {
+        return 0;
+    }
+
+    init_crc32c_tables();
+    return crc32c_update_table(0xFFFFFFFF, data, length) ^ 0xFFFFFFFF;
+}
+
+/**
+ * CRC32C (Castagnoli) calculation
+ * Uses the SSE4.2 crc32 instruction when available, slicing-by-8 otherwise.
+ * @param data Pointer to data to calculate CRC for
+ * @param length Length of data in bytes
+ * @return CRC32C checksum (0 for NULL or empty input)
+ */
+uint32_t calculate_crc32c(const uint8_t* data, size_t length) {
+    if (data == NULL || length == 0) {
+        return 0;
+    }
+
+#ifdef HAVE_X86_CRC_KERNELS
+    if (crc32c_hardware_available()) {
+        return crc32c_update_sse42(0xFFFFFFFF, data, length) ^ 0xFFFFFFFF;
+    }
+#endif
+
+    return calculate_crc32c_software(data, length);
 }
 
 /**
@@ -170,7 +913,7 @@ uint32_t calculate_crc32_naive(const uint8_t* data, size_t length) {
  */
 int validate_registers_optimized(const register_set_t* registers) {
     if (registers == NULL) {
-        printf("Error: NULL register set\n");
+        CHIP_LOG(CHIP_LOG_ERROR, "Error: NULL register set\n");
         return 0;
     }
 
@@ -223,7 +966,7 @@ int validate_registers_optimized(const register_set_t* registers) {
 
     if (score < 0) score = 0;
 
-    printf("Register validation (optimized): Score=%d, Issues=0x%08X\n", score, issues);
+    CHIP_LOG(CHIP_LOG_DEBUG, "Register validation (optimized): Score=%d, Issues=0x%08X\n", score, issues);
     return score;
 }
 
@@ -265,7 +1008,7 @@ int validate_registers_original(const register_set_t* registers) {
 
     if (score < 0) score = 0;
 
-    printf("Register validation (original): Score=%d\n", score);
+    CHIP_LOG(CHIP_LOG_DEBUG, "Register validation (original): Score=%d\n", score);
     return score;
 }
 
@@ -280,7 +1023,7 @@ int validate_registers_original(const register_set_t* registers) {
  */
 int process_chip_array_optimized(chip_state_t** chips, int count, float temperature_threshold) {
     if (chips == NULL || count <= 0) {
-        printf("Error: Invalid chip array parameters\n");
+        CHIP_LOG(CHIP_LOG_ERROR, "Error: Invalid chip array parameters\n");
         return -1;
     }
 
@@ -288,7 +1031,7 @@ int process_chip_array_optimized(chip_state_t** chips, int count, float temperat
     float temp_sum = 0.0f;
     uint32_t error_mask = 0;
 
-    printf("Processing %d chips (optimized)...\n", count);
+    CHIP_LOG(CHIP_LOG_INFO, "Processing %d chips (optimized)...\n", count);
 
     // AI suggestion: Single pass processing with vectorized operations
     for (int i = 0; i < count; i++) {
@@ -310,7 +1053,7 @@ int process_chip_array_optimized(chip_state_t** chips, int count, float temperat
 
         if (has_issues) {
             issues_found++;
-            printf("  Chip[%d] %s: Issues detected\n", i, chip->chip_id);
+            CHIP_LOG(CHIP_LOG_DEBUG, "  Chip[%d] %s: Issues detected\n", i, chip->chip_id);
 
             // Use bit manipulation to categorize issues
             uint32_t issue_flags = 0;
@@ -319,16 +1062,16 @@ int process_chip_array_optimized(chip_state_t** chips, int count, float temperat
             if (chip->error_count > 0) issue_flags |= 0x4;
             if (chip->registers.error_register != 0) issue_flags |= 0x8;
 
-            printf("    Issue flags: 0x%X\n", issue_flags);
+            CHIP_LOG(CHIP_LOG_DEBUG, "    Issue flags: 0x%X\n", issue_flags);
         }
     }
 
     float avg_temperature = (count > 0) ? temp_sum / count : 0.0f;
-    printf("Average temperature: %.1f°C\n", avg_temperature);
-    printf("Chips with issues: %d/%d\n", issues_found, count);
+    CHIP_LOG(CHIP_LOG_INFO, "Average temperature: %.1f°C\n", avg_temperature);
+    CHIP_LOG(CHIP_LOG_INFO, "Chips with issues: %d/%d\n", issues_found, count);
 
     if (error_mask != 0) {
-        printf("Warning: NULL chip pointers detected (mask: 0x%08X)\n", error_mask);
+        CHIP_LOG(CHIP_LOG_WARN, "Warning: NULL chip pointers detected (mask: 0x%08X)\n", error_mask);
     }
 
     return issues_found;
@@ -349,7 +1092,7 @@ int process_chip_array_original(chip_state_t** chips, int count, float temperatu
     int issues_found = 0;
     float temp_sum = 0.0f;
 
-    printf("Processing %d chips (original)...\n", count);
+    CHIP_LOG(CHIP_LOG_INFO, "Processing %d chips (original)...\n", count);
 
     for (int i = 0; i < count; i++) {
         if (chips[i] == NULL) continue;
@@ -360,42 +1103,173 @@ int process_chip_array_original(chip_state_t** chips, int count, float temperatu
         // Check each condition separately
         if (chip->temperature > temperature_threshold) {
             issues_found++;
-            printf("  Chip[%d] %s: Temperature issue\n", i, chip->chip_id);
+            CHIP_LOG(CHIP_LOG_DEBUG, "  Chip[%d] %s: Temperature issue\n", i, chip->chip_id);
         }
 
         if (chip->voltage < 3.0f || chip->voltage > 3.6f) {
             issues_found++;
-            printf("  Chip[%d] %s: Voltage issue\n", i, chip->chip_id);
+            CHIP_LOG(CHIP_LOG_DEBUG, "  Chip[%d] %s: Voltage issue\n", i, chip->chip_id);
         }
 
         if (chip->error_count > 0) {
             issues_found++;
-            printf("  Chip[%d] %s: Error count issue\n", i, chip->chip_id);
+            CHIP_LOG(CHIP_LOG_DEBUG, "  Chip[%d] %s: Error count issue\n", i, chip->chip_id);
         }
 
         if (chip->registers.error_register != 0) {
             issues_found++;
-            printf("  Chip[%d] %s: Error register issue\n", i, chip->chip_id);
+            CHIP_LOG(CHIP_LOG_DEBUG, "  Chip[%d] %s: Error register issue\n", i, chip->chip_id);
         }
     }
 
     float avg_temperature = (count > 0) ? temp_sum / count : 0.0f;
-    printf("Average temperature: %.1f°C\n", avg_temperature);
-    printf("Chips with issues: %d/%d\n", issues_found, count);
+    CHIP_LOG(CHIP_LOG_INFO, "Average temperature: %.1f°C\n", avg_temperature);
+    CHIP_LOG(CHIP_LOG_INFO, "Chips with issues: %d/%d\n", issues_found, count);
 
     return issues_found;
 }
 
+/**
+ * Portable copy using 64-bit words with overlapping head/tail handling
+ * @param d Destination buffer
+ * @param s Source buffer
+ * @param size Number of bytes to copy
+ */
+static void memory_copy_words(uint8_t* d, const uint8_t* s, size_t size) {
+    if (size < 8) {
+        for (size_t i = 0; i < size; i++) {
+            d[i] = s[i];
+        }
+        return;
+    }
+
+    // Last word is copied up front so the loop never needs a byte tail
+    uint64_t tail;
+    memcpy(&tail, s + size - 8, sizeof(tail));
+
+    for (size_t i = 0; i + 8 <= size; i += 8) {
+        uint64_t word;
+        memcpy(&word, s + i, sizeof(word));
+        memcpy(d + i, &word, sizeof(word));
+    }
+
+    memcpy(d + size - 8, &tail, sizeof(tail));
+}
+
+#ifdef HAVE_X86_CRC_KERNELS
+/**
+ * AVX2 copy: 256-bit unaligned loads, destination-aligned stores
+ * Small sizes use overlapping loads/stores instead of byte loops. Sizes at or
+ * above the non-temporal threshold bypass the cache with streaming stores.
+ * @param d Destination buffer
+ * @param s Source buffer (must not overlap d)
+ * @param size Number of bytes to copy
+ * @param nt_threshold Size at which streaming stores are used
+ */
+__attribute__((target("avx2")))
+static void memory_copy_avx2(uint8_t* d, const uint8_t* s, size_t size, size_t nt_threshold) {
+    if (size < 32) {
+        if (size >= 16) {
+            __m128i head = _mm_loadu_si128((const __m128i*)s);
+            __m128i tail = _mm_loadu_si128((const __m128i*)(s + size - 16));
+            _mm_storeu_si128((__m128i*)d, head);
+            _mm_storeu_si128((__m128i*)(d + size - 16), tail);
+        } else {
+            memory_copy_words(d, s, size);
+        }
+        return;
+    }
+
+    // Head and tail are copied unaligned; the body then overlaps them safely
+    __m256i head = _mm256_loadu_si256((const __m256i*)s);
+    __m256i tail = _mm256_loadu_si256((const __m256i*)(s + size - 32));
+
+    if (size <= 64) {
+        _mm256_storeu_si256((__m256i*)d, head);
+        _mm256_storeu_si256((__m256i*)(d + size - 32), tail);
+        return;
+    }
+
+    // Advance to the next 32-byte aligned destination address
+    size_t skew = 32 - ((uintptr_t)d & 31);
+    uint8_t* dst = d + skew;
+    const uint8_t* src = s + skew;
+    size_t remaining = size - skew;
+
+    if (size >= nt_threshold) {
+        while (remaining >= 128) {
+            __m256i a = _mm256_loadu_si256((const __m256i*)(src + 0));
+            __m256i b = _mm256_loadu_si256((const __m256i*)(src + 32));
+            __m256i c = _mm256_loadu_si256((const __m256i*)(src + 64));
+            __m256i e = _mm256_loadu_si256((const __m256i*)(src + 96));
+            _mm256_stream_si256((__m256i*)(dst + 0), a);
+            _mm256_stream_si256((__m256i*)(dst + 32), b);
+            _mm256_stream_si256((__m256i*)(dst + 64), c);
+            _mm256_stream_si256((__m256i*)(dst + 96), e);
+            src += 128;
+            dst += 128;
+            remaining -= 128;
+        }
+        _mm_sfence();
+    } else {
+        while (remaining >= 128) {
+            __m256i a = _mm256_loadu_si256((const __m256i*)(src + 0));
+            __m256i b = _mm256_loadu_si256((const __m256i*)(src + 32));
+            __m256i c = _mm256_loadu_si256((const __m256i*)(src + 64));
+            __m256i e = _mm256_loadu_si256((const __m256i*)(src + 96));
+            _mm256_store_si256((__m256i*)(dst + 0), a);
+            _mm256_store_si256((__m256i*)(dst + 32), b);
+            _mm256_store_si256((__m256i*)(dst + 64), c);
+            _mm256_store_si256((__m256i*)(dst + 96), e);
+            src += 128;
+            dst += 128;
+            remaining -= 128;
+        }
+    }
+
+    while (remaining >= 32) {
+        _mm256_store_si256((__m256i*)dst, _mm256_loadu_si256((const __m256i*)src));
+        src += 32;
+        dst += 32;
+        remaining -= 32;
+    }
+
+    _mm256_storeu_si256((__m256i*)d, head);
+    _mm256_storeu_si256((__m256i*)(d + size - 32), tail);
+}
+#endif
+
+/**
+ * Set the size at which optimized_memory_copy() switches to non-temporal stores
+ * @param threshold Size in bytes (0 restores the default)
+ */
+void set_memory_copy_nt_threshold(size_t threshold) {
+    g_nt_copy_threshold = (threshold == 0) ? DEFAULT_NT_COPY_THRESHOLD : threshold;
+}
+
+/**
+ * Get the size at which optimized_memory_copy() switches to non-temporal stores
+ * @return Threshold in bytes
+ */
+size_t get_memory_copy_nt_threshold(void) {
+    return g_nt_copy_threshold;
+}
+
 /**
  * AI-optimized memory copy with alignment optimization
  * Original AI suggestion: Use word-aligned copies for better performance
  * Human improvement: Added alignment detection and fallback
+ * Performance: AVX2 256-bit copies with unaligned head/tail handling and
+ * streaming stores for large copies; 64-bit word copies without AVX2.
+ * Buffers must not overlap (memcpy semantics).
  * @param dest Destination buffer
  * @param src Source buffer
  * @param size Number of bytes to copy
  */
 void optimized_memory_copy(void* dest, const void* src, size_t size) {
-    if (dest == NULL || src == NULL || size == 0) {
+    if (size == 0) return;
+
+    if (dest == NULL || src == NULL) {
         printf("Error: Invalid parameters for memory copy\n");
         return;
     }
@@ -403,37 +1277,83 @@ void optimized_memory_copy(void* dest, const void* src, size_t size) {
     uint8_t* d = (uint8_t*)dest;
     const uint8_t* s = (const uint8_t*)src;
 
-    // AI optimization: Check alignment and use word copies when possible
-    if (((uintptr_t)dest % sizeof(uint32_t)) == 0 &&
-        ((uintptr_t)src % sizeof(uint32_t)) == 0 &&
-        size >= sizeof(uint32_t)) {
+#ifdef HAVE_X86_CRC_KERNELS
+    detect_cpu_features();
+    if (g_cpu_has_avx2) {
+        memory_copy_avx2(d, s, size, g_nt_copy_threshold);
+        return;
+    }
+#endif
 
-        // Use 32-bit word copies for aligned data
-        size_t word_count = size / sizeof(uint32_t);
-        size_t remaining = size % sizeof(uint32_t);
+    memory_copy_words(d, s, size);
+}
 
-        uint32_t* dest_words = (uint32_t*)dest;
-        const uint32_t* src_words = (const uint32_t*)src;
+// Bytes copied per size and routine in benchmark_memory_copy_sweep()
+#define COPY_SWEEP_BYTES_PER_SIZE (32u * 1024u * 1024u)
 
-        for (size_t i = 0; i < word_count; i++) {
-            dest_words[i] = src_words[i];
+/**
+ * Benchmark optimized_memory_copy() against libc memcpy from 16 B up to max_size
+ * Each size copies about 32 MiB per routine (at least two copies), so the
+ * whole sweep stays under a second or two even with the largest buffers.
+ * @param max_size Largest copy in bytes (0 for 16 MiB; 64 MiB or more shows
+ *                 DRAM bandwidth well past the non-temporal threshold)
+ */
+void benchmark_memory_copy_sweep(size_t max_size) {
+    printf("\n--- Memory Copy Sweep (optimized_memory_copy vs memcpy) ---\n");
+    detect_cpu_features();
+    printf("AVX2: %s, non-temporal threshold: %zu bytes\n",
+           g_cpu_has_avx2 ? "yes" : "no", g_nt_copy_threshold);
+
+    if (max_size == 0) max_size = 16u * 1024u * 1024u;
+
+    uint8_t* src = malloc(max_size + 64);
+    uint8_t* dst = malloc(max_size + 64);
+    if (src == NULL || dst == NULL) {
+        printf("Failed to allocate copy buffers\n");
+        free(src);
+        free(dst);
+        return;
+    }
+    memset(src, 0x5A, max_size + 64);
+    memset(dst, 0, max_size + 64);
+
+    printf("%10s %12s %12s %8s\n", "Size", "Optimized", "memcpy", "Ratio");
+    for (size_t size = 16; size <= max_size; size *= 4) {
+        size_t iterations = COPY_SWEEP_BYTES_PER_SIZE / size;
+        if (iterations > 1000000) iterations = 1000000;
+        if (iterations < 2) iterations = 2;
+
+        // Odd offsets exercise the unaligned head/tail paths
+        const uint8_t* s = src + 1;
+        uint8_t* d = dst + 3;
+
+        // Warm up caches/TLB so both routines start from the same state
+        optimized_memory_copy(d, s, size);
+        memcpy(d, s, size);
+
+        clock_t start = clock();
+        for (size_t i = 0; i < iterations; i++) {
+            benchmark_barrier(d);
+            optimized_memory_copy(d, s, size);
         }
+        double opt_sec = (double)(clock() - start) / CLOCKS_PER_SEC;
 
-        // Copy remaining bytes
-        d += word_count * sizeof(uint32_t);
-        s += word_count * sizeof(uint32_t);
-        for (size_t i = 0; i < remaining; i++) {
-            d[i] = s[i];
+        start = clock();
+        for (size_t i = 0; i < iterations; i++) {
+            benchmark_barrier(d);
+            memcpy(d, s, size);
         }
+        double libc_sec = (double)(clock() - start) / CLOCKS_PER_SEC;
 
-        printf("Optimized copy: %zu words + %zu bytes\n", word_count, remaining);
-    } else {
-        // Fallback to byte-by-byte copy
-        for (size_t i = 0; i < size; i++) {
-            d[i] = s[i];
-        }
-        printf("Byte-wise copy: %zu bytes\n", size);
+        double total_gb = (double)size * iterations / 1e9;
+        double opt_gbps = opt_sec > 0.0 ? total_gb / opt_sec : 0.0;
+        double libc_gbps = libc_sec > 0.0 ? total_gb / libc_sec : 0.0;
+        printf("%10zu %8.2f GB/s %7.2f GB/s %7.2fx\n", size, opt_gbps, libc_gbps,
+               libc_gbps > 0.0 ? opt_gbps / libc_gbps : 0.0);
     }
+
+    free(src);
+    free(dst);
 }
 
 /**
@@ -460,6 +1380,10 @@ void compare_optimization_performance(void) {
 
     performance_metric_t metric;
 
+    // Timed loops measure computation, not per-call diagnostics
+    int saved_log_level = chip_log_get_level();
+    chip_log_set_level(CHIP_LOG_WARN);
+
     printf("\n--- CRC32 Performance Comparison ---\n");
 
     // Test optimized CRC32
@@ -475,6 +1399,7 @@ void compare_optimization_performance(void) {
     start_performance_measurement(&metric, "CRC32 Naive");
     uint32_t crc_naive = 0;
     for (int i = 0; i < num_iterations; i++) {
+        benchmark_barrier(test_data);
         crc_naive = calculate_crc32_naive(test_data, test_data_size);
     }
     end_performance_measurement(&metric);
@@ -483,6 +1408,70 @@ void compare_optimization_performance(void) {
     printf("CRC32 Results: Optimized=0x%08X, Naive=0x%08X\n", crc_opt, crc_naive);
     printf("Performance improvement: %.2fx faster\n", crc_naive_time / crc_opt_time);
 
+    // Compare each table-driven engine against the naive bitwise version
+    printf("\n--- CRC32 Engine Comparison ---\n");
+    for (int engine = 0; engine < CRC32_ENGINE_COUNT; engine++) {
+        if (!crc32_engine_supported((crc32_engine_t)engine)) {
+            printf("  %-12s not supported on this CPU\n", crc32_engine_name((crc32_engine_t)engine));
+            continue;
+        }
+
+        start_performance_measurement(&metric, crc32_engine_name((crc32_engine_t)engine));
+        uint32_t crc_engine = 0;
+        for (int i = 0; i < num_iterations; i++) {
+            benchmark_barrier(test_data);
+            crc_engine = calculate_crc32_with_engine(test_data, test_data_size,
+                                                     (crc32_engine_t)engine);
+        }
+        end_performance_measurement(&metric);
+
+        double mb_per_sec = metric.execution_time_ms > 0.0 ?
+            ((double)test_data_size * num_iterations / (1024.0 * 1024.0)) /
+            (metric.execution_time_ms / 1000.0) : 0.0;
+        printf("  %-12s CRC=0x%08X %s, %.2fx vs naive, %.1f MB/s\n",
+               crc32_engine_name((crc32_engine_t)engine), crc_engine,
+               crc_engine == crc_naive ? "(match)" : "(MISMATCH)",
+               metric.execution_time_ms > 0.0 ? crc_naive_time / metric.execution_time_ms : 0.0,
+               mb_per_sec);
+    }
+    printf("Active engine: %s\n", crc32_engine_name(get_crc32_engine()));
+
+    // Chunked checksum: independent partial CRCs merged with crc32_combine()
+    const size_t chunk_count = 4;
+    const size_t chunk_size = test_data_size / chunk_count;
+    uint32_t crc_chunked = 0;
+    for (size_t c = 0; c < chunk_count; c++) {
+        size_t len = (c == chunk_count - 1) ? test_data_size - c * chunk_size : chunk_size;
+        uint32_t part = calculate_crc32_optimized(test_data + c * chunk_size, len);
+        crc_chunked = (c == 0) ? part : crc32_combine(crc_chunked, part, len);
+    }
+    printf("Chunked CRC32 (%zu parts via crc32_combine): 0x%08X %s\n", chunk_count,
+           crc_chunked, crc_chunked == crc_naive ? "(match)" : "(MISMATCH)");
+
+    // CRC32C: SSE4.2 crc32 instruction vs table-driven fallback
+    start_performance_measurement(&metric, "CRC32C Software");
+    uint32_t crc32c_sw = 0;
+    for (int i = 0; i < num_iterations; i++) {
+        benchmark_barrier(test_data);
+        crc32c_sw = calculate_crc32c_software(test_data, test_data_size);
+    }
+    end_performance_measurement(&metric);
+    double crc32c_sw_time = metric.execution_time_ms;
+
+    start_performance_measurement(&metric, "CRC32C Dispatched");
+    uint32_t crc32c_hw = 0;
+    for (int i = 0; i < num_iterations; i++) {
+        benchmark_barrier(test_data);
+        crc32c_hw = calculate_crc32c(test_data, test_data_size);
+    }
+    end_performance_measurement(&metric);
+
+    printf("CRC32C Results: %s=0x%08X, Software=0x%08X %s\n",
+           crc32c_hardware_available() ? "SSE4.2" : "Software", crc32c_hw, crc32c_sw,
+           crc32c_hw == crc32c_sw ? "(match)" : "(MISMATCH)");
+    printf("CRC32C improvement: %.2fx faster\n",
+           metric.execution_time_ms > 0.0 ? crc32c_sw_time / metric.execution_time_ms : 0.0);
+
     printf("\n--- Register Validation Performance Comparison ---\n");
 
     register_set_t test_registers = {
@@ -550,12 +1539,32 @@ void compare_optimization_performance(void) {
     printf("Processing Results: Optimized=%d issues, Original=%d issues\n", issues_opt, issues_orig);
     printf("Performance improvement: %.2fx faster\n", proc_orig_time / proc_opt_time);
 
+    benchmark_chip_fleet_scan(20000);
+    benchmark_chip_pool(100000);
+    benchmark_chip_slot_map(50000);
+    benchmark_chip_timer_wheel(100000);
+    benchmark_chip_history(100000);
+    benchmark_chip_telemetry(86400);
+    benchmark_register_vectored_access();
+    benchmark_register_pattern_scan();
+    benchmark_register_shadow(2000);
+    benchmark_register_trace(200000);
+    benchmark_state_snapshot(200);
+    benchmark_register_diff(100000);
+    benchmark_register_watch(200000);
+    benchmark_chip_log(50000);
+    benchmark_memory_tracker_scaling(16);
+    benchmark_memory_sampling_overhead(200000);
+    benchmark_guard_page_overhead(2000);
+    benchmark_memory_copy_sweep(0);
+
     // Cleanup
     for (int i = 0; i < chip_count; i++) {
         free(test_chips[i]);
     }
     free(test_chips);
     free(test_data);
+    chip_log_set_level(saved_log_level);
 
     printf("\n=== Performance Summary ===\n");
     printf("CRC32 optimization: %.2fx improvement\n", crc_naive_time / crc_opt_time);
@@ -572,10 +1581,10 @@ void demonstrate_ai_optimizations(void) {
     printf("\nAI Optimization Process:\n");
     printf("1. Identified performance bottlenecks in original code\n");
     printf("2. Applied AI-suggested optimizations:\n");
-    printf("   - Table-driven CRC32 calculation\n");
+    printf("   - Table-driven CRC32 calculation (slicing-by-8/16, PCLMULQDQ folding)\n");
     printf("   - Bitwise operations for validation\n");
     printf("   - SIMD-like array processing\n");
-    printf("   - Memory alignment optimization\n");
+    printf("   - Memory alignment optimization (AVX2 copy engine)\n");
     printf("3. Added human improvements:\n");
     printf("   - Input validation and error handling\n");
     printf("   - Comprehensive error reporting\n");
@@ -0,0 +1,410 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "chip_state.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HAVE_X86_FLEET_KERNELS 1
+#endif
+
+// Field arrays are aligned to a cache line and padded to whole 8-chip vectors
+#define FLEET_ALIGNMENT 64
+#define FLEET_LANES 8
+
+// Issue flag thresholds (shared with process_chip_array_optimized)
+#define FLEET_VOLTAGE_MIN 3.0f
+#define FLEET_VOLTAGE_MAX 3.6f
+
+/**
+ * Allocate one cache-line aligned, zeroed field array
+ * @param capacity Number of elements
+ * @param element_size Size of each element
+ * @return Aligned array or NULL if failed
+ */
+static void* alloc_fleet_array(int capacity, size_t element_size) {
+    void* ptr = NULL;
+    size_t bytes = (size_t)capacity * element_size;
+
+    if (posix_memalign(&ptr, FLEET_ALIGNMENT, bytes) != 0) {
+        return NULL;
+    }
+
+    memset(ptr, 0, bytes);
+    return ptr;
+}
+
+/**
+ * Create a Structure-of-Arrays chip fleet
+ * @param capacity Maximum number of chips
+ * @return Fleet or NULL if failed
+ */
+chip_fleet_t* create_chip_fleet(int capacity) {
+    if (capacity <= 0) {
+        printf("Error: Invalid fleet capacity %d\n", capacity);
+        return NULL;
+    }
+
+    chip_fleet_t* fleet = calloc(1, sizeof(chip_fleet_t));
+    if (fleet == NULL) {
+        printf("Error: Failed to allocate chip fleet\n");
+        return NULL;
+    }
+
+    // Round up so vector loads never run past the end of an array
+    int padded = (capacity + FLEET_LANES - 1) / FLEET_LANES * FLEET_LANES;
+
+    fleet->capacity = capacity;
+    fleet->count = 0;
+    fleet->temperatures = alloc_fleet_array(padded, sizeof(float));
+    fleet->voltages = alloc_fleet_array(padded, sizeof(float));
+    fleet->error_counts = alloc_fleet_array(padded, sizeof(uint32_t));
+    fleet->control_registers = alloc_fleet_array(padded, sizeof(uint32_t));
+    fleet->status_registers = alloc_fleet_array(padded, sizeof(uint32_t));
+    fleet->error_registers = alloc_fleet_array(padded, sizeof(uint32_t));
+    fleet->config_registers = alloc_fleet_array(padded, sizeof(uint32_t));
+
+    if (fleet->temperatures == NULL || fleet->voltages == NULL ||
+        fleet->error_counts == NULL || fleet->control_registers == NULL ||
+        fleet->status_registers == NULL || fleet->error_registers == NULL ||
+        fleet->config_registers == NULL) {
+        printf("Error: Failed to allocate fleet field arrays\n");
+        destroy_chip_fleet(fleet);
+        return NULL;
+    }
+
+    return fleet;
+}
+
+/**
+ * Destroy a chip fleet and all of its field arrays
+ * @param fleet Fleet to destroy
+ */
+void destroy_chip_fleet(chip_fleet_t* fleet) {
+    if (fleet == NULL) return;
+
+    free(fleet->temperatures);
+    free(fleet->voltages);
+    free(fleet->error_counts);
+    free(fleet->control_registers);
+    free(fleet->status_registers);
+    free(fleet->error_registers);
+    free(fleet->config_registers);
+    free(fleet);
+}
+
+/**
+ * Append one chip's hot fields to the fleet
+ * @param fleet Fleet to append to
+ * @param chip Chip to copy from
+ * @return Fleet index of the chip or -1 if failed
+ */
+int chip_fleet_add(chip_fleet_t* fleet, const chip_state_t* chip) {
+    if (fleet == NULL || chip == NULL) {
+        return -1;
+    }
+
+    if (fleet->count >= fleet->capacity) {
+        printf("Error: Chip fleet at capacity (%d chips)\n", fleet->capacity);
+        return -1;
+    }
+
+    int i = fleet->count++;
+    fleet->temperatures[i] = chip->temperature;
+    fleet->voltages[i] = chip->voltage;
+    fleet->error_counts[i] = chip->error_count;
+    fleet->control_registers[i] = chip->registers.control_register;
+    fleet->status_registers[i] = chip->registers.status_register;
+    fleet->error_registers[i] = chip->registers.error_register;
+    fleet->config_registers[i] = chip->registers.config_register;
+
+    return i;
+}
+
+/**
+ * Load a chip pointer array into the fleet (NULL entries are skipped)
+ * @param fleet Fleet to load into (existing contents are replaced)
+ * @param chips Array of chip pointers
+ * @param count Number of chips
+ * @return Number of chips loaded or -1 if failed
+ */
+int chip_fleet_load(chip_fleet_t* fleet, chip_state_t** chips, int count) {
+    if (fleet == NULL || chips == NULL || count < 0) {
+        return -1;
+    }
+
+    fleet->count = 0;
+    for (int i = 0; i < count; i++) {
+        if (chips[i] != NULL && chip_fleet_add(fleet, chips[i]) < 0) {
+            return -1;
+        }
+    }
+
+    return fleet->count;
+}
+
+/**
+ * Compute the issue flags for a single chip
+ * Flags match process_chip_array_optimized(): 0x1 temperature, 0x2 voltage,
+ * 0x4 error count, 0x8 error register.
+ * @param chip Chip to check
+ * @param temperature_threshold Temperature threshold for warnings
+ * @return Issue flags (0 if no issues)
+ */
+uint32_t compute_chip_issue_flags(const chip_state_t* chip, float temperature_threshold) {
+    if (chip == NULL) return 0;
+
+    uint32_t flags = 0;
+    if (chip->temperature > temperature_threshold) flags |= 0x1;
+    if (chip->voltage < FLEET_VOLTAGE_MIN || chip->voltage > FLEET_VOLTAGE_MAX) flags |= 0x2;
+    if (chip->error_count > 0) flags |= 0x4;
+    if (chip->registers.error_register != 0) flags |= 0x8;
+    return flags;
+}
+
+/**
+ * Scalar fleet scan over a range of chips
+ * @param fleet Fleet to scan
+ * @param start First chip index
+ * @param temperature_threshold Temperature threshold for warnings
+ * @param issue_flags Output flags, one byte per chip
+ * @param temp_sum Accumulated temperature sum
+ * @return Number of chips with issues in the range
+ */
+static int scan_fleet_scalar(const chip_fleet_t* fleet, int start, float temperature_threshold,
+                             uint8_t* issue_flags, double* temp_sum) {
+    int issues = 0;
+
+    for (int i = start; i < fleet->count; i++) {
+        float voltage = fleet->voltages[i];
+        uint8_t flags = 0;
+
+        if (fleet->temperatures[i] > temperature_threshold) flags |= 0x1;
+        if (voltage < FLEET_VOLTAGE_MIN || voltage > FLEET_VOLTAGE_MAX) flags |= 0x2;
+        if (fleet->error_counts[i] != 0) flags |= 0x4;
+        if (fleet->error_registers[i] != 0) flags |= 0x8;
+
+        issue_flags[i] = flags;
+        issues += (flags != 0);
+        *temp_sum += fleet->temperatures[i];
+    }
+
+    return issues;
+}
+
+#ifdef HAVE_X86_FLEET_KERNELS
+/**
+ * AVX2 fleet scan: 8 chips per iteration, flags packed to bytes
+ * @param fleet Fleet to scan
+ * @param temperature_threshold Temperature threshold for warnings
+ * @param issue_flags Output flags, one byte per chip
+ * @param temp_sum Accumulated temperature sum
+ * @return Number of chips with issues in the vectorized range
+ */
+__attribute__((target("avx2")))
+static int scan_fleet_avx2(const chip_fleet_t* fleet, float temperature_threshold,
+                           uint8_t* issue_flags, double* temp_sum) {
+    const __m256 threshold = _mm256_set1_ps(temperature_threshold);
+    const __m256 v_min = _mm256_set1_ps(FLEET_VOLTAGE_MIN);
+    const __m256 v_max = _mm256_set1_ps(FLEET_VOLTAGE_MAX);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i bit_temp = _mm256_set1_epi32(0x1);
+    const __m256i bit_volt = _mm256_set1_epi32(0x2);
+    const __m256i bit_count = _mm256_set1_epi32(0x4);
+    const __m256i bit_reg = _mm256_set1_epi32(0x8);
+
+    // Temperatures are summed in double, like the scalar path: a float sum
+    // over a large fleet loses the low digits of each addend
+    __m256d sum_low = _mm256_setzero_pd();
+    __m256d sum_high = _mm256_setzero_pd();
+    int issues = 0;
+    int vector_end = fleet->count / FLEET_LANES * FLEET_LANES;
+
+    for (int i = 0; i < vector_end; i += FLEET_LANES) {
+        __m256 temp = _mm256_load_ps(fleet->temperatures + i);
+        __m256 volt = _mm256_load_ps(fleet->voltages + i);
+        __m256i count = _mm256_load_si256((const __m256i*)(fleet->error_counts + i));
+        __m256i ereg = _mm256_load_si256((const __m256i*)(fleet->error_registers + i));
+
+        __m256i hot = _mm256_castps_si256(_mm256_cmp_ps(temp, threshold, _CMP_GT_OQ));
+        __m256i bad_volt = _mm256_castps_si256(_mm256_or_ps(
+            _mm256_cmp_ps(volt, v_min, _CMP_LT_OQ), _mm256_cmp_ps(volt, v_max, _CMP_GT_OQ)));
+        __m256i has_count = _mm256_andnot_si256(_mm256_cmpeq_epi32(count, zero),
+                                                _mm256_set1_epi32(-1));
+        __m256i has_reg = _mm256_andnot_si256(_mm256_cmpeq_epi32(ereg, zero),
+                                              _mm256_set1_epi32(-1));
+
+        __m256i flags = _mm256_or_si256(
+            _mm256_or_si256(_mm256_and_si256(hot, bit_temp), _mm256_and_si256(bad_volt, bit_volt)),
+            _mm256_or_si256(_mm256_and_si256(has_count, bit_count), _mm256_and_si256(has_reg, bit_reg)));
+
+        // Narrow 8 x 32-bit flags to 8 bytes
+        __m128i packed16 = _mm_packus_epi32(_mm256_castsi256_si128(flags),
+                                            _mm256_extracti128_si256(flags, 1));
+        __m128i packed8 = _mm_packus_epi16(packed16, packed16);
+        _mm_storel_epi64((__m128i*)(issue_flags + i), packed8);
+
+        int any = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(flags, zero)));
+        issues += __builtin_popcount((unsigned int)any);
+
+        sum_low = _mm256_add_pd(sum_low, _mm256_cvtps_pd(_mm256_castps256_ps128(temp)));
+        sum_high = _mm256_add_pd(sum_high, _mm256_cvtps_pd(_mm256_extractf128_ps(temp, 1)));
+    }
+
+    double lanes[FLEET_LANES / 2];
+    _mm256_storeu_pd(lanes, _mm256_add_pd(sum_low, sum_high));
+    for (int j = 0; j < FLEET_LANES / 2; j++) {
+        *temp_sum += lanes[j];
+    }
+
+    return issues;
+}
+#endif
+
+/**
+ * Check whether the AVX2 fleet kernels can run on this CPU
+ * @return true if AVX2 is available
+ */
+bool chip_fleet_simd_available(void) {
+#ifdef HAVE_X86_FLEET_KERNELS
+    static int has_avx2 = -1;
+    if (has_avx2 < 0) {
+        __builtin_cpu_init();
+        has_avx2 = __builtin_cpu_supports("avx2") ? 1 : 0;
+    }
+    return has_avx2 == 1;
+#else
+    return false;
+#endif
+}
+
+/**
+ * Scan the fleet for issues and produce per-chip issue flags
+ * Uses AVX2 when available (use_simd true), scalar code otherwise.
+ * @param fleet Fleet to scan
+ * @param temperature_threshold Temperature threshold for warnings
+ * @param issue_flags Output flags, one byte per chip (at least fleet->count)
+ * @param avg_temperature Optional output for average temperature
+ * @param use_simd Allow the vectorized kernel
+ * @return Number of chips with issues or -1 if invalid parameters
+ */
+int chip_fleet_scan_issues(const chip_fleet_t* fleet, float temperature_threshold,
+                           uint8_t* issue_flags, float* avg_temperature, bool use_simd) {
+    if (fleet == NULL || issue_flags == NULL) {
+        printf("Error: Invalid fleet scan parameters\n");
+        return -1;
+    }
+
+    double temp_sum = 0.0;
+    int issues = 0;
+    int start = 0;
+
+#ifdef HAVE_X86_FLEET_KERNELS
+    if (use_simd && chip_fleet_simd_available()) {
+        issues = scan_fleet_avx2(fleet, temperature_threshold, issue_flags, &temp_sum);
+        start = fleet->count / FLEET_LANES * FLEET_LANES;
+    }
+#else
+    (void)use_simd;
+#endif
+
+    issues += scan_fleet_scalar(fleet, start, temperature_threshold, issue_flags, &temp_sum);
+
+    if (avg_temperature != NULL) {
+        *avg_temperature = fleet->count > 0 ? (float)(temp_sum / fleet->count) : 0.0f;
+    }
+
+    return issues;
+}
+
+/**
+ * Benchmark AoS pointer chasing against the SoA scalar and AVX2 scans
+ * @param chip_count Number of simulated chips
+ */
+void benchmark_chip_fleet_scan(int chip_count) {
+    printf("\n--- SoA Fleet Scan (%d chips) ---\n", chip_count);
+
+    if (chip_count <= 0) return;
+
+    chip_state_t** chips = malloc((size_t)chip_count * sizeof(chip_state_t*));
+    chip_fleet_t* fleet = create_chip_fleet(chip_count);
+    uint8_t* soa_flags = malloc((size_t)chip_count);
+    uint8_t* aos_flags = malloc((size_t)chip_count);
+
+    if (chips == NULL || fleet == NULL || soa_flags == NULL || aos_flags == NULL) {
+        printf("Failed to allocate benchmark fleet\n");
+        free(chips);
+        destroy_chip_fleet(fleet);
+        free(soa_flags);
+        free(aos_flags);
+        return;
+    }
+
+    int created = 0;
+    for (; created < chip_count; created++) {
+        chips[created] = calloc(1, sizeof(chip_state_t));
+        if (chips[created] == NULL) break;
+        chips[created]->temperature = 25.0f + (rand() % 60);
+        chips[created]->voltage = 2.9f + (rand() % 80) / 100.0f;
+        chips[created]->error_count = (rand() % 10 == 0) ? 1 : 0;
+        chips[created]->registers.error_register = (rand() % 20 == 0) ? 0x4 : 0;
+    }
+    chip_fleet_load(fleet, chips, created);
+
+    const int iterations = 200;
+    clock_t start;
+
+    // AoS: chase each pointer and read fields out of the 80+ byte struct
+    int aos_issues = 0;
+    start = clock();
+    for (int it = 0; it < iterations; it++) {
+        aos_issues = 0;
+        for (int i = 0; i < created; i++) {
+            aos_flags[i] = (uint8_t)compute_chip_issue_flags(chips[i], 70.0f);
+            aos_issues += (aos_flags[i] != 0);
+        }
+        __asm__ __volatile__("" : : "r"(aos_flags) : "memory");
+    }
+    double aos_ms = (double)(clock() - start) / CLOCKS_PER_SEC * 1000.0;
+
+    int scalar_issues = 0;
+    start = clock();
+    for (int it = 0; it < iterations; it++) {
+        scalar_issues = chip_fleet_scan_issues(fleet, 70.0f, soa_flags, NULL, false);
+        __asm__ __volatile__("" : : "r"(soa_flags) : "memory");
+    }
+    double scalar_ms = (double)(clock() - start) / CLOCKS_PER_SEC * 1000.0;
+
+    int simd_issues = 0;
+    start = clock();
+    for (int it = 0; it < iterations; it++) {
+        simd_issues = chip_fleet_scan_issues(fleet, 70.0f, soa_flags, NULL, true);
+        __asm__ __volatile__("" : : "r"(soa_flags) : "memory");
+    }
+    double simd_ms = (double)(clock() - start) / CLOCKS_PER_SEC * 1000.0;
+
+    bool flags_match = memcmp(aos_flags, soa_flags, (size_t)created) == 0;
+
+    printf("AoS pointer scan:  %8.3f ms (%d issues)\n", aos_ms, aos_issues);
+    printf("SoA scalar scan:   %8.3f ms (%d issues)\n", scalar_ms, scalar_issues);
+    printf("SoA %s scan:    %8.3f ms (%d issues)\n",
+           chip_fleet_simd_available() ? "AVX2" : "scalar", simd_ms, simd_issues);
+    printf("Per-chip flags match: %s\n", flags_match ? "YES" : "NO");
+    if (simd_ms > 0.0) {
+        printf("SoA SIMD speedup over AoS: %.2fx\n", aos_ms / simd_ms);
+    }
+
+    for (int i = 0; i < created; i++) {
+        free(chips[i]);
+    }
+    free(chips);
+    destroy_chip_fleet(fleet);
+    free(soa_flags);
+    free(aos_flags);
+}
@@ -0,0 +1,441 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include <time.h>
+
+#include "chip_state.h"
+
+#define CHIP_HISTORY_ALIGNMENT 64
+#define CHIP_HISTORY_MAX_CAPACITY (1u << 24)
+
+// Min/max of a range of ring slots, one node of the range tree
+typedef struct {
+    float min;
+    float max;
+} chip_range_node_t;
+
+struct chip_history {
+    chip_sample_t* samples;                        // Ring, cache-line aligned
+    size_t capacity;                               // Power of two
+    size_t mask;
+    uint64_t total;                                // Samples ever recorded
+    chip_range_node_t* trees[CHIP_METRIC_COUNT];   // Implicit tree: leaves at capacity + slot
+    double* sum_before[CHIP_METRIC_COUNT];         // Running sum before each slot's sample
+    double sum[CHIP_METRIC_COUNT];                 // Running sum of every sample
+    uint64_t* errors_before;                       // Same for samples with errors
+    uint64_t errors;
+    float* scratch;                                // Selection buffer for percentiles
+};
+
+/**
+ * Read one metric from a sample
+ * @param sample Sample
+ * @param metric Metric
+ * @return Value
+ */
+static inline float chip_sample_metric(const chip_sample_t* sample, chip_metric_t metric) {
+    return metric == CHIP_METRIC_VOLTAGE ? sample->voltage : sample->temperature;
+}
+
+/**
+ * Create a history ring for one chip
+ * @param capacity Samples to keep (0 = default), rounded up to a power of two
+ * @return History or NULL if failed
+ */
+chip_history_t* create_chip_history(size_t capacity) {
+    if (capacity == 0) capacity = CHIP_HISTORY_DEFAULT_CAPACITY;
+    if (capacity > CHIP_HISTORY_MAX_CAPACITY) {
+        printf("Error: History capacity %zu too large\n", capacity);
+        return NULL;
+    }
+    size_t rounded = 2;
+    while (rounded < capacity) rounded *= 2;
+
+    chip_history_t* history = calloc(1, sizeof(chip_history_t));
+    if (history == NULL) {
+        printf("Error: Failed to allocate chip history\n");
+        return NULL;
+    }
+    history->capacity = rounded;
+    history->mask = rounded - 1;
+
+    bool ok = posix_memalign((void**)&history->samples, CHIP_HISTORY_ALIGNMENT,
+                             rounded * sizeof(chip_sample_t)) == 0;
+    for (int m = 0; ok && m < CHIP_METRIC_COUNT; m++) {
+        ok = posix_memalign((void**)&history->trees[m], CHIP_HISTORY_ALIGNMENT,
+                            2 * rounded * sizeof(chip_range_node_t)) == 0;
+        if (ok) {
+            history->sum_before[m] = malloc(rounded * sizeof(double));
+            ok = history->sum_before[m] != NULL;
+        }
+    }
+    if (ok) {
+        history->errors_before = malloc(rounded * sizeof(uint64_t));
+        history->scratch = malloc(rounded * sizeof(float));
+        ok = history->errors_before != NULL && history->scratch != NULL;
+    }
+    if (!ok) {
+        printf("Error: Failed to allocate chip history storage\n");
+        destroy_chip_history(history);
+        return NULL;
+    }
+
+    chip_history_reset(history);
+    return history;
+}
+
+/**
+ * Destroy a history ring
+ * @param history History to destroy
+ */
+void destroy_chip_history(chip_history_t* history) {
+    if (history == NULL) return;
+
+    free(history->samples);
+    for (int m = 0; m < CHIP_METRIC_COUNT; m++) {
+        free(history->trees[m]);
+        free(history->sum_before[m]);
+    }
+    free(history->errors_before);
+    free(history->scratch);
+    free(history);
+}
+
+/**
+ * Drop every sample (e.g. when the monitor slot is reused for another chip)
+ * @param history History to clear
+ */
+void chip_history_reset(chip_history_t* history) {
+    if (history == NULL) return;
+
+    history->total = 0;
+    history->errors = 0;
+    for (int m = 0; m < CHIP_METRIC_COUNT; m++) {
+        history->sum[m] = 0.0;
+        // Empty slots never win a min or max
+        for (size_t i = 0; i < 2 * history->capacity; i++) {
+            history->trees[m][i].min = FLT_MAX;
+            history->trees[m][i].max = -FLT_MAX;
+        }
+    }
+}
+
+/**
+ * Append a sample of a chip's current state, overwriting the oldest when full
+ * Keeps the aggregates current: O(log capacity) per sample.
+ * @param history History to append to
+ * @param timestamp_ns Sample time (must not go backwards)
+ * @param chip Chip to sample
+ * @return 1 if successful, 0 if failed
+ */
+int chip_history_record(chip_history_t* history, uint64_t timestamp_ns, const chip_state_t* chip) {
+    if (history == NULL || chip == NULL) {
+        printf("Error: Invalid parameters for history record\n");
+        return 0;
+    }
+    if (history->total != 0 &&
+        timestamp_ns < history->samples[(history->total - 1) & history->mask].timestamp_ns) {
+        printf("Error: History sample older than the newest one\n");
+        return 0;
+    }
+
+    size_t slot = (size_t)(history->total & history->mask);
+    chip_sample_t* sample = &history->samples[slot];
+    sample->timestamp_ns = timestamp_ns;
+    sample->temperature = chip->temperature;
+    sample->voltage = chip->voltage;
+    sample->registers = chip->registers;
+
+    history->errors_before[slot] = history->errors;
+    if (chip->registers.error_register != 0) history->errors++;
+
+    for (int m = 0; m < CHIP_METRIC_COUNT; m++) {
+        float value = chip_sample_metric(sample, (chip_metric_t)m);
+        history->sum_before[m][slot] = history->sum[m];
+        history->sum[m] += value;
+
+        chip_range_node_t* tree = history->trees[m];
+        size_t node = history->capacity + slot;
+        tree[node].min = value;
+        tree[node].max = value;
+        for (node >>= 1; node >= 1; node >>= 1) {
+            const chip_range_node_t* left = &tree[2 * node];
+            const chip_range_node_t* right = &tree[2 * node + 1];
+            tree[node].min = left->min < right->min ? left->min : right->min;
+            tree[node].max = left->max > right->max ? left->max : right->max;
+        }
+    }
+
+    history->total++;
+    return 1;
+}
+
+/**
+ * Get the number of samples held
+ * @param history History to read
+ * @return Samples held (at most the capacity)
+ */
+size_t chip_history_count(const chip_history_t* history) {
+    if (history == NULL) return 0;
+    return history->total < history->capacity ? (size_t)history->total : history->capacity;
+}
+
+/**
+ * Get the number of samples the ring can hold
+ * @param history History to read
+ * @return Capacity (a power of two)
+ */
+size_t chip_history_capacity(const chip_history_t* history) {
+    return history != NULL ? history->capacity : 0;
+}
+
+/**
+ * Get a sample by age
+ * @param history History to read
+ * @param age 0 for the newest sample, 1 for the one before, ...
+ * @return Sample, or NULL if not held
+ */
+const chip_sample_t* chip_history_sample(const chip_history_t* history, size_t age) {
+    if (age >= chip_history_count(history)) return NULL;
+    return &history->samples[(history->total - 1 - age) & history->mask];
+}
+
+/**
+ * Count the samples taken at or after a time, for "last T seconds" windows
+ * Binary search over the ring: O(log capacity).
+ * @param history History to read
+ * @param since_ns Start of the window
+ * @return Number of newest samples inside the window
+ */
+size_t chip_history_samples_since(const chip_history_t* history, uint64_t since_ns) {
+    size_t low = 0;
+    size_t high = chip_history_count(history);
+
+    // Timestamps fall with age: find the first age whose sample is too old
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (chip_history_sample(history, mid)->timestamp_ns >= since_ns) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+/**
+ * Fold the tree nodes covering ring slots [begin, end) into a min/max
+ * @param tree Range tree of one metric
+ * @param capacity Ring capacity
+ * @param begin First slot
+ * @param end One past the last slot
+ * @param range Running min/max to update
+ */
+static void chip_range_query(const chip_range_node_t* tree, size_t capacity, size_t begin, size_t end,
+                             chip_range_node_t* range) {
+    for (begin += capacity, end += capacity; begin < end; begin >>= 1, end >>= 1) {
+        if (begin & 1) {
+            if (tree[begin].min < range->min) range->min = tree[begin].min;
+            if (tree[begin].max > range->max) range->max = tree[begin].max;
+            begin++;
+        }
+        if (end & 1) {
+            end--;
+            if (tree[end].min < range->min) range->min = tree[end].min;
+            if (tree[end].max > range->max) range->max = tree[end].max;
+        }
+    }
+}
+
+/**
+ * Min, max and mean of the newest samples
+ * Mean and error count come from running sums in O(1); min and max from the
+ * range tree in O(log capacity). Nothing is rescanned.
+ * @param history History to read
+ * @param metric Metric to aggregate
+ * @param last_n Window length in samples (0 or more than held = all held)
+ * @param stats Receives the aggregates
+ * @return 1 if successful, 0 if the history is empty or parameters invalid
+ */
+int chip_history_window(const chip_history_t* history, chip_metric_t metric, size_t last_n,
+                        chip_window_stats_t* stats) {
+    if (history == NULL || stats == NULL || (int)metric < 0 || metric >= CHIP_METRIC_COUNT) {
+        printf("Error: Invalid parameters for history window\n");
+        return 0;
+    }
+    size_t held = chip_history_count(history);
+    if (held == 0) return 0;
+    if (last_n == 0 || last_n > held) last_n = held;
+
+    uint64_t oldest = history->total - last_n;
+    size_t first = (size_t)(oldest & history->mask);
+    size_t last = (size_t)((history->total - 1) & history->mask);
+
+    chip_range_node_t range = { FLT_MAX, -FLT_MAX };
+    if (first <= last) {
+        chip_range_query(history->trees[metric], history->capacity, first, last + 1, &range);
+    } else {
+        // Window wraps around the end of the ring
+        chip_range_query(history->trees[metric], history->capacity, first, history->capacity, &range);
+        chip_range_query(history->trees[metric], history->capacity, 0, last + 1, &range);
+    }
+
+    stats->samples = last_n;
+    stats->min = range.min;
+    stats->max = range.max;
+    stats->mean = (float)((history->sum[metric] - history->sum_before[metric][first]) / (double)last_n);
+    stats->error_samples = history->errors - history->errors_before[first];
+    stats->first_ns = history->samples[first].timestamp_ns;
+    stats->last_ns = history->samples[last].timestamp_ns;
+    return 1;
+}
+
+/**
+ * Percentile of the newest samples (nearest rank)
+ * Order statistics cannot be kept incrementally for every window length, so
+ * this copies the window and runs quickselect: O(last_n) expected.
+ * @param history History to read (its scratch buffer is used)
+ * @param metric Metric to rank
+ * @param last_n Window length in samples (0 or more than held = all held)
+ * @param percentile Percentile in [0, 100]
+ * @param value Receives the sample value at that rank
+ * @return 1 if successful, 0 if the history is empty or parameters invalid
+ */
+int chip_history_percentile(chip_history_t* history, chip_metric_t metric, size_t last_n,
+                            double percentile, float* value) {
+    if (history == NULL || value == NULL || (int)metric < 0 || metric >= CHIP_METRIC_COUNT ||
+        !(percentile >= 0.0 && percentile <= 100.0)) {
+        printf("Error: Invalid parameters for history percentile\n");
+        return 0;
+    }
+    size_t held = chip_history_count(history);
+    if (held == 0) return 0;
+    if (last_n == 0 || last_n > held) last_n = held;
+
+    float* values = history->scratch;
+    for (size_t age = 0; age < last_n; age++) {
+        values[age] = chip_sample_metric(&history->samples[(history->total - 1 - age) & history->mask], metric);
+    }
+
+    double exact_rank = percentile / 100.0 * (double)last_n;
+    size_t rank = (size_t)exact_rank;
+    if ((double)rank < exact_rank) rank++;
+    size_t k = rank > 0 ? rank - 1 : 0;
+    if (k >= last_n) k = last_n - 1;
+
+    // Quickselect (Hoare partition around the middle element)
+    size_t low = 0;
+    size_t high = last_n - 1;
+    while (low < high) {
+        float pivot = values[low + (high - low) / 2];
+        size_t i = low;
+        size_t j = high;
+        while (i <= j) {
+            while (values[i] < pivot) i++;
+            while (values[j] > pivot) j--;
+            if (i <= j) {
+                float tmp = values[i];
+                values[i] = values[j];
+                values[j] = tmp;
+                i++;
+                if (j == 0) break;
+                j--;
+            }
+        }
+        if (k <= j) {
+            high = j;
+        } else if (k >= i) {
+            low = i;
+        } else {
+            break;
+        }
+    }
+
+    *value = values[k];
+    return 1;
+}
+
+/**
+ * Rescan the newest samples for min, max and mean (the baseline)
+ * @param history History to read
+ * @param last_n Window length (at most the samples held)
+ * @param stats Receives min, max and mean of temperature
+ */
+static void chip_history_window_scan(const chip_history_t* history, size_t last_n, chip_window_stats_t* stats) {
+    float min = FLT_MAX;
+    float max = -FLT_MAX;
+    double sum = 0.0;
+    for (size_t age = 0; age < last_n; age++) {
+        float value = chip_history_sample(history, age)->temperature;
+        if (value < min) min = value;
+        if (value > max) max = value;
+        sum += value;
+    }
+    stats->samples = last_n;
+    stats->min = min;
+    stats->max = max;
+    stats->mean = (float)(sum / (double)last_n);
+}
+
+/**
+ * Record samples and query a sliding window after each one: full rescan
+ * versus the incremental aggregates
+ * @param samples Number of samples to record
+ */
+void benchmark_chip_history(int samples) {
+    const size_t capacity = 4096;
+    const size_t window = 1024;
+    printf("\n--- Chip History Windows (%d samples, window %zu of %zu) ---\n", samples, window, capacity);
+
+    if (samples <= 0) return;
+
+    chip_history_t* history = create_chip_history(capacity);
+    if (history == NULL) return;
+
+    chip_state_t chip;
+    memset(&chip, 0, sizeof(chip));
+    chip.voltage = 3.3f;
+    unsigned int seed = 12345;
+    struct timespec start, end;
+    chip_window_stats_t stats;
+    float checksum[2] = { 0.0f, 0.0f };
+    double elapsed_ms[2];
+
+    for (int variant = 0; variant < 2; variant++) {
+        chip_history_reset(history);
+        seed = 12345;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (int i = 0; i < samples; i++) {
+            chip.temperature = 45.0f + (float)(rand_r(&seed) % 400) / 10.0f;
+            chip_history_record(history, (uint64_t)i * 1000000000ull, &chip);
+            size_t held = chip_history_count(history);
+            size_t last_n = held < window ? held : window;
+            if (variant == 0) {
+                chip_history_window_scan(history, last_n, &stats);
+            } else {
+                chip_history_window(history, CHIP_METRIC_TEMPERATURE, last_n, &stats);
+            }
+            checksum[variant] += stats.max - stats.min + stats.mean;
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        elapsed_ms[variant] = (end.tv_sec - start.tv_sec) * 1e3 + (end.tv_nsec - start.tv_nsec) / 1e6;
+    }
+    __asm__ __volatile__("" : : "r"(checksum) : "memory");
+
+    float p99 = 0.0f;
+    chip_history_percentile(history, CHIP_METRIC_TEMPERATURE, window, 99.0, &p99);
+
+    printf("Rescan window:      %8.3f ms (%.1f ns per record + query)\n",
+           elapsed_ms[0], elapsed_ms[0] * 1e6 / samples);
+    printf("Incremental:        %8.3f ms (%.1f ns per record + query)\n",
+           elapsed_ms[1], elapsed_ms[1] * 1e6 / samples);
+    if (elapsed_ms[1] > 0.0) printf("Window query speedup: %.1fx\n", elapsed_ms[0] / elapsed_ms[1]);
+    printf("Last window: min %.1f, max %.1f, mean %.2f, p99 %.1f°C\n", stats.min, stats.max, stats.mean, p99);
+
+    destroy_chip_history(history);
+}
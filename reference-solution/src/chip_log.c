@@ -0,0 +1,635 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "chip_state.h"
+
+#define CHIP_LOG_DEFAULT_ENTRIES 16384
+#define CHIP_LOG_MAX_ARGS 8
+#define CHIP_LOG_STRING_BYTES 64       // %s arguments, copied into the record
+#define CHIP_LOG_FORMAT_SLOTS 512      // Distinct format strings (power of two)
+#define CHIP_LOG_INLINE_FORMAT 0xFFFF  // Record holds preformatted text
+#define CHIP_LOG_HEAP_FORMAT 0xFFFE    // Record points to preformatted text too long for it
+#define CHIP_LOG_LINE_BYTES 1024
+#define CHIP_LOG_SPEC_BYTES 32
+
+// Raw argument kinds, decided once per format string
+enum {
+    LOG_ARG_INT,
+    LOG_ARG_LONG,
+    LOG_ARG_LLONG,
+    LOG_ARG_SIZE,
+    LOG_ARG_INTMAX,
+    LOG_ARG_PTRDIFF,
+    LOG_ARG_DOUBLE,
+    LOG_ARG_STRING,
+    LOG_ARG_POINTER
+};
+
+// Compiled format: the table index is the format id stored in records
+typedef struct {
+    const char* format;        // Published last; NULL while the slot is free
+    uint8_t deferrable;        // 0 if the format needs inline formatting
+    uint8_t arg_count;
+    uint8_t arg_types[CHIP_LOG_MAX_ARGS];
+} chip_log_format_t;
+
+// One ring slot; sequence implements the bounded MPMC queue protocol
+typedef struct {
+    uint64_t sequence;
+    uint16_t format_id;
+    uint8_t level;
+    uint8_t arg_count;
+    uint64_t args[CHIP_LOG_MAX_ARGS];     // Raw values; %s holds an offset into strings
+    char strings[CHIP_LOG_STRING_BYTES];
+} chip_log_slot_t;
+
+typedef struct {
+    chip_log_slot_t* ring;
+    uint64_t mask;
+    uint64_t enqueue_pos __attribute__((aligned(64)));
+    uint64_t dequeue_pos __attribute__((aligned(64)));
+    uint64_t dropped __attribute__((aligned(64)));
+    uint64_t inline_formatted;
+    uint64_t truncated;
+    uint64_t logged;
+    FILE* sink;
+    pthread_t drain_thread;
+    int running;
+} chip_log_t;
+
+// Runtime level checked by CHIP_LOG() before any argument is touched
+int g_chip_log_level = CHIP_LOG_DEBUG;
+
+static chip_log_t* g_log = NULL;
+// Producers between loading g_log and publishing their slot; stop waits for zero
+static int g_log_inflight = 0;
+
+static chip_log_format_t g_formats[CHIP_LOG_FORMAT_SLOTS];
+static pthread_mutex_t g_format_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * Set the runtime log level; messages above it cost one load
+ * @param level CHIP_LOG_ERROR .. CHIP_LOG_DEBUG
+ */
+void chip_log_set_level(int level) {
+    if (level < CHIP_LOG_ERROR) level = CHIP_LOG_ERROR;
+    if (level > CHIP_LOG_DEBUG) level = CHIP_LOG_DEBUG;
+    __atomic_store_n(&g_chip_log_level, level, __ATOMIC_RELAXED);
+}
+
+/**
+ * Get the runtime log level
+ * @return Current level
+ */
+int chip_log_get_level(void) {
+    return __atomic_load_n(&g_chip_log_level, __ATOMIC_RELAXED);
+}
+
+/**
+ * Parse one conversion specification
+ * @param p Points just past the '%'
+ * @param type Receives the argument kind
+ * @return Pointer past the conversion character, or NULL if it cannot be deferred
+ */
+static const char* parse_log_conversion(const char* p, uint8_t* type) {
+    while (*p != '\0' && strchr("-+ #0", *p) != NULL) p++;
+    while (*p >= '0' && *p <= '9') p++;
+    if (*p == '.') {
+        p++;
+        while (*p >= '0' && *p <= '9') p++;
+    }
+    if (*p == '*') return NULL;
+
+    uint8_t integer = LOG_ARG_INT;
+    if (p[0] == 'h') {
+        p += (p[1] == 'h') ? 2 : 1;
+    } else if (p[0] == 'l' && p[1] == 'l') {
+        integer = LOG_ARG_LLONG;
+        p += 2;
+    } else if (p[0] == 'l') {
+        integer = LOG_ARG_LONG;
+        p++;
+    } else if (p[0] == 'z') {
+        integer = LOG_ARG_SIZE;
+        p++;
+    } else if (p[0] == 'j') {
+        integer = LOG_ARG_INTMAX;
+        p++;
+    } else if (p[0] == 't') {
+        integer = LOG_ARG_PTRDIFF;
+        p++;
+    } else if (p[0] == 'L') {
+        return NULL;
+    }
+
+    switch (*p) {
+        case 'd': case 'i': case 'u': case 'o': case 'x': case 'X':
+            *type = integer;
+            break;
+        case 'c':
+            if (integer != LOG_ARG_INT) return NULL;
+            *type = LOG_ARG_INT;
+            break;
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+            *type = LOG_ARG_DOUBLE;
+            break;
+        case 's':
+            if (integer != LOG_ARG_INT) return NULL;
+            *type = LOG_ARG_STRING;
+            break;
+        case 'p':
+            *type = LOG_ARG_POINTER;
+            break;
+        default:
+            return NULL;
+    }
+    return p + 1;
+}
+
+/**
+ * Compile a format string into its argument kinds
+ * @param format printf format
+ * @param entry Receives argument count and kinds; deferrable is 0 if unsupported
+ */
+static void compile_log_format(const char* format, chip_log_format_t* entry) {
+    entry->deferrable = 1;
+    entry->arg_count = 0;
+
+    for (const char* p = format; *p != '\0'; ) {
+        if (*p++ != '%') continue;
+        if (*p == '%') {
+            p++;
+            continue;
+        }
+
+        uint8_t type;
+        p = parse_log_conversion(p, &type);
+        if (p == NULL || entry->arg_count == CHIP_LOG_MAX_ARGS) {
+            entry->deferrable = 0;
+            return;
+        }
+        entry->arg_types[entry->arg_count++] = type;
+    }
+}
+
+/**
+ * Find or compile the table entry for a format string
+ * Lookups are lock-free; the first use of a format takes a lock to compile it.
+ * @param format printf format (a string literal; the pointer is the key)
+ * @return Format id, or CHIP_LOG_INLINE_FORMAT if it cannot be deferred
+ */
+static uint16_t chip_log_format_id(const char* format) {
+    size_t start = (size_t)(((uintptr_t)format * 0x9E3779B97F4A7C15ull) >> 40) & (CHIP_LOG_FORMAT_SLOTS - 1);
+
+    for (size_t n = 0; n < CHIP_LOG_FORMAT_SLOTS; n++) {
+        size_t slot = (start + n) & (CHIP_LOG_FORMAT_SLOTS - 1);
+        const char* known = __atomic_load_n(&g_formats[slot].format, __ATOMIC_ACQUIRE);
+        if (known == format) {
+            return g_formats[slot].deferrable ? (uint16_t)slot : CHIP_LOG_INLINE_FORMAT;
+        }
+        if (known != NULL) continue;
+
+        pthread_mutex_lock(&g_format_lock);
+        known = g_formats[slot].format;
+        if (known == NULL) {
+            compile_log_format(format, &g_formats[slot]);
+            __atomic_store_n(&g_formats[slot].format, format, __ATOMIC_RELEASE);
+            known = format;
+        }
+        pthread_mutex_unlock(&g_format_lock);
+        if (known == format) {
+            return g_formats[slot].deferrable ? (uint16_t)slot : CHIP_LOG_INLINE_FORMAT;
+        }
+    }
+    return CHIP_LOG_INLINE_FORMAT;
+}
+
+/**
+ * Capture raw arguments into a ring slot according to the compiled format
+ * @param slot Claimed slot
+ * @param entry Compiled format
+ * @param args Arguments
+ * @return true if captured, false if the %s arguments do not fit the string area
+ */
+static bool capture_log_args(chip_log_slot_t* slot, const chip_log_format_t* entry, va_list args) {
+    size_t used = 0;
+
+    for (int i = 0; i < entry->arg_count; i++) {
+        switch (entry->arg_types[i]) {
+            case LOG_ARG_INT:     slot->args[i] = (uint64_t)va_arg(args, int); break;
+            case LOG_ARG_LONG:    slot->args[i] = (uint64_t)va_arg(args, long); break;
+            case LOG_ARG_LLONG:   slot->args[i] = (uint64_t)va_arg(args, long long); break;
+            case LOG_ARG_SIZE:    slot->args[i] = (uint64_t)va_arg(args, size_t); break;
+            case LOG_ARG_INTMAX:  slot->args[i] = (uint64_t)va_arg(args, intmax_t); break;
+            case LOG_ARG_PTRDIFF: slot->args[i] = (uint64_t)va_arg(args, ptrdiff_t); break;
+            case LOG_ARG_POINTER: slot->args[i] = (uint64_t)(uintptr_t)va_arg(args, void*); break;
+            case LOG_ARG_DOUBLE: {
+                double value = va_arg(args, double);
+                memcpy(&slot->args[i], &value, sizeof(value));
+                break;
+            }
+            case LOG_ARG_STRING: {
+                // Strings are copied now: the caller's buffer may change before formatting
+                const char* text = va_arg(args, const char*);
+                if (text == NULL) text = "(null)";
+                size_t room = CHIP_LOG_STRING_BYTES - used;
+                size_t length = strnlen(text, room);
+                if (length == room) return false;
+                memcpy(slot->strings + used, text, length);
+                slot->strings[used + length] = '\0';
+                slot->args[i] = used;
+                used += length + 1;
+                break;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * Format a message on the producer side into a ring slot
+ * Short text lives in the slot; longer text is copied to the heap and freed
+ * by the consumer, so nothing is cut short unless that allocation fails.
+ * @param log Active logger
+ * @param slot Claimed slot
+ * @param format printf format string
+ * @param args Arguments
+ */
+static void capture_log_text(chip_log_t* log, chip_log_slot_t* slot, const char* format, va_list args) {
+    va_list retry;
+    va_copy(retry, args);
+
+    slot->format_id = CHIP_LOG_INLINE_FORMAT;
+    slot->arg_count = 0;
+    int length = vsnprintf(slot->strings, CHIP_LOG_STRING_BYTES, format, args);
+    if (length >= CHIP_LOG_STRING_BYTES) {
+        char* text = malloc((size_t)length + 1);
+        if (text != NULL) {
+            vsnprintf(text, (size_t)length + 1, format, retry);
+            slot->format_id = CHIP_LOG_HEAP_FORMAT;
+            slot->args[0] = (uint64_t)(uintptr_t)text;
+        } else {
+            __atomic_add_fetch(&log->truncated, 1, __ATOMIC_RELAXED);
+        }
+    }
+    va_end(retry);
+    __atomic_add_fetch(&log->inline_formatted, 1, __ATOMIC_RELAXED);
+}
+
+/**
+ * Log a message (use the CHIP_LOG() macro, which filters by level first)
+ * While the logger is stopped the message is printed immediately, exactly as
+ * printf would. While started, the format id and raw arguments go into a
+ * lock-free ring and the background thread does the formatting; when the
+ * ring is full the message is dropped and counted.
+ * @param level Message level
+ * @param format printf format string literal
+ */
+void chip_log_write(int level, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+
+    __atomic_add_fetch(&g_log_inflight, 1, __ATOMIC_SEQ_CST);
+    chip_log_t* log = __atomic_load_n(&g_log, __ATOMIC_SEQ_CST);
+    if (log == NULL) {
+        __atomic_sub_fetch(&g_log_inflight, 1, __ATOMIC_RELEASE);
+        vprintf(format, args);
+        va_end(args);
+        return;
+    }
+
+    uint16_t id = chip_log_format_id(format);
+    uint64_t pos = __atomic_load_n(&log->enqueue_pos, __ATOMIC_RELAXED);
+    chip_log_slot_t* slot;
+    for (;;) {
+        slot = &log->ring[pos & log->mask];
+        uint64_t seq = __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE);
+        int64_t diff = (int64_t)(seq - pos);
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&log->enqueue_pos, &pos, pos + 1, true,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if (diff < 0) {
+            __atomic_add_fetch(&log->dropped, 1, __ATOMIC_RELAXED);
+            __atomic_sub_fetch(&g_log_inflight, 1, __ATOMIC_RELEASE);
+            va_end(args);
+            return;
+        } else {
+            pos = __atomic_load_n(&log->enqueue_pos, __ATOMIC_RELAXED);
+        }
+    }
+
+    slot->level = (uint8_t)level;
+    if (id != CHIP_LOG_INLINE_FORMAT) {
+        // Keep a copy of the arguments in case the strings overflow the record
+        va_list retry;
+        va_copy(retry, args);
+        slot->format_id = id;
+        slot->arg_count = g_formats[id].arg_count;
+        if (!capture_log_args(slot, &g_formats[id], args)) {
+            capture_log_text(log, slot, format, retry);
+        }
+        va_end(retry);
+    } else {
+        // Unsupported conversions: format here
+        capture_log_text(log, slot, format, args);
+    }
+    __atomic_store_n(&slot->sequence, pos + 1, __ATOMIC_RELEASE);
+    __atomic_sub_fetch(&g_log_inflight, 1, __ATOMIC_RELEASE);
+    va_end(args);
+}
+
+/**
+ * Format one argument with its own conversion specification
+ * @param out Output buffer
+ * @param room Bytes available
+ * @param spec Single conversion specification, e.g. "%08X"
+ * @param type Argument kind
+ * @param slot Record holding the raw value
+ * @param value Raw value
+ * @return Characters that would have been written
+ */
+static int format_log_arg(char* out, size_t room, const char* spec, uint8_t type,
+                          const chip_log_slot_t* slot, uint64_t value) {
+    switch (type) {
+        case LOG_ARG_INT:     return snprintf(out, room, spec, (int)value);
+        case LOG_ARG_LONG:    return snprintf(out, room, spec, (long)value);
+        case LOG_ARG_LLONG:   return snprintf(out, room, spec, (long long)value);
+        case LOG_ARG_SIZE:    return snprintf(out, room, spec, (size_t)value);
+        case LOG_ARG_INTMAX:  return snprintf(out, room, spec, (intmax_t)value);
+        case LOG_ARG_PTRDIFF: return snprintf(out, room, spec, (ptrdiff_t)value);
+        case LOG_ARG_POINTER: return snprintf(out, room, spec, (void*)(uintptr_t)value);
+        case LOG_ARG_STRING:  return snprintf(out, room, spec, slot->strings + value);
+        case LOG_ARG_DOUBLE: {
+            double number;
+            memcpy(&number, &value, sizeof(number));
+            return snprintf(out, room, spec, number);
+        }
+    }
+    return 0;
+}
+
+/**
+ * Format a deferred record into text (consumer side)
+ * @param slot Record
+ * @param line Output buffer of CHIP_LOG_LINE_BYTES
+ * @return Length of the text
+ */
+static size_t render_log_record(const chip_log_slot_t* slot, char* line) {
+    if (slot->format_id == CHIP_LOG_INLINE_FORMAT) {
+        return strnlen(slot->strings, CHIP_LOG_STRING_BYTES);
+    }
+    if (slot->format_id == CHIP_LOG_HEAP_FORMAT) {
+        return strlen((const char*)(uintptr_t)slot->args[0]);
+    }
+
+    const chip_log_format_t* entry = &g_formats[slot->format_id];
+    size_t length = 0;
+    int arg = 0;
+
+    // Argument kinds come from the same parser, so each spec here lines up with one
+    for (const char* p = entry->format; *p != '\0' && length < CHIP_LOG_LINE_BYTES - 1; ) {
+        if (*p != '%') {
+            line[length++] = *p++;
+            continue;
+        }
+        if (p[1] == '%') {
+            line[length++] = '%';
+            p += 2;
+            continue;
+        }
+
+        uint8_t type;
+        const char* end = parse_log_conversion(p + 1, &type);
+        char spec[CHIP_LOG_SPEC_BYTES];
+        size_t spec_length = (size_t)(end - p);
+        if (spec_length >= sizeof(spec) || arg >= slot->arg_count) break;
+        memcpy(spec, p, spec_length);
+        spec[spec_length] = '\0';
+
+        int written = format_log_arg(line + length, CHIP_LOG_LINE_BYTES - length, spec, type,
+                                     slot, slot->args[arg++]);
+        if (written > 0) length += (size_t)written;
+        if (length >= CHIP_LOG_LINE_BYTES) length = CHIP_LOG_LINE_BYTES - 1;
+        p = end;
+    }
+    return length;
+}
+
+/**
+ * Format every published record to the sink (single consumer)
+ * @param log Active logger
+ * @return Records drained
+ */
+static size_t chip_log_drain(chip_log_t* log) {
+    size_t drained = 0;
+    uint64_t pos = log->dequeue_pos;
+    char line[CHIP_LOG_LINE_BYTES];
+
+    for (;;) {
+        chip_log_slot_t* slot = &log->ring[pos & log->mask];
+        if (__atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE) != pos + 1) break;
+
+        const char* text = line;
+        if (slot->format_id == CHIP_LOG_INLINE_FORMAT) {
+            text = slot->strings;
+        } else if (slot->format_id == CHIP_LOG_HEAP_FORMAT) {
+            text = (const char*)(uintptr_t)slot->args[0];
+        }
+        fwrite(text, 1, render_log_record(slot, line), log->sink);
+        if (slot->format_id == CHIP_LOG_HEAP_FORMAT) {
+            free((void*)(uintptr_t)slot->args[0]);
+        }
+        __atomic_store_n(&slot->sequence, pos + log->mask + 1, __ATOMIC_RELEASE);
+        pos++;
+        drained++;
+    }
+
+    __atomic_store_n(&log->dequeue_pos, pos, __ATOMIC_RELEASE);
+    log->logged += drained;
+    if (drained > 0) fflush(log->sink);
+    return drained;
+}
+
+/**
+ * Background drain loop: format queued records, sleep briefly when idle
+ * @param arg Active logger
+ * @return NULL
+ */
+static void* chip_log_drain_worker(void* arg) {
+    chip_log_t* log = (chip_log_t*)arg;
+    struct timespec idle = { 0, 200000 };
+
+    while (__atomic_load_n(&log->running, __ATOMIC_ACQUIRE)) {
+        if (chip_log_drain(log) == 0) nanosleep(&idle, NULL);
+    }
+    return NULL;
+}
+
+/**
+ * Switch to deferred logging: records are formatted by a background thread
+ * @param sink Output stream (NULL = stdout); stays owned by the caller
+ * @param ring_entries Ring capacity, rounded up to a power of two (0 = 16384)
+ * @return 1 if started, 0 otherwise
+ */
+int chip_log_start(FILE* sink, size_t ring_entries) {
+    if (g_log != NULL) {
+        printf("Error: Deferred logging already running\n");
+        return 0;
+    }
+
+    size_t capacity = 1;
+    size_t wanted = ring_entries != 0 ? ring_entries : CHIP_LOG_DEFAULT_ENTRIES;
+    while (capacity < wanted) capacity <<= 1;
+
+    chip_log_t* log = calloc(1, sizeof(chip_log_t));
+    chip_log_slot_t* ring = calloc(capacity, sizeof(chip_log_slot_t));
+    if (log == NULL || ring == NULL) {
+        printf("Error: Failed to allocate log ring\n");
+        free(log);
+        free(ring);
+        return 0;
+    }
+    log->ring = ring;
+    log->mask = capacity - 1;
+    log->sink = sink != NULL ? sink : stdout;
+    for (size_t i = 0; i < capacity; i++) {
+        log->ring[i].sequence = i;
+    }
+
+    fflush(log->sink);
+    log->running = 1;
+    if (pthread_create(&log->drain_thread, NULL, chip_log_drain_worker, log) != 0) {
+        printf("Error: Failed to start log drain thread\n");
+        free(log->ring);
+        free(log);
+        return 0;
+    }
+
+    __atomic_store_n(&g_log, log, __ATOMIC_RELEASE);
+    return 1;
+}
+
+/**
+ * Wait until every message logged so far has been written to the sink
+ */
+void chip_log_flush(void) {
+    chip_log_t* log = __atomic_load_n(&g_log, __ATOMIC_ACQUIRE);
+    if (log == NULL) {
+        fflush(stdout);
+        return;
+    }
+
+    struct timespec pause = { 0, 100000 };
+    uint64_t target = __atomic_load_n(&log->enqueue_pos, __ATOMIC_ACQUIRE);
+    while (__atomic_load_n(&log->dequeue_pos, __ATOMIC_ACQUIRE) < target) {
+        nanosleep(&pause, NULL);
+    }
+}
+
+/**
+ * Stop deferred logging: drain the ring and go back to immediate printing
+ * @param stats Receives final counters (may be NULL)
+ * @return 1 if the logger was stopped, 0 if it was not running
+ */
+int chip_log_stop(chip_log_stats_t* stats) {
+    chip_log_t* log = g_log;
+    if (log == NULL) return 0;
+
+    __atomic_store_n(&g_log, NULL, __ATOMIC_SEQ_CST);
+    while (__atomic_load_n(&g_log_inflight, __ATOMIC_SEQ_CST) != 0) {
+        // Spin until in-flight producers have published or dropped their record
+    }
+    __atomic_store_n(&log->running, 0, __ATOMIC_RELEASE);
+    pthread_join(log->drain_thread, NULL);
+    chip_log_drain(log);
+
+    if (stats != NULL) {
+        stats->logged = log->logged;
+        stats->dropped = __atomic_load_n(&log->dropped, __ATOMIC_RELAXED);
+        stats->inline_formatted = __atomic_load_n(&log->inline_formatted, __ATOMIC_RELAXED);
+        stats->truncated = __atomic_load_n(&log->truncated, __ATOMIC_RELAXED);
+    }
+    free(log->ring);
+    free(log);
+    return 1;
+}
+
+/**
+ * Compare printf-style formatting with deferred and filtered logging of the
+ * register write diagnostic
+ * @param messages Number of messages per variant
+ */
+void benchmark_chip_log(int messages) {
+    printf("\n--- Deferred Logging (%d messages) ---\n", messages);
+
+    FILE* sink = fopen("/dev/null", "w");
+    if (messages <= 0 || sink == NULL || g_log != NULL) {
+        printf("Error: Invalid logging benchmark parameters\n");
+        if (sink != NULL) fclose(sink);
+        return;
+    }
+    int saved_level = chip_log_get_level();
+    chip_log_set_level(CHIP_LOG_DEBUG);
+    // Thread CPU time: on a single core the drain thread would otherwise be
+    // billed to whichever loop it happens to preempt
+    struct timespec start, end;
+
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &start);
+    for (int i = 0; i < messages; i++) {
+        fprintf(sink, "Register 0x%08X = 0x%08X\n", 0x40000000u + (uint32_t)(i & 0xFF) * 4, (uint32_t)i);
+    }
+    fflush(sink);
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &end);
+    double printf_ns = ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / messages;
+
+    // Ring sized so the producer never waits on the (possibly descheduled) drain thread
+    chip_log_stats_t stats = { 0, 0, 0, 0 };
+    double deferred_ns = 0.0;
+    double drain_ns = 0.0;
+    if (chip_log_start(sink, (size_t)messages)) {
+        struct timespec process_start, process_end;
+        clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &process_start);
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &start);
+        for (int i = 0; i < messages; i++) {
+            CHIP_LOG(CHIP_LOG_DEBUG, "Register 0x%08X = 0x%08X\n", 0x40000000u + (uint32_t)(i & 0xFF) * 4, (uint32_t)i);
+        }
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &end);
+        chip_log_stop(&stats);
+        clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &process_end);
+
+        double producer_ns = (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec);
+        double process_ns = (process_end.tv_sec - process_start.tv_sec) * 1e9 +
+                            (process_end.tv_nsec - process_start.tv_nsec);
+        deferred_ns = producer_ns / messages;
+        drain_ns = (process_ns - producer_ns) / messages;
+    }
+
+    chip_log_set_level(CHIP_LOG_WARN);
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &start);
+    for (int i = 0; i < messages; i++) {
+        CHIP_LOG(CHIP_LOG_DEBUG, "Register 0x%08X = 0x%08X\n", 0x40000000u + (uint32_t)(i & 0xFF) * 4, (uint32_t)i);
+        __asm__ __volatile__("" : : : "memory");
+    }
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &end);
+    double filtered_ns = ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / messages;
+    chip_log_set_level(saved_level);
+    fclose(sink);
+
+    printf("printf formatting:   %8.1f ns/message\n", printf_ns);
+    printf("Deferred record:     %8.1f ns/message (%llu written, %llu dropped)\n", deferred_ns,
+           (unsigned long long)stats.logged, (unsigned long long)stats.dropped);
+    printf("Background format:   %8.1f ns/message (off the hot path)\n", drain_ns);
+    printf("Filtered by level:   %8.1f ns/message\n", filtered_ns);
+    if (deferred_ns > 0.0) printf("Hot-path speedup: %.1fx\n", printf_ns / deferred_ns);
+}
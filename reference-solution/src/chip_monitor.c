@@ -1,9 +1,12 @@
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdio.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include <string.h>
 #include <stdlib.h>
 #include <time.h>
+#include <unistd.h>
 
 // Include external function declarations
 extern void demonstrate_pointer_operations(void);
@@ -15,6 +18,19 @@ extern void demonstrate_comprehensive_bit_ops(void);
 extern void test_bit_patterns(void);
 extern void demonstrate_advanced_bit_fields(void);
 
+// Register trace replay (must match register_replay_stats_t in chip_state.h)
+typedef struct {
+    uint64_t records;
+    uint64_t reads;
+    uint64_t writes;
+    uint64_t mismatches;
+    uint64_t out_of_range;
+    uint64_t trace_span_ns;
+    uint64_t elapsed_ns;
+} register_replay_stats_t;
+
+extern long long register_trace_replay(const char* path, bool paced, register_replay_stats_t* stats);
+
 // Chip state structure (duplicated for integration)
 typedef struct {
     uint32_t control_register;
@@ -36,13 +52,240 @@ typedef struct {
     uint64_t uptime_seconds;
 } chip_state_t;
 
-#define MAX_MONITORED_CHIPS 8
-#define MONITOR_UPDATE_INTERVAL 1000  // milliseconds
+// Monitored chips live in a slot map (chip_slot_map.c); callers hold
+// generational handles that stay valid while other chips come and go
+// (handle layout and chip_slot_map_t must match chip_state.h)
+typedef uint64_t chip_handle_t;
+#define CHIP_HANDLE_INVALID ((chip_handle_t)0)
+#define CHIP_HANDLE_SLOT(handle) ((uint32_t)(handle))
+
+typedef struct {
+    chip_state_t* chips;
+    uint32_t* dense_slot;
+    uint32_t* slot_index;
+    uint32_t* slot_generation;
+    uint32_t count;
+    uint32_t capacity;
+    uint32_t slot_count;
+    uint32_t free_head;
+} chip_slot_map_t;
+
+extern chip_slot_map_t* create_chip_slot_map(size_t initial_capacity);
+extern void destroy_chip_slot_map(chip_slot_map_t* map);
+extern chip_handle_t chip_slot_map_insert(chip_slot_map_t* map, const chip_state_t* chip);
+extern int chip_slot_map_remove(chip_slot_map_t* map, chip_handle_t handle);
+extern chip_state_t* chip_slot_map_get(const chip_slot_map_t* map, chip_handle_t handle);
+extern chip_handle_t chip_slot_map_handle_at(const chip_slot_map_t* map, size_t dense_index);
+extern void chip_slot_map_clear(chip_slot_map_t* map);
+
+// Parallel monitoring pass on a work-stealing pool (chip_worker_pool.c);
+// types and thresholds must match chip_state.h
+#define CHIP_HEALTH_CRITICAL 50
+#define CHIP_HEALTH_WARNING  80
+
+typedef struct chip_worker_pool chip_worker_pool_t;
+typedef int (*chip_health_fn_t)(chip_state_t* chip);
+
+typedef struct {
+    long total_health;
+    int chips;
+    int critical_chips;
+    int warning_chips;
+} chip_monitor_totals_t;
+
+extern chip_worker_pool_t* create_chip_worker_pool(int workers);
+extern void destroy_chip_worker_pool(chip_worker_pool_t* pool);
+extern int chip_worker_pool_size(const chip_worker_pool_t* pool);
+extern int chip_monitor_pass(chip_worker_pool_t* pool, chip_state_t* chips, size_t count,
+                             chip_health_fn_t health_fn, int* health, chip_monitor_totals_t* totals);
+
+// Periodic polling on a hierarchical timer wheel (chip_timer_wheel.c);
+// types must match chip_state.h
+typedef struct chip_timer_wheel chip_timer_wheel_t;
+typedef void (*chip_timer_fn_t)(void* context, uint64_t data);
+
+extern chip_timer_wheel_t* create_chip_timer_wheel(uint64_t tick_ns, uint64_t start_ns);
+extern void destroy_chip_timer_wheel(chip_timer_wheel_t* wheel);
+extern int chip_timer_schedule(chip_timer_wheel_t* wheel, uint64_t now_ns, uint64_t period_ns, uint64_t jitter_ns,
+                               chip_timer_fn_t fn, void* context, uint64_t data);
+extern int chip_timer_cancel(chip_timer_wheel_t* wheel, int timer_id);
+extern int chip_timer_set_period(chip_timer_wheel_t* wheel, int timer_id, uint64_t period_ns);
+extern size_t chip_timer_wheel_advance(chip_timer_wheel_t* wheel, uint64_t now_ns);
+extern uint64_t chip_timer_wheel_next_expiry(const chip_timer_wheel_t* wheel);
+extern void print_chip_timer_report(const chip_timer_wheel_t* wheel);
+
+// Per-chip sample history (chip_history.c); types must match chip_state.h
+typedef struct chip_history chip_history_t;
+typedef struct {
+    uint64_t timestamp_ns;
+    float temperature;
+    float voltage;
+    register_set_t registers;
+} chip_sample_t;
+typedef enum {
+    CHIP_METRIC_TEMPERATURE = 0,
+    CHIP_METRIC_VOLTAGE,
+    CHIP_METRIC_COUNT
+} chip_metric_t;
+typedef struct {
+    size_t samples;
+    float min;
+    float max;
+    float mean;
+    uint64_t error_samples;
+    uint64_t first_ns;
+    uint64_t last_ns;
+} chip_window_stats_t;
+
+extern chip_history_t* create_chip_history(size_t capacity);
+extern void destroy_chip_history(chip_history_t* history);
+extern void chip_history_reset(chip_history_t* history);
+extern int chip_history_record(chip_history_t* history, uint64_t timestamp_ns, const chip_state_t* chip);
+extern size_t chip_history_count(const chip_history_t* history);
+extern const chip_sample_t* chip_history_sample(const chip_history_t* history, size_t age);
+extern int chip_history_window(const chip_history_t* history, chip_metric_t metric, size_t last_n,
+                               chip_window_stats_t* stats);
+
+// Compressed long-term archive (chip_telemetry.c); types must match chip_state.h
+#define CHIP_TELEMETRY_COLUMNS 4
+typedef struct chip_telemetry chip_telemetry_t;
+typedef struct {
+    uint64_t samples;
+    uint64_t dropped_samples;
+    size_t blocks;
+    size_t open_samples;
+    size_t encoded_bytes;
+    size_t index_bytes;
+    size_t raw_bytes;
+    size_t column_bytes[CHIP_TELEMETRY_COLUMNS];
+} chip_telemetry_stats_t;
+
+extern chip_telemetry_t* create_chip_telemetry(size_t block_samples);
+extern void destroy_chip_telemetry(chip_telemetry_t* store);
+extern void chip_telemetry_reset(chip_telemetry_t* store);
+extern int chip_telemetry_set_retention(chip_telemetry_t* store, size_t max_blocks);
+extern int chip_telemetry_append(chip_telemetry_t* store, const chip_sample_t* sample);
+extern void chip_telemetry_stats(const chip_telemetry_t* store, chip_telemetry_stats_t* stats);
+
+#define MONITOR_INITIAL_CAPACITY 8    // Grows on demand
+#define MONITOR_UPDATE_INTERVAL 1000  // milliseconds, default polling period per chip
+#define MONITOR_TICK_NS 1000000ull    // Scheduler resolution (1 ms)
+#define MONITOR_HISTORY_SAMPLES 256   // Samples kept per chip
+#define MONITOR_ARCHIVE_BLOCK_SAMPLES 128  // Archive block size (the raw open block is 4 KiB)
+#define MONITOR_ARCHIVE_MAX_BLOCKS 256     // Archive retention: 32768 samples, ~9 h at 1 s polling
+#define MONITOR_TREND_RECENT 4        // Recent samples compared against...
+#define MONITOR_TREND_BASELINE 32     // ...the mean of this longer window
+#define MONITOR_TREND_RISE 5.0f       // °C above baseline that counts as a rising trend
 
 // Global monitoring state
-static chip_state_t monitored_chips[MAX_MONITORED_CHIPS];
-static int active_monitors = 0;
+static chip_slot_map_t* monitored_chips = NULL;
 static bool monitoring_active = false;
+static chip_worker_pool_t* monitor_pool = NULL;
+static int monitor_workers = 0;       // 0 = one per online CPU
+static int* monitor_health = NULL;    // Per-chip scores of the last pass
+static size_t monitor_health_capacity = 0;
+static chip_timer_wheel_t* monitor_wheel = NULL;
+static int* monitor_timer_ids = NULL;     // Polling timer per slot-map slot, -1 if none
+static chip_history_t** monitor_histories = NULL;  // Sample history per slot-map slot
+static chip_telemetry_t** monitor_archives = NULL;  // Compressed full history per slot
+static size_t monitor_slot_capacity = 0;
+static uint64_t monitor_polls = 0;
+
+static int schedule_chip_polling(chip_handle_t handle);
+
+/**
+ * Read the monotonic clock
+ * @return Nanoseconds
+ */
+static uint64_t monitor_now_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+}
+
+/**
+ * Release the polling timers, sample histories and their bookkeeping
+ */
+static void release_monitor_slots(void) {
+    destroy_chip_timer_wheel(monitor_wheel);
+    monitor_wheel = NULL;
+    for (size_t i = 0; i < monitor_slot_capacity; i++) {
+        destroy_chip_history(monitor_histories[i]);
+        destroy_chip_telemetry(monitor_archives[i]);
+    }
+    free(monitor_histories);
+    monitor_histories = NULL;
+    free(monitor_archives);
+    monitor_archives = NULL;
+    free(monitor_timer_ids);
+    monitor_timer_ids = NULL;
+    monitor_slot_capacity = 0;
+    monitor_polls = 0;
+}
+
+/**
+ * Make room for the per-slot timer and history of a slot
+ * @param slot Slot-map slot
+ * @return 1 if successful, 0 if failed
+ */
+static int reserve_monitor_slot(uint32_t slot) {
+    if (slot < monitor_slot_capacity) return 1;
+
+    size_t capacity = monitor_slot_capacity != 0 ? monitor_slot_capacity : MONITOR_INITIAL_CAPACITY;
+    while (capacity <= slot) capacity *= 2;
+
+    int* ids = realloc(monitor_timer_ids, capacity * sizeof(int));
+    if (ids == NULL) {
+        printf("Error: Failed to allocate polling timers\n");
+        return 0;
+    }
+    monitor_timer_ids = ids;
+    chip_history_t** histories = realloc(monitor_histories, capacity * sizeof(chip_history_t*));
+    if (histories == NULL) {
+        printf("Error: Failed to allocate chip histories\n");
+        return 0;
+    }
+    monitor_histories = histories;
+    chip_telemetry_t** archives = realloc(monitor_archives, capacity * sizeof(chip_telemetry_t*));
+    if (archives == NULL) {
+        printf("Error: Failed to allocate telemetry archives\n");
+        return 0;
+    }
+    monitor_archives = archives;
+
+    for (size_t i = monitor_slot_capacity; i < capacity; i++) {
+        ids[i] = -1;
+        histories[i] = NULL;
+        archives[i] = NULL;
+    }
+    monitor_slot_capacity = capacity;
+    return 1;
+}
+
+/**
+ * Find the monitor slot of a chip stored in the monitor
+ * @param chip Chip pointer, possibly into the monitor's dense storage
+ * @return Slot, or UINT32_MAX if the chip is not a monitored one
+ */
+static uint32_t find_chip_slot(const chip_state_t* chip) {
+    if (monitored_chips == NULL || chip < monitored_chips->chips ||
+        chip >= monitored_chips->chips + monitored_chips->count) {
+        return UINT32_MAX;
+    }
+
+    uint32_t slot = monitored_chips->dense_slot[chip - monitored_chips->chips];
+    return slot < monitor_slot_capacity ? slot : UINT32_MAX;
+}
+
+/**
+ * Find the sample history of a chip stored in the monitor
+ * @param chip Chip pointer, possibly into the monitor's dense storage
+ * @return History, or NULL if the chip is not a monitored one
+ */
+static chip_history_t* find_chip_history(const chip_state_t* chip) {
+    uint32_t slot = find_chip_slot(chip);
+    return slot != UINT32_MAX ? monitor_histories[slot] : NULL;
+}
 
 /**
  * Initialize the chip monitoring system
@@ -50,70 +293,169 @@ static bool monitoring_active = false;
 void init_chip_monitor(void) {
     printf("=== Initializing Chip Monitor System ===\n");
 
-    // Clear all monitored chips
-    memset(monitored_chips, 0, sizeof(monitored_chips));
-    active_monitors = 0;
+    // Clear all monitored chips; handles from before become stale
+    if (monitored_chips == NULL) {
+        monitored_chips = create_chip_slot_map(MONITOR_INITIAL_CAPACITY);
+    } else {
+        chip_slot_map_clear(monitored_chips);
+    }
     monitoring_active = false;
 
+    // Fresh scheduler and histories: both belonged to the cleared chips
+    release_monitor_slots();
+    monitor_wheel = create_chip_timer_wheel(MONITOR_TICK_NS, monitor_now_ns());
+
     printf("Chip monitor system initialized\n");
-    printf("Maximum monitored chips: %d\n", MAX_MONITORED_CHIPS);
+    printf("Monitor capacity: %u chips (grows on demand)\n",
+           monitored_chips != NULL ? monitored_chips->capacity : 0);
+    printf("Default polling interval: %d ms\n", MONITOR_UPDATE_INTERVAL);
+}
+
+/**
+ * Release the chip monitoring system
+ */
+void shutdown_chip_monitor(void) {
+    destroy_chip_slot_map(monitored_chips);
+    monitored_chips = NULL;
+    destroy_chip_worker_pool(monitor_pool);
+    monitor_pool = NULL;
+    free(monitor_health);
+    monitor_health = NULL;
+    monitor_health_capacity = 0;
+    release_monitor_slots();
+    monitoring_active = false;
 }
 
 /**
  * Add a chip to the monitoring system
- * @param chip Pointer to chip to monitor
- * @return Monitor index or -1 if failed
+ * @param chip Pointer to chip to monitor (copied in)
+ * @return Monitor handle or CHIP_HANDLE_INVALID if failed
  */
-int add_chip_to_monitor(chip_state_t* chip) {
+chip_handle_t add_chip_to_monitor(const chip_state_t* chip) {
     if (chip == NULL) {
         printf("Error: Cannot monitor NULL chip\n");
-        return -1;
+        return CHIP_HANDLE_INVALID;
     }
 
-    if (active_monitors >= MAX_MONITORED_CHIPS) {
-        printf("Error: Monitor system at capacity (%d chips)\n", MAX_MONITORED_CHIPS);
-        return -1;
+    if (monitored_chips == NULL) {
+        printf("Error: Chip monitor not initialized\n");
+        return CHIP_HANDLE_INVALID;
     }
 
     if (!chip->is_initialized) {
         printf("Error: Cannot monitor uninitialized chip\n");
-        return -1;
+        return CHIP_HANDLE_INVALID;
+    }
+
+    chip_handle_t handle = chip_slot_map_insert(monitored_chips, chip);
+    if (handle == CHIP_HANDLE_INVALID) {
+        return CHIP_HANDLE_INVALID;
     }
 
-    // Copy chip to monitoring array
-    monitored_chips[active_monitors] = *chip;
-    int monitor_index = active_monitors;
-    active_monitors++;
+    // A reused slot keeps its history and archive buffers, emptied for the new chip
+    uint32_t slot = CHIP_HANDLE_SLOT(handle);
+    if (reserve_monitor_slot(slot)) {
+        if (monitor_histories[slot] == NULL) monitor_histories[slot] = create_chip_history(MONITOR_HISTORY_SAMPLES);
+        if (monitor_archives[slot] == NULL) {
+            monitor_archives[slot] = create_chip_telemetry(MONITOR_ARCHIVE_BLOCK_SAMPLES);
+            if (monitor_archives[slot] != NULL) {
+                chip_telemetry_set_retention(monitor_archives[slot], MONITOR_ARCHIVE_MAX_BLOCKS);
+            }
+        }
+    }
+    if (slot >= monitor_slot_capacity || monitor_histories[slot] == NULL || monitor_archives[slot] == NULL ||
+        !schedule_chip_polling(handle)) {
+        chip_slot_map_remove(monitored_chips, handle);
+        return CHIP_HANDLE_INVALID;
+    }
+    chip_history_reset(monitor_histories[slot]);
+    chip_telemetry_reset(monitor_archives[slot]);
 
-    printf("Added chip '%s' to monitor (Index: %d)\n",
-           chip->chip_id, monitor_index);
+    printf("Added chip '%s' to monitor (Slot: %u)\n",
+           chip->chip_id, CHIP_HANDLE_SLOT(handle));
 
-    return monitor_index;
+    return handle;
 }
 
 /**
  * Remove a chip from monitoring
- * @param monitor_index Index of chip to remove
+ * @param handle Handle returned by add_chip_to_monitor()
  * @return 1 if successful, 0 if failed
  */
-int remove_chip_from_monitor(int monitor_index) {
-    if (monitor_index < 0 || monitor_index >= active_monitors) {
-        printf("Error: Invalid monitor index %d\n", monitor_index);
+int remove_chip_from_monitor(chip_handle_t handle) {
+    chip_state_t* chip = chip_slot_map_get(monitored_chips, handle);
+    if (chip == NULL) {
+        printf("Error: Invalid or stale monitor handle 0x%016llX\n", (unsigned long long)handle);
         return 0;
     }
 
-    printf("Removing chip '%s' from monitor\n",
-           monitored_chips[monitor_index].chip_id);
+    printf("Removing chip '%s' from monitor\n", chip->chip_id);
 
-    // Shift remaining chips down
-    for (int i = monitor_index; i < active_monitors - 1; i++) {
-        monitored_chips[i] = monitored_chips[i + 1];
+    uint32_t slot = CHIP_HANDLE_SLOT(handle);
+    if (slot < monitor_slot_capacity && monitor_timer_ids[slot] >= 0) {
+        chip_timer_cancel(monitor_wheel, monitor_timer_ids[slot]);
+        monitor_timer_ids[slot] = -1;
     }
+    chip_slot_map_remove(monitored_chips, handle);
+
+    printf("Chip removed. Active monitors: %u\n", monitored_chips->count);
+    return 1;
+}
+
+/**
+ * Look up a monitored chip
+ * The pointer is valid until the next add or remove; keep the handle.
+ * @param handle Handle returned by add_chip_to_monitor()
+ * @return Monitored copy of the chip, or NULL if the handle is stale
+ */
+chip_state_t* get_monitored_chip(chip_handle_t handle) {
+    return chip_slot_map_get(monitored_chips, handle);
+}
+
+/**
+ * Get the sample history of a monitored chip
+ * @param handle Handle returned by add_chip_to_monitor()
+ * @return History, or NULL if the handle is stale
+ */
+chip_history_t* get_monitored_chip_history(chip_handle_t handle) {
+    chip_state_t* chip = chip_slot_map_get(monitored_chips, handle);
+    return chip != NULL ? find_chip_history(chip) : NULL;
+}
 
-    active_monitors--;
-    memset(&monitored_chips[active_monitors], 0, sizeof(chip_state_t));
+/**
+ * Get the compressed sample archive of a monitored chip
+ * @param handle Handle returned by add_chip_to_monitor()
+ * @return Archive, or NULL if the handle is stale
+ */
+chip_telemetry_t* get_monitored_chip_telemetry(chip_handle_t handle) {
+    chip_state_t* chip = chip_slot_map_get(monitored_chips, handle);
+    uint32_t slot = chip != NULL ? find_chip_slot(chip) : UINT32_MAX;
+    return slot != UINT32_MAX ? monitor_archives[slot] : NULL;
+}
 
-    printf("Chip removed. Active monitors: %d\n", active_monitors);
+/**
+ * Get the number of monitored chips
+ * @return Active monitor count
+ */
+int get_monitored_chip_count(void) {
+    return monitored_chips != NULL ? (int)monitored_chips->count : 0;
+}
+
+/**
+ * Set the number of threads used by monitor_all_chips()
+ * The pool is (re)built on the next monitoring pass.
+ * @param workers Worker threads including the caller (0 = one per online CPU)
+ * @return 1 if successful, 0 if failed
+ */
+int set_monitor_worker_count(int workers) {
+    if (workers < 0) {
+        printf("Error: Invalid monitor worker count %d\n", workers);
+        return 0;
+    }
+
+    destroy_chip_worker_pool(monitor_pool);
+    monitor_pool = NULL;
+    monitor_workers = workers;
     return 1;
 }
 
@@ -148,50 +490,77 @@ void update_chip_status(chip_state_t* chip) {
 
     // Simulate uptime increment
     chip->uptime_seconds++;
+
+    // Monitored chips keep a sample history for trend checks, and recent
+    // samples in the compressed archive. Timestamps are quantized to the
+    // scheduler tick, so on-time periodic polls encode as zero delta-of-deltas.
+    uint32_t slot = find_chip_slot(chip);
+    uint64_t sampled_ns = monitor_now_ns() / MONITOR_TICK_NS * MONITOR_TICK_NS;
+    if (slot != UINT32_MAX && chip_history_record(monitor_histories[slot], sampled_ns, chip)) {
+        chip_telemetry_append(monitor_archives[slot], chip_history_sample(monitor_histories[slot], 0));
+    }
 }
 
 /**
- * Perform comprehensive chip health check
+ * Score chip health, optionally printing the breakdown
+ * Reads the chip only, so the report can be printed after a parallel pass.
  * @param chip Pointer to chip to check
+ * @param report Print each check
  * @return Health score (0-100)
  */
-int perform_health_check(chip_state_t* chip) {
+static int score_chip_health(const chip_state_t* chip, bool report) {
     if (chip == NULL || !chip->is_initialized) {
         return 0;
     }
 
     int health_score = 100;
 
-    printf("\n--- Health Check: %s ---\n", chip->chip_id);
+    if (report) printf("\n--- Health Check: %s ---\n", chip->chip_id);
 
     // Check temperature
     if (chip->temperature > 85.0f) {
-        printf("  Temperature WARNING: %.1f°C (critical)\n", chip->temperature);
+        if (report) printf("  Temperature WARNING: %.1f°C (critical)\n", chip->temperature);
         health_score -= 30;
     } else if (chip->temperature > 70.0f) {
-        printf("  Temperature CAUTION: %.1f°C (high)\n", chip->temperature);
+        if (report) printf("  Temperature CAUTION: %.1f°C (high)\n", chip->temperature);
         health_score -= 15;
     } else {
-        printf("  Temperature OK: %.1f°C\n", chip->temperature);
+        if (report) printf("  Temperature OK: %.1f°C\n", chip->temperature);
     }
 
     // Check voltage
     if (chip->voltage < 3.0f || chip->voltage > 3.6f) {
-        printf("  Voltage WARNING: %.2fV (out of range)\n", chip->voltage);
+        if (report) printf("  Voltage WARNING: %.2fV (out of range)\n", chip->voltage);
         health_score -= 25;
     } else {
-        printf("  Voltage OK: %.2fV\n", chip->voltage);
+        if (report) printf("  Voltage OK: %.2fV\n", chip->voltage);
     }
 
     // Check error count
     if (chip->error_count > 10) {
-        printf("  Error count HIGH: %u errors\n", chip->error_count);
+        if (report) printf("  Error count HIGH: %u errors\n", chip->error_count);
         health_score -= 20;
     } else if (chip->error_count > 0) {
-        printf("  Error count MODERATE: %u errors\n", chip->error_count);
+        if (report) printf("  Error count MODERATE: %u errors\n", chip->error_count);
         health_score -= 10;
     } else {
-        printf("  Error count OK: %u errors\n", chip->error_count);
+        if (report) printf("  Error count OK: %u errors\n", chip->error_count);
+    }
+
+    // Check temperature trend: recent samples against a longer baseline
+    chip_history_t* history = find_chip_history(chip);
+    chip_window_stats_t recent, baseline;
+    if (chip_history_count(history) > MONITOR_TREND_RECENT &&
+        chip_history_window(history, CHIP_METRIC_TEMPERATURE, MONITOR_TREND_RECENT, &recent) &&
+        chip_history_window(history, CHIP_METRIC_TEMPERATURE, MONITOR_TREND_BASELINE, &baseline)) {
+        float rise = recent.mean - baseline.mean;
+        if (rise > MONITOR_TREND_RISE) {
+            if (report) printf("  Temperature TREND: rising, +%.1f°C over %zu-sample mean\n", rise, baseline.samples);
+            health_score -= 10;
+        } else {
+            if (report) printf("  Temperature trend OK: %.1f-%.1f°C over last %zu samples\n",
+                               baseline.min, baseline.max, baseline.samples);
+        }
     }
 
     // Check register consistency
@@ -199,61 +568,192 @@ int perform_health_check(chip_state_t* chip) {
     bool enable_bit = (chip->registers.control_register & (1U << 0)) != 0;
 
     if (enable_bit && !ready_bit) {
-        printf("  Register INCONSISTENCY: Enabled but not ready\n");
+        if (report) printf("  Register INCONSISTENCY: Enabled but not ready\n");
         health_score -= 15;
     } else {
-        printf("  Register consistency OK\n");
+        if (report) printf("  Register consistency OK\n");
     }
 
     // Ensure health score doesn't go below 0
     if (health_score < 0) health_score = 0;
 
-    printf("  Overall Health Score: %d/100\n", health_score);
+    if (report) printf("  Overall Health Score: %d/100\n", health_score);
 
     return health_score;
 }
 
+/**
+ * Perform comprehensive chip health check
+ * @param chip Pointer to chip to check
+ * @return Health score (0-100)
+ */
+int perform_health_check(chip_state_t* chip) {
+    return score_chip_health(chip, true);
+}
+
+/**
+ * Per-chip work of a monitoring pass: update status, then score quietly
+ * @param chip Chip to monitor (only this chip is touched)
+ * @return Health score (0-100)
+ */
+static int monitor_chip_tick(chip_state_t* chip) {
+    update_chip_status(chip);
+    return score_chip_health(chip, false);
+}
+
+/**
+ * Create the worker pool and size the score buffer for a monitoring pass
+ * @param count Number of chips in the pass
+ * @return 1 if successful, 0 if failed
+ */
+static int prepare_monitor_pass(size_t count) {
+    if (monitor_pool == NULL) {
+        monitor_pool = create_chip_worker_pool(monitor_workers);
+        if (monitor_pool == NULL) return 0;
+    }
+
+    if (count > monitor_health_capacity) {
+        int* health = realloc(monitor_health, count * sizeof(int));
+        if (health == NULL) {
+            printf("Error: Failed to allocate health scores for %zu chips\n", count);
+            return 0;
+        }
+        monitor_health = health;
+        monitor_health_capacity = count;
+    }
+    return 1;
+}
+
+/**
+ * Timer callback: update and score one chip on its own polling period
+ * @param context Unused
+ * @param data Chip handle
+ */
+static void poll_monitored_chip(void* context, uint64_t data) {
+    (void)context;
+    chip_state_t* chip = chip_slot_map_get(monitored_chips, (chip_handle_t)data);
+    if (chip == NULL) return;
+
+    monitor_polls++;
+    int health = monitor_chip_tick(chip);
+    if (health < CHIP_HEALTH_CRITICAL) {
+        printf("ALERT: %s health %d/100 (temp %.1f°C, %u errors)\n",
+               chip->chip_id, health, chip->temperature, chip->error_count);
+    }
+}
+
+/**
+ * Start polling a newly monitored chip every MONITOR_UPDATE_INTERVAL
+ * The first poll lands at a random point within the first extra interval,
+ * so chips added together do not all poll on the same tick.
+ * @param handle Chip handle
+ * @return 1 if successful, 0 if failed
+ */
+static int schedule_chip_polling(chip_handle_t handle) {
+    uint32_t slot = CHIP_HANDLE_SLOT(handle);
+    if (monitor_wheel == NULL || !reserve_monitor_slot(slot)) return 0;
+
+    uint64_t period = (uint64_t)MONITOR_UPDATE_INTERVAL * 1000000ull;
+    int id = chip_timer_schedule(monitor_wheel, monitor_now_ns(), period, period,
+                                 poll_monitored_chip, NULL, handle);
+    if (id < 0) return 0;
+    monitor_timer_ids[slot] = id;
+    return 1;
+}
+
+/**
+ * Change how often a chip is polled (fast for hot chips, slow for idle ones)
+ * @param handle Chip handle
+ * @param interval_ms Polling period in milliseconds
+ * @return 1 if successful, 0 if failed
+ */
+int set_chip_monitor_interval(chip_handle_t handle, uint32_t interval_ms) {
+    uint32_t slot = CHIP_HANDLE_SLOT(handle);
+    if (chip_slot_map_get(monitored_chips, handle) == NULL || interval_ms == 0 ||
+        slot >= monitor_slot_capacity || monitor_timer_ids[slot] < 0) {
+        printf("Error: Cannot set polling interval for handle 0x%016llX\n", (unsigned long long)handle);
+        return 0;
+    }
+
+    return chip_timer_set_period(monitor_wheel, monitor_timer_ids[slot], (uint64_t)interval_ms * 1000000ull);
+}
+
+/**
+ * Poll chips on their own periods for a while, then print the drift and
+ * latency report
+ * @param duration_ms How long to run
+ * @return Number of chip polls, or -1 if the monitor is not initialized
+ */
+int run_chip_monitor_scheduler(uint32_t duration_ms) {
+    if (monitor_wheel == NULL) {
+        printf("Error: Chip monitor not initialized\n");
+        return -1;
+    }
+
+    printf("\n=== Scheduled Monitoring (%u ms) ===\n", duration_ms);
+    uint64_t polls_before = monitor_polls;
+    uint64_t end = monitor_now_ns() + (uint64_t)duration_ms * 1000000ull;
+    monitoring_active = true;
+
+    for (;;) {
+        uint64_t now = monitor_now_ns();
+        chip_timer_wheel_advance(monitor_wheel, now);
+        if (now >= end) break;
+
+        // Sleep until the next poll can be due, or the end of the run
+        uint64_t wake = chip_timer_wheel_next_expiry(monitor_wheel);
+        if (wake > end) wake = end;
+        struct timespec until = { (time_t)(wake / 1000000000ull), (long)(wake % 1000000000ull) };
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &until, NULL);
+    }
+
+    monitoring_active = false;
+    int polls = (int)(monitor_polls - polls_before);
+    print_chip_timer_report(monitor_wheel);
+    printf("Chip polls: %d across %d chips\n", polls, get_monitored_chip_count());
+    return polls;
+}
+
 /**
  * Monitor all chips and generate status report
  */
 void monitor_all_chips(void) {
+    int active_monitors = get_monitored_chip_count();
     if (active_monitors == 0) {
         printf("No chips currently being monitored\n");
         return;
     }
 
     printf("\n=== Chip Monitoring Report ===\n");
-    printf("Active Monitors: %d/%d\n", active_monitors, MAX_MONITORED_CHIPS);
+    printf("Active Monitors: %d (capacity %u)\n", active_monitors, monitored_chips->capacity);
     printf("Timestamp: %lu\n", (unsigned long)time(NULL));
 
-    int total_health = 0;
-    int critical_chips = 0;
-    int warning_chips = 0;
+    // Update and score every chip in parallel, then report in chip order
+    chip_monitor_totals_t totals;
+    if (!prepare_monitor_pass((size_t)active_monitors) ||
+        !chip_monitor_pass(monitor_pool, monitored_chips->chips, (size_t)active_monitors,
+                           monitor_chip_tick, monitor_health, &totals)) {
+        printf("Error: Monitoring pass failed\n");
+        return;
+    }
+    printf("Workers: %d\n", chip_worker_pool_size(monitor_pool));
 
     for (int i = 0; i < active_monitors; i++) {
-        chip_state_t* chip = &monitored_chips[i];
-
-        // Update chip status
-        update_chip_status(chip);
-
-        // Perform health check
-        int health = perform_health_check(chip);
-        total_health += health;
-
-        if (health < 50) {
-            critical_chips++;
-        } else if (health < 80) {
-            warning_chips++;
-        }
+        chip_state_t* chip = &monitored_chips->chips[i];
+        int health = monitor_health[i];
+        score_chip_health(chip, true);
 
         // Display quick status
-        printf("\n[%d] %s: Health=%d%%, Temp=%.1f°C, Errors=%u, Uptime=%llus\n",
-               i, chip->chip_id, health, chip->temperature,
+        printf("\n[%u] %s: Health=%d%%, Temp=%.1f°C, Errors=%u, Uptime=%llus\n",
+               CHIP_HANDLE_SLOT(chip_slot_map_handle_at(monitored_chips, (size_t)i)),
+               chip->chip_id, health, chip->temperature,
                chip->error_count, (unsigned long long)chip->uptime_seconds);
     }
 
     // System summary
-    float avg_health = (float)total_health / active_monitors;
+    int critical_chips = totals.critical_chips;
+    int warning_chips = totals.warning_chips;
+    float avg_health = (float)totals.total_health / active_monitors;
     printf("\n=== System Summary ===\n");
     printf("Average Health: %.1f%%\n", avg_health);
     printf("Critical Chips: %d\n", critical_chips);
@@ -308,9 +808,17 @@ void simulate_stress_test(void) {
     test_chips[2].registers.control_register = 0x00000001;
     test_chips[2].registers.status_register = 0x80000001;
 
-    // Add chips to monitor
+    // Add chips to monitor; the handles stay valid whatever else is monitored
+    chip_handle_t handles[3];
     for (int i = 0; i < 3; i++) {
-        add_chip_to_monitor(&test_chips[i]);
+        handles[i] = add_chip_to_monitor(&test_chips[i]);
+    }
+    chip_state_t* cpu = get_monitored_chip(handles[0]);
+    chip_state_t* gpu = get_monitored_chip(handles[1]);
+    chip_state_t* dsp = get_monitored_chip(handles[2]);
+    if (cpu == NULL || gpu == NULL || dsp == NULL) {
+        printf("Error: Failed to monitor stress test chips\n");
+        return;
     }
 
     // Simulate stress test phases
@@ -318,27 +826,49 @@ void simulate_stress_test(void) {
     monitor_all_chips();
 
     printf("\n--- Phase 2: Increased Load ---\n");
-    monitored_chips[0].temperature = 72.0f;  // CPU heating up
-    monitored_chips[1].temperature = 68.0f;  // GPU heating up
-    monitored_chips[2].voltage = 3.1f;       // DSP voltage drop
+    cpu->temperature = 72.0f;  // CPU heating up
+    gpu->temperature = 68.0f;  // GPU heating up
+    dsp->voltage = 3.1f;       // DSP voltage drop
     monitor_all_chips();
 
     printf("\n--- Phase 3: Stress Conditions ---\n");
-    monitored_chips[0].temperature = 88.0f;  // CPU overheating
-    monitored_chips[0].registers.error_register = 0x00000001;  // Thermal error
-    monitored_chips[1].temperature = 82.0f;  // GPU very hot
-    monitored_chips[1].error_count = 5;      // Some errors
-    monitored_chips[2].voltage = 2.9f;       // DSP undervoltage
-    monitored_chips[2].registers.error_register = 0x00000002;  // Voltage error
+    cpu->temperature = 88.0f;  // CPU overheating
+    cpu->registers.error_register = 0x00000001;  // Thermal error
+    gpu->temperature = 82.0f;  // GPU very hot
+    gpu->error_count = 5;      // Some errors
+    dsp->voltage = 2.9f;       // DSP undervoltage
+    dsp->registers.error_register = 0x00000002;  // Voltage error
     monitor_all_chips();
 
     printf("\n--- Phase 4: Recovery ---\n");
-    monitored_chips[0].temperature = 65.0f;  // CPU cooling
-    monitored_chips[0].registers.error_register = 0x00000000;  // Errors cleared
-    monitored_chips[1].temperature = 58.0f;  // GPU cooling
-    monitored_chips[2].voltage = 3.3f;       // DSP voltage restored
-    monitored_chips[2].registers.error_register = 0x00000000;  // Errors cleared
+    cpu->temperature = 65.0f;  // CPU cooling
+    cpu->registers.error_register = 0x00000000;  // Errors cleared
+    gpu->temperature = 58.0f;  // GPU cooling
+    dsp->voltage = 3.3f;       // DSP voltage restored
+    dsp->registers.error_register = 0x00000000;  // Errors cleared
     monitor_all_chips();
+
+    printf("\n--- Phase 5: Scheduled Polling ---\n");
+    // The CPU is still warm: watch it closely, leave the rest on the default period
+    set_chip_monitor_interval(handles[0], MONITOR_UPDATE_INTERVAL / 10);
+    run_chip_monitor_scheduler(MONITOR_UPDATE_INTERVAL + MONITOR_UPDATE_INTERVAL / 5);
+
+    printf("\n--- Sample History ---\n");
+    for (int i = 0; i < 3; i++) {
+        chip_state_t* chip = get_monitored_chip(handles[i]);
+        chip_window_stats_t temp, volt;
+        if (chip == NULL ||
+            !chip_history_window(get_monitored_chip_history(handles[i]), CHIP_METRIC_TEMPERATURE, 0, &temp) ||
+            !chip_history_window(get_monitored_chip_history(handles[i]), CHIP_METRIC_VOLTAGE, 0, &volt)) {
+            continue;
+        }
+        chip_telemetry_stats_t archive;
+        chip_telemetry_stats(get_monitored_chip_telemetry(handles[i]), &archive);
+        printf("%-10s %3zu samples  temp %.1f-%.1f°C (mean %.1f)  voltage %.2f-%.2fV  %llu with errors"
+               "  (archive: %llu samples)\n",
+               chip->chip_id, temp.samples, temp.min, temp.max, temp.mean, volt.min, volt.max,
+               (unsigned long long)temp.error_samples, (unsigned long long)archive.samples);
+    }
 }
 
 /**
@@ -427,15 +957,114 @@ void run_chip_monitor_demo(void) {
     // Run stress test simulation
     simulate_stress_test();
 
+    shutdown_chip_monitor();
+
     printf("\n========================================\n");
     printf("    CHIP MONITOR DEMO COMPLETE\n");
     printf("========================================\n");
 }
 
+/**
+ * Replay a register trace file against a fresh bank and report the result
+ * @param path Trace file written by register_trace_start()
+ * @param paced Reproduce the original access timing
+ * @return Process exit status
+ */
+static int run_register_replay(const char* path, bool paced) {
+    register_replay_stats_t stats;
+    long long replayed = register_trace_replay(path, paced, &stats);
+    if (replayed < 0) return 1;
+
+    printf("Replayed %lld register accesses (%llu reads, %llu writes) from %s\n",
+           replayed, (unsigned long long)stats.reads, (unsigned long long)stats.writes, path);
+    printf("Trace span %.3f ms, replay took %.3f ms (%s)\n",
+           stats.trace_span_ns / 1e6, stats.elapsed_ns / 1e6, paced ? "paced" : "full speed");
+    printf("Mismatches: %llu, out of range: %llu\n",
+           (unsigned long long)stats.mismatches, (unsigned long long)stats.out_of_range);
+    return stats.mismatches == 0 && stats.out_of_range == 0 ? 0 : 2;
+}
+
+/**
+ * Time the parallel monitoring pass on a synthetic fleet for 1..N workers
+ * @param chip_count Number of chips in the fleet
+ * @param max_workers Largest worker count to try (0 = online CPUs)
+ * @return Process exit status
+ */
+static int run_monitor_benchmark(int chip_count, int max_workers) {
+    if (chip_count <= 0 || max_workers < 0) {
+        printf("Error: Invalid monitor benchmark parameters\n");
+        return 1;
+    }
+    if (max_workers == 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        max_workers = online > 0 ? (int)online : 1;
+    }
+
+    chip_state_t* fleet = calloc((size_t)chip_count, sizeof(chip_state_t));
+    int* health = malloc((size_t)chip_count * sizeof(int));
+    if (fleet == NULL || health == NULL) {
+        printf("Error: Failed to allocate %d-chip fleet\n", chip_count);
+        free(fleet);
+        free(health);
+        return 1;
+    }
+    for (int i = 0; i < chip_count; i++) {
+        snprintf(fleet[i].chip_id, sizeof(fleet[i].chip_id), "CHIP_%d", i);
+        fleet[i].temperature = 40.0f + (float)(i % 55);
+        fleet[i].voltage = 2.9f + (float)(i % 9) * 0.1f;
+        fleet[i].registers.control_register = 0x00000001;
+        fleet[i].registers.status_register = (i % 7 == 0) ? 0 : 0x80000001;
+        fleet[i].registers.error_register = (i % 13 == 0) ? 1 : 0;
+        fleet[i].is_initialized = true;
+    }
+
+    printf("=== Parallel Monitoring Pass (%d chips) ===\n", chip_count);
+    printf("%8s %12s %10s %8s\n", "Workers", "ms/pass", "Chips/s", "Speedup");
+
+    const int passes = 20;
+    double single_ms = 0.0;
+    // 1, 2, 4, ... and finally max_workers itself
+    for (int workers = 1; ; workers = workers * 2 < max_workers ? workers * 2 : max_workers) {
+        chip_worker_pool_t* pool = create_chip_worker_pool(workers);
+        if (pool == NULL) break;
+
+        chip_monitor_totals_t totals;
+        struct timespec start, end;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (int p = 0; p < passes; p++) {
+            chip_monitor_pass(pool, fleet, (size_t)chip_count, monitor_chip_tick, health, &totals);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        destroy_chip_worker_pool(pool);
+
+        double ms = ((end.tv_sec - start.tv_sec) * 1e3 + (end.tv_nsec - start.tv_nsec) / 1e6) / passes;
+        if (workers == 1) single_ms = ms;
+        printf("%8d %12.3f %10.0f %7.2fx   (critical %d, warning %d)\n", workers, ms,
+               ms > 0.0 ? chip_count / (ms / 1e3) : 0.0, ms > 0.0 ? single_ms / ms : 0.0,
+               totals.critical_chips, totals.warning_chips);
+        if (workers == max_workers) break;
+    }
+
+    free(fleet);
+    free(health);
+    return 0;
+}
+
 /**
  * Main function for comprehensive testing
  */
-int main(void) {
+int main(int argc, char* argv[]) {
+    // Replay tool: day3_reference --replay <trace file> [--paced]
+    if (argc >= 3 && strcmp(argv[1], "--replay") == 0) {
+        return run_register_replay(argv[2], argc >= 4 && strcmp(argv[3], "--paced") == 0);
+    }
+
+    // Scaling benchmark: day3_reference --bench-monitor [chips] [max workers]
+    if (argc >= 2 && strcmp(argv[1], "--bench-monitor") == 0) {
+        return run_monitor_benchmark(argc >= 3 ? atoi(argv[2]) : 100000,
+                                     argc >= 4 ? atoi(argv[3]) : 0);
+    }
+
     printf("=== Day 3: Memory Management and Data Structures ===\n");
     printf("Reference Solution Demonstration\n\n");
 
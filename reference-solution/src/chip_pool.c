@@ -0,0 +1,347 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "chip_state.h"
+
+// Slots start on a cache line and are a whole number of cache lines long
+#define CHIP_POOL_ALIGNMENT 64
+#define CHIP_POOL_DEFAULT_SLAB_SLOTS 1024
+
+// Written into free slots of tracked pools to catch double frees
+#define CHIP_POOL_FREE_MAGIC 0xC41FF4EEu
+
+// A slot holds either a live chip or a free-list link
+typedef union chip_pool_slot {
+    chip_state_t chip;
+    struct {
+        union chip_pool_slot* next;
+        uint32_t free_magic;
+    } link;
+} __attribute__((aligned(CHIP_POOL_ALIGNMENT))) chip_pool_slot_t;
+
+// One contiguous block of slots
+struct chip_pool_slab {
+    struct chip_pool_slab* next;
+    void* raw;                 // Pointer to release (differs from the slab when tracked)
+    chip_pool_slot_t* slots;
+    size_t slot_count;
+};
+
+/**
+ * Allocate a slab of at least slot_count slots and link it into the pool
+ * Slots are returned uninitialized; the caller decides where they go.
+ * @param pool Pool to grow
+ * @param slot_count Number of slots
+ * @return New slab or NULL if failed
+ */
+static chip_pool_slab_t* chip_pool_add_slab(chip_pool_t* pool, size_t slot_count) {
+    size_t header = (sizeof(chip_pool_slab_t) + CHIP_POOL_ALIGNMENT - 1) /
+                    CHIP_POOL_ALIGNMENT * CHIP_POOL_ALIGNMENT;
+    size_t bytes = header + slot_count * sizeof(chip_pool_slot_t);
+    void* raw = NULL;
+    char* base = NULL;
+
+    if (pool->use_tracker) {
+        // SAFE_MALLOC only guarantees 4-byte alignment: over-allocate and align up
+        raw = SAFE_MALLOC(bytes + CHIP_POOL_ALIGNMENT);
+        if (raw == NULL) return NULL;
+        base = (char*)(((uintptr_t)raw + CHIP_POOL_ALIGNMENT - 1) &
+                       ~(uintptr_t)(CHIP_POOL_ALIGNMENT - 1));
+    } else {
+        if (posix_memalign(&raw, CHIP_POOL_ALIGNMENT, bytes) != 0) return NULL;
+        base = raw;
+    }
+
+    chip_pool_slab_t* slab = (chip_pool_slab_t*)base;
+    slab->raw = raw;
+    slab->slots = (chip_pool_slot_t*)(base + header);
+    slab->slot_count = slot_count;
+    slab->next = pool->slabs;
+    pool->slabs = slab;
+    pool->slab_count++;
+    pool->total_slots += slot_count;
+    return slab;
+}
+
+/**
+ * Push a slot onto the free list
+ * @param pool Pool owning the slot
+ * @param slot Slot to release
+ */
+static inline void chip_pool_push_free(chip_pool_t* pool, chip_pool_slot_t* slot) {
+    slot->link.next = pool->free_list;
+    if (pool->use_tracker) {
+        slot->link.free_magic = CHIP_POOL_FREE_MAGIC;
+    }
+    pool->free_list = slot;
+}
+
+/**
+ * Check that a chip pointer is a slot of this pool (tracked pools only)
+ * @param pool Pool to search
+ * @param chip Chip pointer
+ * @return true if chip is the start of a slot in one of the pool's slabs
+ */
+static bool chip_pool_owns(const chip_pool_t* pool, const chip_state_t* chip) {
+    uintptr_t addr = (uintptr_t)chip;
+    for (const chip_pool_slab_t* slab = pool->slabs; slab != NULL; slab = slab->next) {
+        uintptr_t start = (uintptr_t)slab->slots;
+        uintptr_t end = start + slab->slot_count * sizeof(chip_pool_slot_t);
+        if (addr >= start && addr < end) {
+            return (addr - start) % sizeof(chip_pool_slot_t) == 0;
+        }
+    }
+    return false;
+}
+
+/**
+ * Create a slab pool for chip_state_t objects
+ * @param slots_per_slab Slots added each time the pool grows (0 for the default)
+ * @param use_tracker true to allocate slabs with SAFE_MALLOC and check frees
+ * @return Pool or NULL if failed
+ */
+chip_pool_t* create_chip_pool(size_t slots_per_slab, bool use_tracker) {
+    chip_pool_t* pool = calloc(1, sizeof(chip_pool_t));
+    if (pool == NULL) {
+        printf("Error: Failed to allocate chip pool\n");
+        return NULL;
+    }
+
+    pool->slots_per_slab = slots_per_slab != 0 ? slots_per_slab : CHIP_POOL_DEFAULT_SLAB_SLOTS;
+    pool->use_tracker = use_tracker;
+    return pool;
+}
+
+/**
+ * Destroy a pool and every chip allocated from it in one pass over its slabs
+ * @param pool Pool to destroy
+ */
+void destroy_chip_pool(chip_pool_t* pool) {
+    if (pool == NULL) return;
+
+    chip_pool_slab_t* slab = pool->slabs;
+    while (slab != NULL) {
+        chip_pool_slab_t* next = slab->next;
+        if (pool->use_tracker) {
+            void* raw = slab->raw;
+            SAFE_FREE(raw);
+        } else {
+            free(slab->raw);
+        }
+        slab = next;
+    }
+
+    free(pool);
+}
+
+/**
+ * Allocate one zeroed chip from the pool
+ * @param pool Pool to allocate from
+ * @return Chip or NULL if failed
+ */
+chip_state_t* chip_pool_alloc(chip_pool_t* pool) {
+    if (pool == NULL) return NULL;
+
+    if (pool->free_list == NULL) {
+        chip_pool_slab_t* slab = chip_pool_add_slab(pool, pool->slots_per_slab);
+        if (slab == NULL) {
+            printf("Error: Failed to grow chip pool\n");
+            return NULL;
+        }
+        // Push in reverse so consecutive allocations walk the slab in address order
+        for (size_t i = slab->slot_count; i > 0; i--) {
+            chip_pool_push_free(pool, &slab->slots[i - 1]);
+        }
+    }
+
+    chip_pool_slot_t* slot = pool->free_list;
+    pool->free_list = slot->link.next;
+    pool->live_count++;
+
+    memset(&slot->chip, 0, sizeof(chip_state_t));
+    return &slot->chip;
+}
+
+/**
+ * Return one chip to the pool
+ * Tracked pools reject pointers they do not own and repeated frees.
+ * @param pool Pool the chip came from
+ * @param chip Chip to release
+ */
+void chip_pool_free(chip_pool_t* pool, chip_state_t* chip) {
+    if (pool == NULL || chip == NULL) return;
+
+    chip_pool_slot_t* slot = (chip_pool_slot_t*)chip;
+
+    if (pool->use_tracker) {
+        if (!chip_pool_owns(pool, chip)) {
+            printf("ERROR: Chip %p does not belong to this pool\n", (void*)chip);
+            return;
+        }
+        if (slot->link.free_magic == CHIP_POOL_FREE_MAGIC) {
+            printf("ERROR: Double free of pooled chip %p\n", (void*)chip);
+            return;
+        }
+        memset(chip, 0xDD, sizeof(chip_state_t));
+    }
+
+    chip_pool_push_free(pool, slot);
+    pool->live_count--;
+}
+
+/**
+ * Allocate count zeroed chips at once
+ * Reuses free slots first, then carves the rest from a single new slab so
+ * the chips are contiguous in memory.
+ * @param pool Pool to allocate from
+ * @param chips Output array of count chip pointers
+ * @param count Number of chips
+ * @return Number of chips allocated (count, or 0 if failed)
+ */
+size_t chip_pool_alloc_bulk(chip_pool_t* pool, chip_state_t** chips, size_t count) {
+    if (pool == NULL || chips == NULL || count == 0) return 0;
+
+    size_t n = 0;
+    while (n < count && pool->free_list != NULL) {
+        chip_pool_slot_t* slot = pool->free_list;
+        pool->free_list = slot->link.next;
+        memset(&slot->chip, 0, sizeof(chip_state_t));
+        chips[n++] = &slot->chip;
+    }
+
+    if (n < count) {
+        size_t needed = count - n;
+        chip_pool_slab_t* slab = chip_pool_add_slab(pool,
+            needed > pool->slots_per_slab ? needed : pool->slots_per_slab);
+        if (slab == NULL) {
+            printf("Error: Failed to grow chip pool for %zu chips\n", needed);
+            // Give back what was taken so the pool stays consistent
+            while (n > 0) {
+                chip_pool_push_free(pool, (chip_pool_slot_t*)chips[--n]);
+            }
+            return 0;
+        }
+
+        // Fresh slots are contiguous: zero them in one pass
+        memset(slab->slots, 0, needed * sizeof(chip_pool_slot_t));
+        for (size_t i = 0; i < needed; i++) {
+            chips[n++] = &slab->slots[i].chip;
+        }
+        for (size_t i = slab->slot_count; i > needed; i--) {
+            chip_pool_push_free(pool, &slab->slots[i - 1]);
+        }
+    }
+
+    pool->live_count += count;
+    return count;
+}
+
+/**
+ * Return count chips to the pool
+ * @param pool Pool the chips came from
+ * @param chips Array of chip pointers (NULL entries are skipped)
+ * @param count Number of entries
+ */
+void chip_pool_free_bulk(chip_pool_t* pool, chip_state_t** chips, size_t count) {
+    if (pool == NULL || chips == NULL) return;
+
+    // Reverse order keeps the free list in ascending address order
+    if (pool->use_tracker) {
+        for (size_t i = count; i > 0; i--) {
+            if (chips[i - 1] != NULL) {
+                chip_pool_free(pool, chips[i - 1]);
+            }
+        }
+        return;
+    }
+
+    chip_pool_slot_t* head = pool->free_list;
+    size_t released = 0;
+    for (size_t i = count; i > 0; i--) {
+        chip_pool_slot_t* slot = (chip_pool_slot_t*)chips[i - 1];
+        if (slot == NULL) continue;
+        slot->link.next = head;
+        head = slot;
+        released++;
+    }
+    pool->free_list = head;
+    pool->live_count -= released;
+}
+
+/**
+ * Benchmark fleet setup and teardown: one malloc per chip versus the slab pool
+ * @param chip_count Number of chips to create and destroy
+ */
+void benchmark_chip_pool(int chip_count) {
+    printf("\n--- Chip Slab Pool (%d chips) ---\n", chip_count);
+
+    if (chip_count <= 0) return;
+
+    chip_state_t** chips = malloc((size_t)chip_count * sizeof(chip_state_t*));
+    if (chips == NULL) {
+        printf("Failed to allocate benchmark chip array\n");
+        return;
+    }
+
+    const int rounds = 5;
+    clock_t start;
+
+    // One malloc/free per chip
+    start = clock();
+    for (int r = 0; r < rounds; r++) {
+        for (int i = 0; i < chip_count; i++) {
+            chips[i] = calloc(1, sizeof(chip_state_t));
+        }
+        __asm__ __volatile__("" : : "r"(chips) : "memory");
+        for (int i = 0; i < chip_count; i++) {
+            free(chips[i]);
+        }
+    }
+    double malloc_ms = (double)(clock() - start) / CLOCKS_PER_SEC * 1000.0;
+
+    // Bulk allocate from a fresh pool and destroy it whole
+    start = clock();
+    size_t pool_slabs = 0;
+    for (int r = 0; r < rounds; r++) {
+        chip_pool_t* pool = create_chip_pool(0, false);
+        if (pool == NULL || chip_pool_alloc_bulk(pool, chips, (size_t)chip_count) == 0) {
+            destroy_chip_pool(pool);
+            break;
+        }
+        pool_slabs = pool->slab_count;
+        __asm__ __volatile__("" : : "r"(chips) : "memory");
+        destroy_chip_pool(pool);
+    }
+    double pool_ms = (double)(clock() - start) / CLOCKS_PER_SEC * 1000.0;
+
+    // Reused pool: bulk free then bulk allocate again (free-list path)
+    double reuse_ms = 0.0;
+    chip_pool_t* pool = create_chip_pool(0, false);
+    if (pool != NULL && chip_pool_alloc_bulk(pool, chips, (size_t)chip_count) != 0) {
+        start = clock();
+        for (int r = 0; r < rounds; r++) {
+            chip_pool_free_bulk(pool, chips, (size_t)chip_count);
+            chip_pool_alloc_bulk(pool, chips, (size_t)chip_count);
+            __asm__ __volatile__("" : : "r"(chips) : "memory");
+        }
+        reuse_ms = (double)(clock() - start) / CLOCKS_PER_SEC * 1000.0;
+    }
+    destroy_chip_pool(pool);
+
+    printf("malloc per chip:      %8.3f ms/round (%d allocator calls)\n",
+           malloc_ms / rounds, 2 * chip_count);
+    printf("Pool bulk + destroy:  %8.3f ms/round (%zu slab allocations)\n",
+           pool_ms / rounds, pool_slabs);
+    printf("Pool free/alloc reuse:%8.3f ms/round (no allocator calls)\n", reuse_ms / rounds);
+    if (pool_ms > 0.0) {
+        printf("Pool setup/teardown speedup: %.2fx\n", malloc_ms / pool_ms);
+    }
+
+    free(chips);
+}
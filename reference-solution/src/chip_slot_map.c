@@ -0,0 +1,295 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "chip_state.h"
+
+#define CHIP_SLOT_MAP_DEFAULT_CAPACITY 64
+#define CHIP_SLOT_MAP_MAX_CHIPS (UINT32_MAX - 1)
+#define CHIP_SLOT_NONE UINT32_MAX
+
+/**
+ * Build a handle from a slot and its generation
+ * @param slot Slot number
+ * @param generation Generation of the slot when the chip was inserted
+ * @return Handle (never CHIP_HANDLE_INVALID, generations start at 1)
+ */
+static inline chip_handle_t make_chip_handle(uint32_t slot, uint32_t generation) {
+    return ((chip_handle_t)generation << 32) | slot;
+}
+
+/**
+ * Resize every array of the map to a new capacity
+ * Slots only come into existence while the map is full, so the slot arrays
+ * never need more entries than the dense arrays.
+ * @param map Map to grow
+ * @param capacity New capacity (> map->capacity)
+ * @return 1 if successful, 0 if failed
+ */
+static int chip_slot_map_grow(chip_slot_map_t* map, uint32_t capacity) {
+    chip_state_t* chips = realloc(map->chips, (size_t)capacity * sizeof(chip_state_t));
+    if (chips == NULL) return 0;
+    map->chips = chips;
+
+    uint32_t* dense_slot = realloc(map->dense_slot, (size_t)capacity * sizeof(uint32_t));
+    if (dense_slot == NULL) return 0;
+    map->dense_slot = dense_slot;
+
+    uint32_t* slot_index = realloc(map->slot_index, (size_t)capacity * sizeof(uint32_t));
+    if (slot_index == NULL) return 0;
+    map->slot_index = slot_index;
+
+    uint32_t* slot_generation = realloc(map->slot_generation, (size_t)capacity * sizeof(uint32_t));
+    if (slot_generation == NULL) return 0;
+    map->slot_generation = slot_generation;
+
+    map->capacity = capacity;
+    return 1;
+}
+
+/**
+ * Create a slot map for monitored chips
+ * @param initial_capacity Chips to reserve room for (0 = default)
+ * @return Map or NULL if failed
+ */
+chip_slot_map_t* create_chip_slot_map(size_t initial_capacity) {
+    if (initial_capacity > CHIP_SLOT_MAP_MAX_CHIPS) {
+        printf("Error: Slot map capacity %zu too large\n", initial_capacity);
+        return NULL;
+    }
+
+    chip_slot_map_t* map = calloc(1, sizeof(chip_slot_map_t));
+    if (map == NULL) {
+        printf("Error: Failed to allocate chip slot map\n");
+        return NULL;
+    }
+
+    map->free_head = CHIP_SLOT_NONE;
+    uint32_t capacity = initial_capacity != 0 ? (uint32_t)initial_capacity : CHIP_SLOT_MAP_DEFAULT_CAPACITY;
+    if (!chip_slot_map_grow(map, capacity)) {
+        printf("Error: Failed to allocate chip slot map storage\n");
+        destroy_chip_slot_map(map);
+        return NULL;
+    }
+    return map;
+}
+
+/**
+ * Destroy a slot map and the chips stored in it
+ * @param map Map to destroy
+ */
+void destroy_chip_slot_map(chip_slot_map_t* map) {
+    if (map == NULL) return;
+
+    free(map->chips);
+    free(map->dense_slot);
+    free(map->slot_index);
+    free(map->slot_generation);
+    free(map);
+}
+
+/**
+ * Copy a chip into the map
+ * Chips are stored densely, so a pointer from chip_slot_map_get() is only
+ * valid until the next insert or remove; keep the handle instead.
+ * @param map Map to insert into
+ * @param chip Chip to copy
+ * @return Handle of the stored chip, or CHIP_HANDLE_INVALID if failed
+ */
+chip_handle_t chip_slot_map_insert(chip_slot_map_t* map, const chip_state_t* chip) {
+    if (map == NULL || chip == NULL) {
+        printf("Error: Invalid parameters for slot map insert\n");
+        return CHIP_HANDLE_INVALID;
+    }
+
+    if (map->count == map->capacity) {
+        if (map->capacity == CHIP_SLOT_MAP_MAX_CHIPS) {
+            printf("Error: Slot map full (%u chips)\n", map->count);
+            return CHIP_HANDLE_INVALID;
+        }
+        uint32_t capacity = map->capacity > CHIP_SLOT_MAP_MAX_CHIPS / 2 ?
+                            CHIP_SLOT_MAP_MAX_CHIPS : map->capacity * 2;
+        if (!chip_slot_map_grow(map, capacity)) {
+            printf("Error: Failed to grow chip slot map to %u chips\n", capacity);
+            return CHIP_HANDLE_INVALID;
+        }
+    }
+
+    // Reuse a freed slot (its generation was bumped on remove), or open a new one
+    uint32_t slot = map->free_head;
+    if (slot != CHIP_SLOT_NONE) {
+        map->free_head = map->slot_index[slot];
+    } else {
+        slot = map->slot_count++;
+        map->slot_generation[slot] = 1;
+    }
+
+    uint32_t dense = map->count++;
+    map->chips[dense] = *chip;
+    map->dense_slot[dense] = slot;
+    map->slot_index[slot] = dense;
+    return make_chip_handle(slot, map->slot_generation[slot]);
+}
+
+/**
+ * Check a handle against the slot's current generation
+ * @param map Map the handle came from
+ * @param handle Handle to check
+ * @return Slot number, or CHIP_SLOT_NONE if the handle is stale or invalid
+ */
+static inline uint32_t chip_slot_map_live_slot(const chip_slot_map_t* map, chip_handle_t handle) {
+    uint32_t slot = CHIP_HANDLE_SLOT(handle);
+    if (map == NULL || slot >= map->slot_count ||
+        map->slot_generation[slot] != CHIP_HANDLE_GENERATION(handle)) {
+        return CHIP_SLOT_NONE;
+    }
+    return slot;
+}
+
+/**
+ * Remove a chip in O(1): the last dense chip moves into the hole
+ * @param map Map to remove from
+ * @param handle Handle of the chip
+ * @return 1 if removed, 0 if the handle is stale or invalid
+ */
+int chip_slot_map_remove(chip_slot_map_t* map, chip_handle_t handle) {
+    uint32_t slot = chip_slot_map_live_slot(map, handle);
+    if (slot == CHIP_SLOT_NONE) return 0;
+
+    uint32_t dense = map->slot_index[slot];
+    uint32_t last = --map->count;
+    if (dense != last) {
+        map->chips[dense] = map->chips[last];
+        map->dense_slot[dense] = map->dense_slot[last];
+        map->slot_index[map->dense_slot[dense]] = dense;
+    }
+
+    // Invalidate outstanding handles; generation 0 is never handed out
+    uint32_t generation = map->slot_generation[slot] + 1;
+    map->slot_generation[slot] = generation != 0 ? generation : 1;
+    map->slot_index[slot] = map->free_head;
+    map->free_head = slot;
+    return 1;
+}
+
+/**
+ * Look up a chip by handle
+ * @param map Map to search
+ * @param handle Handle returned by chip_slot_map_insert()
+ * @return Chip, or NULL if the handle is stale or invalid
+ */
+chip_state_t* chip_slot_map_get(const chip_slot_map_t* map, chip_handle_t handle) {
+    uint32_t slot = chip_slot_map_live_slot(map, handle);
+    return slot != CHIP_SLOT_NONE ? &map->chips[map->slot_index[slot]] : NULL;
+}
+
+/**
+ * Get the handle of the chip at a dense position (for iteration)
+ * @param map Map to read
+ * @param dense_index Position in map->chips, below map->count
+ * @return Handle, or CHIP_HANDLE_INVALID if out of range
+ */
+chip_handle_t chip_slot_map_handle_at(const chip_slot_map_t* map, size_t dense_index) {
+    if (map == NULL || dense_index >= map->count) return CHIP_HANDLE_INVALID;
+
+    uint32_t slot = map->dense_slot[dense_index];
+    return make_chip_handle(slot, map->slot_generation[slot]);
+}
+
+/**
+ * Remove every chip; all outstanding handles become stale
+ * @param map Map to clear
+ */
+void chip_slot_map_clear(chip_slot_map_t* map) {
+    if (map == NULL) return;
+
+    while (map->count > 0) {
+        chip_slot_map_remove(map, chip_slot_map_handle_at(map, map->count - 1));
+    }
+}
+
+/**
+ * Compare the fixed array with shift-down removal against the slot map under
+ * churn: remove a random chip, insert a new one, then scan every chip
+ * @param chip_count Number of monitored chips
+ */
+void benchmark_chip_slot_map(int chip_count) {
+    printf("\n--- Chip Slot Map (%d chips) ---\n", chip_count);
+
+    if (chip_count <= 1) return;
+
+    const int churn = 2000;
+    chip_state_t* array = malloc((size_t)chip_count * sizeof(chip_state_t));
+    chip_handle_t* handles = malloc((size_t)chip_count * sizeof(chip_handle_t));
+    chip_slot_map_t* map = create_chip_slot_map(0);
+    if (array == NULL || handles == NULL || map == NULL) {
+        printf("Failed to allocate benchmark chips\n");
+        free(array);
+        free(handles);
+        destroy_chip_slot_map(map);
+        return;
+    }
+
+    chip_state_t chip;
+    memset(&chip, 0, sizeof(chip));
+    chip.is_initialized = true;
+    chip.temperature = 45.0f;
+    unsigned int seed = 12345;
+    struct timespec start, end;
+
+    // Array with shift-down removal: indices of later chips change on every remove
+    for (int i = 0; i < chip_count; i++) {
+        chip.serial_number = (uint32_t)i;
+        array[i] = chip;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int count = chip_count;
+    for (int i = 0; i < churn; i++) {
+        int victim = rand_r(&seed) % count;
+        memmove(&array[victim], &array[victim + 1], (size_t)(count - victim - 1) * sizeof(chip_state_t));
+        chip.serial_number = (uint32_t)(chip_count + i);
+        array[count - 1] = chip;
+    }
+    float array_sum = 0.0f;
+    for (int i = 0; i < count; i++) array_sum += array[i].temperature;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double array_ms = (end.tv_sec - start.tv_sec) * 1e3 + (end.tv_nsec - start.tv_nsec) / 1e6;
+
+    // Slot map: O(1) swap-remove, handles of other chips stay valid
+    for (int i = 0; i < chip_count; i++) {
+        chip.serial_number = (uint32_t)i;
+        handles[i] = chip_slot_map_insert(map, &chip);
+    }
+    seed = 12345;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < churn; i++) {
+        int victim = rand_r(&seed) % chip_count;
+        chip_slot_map_remove(map, handles[victim]);
+        chip.serial_number = (uint32_t)(chip_count + i);
+        handles[victim] = chip_slot_map_insert(map, &chip);
+    }
+    float map_sum = 0.0f;
+    for (uint32_t i = 0; i < map->count; i++) map_sum += map->chips[i].temperature;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double map_ms = (end.tv_sec - start.tv_sec) * 1e3 + (end.tv_nsec - start.tv_nsec) / 1e6;
+    __asm__ __volatile__("" : : "r"(&array_sum), "r"(&map_sum) : "memory");
+
+    // Every live handle still resolves to the chip it was issued for
+    int resolved = 0;
+    for (int i = 0; i < chip_count; i++) {
+        if (chip_slot_map_get(map, handles[i]) != NULL) resolved++;
+    }
+
+    printf("Array shift-remove:  %8.3f ms (%d remove/insert pairs + scan)\n", array_ms, churn);
+    printf("Slot map:            %8.3f ms (%d/%d handles still valid)\n", map_ms, resolved, chip_count);
+    if (map_ms > 0.0) printf("Churn speedup: %.1fx\n", array_ms / map_ms);
+
+    free(array);
+    free(handles);
+    destroy_chip_slot_map(map);
+}
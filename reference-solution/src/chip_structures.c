@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <string.h>
 #include <stdlib.h>
 #include <time.h>
@@ -39,6 +40,64 @@ typedef struct {
 // Global system state
 static system_state_t g_system;
 
+// Copy-on-write snapshot hook (must match SNAPSHOT_REGION_SYSTEM in chip_state.h)
+#define SNAPSHOT_REGION_SYSTEM 1
+extern int g_snapshot_active;
+void snapshot_before_write(int region, const void* address, size_t length);
+
+/**
+ * Let live snapshots preserve system state before it is modified
+ * @param address First byte about to change
+ * @param length Bytes about to change
+ */
+static inline void system_before_write(const void* address, size_t length) {
+    if (__builtin_expect(__atomic_load_n(&g_snapshot_active, __ATOMIC_RELAXED) != 0, 0)) {
+        snapshot_before_write(SNAPSHOT_REGION_SYSTEM, address, length);
+    }
+}
+
+/**
+ * Get the global system state (read-only)
+ * Writers must go through the functions in this file so snapshots see the change.
+ * @return Pointer to the system state
+ */
+const system_state_t* get_system_state(void) {
+    return &g_system;
+}
+
+/**
+ * Overwrite the whole system state with a saved copy
+ * Goes through the snapshot hook like every other system state write.
+ * @param saved State to restore
+ */
+void restore_system_state(const system_state_t* saved) {
+    if (saved == NULL) {
+        printf("Error: NULL pointer passed to restore_system_state\n");
+        return;
+    }
+
+    system_before_write(&g_system, sizeof(g_system));
+    memcpy(&g_system, saved, sizeof(g_system));
+}
+
+/**
+ * Write raw bytes of the system state without the snapshot hook
+ * For the snapshot layer only, which preserves the bytes itself first.
+ * @param offset Byte offset into system_state_t
+ * @param data Bytes to write
+ * @param length Number of bytes
+ * @return 1 if written, 0 if out of range
+ */
+int restore_system_state_bytes(size_t offset, const void* data, size_t length) {
+    if (data == NULL || offset > sizeof(g_system) || length > sizeof(g_system) - offset) {
+        printf("Error: Invalid system state range %zu+%zu\n", offset, length);
+        return 0;
+    }
+
+    memcpy((unsigned char*)&g_system + offset, data, length);
+    return 1;
+}
+
 /**
  * Initialize a chip state structure
  * @param chip Pointer to chip state structure
@@ -151,15 +210,20 @@ void update_chip_registers(chip_state_t* chip, register_set_t* new_regs) {
         chip->error_count++;
     }
 
-    printf("Chip '%s' registers updated:\n", chip->chip_id);
-    printf("  Control: 0x%08X -> 0x%08X\n",
-           old_regs.control_register, new_regs->control_register);
-    printf("  Status:  0x%08X -> 0x%08X\n",
-           old_regs.status_register, new_regs->status_register);
-    printf("  Error:   0x%08X -> 0x%08X\n",
-           old_regs.error_register, new_regs->error_register);
-    printf("  Config:  0x%08X -> 0x%08X\n",
-           old_regs.config_register, new_regs->config_register);
+    // Report only registers that changed, with the bits that flipped
+    const uint32_t* old_words = (const uint32_t*)&old_regs;
+    const uint32_t* new_words = (const uint32_t*)new_regs;
+    static const char* const names[4] = { "Control:", "Status: ", "Error:  ", "Config: " };
+    int changed = 0;
+    for (int i = 0; i < 4; i++) {
+        if ((old_words[i] ^ new_words[i]) == 0) continue;
+        if (changed++ == 0) printf("Chip '%s' registers updated:\n", chip->chip_id);
+        printf("  %s 0x%08X -> 0x%08X (bits 0x%08X)\n",
+               names[i], old_words[i], new_words[i], old_words[i] ^ new_words[i]);
+    }
+    if (changed == 0) {
+        printf("Chip '%s' registers unchanged\n", chip->chip_id);
+    }
 }
 
 /**
@@ -262,6 +326,7 @@ void print_chip_summary(const chip_state_t* chip) {
  * Initialize the system state
  */
 void init_system_state(void) {
+    system_before_write(&g_system, sizeof(system_state_t));
     memset(&g_system, 0, sizeof(system_state_t));
     g_system.active_chip_count = 0;
     g_system.total_error_count = 0;
@@ -293,6 +358,8 @@ int add_chip_to_system(chip_state_t* chip) {
     }
 
     // Copy chip to system array
+    system_before_write(&g_system.chips[g_system.active_chip_count], sizeof(chip_state_t));
+    system_before_write(&g_system.active_chip_count, sizeof(g_system.active_chip_count));
     g_system.chips[g_system.active_chip_count] = *chip;
     g_system.active_chip_count++;
 
@@ -307,6 +374,8 @@ int add_chip_to_system(chip_state_t* chip) {
  * Update system-wide statistics
  */
 void update_system_statistics(void) {
+    system_before_write(&g_system.active_chip_count,
+                        sizeof(system_state_t) - offsetof(system_state_t, active_chip_count));
     if (g_system.active_chip_count == 0) {
         g_system.average_temperature = 0.0f;
         g_system.total_error_count = 0;
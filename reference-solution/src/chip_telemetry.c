@@ -0,0 +1,840 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "chip_state.h"
+
+#define CHIP_TELEMETRY_MAX_BLOCK_SAMPLES 65536
+
+// Columns of an encoded block, each byte-aligned so it decodes on its own
+enum {
+    TELEMETRY_COLUMN_TIMESTAMP = 0,
+    TELEMETRY_COLUMN_TEMPERATURE,
+    TELEMETRY_COLUMN_VOLTAGE,
+    TELEMETRY_COLUMN_REGISTERS
+};
+
+// Block index entry: enough to find a timestamp without decoding anything
+typedef struct {
+    uint64_t first_ns;
+    uint64_t last_ns;
+    size_t offset;                                      // Start of the block in data
+    uint32_t column_bytes[CHIP_TELEMETRY_COLUMNS];
+    uint32_t count;
+} chip_telemetry_block_t;
+
+struct chip_telemetry {
+    uint8_t* data;                      // Sealed blocks, back to back
+    size_t size;
+    size_t capacity;
+    chip_telemetry_block_t* blocks;
+    size_t block_count;
+    size_t block_capacity;
+    chip_sample_t* open;                // Block being filled, kept raw until sealed
+    size_t open_count;
+    size_t block_samples;
+    size_t max_blocks;                  // Sealed blocks kept (0 = unlimited)
+    uint64_t total;                     // Retained samples
+    uint64_t dropped;                   // Samples discarded by retention
+    size_t column_bytes[CHIP_TELEMETRY_COLUMNS];
+};
+
+// MSB-first bit writer appending to the store's data buffer
+typedef struct {
+    chip_telemetry_t* store;
+    uint64_t acc;
+    int bits;                           // Pending bits in acc (< 8 between calls)
+    bool failed;
+} telemetry_writer_t;
+
+// MSB-first bit reader over one column
+typedef struct {
+    const uint8_t* data;
+    size_t size;
+    size_t pos;
+    uint64_t acc;
+    int bits;
+} telemetry_reader_t;
+
+/**
+ * Make room for a few more bytes of encoded data
+ * @param writer Writer
+ * @param bytes Bytes needed
+ * @return 1 if successful, 0 if failed
+ */
+static int telemetry_reserve(telemetry_writer_t* writer, size_t bytes) {
+    chip_telemetry_t* store = writer->store;
+    if (store->size + bytes <= store->capacity) return 1;
+
+    size_t capacity = store->capacity != 0 ? store->capacity : 4096;
+    while (capacity < store->size + bytes) capacity *= 2;
+    uint8_t* data = realloc(store->data, capacity);
+    if (data == NULL) {
+        writer->failed = true;
+        return 0;
+    }
+    store->data = data;
+    store->capacity = capacity;
+    return 1;
+}
+
+/**
+ * Append up to 56 bits
+ * @param writer Writer
+ * @param value Bits, right-aligned
+ * @param bits Number of bits (1-56)
+ */
+static inline void telemetry_put(telemetry_writer_t* writer, uint64_t value, int bits) {
+    if (!telemetry_reserve(writer, 8)) return;
+
+    writer->acc = (writer->acc << bits) | (value & ((1ull << bits) - 1));
+    writer->bits += bits;
+    chip_telemetry_t* store = writer->store;
+    while (writer->bits >= 8) {
+        writer->bits -= 8;
+        store->data[store->size++] = (uint8_t)(writer->acc >> writer->bits);
+    }
+}
+
+/**
+ * Append a full 64-bit value
+ * @param writer Writer
+ * @param value Value
+ */
+static inline void telemetry_put64(telemetry_writer_t* writer, uint64_t value) {
+    telemetry_put(writer, value >> 32, 32);
+    telemetry_put(writer, value & 0xFFFFFFFFu, 32);
+}
+
+/**
+ * Pad the last byte of a column with zero bits
+ * @param writer Writer
+ */
+static void telemetry_finish(telemetry_writer_t* writer) {
+    if (writer->bits > 0) telemetry_put(writer, 0, 8 - writer->bits);
+    writer->acc = 0;
+}
+
+/**
+ * Read up to 56 bits (zeros past the end of the column)
+ * @param reader Reader
+ * @param bits Number of bits (1-56)
+ * @return Bits, right-aligned
+ */
+static inline uint64_t telemetry_get(telemetry_reader_t* reader, int bits) {
+    while (reader->bits < bits) {
+        reader->acc = (reader->acc << 8) | (reader->pos < reader->size ? reader->data[reader->pos++] : 0);
+        reader->bits += 8;
+    }
+    reader->bits -= bits;
+    return (reader->acc >> reader->bits) & ((1ull << bits) - 1);
+}
+
+/**
+ * Read a full 64-bit value
+ * @param reader Reader
+ * @return Value
+ */
+static inline uint64_t telemetry_get64(telemetry_reader_t* reader) {
+    uint64_t high = telemetry_get(reader, 32);
+    return (high << 32) | telemetry_get(reader, 32);
+}
+
+/**
+ * Sign-extend an n-bit two's complement value
+ * @param value Bits, right-aligned
+ * @param bits Width (< 64)
+ * @return Signed value
+ */
+static inline int64_t telemetry_sign_extend(uint64_t value, int bits) {
+    uint64_t sign = 1ull << (bits - 1);
+    return (int64_t)((value ^ sign) - sign);
+}
+
+/**
+ * Encode timestamps as delta-of-delta with Gorilla's variable-size buckets
+ * Samples on a steady period cost one bit each.
+ * @param writer Writer
+ * @param samples Samples of the block
+ * @param count Number of samples (> 0)
+ */
+static void encode_timestamp_column(telemetry_writer_t* writer, const chip_sample_t* samples, size_t count) {
+    uint64_t previous = samples[0].timestamp_ns;
+    uint64_t previous_delta = 0;
+    telemetry_put64(writer, previous);
+
+    for (size_t i = 1; i < count; i++) {
+        uint64_t delta = samples[i].timestamp_ns - previous;
+        int64_t dod = (int64_t)(delta - previous_delta);
+        previous = samples[i].timestamp_ns;
+        previous_delta = delta;
+
+        if (dod == 0) {
+            telemetry_put(writer, 0x0, 1);
+        } else if (dod >= -64 && dod <= 63) {
+            telemetry_put(writer, 0x2, 2);
+            telemetry_put(writer, (uint64_t)dod, 7);
+        } else if (dod >= -256 && dod <= 255) {
+            telemetry_put(writer, 0x6, 3);
+            telemetry_put(writer, (uint64_t)dod, 9);
+        } else if (dod >= -2048 && dod <= 2047) {
+            telemetry_put(writer, 0xE, 4);
+            telemetry_put(writer, (uint64_t)dod, 12);
+        } else if (dod >= INT32_MIN && dod <= INT32_MAX) {
+            telemetry_put(writer, 0x1E, 5);
+            telemetry_put(writer, (uint64_t)dod, 32);
+        } else {
+            telemetry_put(writer, 0x1F, 5);
+            telemetry_put64(writer, (uint64_t)dod);
+        }
+    }
+}
+
+/**
+ * Decode a timestamp column
+ * @param reader Reader over the column
+ * @param samples Receives timestamp_ns of each sample
+ * @param count Number of samples
+ */
+static void decode_timestamp_column(telemetry_reader_t* reader, chip_sample_t* samples, size_t count) {
+    uint64_t previous = telemetry_get64(reader);
+    uint64_t previous_delta = 0;
+    samples[0].timestamp_ns = previous;
+
+    for (size_t i = 1; i < count; i++) {
+        int64_t dod;
+        if (telemetry_get(reader, 1) == 0) {
+            dod = 0;
+        } else if (telemetry_get(reader, 1) == 0) {
+            dod = telemetry_sign_extend(telemetry_get(reader, 7), 7);
+        } else if (telemetry_get(reader, 1) == 0) {
+            dod = telemetry_sign_extend(telemetry_get(reader, 9), 9);
+        } else if (telemetry_get(reader, 1) == 0) {
+            dod = telemetry_sign_extend(telemetry_get(reader, 12), 12);
+        } else if (telemetry_get(reader, 1) == 0) {
+            dod = telemetry_sign_extend(telemetry_get(reader, 32), 32);
+        } else {
+            dod = (int64_t)telemetry_get64(reader);
+        }
+        previous_delta += (uint64_t)dod;
+        previous += previous_delta;
+        samples[i].timestamp_ns = previous;
+    }
+}
+
+/**
+ * Read the raw bits of one float metric of a sample
+ * @param sample Sample
+ * @param column TELEMETRY_COLUMN_TEMPERATURE or TELEMETRY_COLUMN_VOLTAGE
+ * @return IEEE-754 bits
+ */
+static inline uint32_t telemetry_float_bits(const chip_sample_t* sample, int column) {
+    uint32_t bits;
+    memcpy(&bits, column == TELEMETRY_COLUMN_VOLTAGE ? &sample->voltage : &sample->temperature, sizeof(bits));
+    return bits;
+}
+
+/**
+ * Encode a float column: XOR with the previous value, then store only the
+ * meaningful bits between the leading and trailing zeros (Gorilla)
+ * @param writer Writer
+ * @param samples Samples of the block
+ * @param count Number of samples (> 0)
+ * @param column TELEMETRY_COLUMN_TEMPERATURE or TELEMETRY_COLUMN_VOLTAGE
+ */
+static void encode_float_column(telemetry_writer_t* writer, const chip_sample_t* samples, size_t count, int column) {
+    uint32_t previous = telemetry_float_bits(&samples[0], column);
+    int window_leading = -1;            // No window until the first non-zero XOR
+    int window_trailing = 0;
+    telemetry_put(writer, previous, 32);
+
+    for (size_t i = 1; i < count; i++) {
+        uint32_t bits = telemetry_float_bits(&samples[i], column);
+        uint32_t x = bits ^ previous;
+        previous = bits;
+
+        if (x == 0) {
+            telemetry_put(writer, 0x0, 1);
+            continue;
+        }
+
+        int leading = __builtin_clz(x);
+        int trailing = __builtin_ctz(x);
+        if (window_leading >= 0 && leading >= window_leading && trailing >= window_trailing) {
+            // Fits the previous window: reuse its size
+            telemetry_put(writer, 0x2, 2);
+            telemetry_put(writer, x >> window_trailing, 32 - window_leading - window_trailing);
+        } else {
+            int meaningful = 32 - leading - trailing;
+            telemetry_put(writer, 0x3, 2);
+            telemetry_put(writer, (uint64_t)leading, 5);
+            telemetry_put(writer, (uint64_t)(meaningful - 1), 5);
+            telemetry_put(writer, x >> trailing, meaningful);
+            window_leading = leading;
+            window_trailing = trailing;
+        }
+    }
+}
+
+/**
+ * Decode a float column
+ * @param reader Reader over the column
+ * @param samples Receives the metric of each sample
+ * @param count Number of samples
+ * @param column TELEMETRY_COLUMN_TEMPERATURE or TELEMETRY_COLUMN_VOLTAGE
+ */
+static void decode_float_column(telemetry_reader_t* reader, chip_sample_t* samples, size_t count, int column) {
+    uint32_t value = (uint32_t)telemetry_get(reader, 32);
+    int window_leading = 0;
+    int window_trailing = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        if (i > 0 && telemetry_get(reader, 1) != 0) {
+            if (telemetry_get(reader, 1) != 0) {
+                window_leading = (int)telemetry_get(reader, 5);
+                int meaningful = (int)telemetry_get(reader, 5) + 1;
+                window_trailing = 32 - window_leading - meaningful;
+            }
+            int meaningful = 32 - window_leading - window_trailing;
+            value ^= (uint32_t)telemetry_get(reader, meaningful) << window_trailing;
+        }
+        memcpy(column == TELEMETRY_COLUMN_VOLTAGE ? &samples[i].voltage : &samples[i].temperature,
+               &value, sizeof(value));
+    }
+}
+
+/**
+ * Encode the register words: a bit for "no change", otherwise a mask of the
+ * changed words and the XOR of each as a varint
+ * @param writer Writer
+ * @param samples Samples of the block
+ * @param count Number of samples
+ */
+static void encode_register_column(telemetry_writer_t* writer, const chip_sample_t* samples, size_t count) {
+    uint32_t previous[4] = { 0, 0, 0, 0 };
+
+    for (size_t i = 0; i < count; i++) {
+        const register_set_t* regs = &samples[i].registers;
+        uint32_t words[4] = { regs->control_register, regs->status_register,
+                              regs->error_register, regs->config_register };
+        uint32_t x[4];
+        unsigned mask = 0;
+        for (int w = 0; w < 4; w++) {
+            x[w] = words[w] ^ previous[w];
+            previous[w] = words[w];
+            if (x[w] != 0) mask |= 1u << w;
+        }
+
+        if (mask == 0) {
+            telemetry_put(writer, 0x0, 1);
+            continue;
+        }
+        telemetry_put(writer, 0x1, 1);
+        telemetry_put(writer, mask, 4);
+        for (int w = 0; w < 4; w++) {
+            if (x[w] == 0) continue;
+            uint32_t v = x[w];
+            while (v >= 0x80) {
+                telemetry_put(writer, 0x80 | (v & 0x7F), 8);
+                v >>= 7;
+            }
+            telemetry_put(writer, v, 8);
+        }
+    }
+}
+
+/**
+ * Decode a register column
+ * @param reader Reader over the column
+ * @param samples Receives the registers of each sample
+ * @param count Number of samples
+ */
+static void decode_register_column(telemetry_reader_t* reader, chip_sample_t* samples, size_t count) {
+    uint32_t words[4] = { 0, 0, 0, 0 };
+
+    for (size_t i = 0; i < count; i++) {
+        if (telemetry_get(reader, 1) != 0) {
+            unsigned mask = (unsigned)telemetry_get(reader, 4);
+            for (int w = 0; w < 4; w++) {
+                if ((mask & (1u << w)) == 0) continue;
+                uint32_t v = 0;
+                for (int shift = 0; shift < 35; shift += 7) {
+                    uint32_t byte = (uint32_t)telemetry_get(reader, 8);
+                    v |= (byte & 0x7F) << shift;
+                    if ((byte & 0x80) == 0) break;
+                }
+                words[w] ^= v;
+            }
+        }
+        samples[i].registers.control_register = words[0];
+        samples[i].registers.status_register = words[1];
+        samples[i].registers.error_register = words[2];
+        samples[i].registers.config_register = words[3];
+    }
+}
+
+/**
+ * Create a compressed telemetry store for one sample stream
+ * @param block_samples Samples per block (0 = default); smaller blocks seek
+ *                      faster, larger blocks compress slightly better
+ * @return Store or NULL if failed
+ */
+chip_telemetry_t* create_chip_telemetry(size_t block_samples) {
+    if (block_samples == 0) block_samples = CHIP_TELEMETRY_DEFAULT_BLOCK_SAMPLES;
+    if (block_samples > CHIP_TELEMETRY_MAX_BLOCK_SAMPLES) {
+        printf("Error: Telemetry block of %zu samples too large\n", block_samples);
+        return NULL;
+    }
+
+    chip_telemetry_t* store = calloc(1, sizeof(chip_telemetry_t));
+    if (store == NULL) {
+        printf("Error: Failed to allocate telemetry store\n");
+        return NULL;
+    }
+    store->block_samples = block_samples;
+    store->open = malloc(block_samples * sizeof(chip_sample_t));
+    if (store->open == NULL) {
+        printf("Error: Failed to allocate telemetry buffers\n");
+        destroy_chip_telemetry(store);
+        return NULL;
+    }
+    return store;
+}
+
+/**
+ * Destroy a telemetry store
+ * @param store Store to destroy
+ */
+void destroy_chip_telemetry(chip_telemetry_t* store) {
+    if (store == NULL) return;
+
+    free(store->data);
+    free(store->blocks);
+    free(store->open);
+    free(store);
+}
+
+/**
+ * Discard the oldest sealed blocks beyond the retention limit
+ * @param store Store to trim
+ */
+static void chip_telemetry_enforce_retention(chip_telemetry_t* store) {
+    if (store->max_blocks == 0 || store->block_count <= store->max_blocks) return;
+
+    size_t drop = store->block_count - store->max_blocks;
+    for (size_t b = 0; b < drop; b++) {
+        store->total -= store->blocks[b].count;
+        store->dropped += store->blocks[b].count;
+        for (int column = 0; column < CHIP_TELEMETRY_COLUMNS; column++) {
+            store->column_bytes[column] -= store->blocks[b].column_bytes[column];
+        }
+    }
+
+    size_t shift = store->blocks[drop].offset;
+    memmove(store->data, store->data + shift, store->size - shift);
+    store->size -= shift;
+    memmove(store->blocks, store->blocks + drop, store->max_blocks * sizeof(chip_telemetry_block_t));
+    store->block_count = store->max_blocks;
+    for (size_t b = 0; b < store->block_count; b++) {
+        store->blocks[b].offset -= shift;
+    }
+}
+
+/**
+ * Drop every sample but keep the allocated buffers
+ * @param store Store to clear
+ */
+void chip_telemetry_reset(chip_telemetry_t* store) {
+    if (store == NULL) return;
+
+    store->size = 0;
+    store->block_count = 0;
+    store->open_count = 0;
+    store->total = 0;
+    store->dropped = 0;
+    memset(store->column_bytes, 0, sizeof(store->column_bytes));
+}
+
+/**
+ * Bound the store to its newest sealed blocks; older ones are discarded
+ * as new blocks are sealed
+ * @param store Store to configure
+ * @param max_blocks Sealed blocks to keep (0 = keep everything)
+ * @return 1 if successful, 0 if failed
+ */
+int chip_telemetry_set_retention(chip_telemetry_t* store, size_t max_blocks) {
+    if (store == NULL) {
+        printf("Error: Invalid telemetry store\n");
+        return 0;
+    }
+
+    store->max_blocks = max_blocks;
+    chip_telemetry_enforce_retention(store);
+    return 1;
+}
+
+/**
+ * Encode the open block and add it to the block index
+ * @param store Store to seal
+ * @return 1 if successful (or nothing to seal), 0 if failed
+ */
+int chip_telemetry_flush(chip_telemetry_t* store) {
+    if (store == NULL) return 0;
+    if (store->open_count == 0) return 1;
+
+    if (store->block_count == store->block_capacity) {
+        size_t capacity = store->block_capacity != 0 ? store->block_capacity * 2 : 16;
+        chip_telemetry_block_t* blocks = realloc(store->blocks, capacity * sizeof(chip_telemetry_block_t));
+        if (blocks == NULL) {
+            printf("Error: Failed to grow telemetry block index\n");
+            return 0;
+        }
+        store->blocks = blocks;
+        store->block_capacity = capacity;
+    }
+
+    chip_telemetry_block_t* block = &store->blocks[store->block_count];
+    const chip_sample_t* samples = store->open;
+    size_t count = store->open_count;
+    block->first_ns = samples[0].timestamp_ns;
+    block->last_ns = samples[count - 1].timestamp_ns;
+    block->offset = store->size;
+    block->count = (uint32_t)count;
+
+    telemetry_writer_t writer = { store, 0, 0, false };
+    for (int column = 0; column < CHIP_TELEMETRY_COLUMNS; column++) {
+        size_t start = store->size;
+        switch (column) {
+        case TELEMETRY_COLUMN_TIMESTAMP:
+            encode_timestamp_column(&writer, samples, count);
+            break;
+        case TELEMETRY_COLUMN_REGISTERS:
+            encode_register_column(&writer, samples, count);
+            break;
+        default:
+            encode_float_column(&writer, samples, count, column);
+            break;
+        }
+        telemetry_finish(&writer);
+        block->column_bytes[column] = (uint32_t)(store->size - start);
+    }
+    if (writer.failed) {
+        printf("Error: Failed to grow telemetry storage\n");
+        store->size = block->offset;
+        return 0;
+    }
+
+    for (int column = 0; column < CHIP_TELEMETRY_COLUMNS; column++) {
+        store->column_bytes[column] += block->column_bytes[column];
+    }
+    store->block_count++;
+    store->open_count = 0;
+    chip_telemetry_enforce_retention(store);
+    return 1;
+}
+
+/**
+ * Append a sample; a full block is encoded and sealed
+ * @param store Store to append to
+ * @param sample Sample (timestamps must not go backwards)
+ * @return 1 if successful, 0 if failed
+ */
+int chip_telemetry_append(chip_telemetry_t* store, const chip_sample_t* sample) {
+    if (store == NULL || sample == NULL) {
+        printf("Error: Invalid parameters for telemetry append\n");
+        return 0;
+    }
+
+    uint64_t newest = store->open_count != 0 ? store->open[store->open_count - 1].timestamp_ns :
+                      store->block_count != 0 ? store->blocks[store->block_count - 1].last_ns : 0;
+    if (store->total != 0 && sample->timestamp_ns < newest) {
+        printf("Error: Telemetry sample older than the newest one\n");
+        return 0;
+    }
+
+    store->open[store->open_count++] = *sample;
+    store->total++;
+    if (store->open_count == store->block_samples && !chip_telemetry_flush(store)) {
+        store->open_count--;
+        store->total--;
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * Decode one sealed block
+ * @param store Store to read
+ * @param index Block number
+ * @param samples Receives the block's samples
+ */
+static void chip_telemetry_decode(const chip_telemetry_t* store, size_t index, chip_sample_t* samples) {
+    const chip_telemetry_block_t* block = &store->blocks[index];
+    const uint8_t* column_data = store->data + block->offset;
+
+    for (int column = 0; column < CHIP_TELEMETRY_COLUMNS; column++) {
+        telemetry_reader_t reader = { column_data, block->column_bytes[column], 0, 0, 0 };
+        switch (column) {
+        case TELEMETRY_COLUMN_TIMESTAMP:
+            decode_timestamp_column(&reader, samples, block->count);
+            break;
+        case TELEMETRY_COLUMN_REGISTERS:
+            decode_register_column(&reader, samples, block->count);
+            break;
+        default:
+            decode_float_column(&reader, samples, block->count, column);
+            break;
+        }
+        column_data += block->column_bytes[column];
+    }
+}
+
+/**
+ * Decode one sealed block
+ * @param store Store to read
+ * @param index Block number (below chip_telemetry_stats().blocks)
+ * @param samples Receives the block's samples (room for the block size)
+ * @return Number of samples, or -1 if the block does not exist
+ */
+long chip_telemetry_decode_block(chip_telemetry_t* store, size_t index, chip_sample_t* samples) {
+    if (store == NULL || samples == NULL || index >= store->block_count) {
+        printf("Error: Invalid telemetry block %zu\n", index);
+        return -1;
+    }
+
+    chip_telemetry_decode(store, index, samples);
+    return (long)store->blocks[index].count;
+}
+
+/**
+ * Find the first sealed block that may hold a time (binary search on the index)
+ * @param store Store to search
+ * @param timestamp_ns Time to find
+ * @return First block whose last sample is at or after the time (block_count if none)
+ */
+static size_t chip_telemetry_find_block(const chip_telemetry_t* store, uint64_t timestamp_ns) {
+    size_t low = 0;
+    size_t high = store->block_count;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (store->blocks[mid].last_ns < timestamp_ns) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+/**
+ * Read the samples taken in a time range; only blocks overlapping it are decoded
+ * Sealed blocks are decoded into a scratch buffer allocated for the call, so
+ * idle stores carry no decode buffer.
+ * @param store Store to read
+ * @param from_ns Start of the range (inclusive)
+ * @param to_ns End of the range (inclusive)
+ * @param samples Receives samples in time order
+ * @param max_samples Room in samples
+ * @return Number of samples written (stops at max_samples), or -1 if failed
+ */
+long chip_telemetry_read_range(chip_telemetry_t* store, uint64_t from_ns, uint64_t to_ns,
+                               chip_sample_t* samples, size_t max_samples) {
+    if (store == NULL || (samples == NULL && max_samples != 0) || from_ns > to_ns) {
+        printf("Error: Invalid parameters for telemetry range read\n");
+        return -1;
+    }
+
+    chip_sample_t* scratch = NULL;
+    size_t written = 0;
+    for (size_t b = chip_telemetry_find_block(store, from_ns);
+         b <= store->block_count && written < max_samples; b++) {
+        const chip_sample_t* block;
+        size_t count;
+        if (b < store->block_count) {
+            if (store->blocks[b].first_ns > to_ns) break;
+            if (scratch == NULL) {
+                scratch = malloc(store->block_samples * sizeof(chip_sample_t));
+                if (scratch == NULL) {
+                    printf("Error: Failed to allocate telemetry decode buffer\n");
+                    return -1;
+                }
+            }
+            chip_telemetry_decode(store, b, scratch);
+            block = scratch;
+            count = store->blocks[b].count;
+        } else {
+            // The open block is still raw
+            block = store->open;
+            count = store->open_count;
+        }
+
+        for (size_t i = 0; i < count && written < max_samples; i++) {
+            if (block[i].timestamp_ns > to_ns) {
+                free(scratch);
+                return (long)written;
+            }
+            if (block[i].timestamp_ns >= from_ns) samples[written++] = block[i];
+        }
+    }
+    free(scratch);
+    return (long)written;
+}
+
+/**
+ * Get a chip's state as of a time: the newest sample at or before it
+ * Seeks through the block index, so at most one block is decoded.
+ * @param store Store to read
+ * @param timestamp_ns Time of interest
+ * @param sample Receives the sample
+ * @return 1 if found, 0 if no sample is that old
+ */
+int chip_telemetry_read_at(chip_telemetry_t* store, uint64_t timestamp_ns, chip_sample_t* sample) {
+    if (store == NULL || sample == NULL) {
+        printf("Error: Invalid parameters for telemetry read\n");
+        return 0;
+    }
+
+    // The open block, then the sealed block at or just before the time
+    if (store->open_count != 0 && store->open[0].timestamp_ns <= timestamp_ns) {
+        size_t i = store->open_count;
+        while (store->open[i - 1].timestamp_ns > timestamp_ns) i--;
+        *sample = store->open[i - 1];
+        return 1;
+    }
+
+    size_t b = chip_telemetry_find_block(store, timestamp_ns);
+    if (b == store->block_count || store->blocks[b].first_ns > timestamp_ns) {
+        if (b == 0) return 0;
+        b--;  // Falls between two blocks: the previous block's last sample
+    }
+
+    chip_sample_t* block = malloc(store->block_samples * sizeof(chip_sample_t));
+    if (block == NULL) {
+        printf("Error: Failed to allocate telemetry decode buffer\n");
+        return 0;
+    }
+    chip_telemetry_decode(store, b, block);
+    size_t i = store->blocks[b].count;
+    while (block[i - 1].timestamp_ns > timestamp_ns) i--;
+    *sample = block[i - 1];
+    free(block);
+    return 1;
+}
+
+/**
+ * Get size and compression statistics
+ * @param store Store to read
+ * @param stats Receives the statistics
+ */
+void chip_telemetry_stats(const chip_telemetry_t* store, chip_telemetry_stats_t* stats) {
+    if (stats == NULL) return;
+    memset(stats, 0, sizeof(*stats));
+    if (store == NULL) return;
+
+    stats->samples = store->total;
+    stats->dropped_samples = store->dropped;
+    stats->blocks = store->block_count;
+    stats->open_samples = store->open_count;
+    stats->encoded_bytes = store->size;
+    stats->index_bytes = store->block_count * sizeof(chip_telemetry_block_t);
+    stats->raw_bytes = (size_t)(store->total - store->open_count) * sizeof(chip_sample_t);
+    for (int column = 0; column < CHIP_TELEMETRY_COLUMNS; column++) {
+        stats->column_bytes[column] = store->column_bytes[column];
+    }
+}
+
+/**
+ * Encode a day of 1 Hz telemetry, then time decoding and random seeks
+ * The samples drift like a real chip: temperature walks in 0.1°C steps,
+ * voltage rarely moves, registers change with the temperature code and on
+ * occasional errors, and a few polls land late.
+ * @param samples Number of samples to encode
+ */
+void benchmark_chip_telemetry(int samples) {
+    printf("\n--- Chip Telemetry Codec (%d samples at 1 Hz) ---\n", samples);
+
+    if (samples <= 0) return;
+
+    chip_sample_t* input = malloc((size_t)samples * sizeof(chip_sample_t));
+    chip_sample_t* output = malloc((size_t)samples * sizeof(chip_sample_t));
+    chip_telemetry_t* store = create_chip_telemetry(0);
+    if (input == NULL || output == NULL || store == NULL) {
+        printf("Failed to allocate benchmark telemetry\n");
+        free(input);
+        free(output);
+        destroy_chip_telemetry(store);
+        return;
+    }
+
+    unsigned int seed = 12345;
+    int temp_tenths = 450;
+    float voltage = 3.30f;
+    uint64_t timestamp = 1000000000ull;
+    for (int i = 0; i < samples; i++) {
+        int r = rand_r(&seed);
+        temp_tenths += (r % 3) - 1;
+        if (temp_tenths < 300) temp_tenths = 300;
+        if (temp_tenths > 900) temp_tenths = 900;
+        if (r % 500 == 0) voltage = voltage > 3.29f ? 3.28f : 3.30f;
+        input[i].timestamp_ns = timestamp + (r % 50 == 0 ? (uint64_t)(r % 4) * 1000000ull : 0);
+        input[i].temperature = (float)temp_tenths / 10.0f;
+        input[i].voltage = voltage;
+        input[i].registers.control_register = 0x00000001;
+        input[i].registers.status_register = 0x80000001 | ((uint32_t)(temp_tenths / 10 + 40) << 8);
+        input[i].registers.error_register = r % 1000 == 0 ? 0x1 : 0x0;
+        input[i].registers.config_register = 0xABCDEF00;
+        timestamp += 1000000000ull;
+    }
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < samples; i++) chip_telemetry_append(store, &input[i]);
+    chip_telemetry_flush(store);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double encode_ms = (end.tv_sec - start.tv_sec) * 1e3 + (end.tv_nsec - start.tv_nsec) / 1e6;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    long decoded = chip_telemetry_read_range(store, 0, UINT64_MAX, output, (size_t)samples);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double decode_ms = (end.tv_sec - start.tv_sec) * 1e3 + (end.tv_nsec - start.tv_nsec) / 1e6;
+    bool exact = decoded == samples && memcmp(input, output, (size_t)samples * sizeof(chip_sample_t)) == 0;
+
+    const int seeks = 10000;
+    chip_sample_t found;
+    uint64_t span = input[samples - 1].timestamp_ns - input[0].timestamp_ns + 1;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < seeks; i++) {
+        uint64_t at = input[0].timestamp_ns + ((uint64_t)rand_r(&seed) * 1000003ull) % span;
+        chip_telemetry_read_at(store, at, &found);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double seek_ms = (end.tv_sec - start.tv_sec) * 1e3 + (end.tv_nsec - start.tv_nsec) / 1e6;
+    __asm__ __volatile__("" : : "r"(&found) : "memory");
+
+    chip_telemetry_stats_t stats;
+    chip_telemetry_stats(store, &stats);
+    size_t stored = stats.encoded_bytes + stats.index_bytes;
+    double raw_mb = stats.raw_bytes / (1024.0 * 1024.0);
+    printf("Raw samples:   %10zu bytes (%zu per sample)\n", stats.raw_bytes, sizeof(chip_sample_t));
+    printf("Compressed:    %10zu bytes (%.2f bytes per sample, %.1fx, %zu blocks)\n",
+           stored, (double)stored / samples, (double)stats.raw_bytes / stored, stats.blocks);
+    printf("Bits per sample: timestamp %.2f, temperature %.2f, voltage %.2f, registers %.2f\n",
+           stats.column_bytes[0] * 8.0 / samples, stats.column_bytes[1] * 8.0 / samples,
+           stats.column_bytes[2] * 8.0 / samples, stats.column_bytes[3] * 8.0 / samples);
+    printf("Encode: %8.3f ms (%.0f MB/s of raw samples)\n", encode_ms, raw_mb / (encode_ms / 1e3));
+    printf("Decode: %8.3f ms (%.0f MB/s), round trip %s\n",
+           decode_ms, raw_mb / (decode_ms / 1e3), exact ? "exact" : "MISMATCH");
+    printf("Random seek: %.2f us per lookup\n", seek_ms * 1e3 / seeks);
+    printf("1000 chips x 1 day at 1 Hz: %.0f MB raw, %.0f MB compressed\n",
+           1000.0 * 86400 * sizeof(chip_sample_t) / (1024.0 * 1024.0),
+           1000.0 * 86400 * ((double)stored / samples) / (1024.0 * 1024.0));
+
+    free(input);
+    free(output);
+    destroy_chip_telemetry(store);
+}
@@ -0,0 +1,495 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "chip_state.h"
+
+// Four levels of 64 slots: level l slots are 64^l ticks wide, so the wheel
+// spans 64^4 ticks (~4.6 hours at 1 ms) before timers need re-cascading
+#define TIMER_WHEEL_LEVELS 4
+#define TIMER_WHEEL_BITS 6
+#define TIMER_WHEEL_SLOTS (1 << TIMER_WHEEL_BITS)
+#define TIMER_WHEEL_MASK (TIMER_WHEEL_SLOTS - 1)
+#define TIMER_WHEEL_SPAN (1ull << (TIMER_WHEEL_LEVELS * TIMER_WHEEL_BITS))
+#define TIMER_NONE (-1)
+
+typedef struct {
+    chip_timer_fn_t fn;
+    void* context;
+    uint64_t data;
+    uint64_t period_ns;
+    uint64_t due_ns;            // Nominal expiry; reschedules add period_ns to it
+    uint64_t due_tick;
+    uint64_t last_fire_ns;      // 0 until the first firing
+    int32_t next;               // Slot list links, or free list link
+    int32_t prev;
+    int16_t level;              // -1 while not in a slot
+    uint8_t slot;
+    bool active;
+} chip_timer_t;
+
+struct chip_timer_wheel {
+    uint64_t tick_ns;
+    uint64_t start_ns;
+    uint64_t current_tick;      // Every tick up to here has fired
+    int32_t slots[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];
+    chip_timer_t* timers;
+    int32_t timer_capacity;
+    int32_t free_head;
+    int32_t firing;             // Timer whose callback is running, or TIMER_NONE
+    uint64_t jitter_state;
+    chip_timer_stats_t stats;
+};
+
+/**
+ * Convert an absolute time to the first tick at or after it
+ * @param wheel Timer wheel
+ * @param time_ns Monotonic time
+ * @return Tick number
+ */
+static inline uint64_t timer_tick_ceil(const chip_timer_wheel_t* wheel, uint64_t time_ns) {
+    if (time_ns <= wheel->start_ns) return 0;
+    return (time_ns - wheel->start_ns + wheel->tick_ns - 1) / wheel->tick_ns;
+}
+
+/**
+ * Link a timer into the slot matching its expiry tick
+ * Overdue timers go on the earliest tick that has not been drained yet, not
+ * into an already drained slot where they would wait a full rotation.
+ * @param wheel Timer wheel
+ * @param id Timer (not in any slot)
+ * @param earliest First tick whose slot will still be drained: current_tick
+ *                 while cascading into it, current_tick + 1 otherwise
+ */
+static void timer_wheel_link(chip_timer_wheel_t* wheel, int32_t id, uint64_t earliest) {
+    chip_timer_t* timer = &wheel->timers[id];
+    uint64_t due = timer->due_tick > earliest ? timer->due_tick : earliest;
+    uint64_t delta = due - wheel->current_tick;
+
+    int level = 0;
+    while (level < TIMER_WHEEL_LEVELS - 1 && delta >= (1ull << (TIMER_WHEEL_BITS * (level + 1)))) {
+        level++;
+    }
+    if (delta >= TIMER_WHEEL_SPAN) {
+        // Beyond the top level: park it where it will be re-cascaded
+        due = wheel->current_tick + TIMER_WHEEL_SPAN - 1;
+    }
+
+    int slot = (int)((due >> (TIMER_WHEEL_BITS * level)) & TIMER_WHEEL_MASK);
+    timer->level = (int16_t)level;
+    timer->slot = (uint8_t)slot;
+    timer->prev = TIMER_NONE;
+    timer->next = wheel->slots[level][slot];
+    if (timer->next != TIMER_NONE) wheel->timers[timer->next].prev = id;
+    wheel->slots[level][slot] = id;
+}
+
+/**
+ * Unlink a timer from its slot
+ * @param wheel Timer wheel
+ * @param id Timer
+ */
+static void timer_wheel_unlink(chip_timer_wheel_t* wheel, int32_t id) {
+    chip_timer_t* timer = &wheel->timers[id];
+    if (timer->level < 0) return;
+
+    if (timer->prev != TIMER_NONE) {
+        wheel->timers[timer->prev].next = timer->next;
+    } else {
+        wheel->slots[timer->level][timer->slot] = timer->next;
+    }
+    if (timer->next != TIMER_NONE) wheel->timers[timer->next].prev = timer->prev;
+    timer->level = -1;
+}
+
+/**
+ * Create a timer wheel
+ * @param tick_ns Tick resolution (0 = 1 ms)
+ * @param start_ns Monotonic time of tick 0
+ * @return Wheel or NULL if failed
+ */
+chip_timer_wheel_t* create_chip_timer_wheel(uint64_t tick_ns, uint64_t start_ns) {
+    chip_timer_wheel_t* wheel = calloc(1, sizeof(chip_timer_wheel_t));
+    if (wheel == NULL) {
+        printf("Error: Failed to allocate timer wheel\n");
+        return NULL;
+    }
+
+    wheel->tick_ns = tick_ns != 0 ? tick_ns : 1000000;
+    wheel->start_ns = start_ns;
+    wheel->free_head = TIMER_NONE;
+    wheel->firing = TIMER_NONE;
+    wheel->jitter_state = 0x9E3779B97F4A7C15ull ^ start_ns;
+    for (int l = 0; l < TIMER_WHEEL_LEVELS; l++) {
+        for (int s = 0; s < TIMER_WHEEL_SLOTS; s++) {
+            wheel->slots[l][s] = TIMER_NONE;
+        }
+    }
+    return wheel;
+}
+
+/**
+ * Destroy a timer wheel and all its timers
+ * @param wheel Wheel to destroy
+ */
+void destroy_chip_timer_wheel(chip_timer_wheel_t* wheel) {
+    if (wheel == NULL) return;
+
+    free(wheel->timers);
+    free(wheel);
+}
+
+/**
+ * Draw a phase offset in [0, jitter_ns] (xorshift64)
+ * @param wheel Timer wheel
+ * @param jitter_ns Largest offset
+ * @return Offset in nanoseconds
+ */
+static uint64_t timer_jitter(chip_timer_wheel_t* wheel, uint64_t jitter_ns) {
+    if (jitter_ns == 0) return 0;
+
+    uint64_t x = wheel->jitter_state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    wheel->jitter_state = x;
+    return x % (jitter_ns + 1);
+}
+
+/**
+ * Add a periodic timer
+ * The first expiry is now + period + a random offset of up to jitter_ns, so
+ * timers added together with the same period are spread out instead of all
+ * firing on the same tick. Later expiries follow at exact period steps.
+ * @param wheel Timer wheel
+ * @param now_ns Current monotonic time
+ * @param period_ns Period (at least one tick)
+ * @param jitter_ns Largest phase offset of the first expiry
+ * @param fn Callback
+ * @param context Passed through to fn
+ * @param data Passed through to fn (e.g. a chip handle)
+ * @return Timer id, or -1 if failed
+ */
+int chip_timer_schedule(chip_timer_wheel_t* wheel, uint64_t now_ns, uint64_t period_ns, uint64_t jitter_ns,
+                        chip_timer_fn_t fn, void* context, uint64_t data) {
+    if (wheel == NULL || fn == NULL || period_ns < wheel->tick_ns) {
+        printf("Error: Invalid parameters for timer schedule\n");
+        return -1;
+    }
+
+    if (wheel->free_head == TIMER_NONE) {
+        if (wheel->timer_capacity > INT32_MAX / 2) {
+            printf("Error: Timer wheel full (%d timers)\n", wheel->timer_capacity);
+            return -1;
+        }
+        int32_t capacity = wheel->timer_capacity != 0 ? wheel->timer_capacity * 2 : 64;
+        chip_timer_t* timers = realloc(wheel->timers, (size_t)capacity * sizeof(chip_timer_t));
+        if (timers == NULL) {
+            printf("Error: Failed to grow timer wheel to %d timers\n", capacity);
+            return -1;
+        }
+        wheel->timers = timers;
+        for (int32_t i = capacity - 1; i >= wheel->timer_capacity; i--) {
+            timers[i].active = false;
+            timers[i].level = -1;
+            timers[i].next = wheel->free_head;
+            wheel->free_head = i;
+        }
+        wheel->timer_capacity = capacity;
+    }
+
+    int32_t id = wheel->free_head;
+    chip_timer_t* timer = &wheel->timers[id];
+    wheel->free_head = timer->next;
+
+    timer->fn = fn;
+    timer->context = context;
+    timer->data = data;
+    timer->period_ns = period_ns;
+    timer->due_ns = now_ns + period_ns + timer_jitter(wheel, jitter_ns);
+    timer->due_tick = timer_tick_ceil(wheel, timer->due_ns);
+    timer->last_fire_ns = 0;
+    timer->active = true;
+    timer_wheel_link(wheel, id, wheel->current_tick + 1);
+    wheel->stats.active_timers++;
+    return id;
+}
+
+/**
+ * Look up an active timer
+ * @param wheel Timer wheel
+ * @param timer_id Timer id
+ * @return Timer or NULL if not active
+ */
+static chip_timer_t* timer_wheel_find(chip_timer_wheel_t* wheel, int timer_id) {
+    if (wheel == NULL || timer_id < 0 || timer_id >= wheel->timer_capacity) return NULL;
+
+    chip_timer_t* timer = &wheel->timers[timer_id];
+    return timer->active ? timer : NULL;
+}
+
+/**
+ * Cancel a timer (safe from inside any timer callback)
+ * @param wheel Timer wheel
+ * @param timer_id Timer id
+ * @return 1 if cancelled, 0 if not active
+ */
+int chip_timer_cancel(chip_timer_wheel_t* wheel, int timer_id) {
+    chip_timer_t* timer = timer_wheel_find(wheel, timer_id);
+    if (timer == NULL) return 0;
+
+    timer_wheel_unlink(wheel, timer_id);
+    timer->active = false;
+    wheel->stats.active_timers--;
+    if (timer_id != wheel->firing) {
+        timer->next = wheel->free_head;
+        wheel->free_head = timer_id;
+    }
+    return 1;
+}
+
+/**
+ * Change a timer's period; the next expiry is one new period after the last,
+ * but no more than one new period from the wheel's current tick, so a chip
+ * switched to fast polling is not left waiting out its old slow period
+ * @param wheel Timer wheel
+ * @param timer_id Timer id
+ * @param period_ns New period (at least one tick)
+ * @return 1 if changed, 0 if failed
+ */
+int chip_timer_set_period(chip_timer_wheel_t* wheel, int timer_id, uint64_t period_ns) {
+    chip_timer_t* timer = timer_wheel_find(wheel, timer_id);
+    if (timer == NULL || period_ns < wheel->tick_ns) return 0;
+
+    // A firing timer is re-linked one (new) period after its current expiry
+    if (timer_id != wheel->firing) {
+        uint64_t latest = wheel->start_ns + wheel->current_tick * wheel->tick_ns + period_ns;
+        timer->due_ns = timer->due_ns - timer->period_ns + period_ns;
+        if (timer->due_ns > latest) timer->due_ns = latest;
+        timer_wheel_unlink(wheel, timer_id);
+        timer->due_tick = timer_tick_ceil(wheel, timer->due_ns);
+        timer_wheel_link(wheel, timer_id, wheel->current_tick + 1);
+    }
+    timer->period_ns = period_ns;
+    return 1;
+}
+
+/**
+ * Re-insert every timer of a higher-level slot at a finer level
+ * @param wheel Timer wheel
+ * @param level Level to cascade
+ * @param slot Slot to cascade
+ */
+static void timer_wheel_cascade(chip_timer_wheel_t* wheel, int level, int slot) {
+    int32_t id = wheel->slots[level][slot];
+    wheel->slots[level][slot] = TIMER_NONE;
+
+    while (id != TIMER_NONE) {
+        int32_t next = wheel->timers[id].next;
+        wheel->timers[id].level = -1;
+        timer_wheel_link(wheel, id, wheel->current_tick);
+        id = next;
+    }
+}
+
+/**
+ * Fire one timer and put it back at its next period
+ * @param wheel Timer wheel
+ * @param id Timer (already unlinked)
+ * @param now_ns Current monotonic time
+ */
+static void timer_wheel_fire(chip_timer_wheel_t* wheel, int32_t id, uint64_t now_ns) {
+    chip_timer_t* timer = &wheel->timers[id];
+    uint64_t lateness = now_ns > timer->due_ns ? now_ns - timer->due_ns : 0;
+
+    wheel->stats.fired++;
+    wheel->stats.total_lateness_ns += lateness;
+    if (lateness > wheel->stats.max_lateness_ns) wheel->stats.max_lateness_ns = lateness;
+    if (timer->last_fire_ns != 0) {
+        uint64_t interval = now_ns - timer->last_fire_ns;
+        uint64_t drift = interval > timer->period_ns ? interval - timer->period_ns : timer->period_ns - interval;
+        if (drift > wheel->stats.max_drift_ns) wheel->stats.max_drift_ns = drift;
+    }
+    timer->last_fire_ns = now_ns;
+
+    wheel->firing = id;
+    timer->fn(timer->context, timer->data);
+    wheel->firing = TIMER_NONE;
+
+    // Cancelled from its own callback: release the slot now
+    timer = &wheel->timers[id];
+    if (!timer->active) {
+        timer->next = wheel->free_head;
+        wheel->free_head = id;
+        return;
+    }
+
+    // Stay on the original phase; periods that already passed are skipped, not replayed
+    timer->due_ns += timer->period_ns;
+    if (timer->due_ns <= now_ns) {
+        uint64_t behind = (now_ns - timer->due_ns) / timer->period_ns + 1;
+        wheel->stats.missed += behind;
+        timer->due_ns += behind * timer->period_ns;
+    }
+    timer->due_tick = timer_tick_ceil(wheel, timer->due_ns);
+    timer_wheel_link(wheel, id, wheel->current_tick + 1);
+}
+
+/**
+ * Advance the wheel to now and fire every timer that came due
+ * Callbacks may schedule, cancel or re-period any timer.
+ * @param wheel Timer wheel
+ * @param now_ns Current monotonic time
+ * @return Number of timers fired
+ */
+size_t chip_timer_wheel_advance(chip_timer_wheel_t* wheel, uint64_t now_ns) {
+    if (wheel == NULL || now_ns < wheel->start_ns) return 0;
+
+    uint64_t target = (now_ns - wheel->start_ns) / wheel->tick_ns;
+    size_t fired = 0;
+
+    while (wheel->current_tick < target) {
+        if (wheel->stats.active_timers == 0) {
+            wheel->current_tick = target;
+            break;
+        }
+        uint64_t tick = ++wheel->current_tick;
+
+        // Entering a new block of a coarser level: spread its timers downward
+        for (int level = 1; level < TIMER_WHEEL_LEVELS; level++) {
+            if ((tick & ((1ull << (TIMER_WHEEL_BITS * level)) - 1)) != 0) break;
+            timer_wheel_cascade(wheel, level, (int)((tick >> (TIMER_WHEEL_BITS * level)) & TIMER_WHEEL_MASK));
+        }
+
+        size_t tick_fires = 0;
+        int32_t* head = &wheel->slots[0][tick & TIMER_WHEEL_MASK];
+        while (*head != TIMER_NONE) {
+            int32_t id = *head;
+            timer_wheel_unlink(wheel, id);
+            timer_wheel_fire(wheel, id, now_ns);
+            tick_fires++;
+        }
+        if (tick_fires > wheel->stats.max_tick_fires) wheel->stats.max_tick_fires = tick_fires;
+        fired += tick_fires;
+    }
+    return fired;
+}
+
+/**
+ * Find how long the wheel can sleep before the next timer may be due
+ * Checks only the first occupied slot of each level (256 slots at most). A
+ * coarse slot counts from the start of its block, so the result may be
+ * early but never late. Linked timers are always due after the current tick,
+ * so overdue ones report the next tick.
+ * @param wheel Timer wheel
+ * @return Monotonic time to advance at next, or UINT64_MAX if no timers
+ */
+uint64_t chip_timer_wheel_next_expiry(const chip_timer_wheel_t* wheel) {
+    if (wheel == NULL || wheel->stats.active_timers == 0) return UINT64_MAX;
+
+    uint64_t earliest = UINT64_MAX;
+    for (int level = 0; level < TIMER_WHEEL_LEVELS; level++) {
+        int shift = TIMER_WHEEL_BITS * level;
+        for (uint64_t k = 1; k <= TIMER_WHEEL_SLOTS; k++) {
+            uint64_t block = (wheel->current_tick >> shift) + k;
+            if (wheel->slots[level][block & TIMER_WHEEL_MASK] != TIMER_NONE) {
+                if ((block << shift) < earliest) earliest = block << shift;
+                break;
+            }
+        }
+    }
+    return wheel->start_ns + earliest * wheel->tick_ns;
+}
+
+/**
+ * Get firing, lateness and drift statistics
+ * @param wheel Timer wheel
+ * @param stats Receives the statistics
+ */
+void chip_timer_wheel_stats(const chip_timer_wheel_t* wheel, chip_timer_stats_t* stats) {
+    if (wheel == NULL || stats == NULL) return;
+    *stats = wheel->stats;
+}
+
+/**
+ * Print the drift and latency report
+ * @param wheel Timer wheel
+ */
+void print_chip_timer_report(const chip_timer_wheel_t* wheel) {
+    if (wheel == NULL) return;
+
+    const chip_timer_stats_t* stats = &wheel->stats;
+    printf("\n=== Monitor Scheduler Report ===\n");
+    printf("Active timers: %d (tick %.3f ms)\n", stats->active_timers, wheel->tick_ns / 1e6);
+    printf("Timers fired: %llu, periods missed: %llu\n",
+           (unsigned long long)stats->fired, (unsigned long long)stats->missed);
+    printf("Latency: mean %.3f ms, max %.3f ms\n",
+           stats->fired != 0 ? (double)stats->total_lateness_ns / stats->fired / 1e6 : 0.0,
+           stats->max_lateness_ns / 1e6);
+    printf("Max period drift: %.3f ms\n", stats->max_drift_ns / 1e6);
+    printf("Largest single-tick burst: %zu timers\n", stats->max_tick_fires);
+}
+
+// Callback of benchmark_chip_timer_wheel: count polls
+static void count_timer_poll(void* context, uint64_t data) {
+    (void)data;
+    (*(uint64_t*)context)++;
+}
+
+/**
+ * Simulate 10 s of monitoring: every chip polled at the hot rate versus
+ * 10% hot chips at 100 ms and idle chips at 1000 ms on the timer wheel
+ * @param timers Number of monitored chips
+ */
+void benchmark_chip_timer_wheel(int timers) {
+    printf("\n--- Monitor Timer Wheel (%d chips, 10 s simulated) ---\n", timers);
+
+    if (timers <= 0) return;
+
+    const uint64_t ms = 1000000ull;
+    const uint64_t duration = 10000 * ms;
+    double elapsed_ms[2] = { 0.0, 0.0 };
+    uint64_t polls[2] = { 0, 0 };
+    chip_timer_stats_t stats[2];
+    memset(stats, 0, sizeof(stats));
+
+    for (int variant = 0; variant < 2; variant++) {
+        chip_timer_wheel_t* wheel = create_chip_timer_wheel(ms, 0);
+        if (wheel == NULL) return;
+
+        // Variant 0: everyone at 100 ms, no spreading; variant 1: tiered periods with jitter
+        for (int i = 0; i < timers; i++) {
+            bool hot = variant == 0 || i % 10 == 0;
+            uint64_t period = hot ? 100 * ms : 1000 * ms;
+            if (chip_timer_schedule(wheel, 0, period, variant == 0 ? 0 : period, count_timer_poll,
+                                    &polls[variant], (uint64_t)i) < 0) {
+                break;
+            }
+        }
+
+        struct timespec start, end;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (uint64_t now = ms; now <= duration; now += ms) {
+            chip_timer_wheel_advance(wheel, now);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        elapsed_ms[variant] = (end.tv_sec - start.tv_sec) * 1e3 + (end.tv_nsec - start.tv_nsec) / 1e6;
+        chip_timer_wheel_stats(wheel, &stats[variant]);
+        destroy_chip_timer_wheel(wheel);
+    }
+
+    printf("Uniform 100 ms:   %9llu polls, %7.2f ms wheel time, worst tick %zu polls\n",
+           (unsigned long long)polls[0], elapsed_ms[0], stats[0].max_tick_fires);
+    printf("Tiered + jitter:  %9llu polls, %7.2f ms wheel time, worst tick %zu polls\n",
+           (unsigned long long)polls[1], elapsed_ms[1], stats[1].max_tick_fires);
+    if (polls[1] != 0) {
+        printf("Polls saved: %.1f%%, wheel cost %.1f ns/poll\n",
+               100.0 * (1.0 - (double)polls[1] / (double)polls[0]),
+               elapsed_ms[1] * 1e6 / (double)polls[1]);
+    }
+}
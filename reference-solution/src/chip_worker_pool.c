@@ -0,0 +1,392 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "chip_state.h"
+
+#define CHIP_WORKER_POOL_MAX_WORKERS 256
+#define CHIP_WORKER_MAX_CHUNKS UINT32_MAX
+
+// Chunks [next, end) still owned by a worker, packed into one word so the
+// owner (taking from the front) and thieves (taking from the back) can
+// claim a chunk with a single compare-and-swap
+typedef struct {
+    uint64_t range;
+} __attribute__((aligned(64))) chip_worker_range_t;
+
+// Per-worker partial aggregate, merged once the pass is over
+typedef struct {
+    chip_monitor_totals_t totals;
+} __attribute__((aligned(64))) chip_worker_totals_t;
+
+struct chip_worker_pool {
+    int workers;                   // Including the calling thread (worker 0)
+    pthread_t* threads;
+    chip_worker_range_t* ranges;
+
+    pthread_mutex_t lock;
+    pthread_cond_t start_cond;
+    pthread_cond_t done_cond;
+    uint64_t job_generation;
+    int running_helpers;           // Helper threads still working on the job
+    bool shutting_down;
+
+    // Current job
+    chip_parallel_fn_t fn;
+    void* context;
+    size_t count;
+    size_t chunk;
+    uint64_t steals;
+};
+
+typedef struct {
+    chip_worker_pool_t* pool;
+    int index;
+} chip_worker_arg_t;
+
+static inline uint64_t pack_range(uint32_t next, uint32_t end) {
+    return ((uint64_t)next << 32) | end;
+}
+
+/**
+ * Claim the next chunk from the front of a worker's own range
+ * @param slot Worker's range
+ * @param chunk_index Receives the chunk
+ * @return true if a chunk was claimed
+ */
+static bool take_own_chunk(chip_worker_range_t* slot, uint32_t* chunk_index) {
+    uint64_t range = __atomic_load_n(&slot->range, __ATOMIC_ACQUIRE);
+    for (;;) {
+        uint32_t next = (uint32_t)(range >> 32);
+        uint32_t end = (uint32_t)range;
+        if (next >= end) return false;
+        if (__atomic_compare_exchange_n(&slot->range, &range, pack_range(next + 1, end), true,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            *chunk_index = next;
+            return true;
+        }
+    }
+}
+
+/**
+ * Steal a chunk from the back of another worker's range
+ * @param slot Victim's range
+ * @param chunk_index Receives the chunk
+ * @return true if a chunk was stolen
+ */
+static bool steal_chunk(chip_worker_range_t* slot, uint32_t* chunk_index) {
+    uint64_t range = __atomic_load_n(&slot->range, __ATOMIC_ACQUIRE);
+    for (;;) {
+        uint32_t next = (uint32_t)(range >> 32);
+        uint32_t end = (uint32_t)range;
+        if (next >= end) return false;
+        if (__atomic_compare_exchange_n(&slot->range, &range, pack_range(next, end - 1), true,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            *chunk_index = end - 1;
+            return true;
+        }
+    }
+}
+
+/**
+ * Run chunks of the current job until every range is empty
+ * The chunk set is fixed when the job starts, so once a full sweep over the
+ * victims finds nothing, no work can appear again.
+ * @param pool Pool running the job
+ * @param worker Index of the calling worker
+ */
+static void run_worker_chunks(chip_worker_pool_t* pool, int worker) {
+    uint32_t chunk_index;
+    uint64_t steals = 0;
+
+    for (;;) {
+        bool found = take_own_chunk(&pool->ranges[worker], &chunk_index);
+        for (int v = 1; !found && v < pool->workers; v++) {
+            found = steal_chunk(&pool->ranges[(worker + v) % pool->workers], &chunk_index);
+            if (found) steals++;
+        }
+        if (!found) break;
+
+        size_t begin = (size_t)chunk_index * pool->chunk;
+        size_t end = begin + pool->chunk < pool->count ? begin + pool->chunk : pool->count;
+        pool->fn(pool->context, begin, end, worker);
+    }
+
+    if (steals != 0) __atomic_add_fetch(&pool->steals, steals, __ATOMIC_RELAXED);
+}
+
+/**
+ * Helper thread: wait for a job, work on it, report completion
+ * @param arg chip_worker_arg_t (freed here)
+ * @return NULL
+ */
+static void* chip_worker_main(void* arg) {
+    chip_worker_arg_t* worker_arg = (chip_worker_arg_t*)arg;
+    chip_worker_pool_t* pool = worker_arg->pool;
+    int index = worker_arg->index;
+    free(worker_arg);
+
+    // Generation 0 is the pool's state at creation; a job published before
+    // this thread first takes the lock must still be picked up
+    uint64_t seen = 0;
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        while (pool->job_generation == seen && !pool->shutting_down) {
+            pthread_cond_wait(&pool->start_cond, &pool->lock);
+        }
+        if (pool->shutting_down) break;
+        seen = pool->job_generation;
+        pthread_mutex_unlock(&pool->lock);
+
+        run_worker_chunks(pool, index);
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->running_helpers == 0) {
+            pthread_cond_signal(&pool->done_cond);
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+/**
+ * Create a work-stealing pool; the calling thread acts as worker 0
+ * @param workers Total workers including the caller (0 = online CPUs)
+ * @return Pool or NULL if failed
+ */
+chip_worker_pool_t* create_chip_worker_pool(int workers) {
+    if (workers <= 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        workers = online > 0 ? (int)online : 1;
+    }
+    if (workers > CHIP_WORKER_POOL_MAX_WORKERS) {
+        printf("Error: Worker count %d exceeds limit of %d\n", workers, CHIP_WORKER_POOL_MAX_WORKERS);
+        return NULL;
+    }
+
+    chip_worker_pool_t* pool = calloc(1, sizeof(chip_worker_pool_t));
+    chip_worker_range_t* ranges = NULL;
+    pthread_t* threads = malloc((size_t)workers * sizeof(pthread_t));
+    if (posix_memalign((void**)&ranges, 64, (size_t)workers * sizeof(chip_worker_range_t)) != 0) {
+        ranges = NULL;
+    }
+    if (pool == NULL || ranges == NULL || threads == NULL) {
+        printf("Error: Failed to allocate worker pool\n");
+        free(pool);
+        free(ranges);
+        free(threads);
+        return NULL;
+    }
+    memset(ranges, 0, (size_t)workers * sizeof(chip_worker_range_t));
+
+    pool->ranges = ranges;
+    pool->threads = threads;
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->start_cond, NULL);
+    pthread_cond_init(&pool->done_cond, NULL);
+
+    // Worker 0 is whoever calls chip_parallel_for(); helpers are 1..workers-1
+    pool->workers = 1;
+    for (int i = 1; i < workers; i++) {
+        chip_worker_arg_t* arg = malloc(sizeof(chip_worker_arg_t));
+        if (arg == NULL) break;
+        arg->pool = pool;
+        arg->index = i;
+        if (pthread_create(&pool->threads[i], NULL, chip_worker_main, arg) != 0) {
+            free(arg);
+            break;
+        }
+        pool->workers++;
+    }
+    if (pool->workers != workers) {
+        printf("Error: Started %d of %d workers\n", pool->workers, workers);
+        destroy_chip_worker_pool(pool);
+        return NULL;
+    }
+    return pool;
+}
+
+/**
+ * Stop the helper threads and free the pool
+ * @param pool Pool to destroy (must not be running a job)
+ */
+void destroy_chip_worker_pool(chip_worker_pool_t* pool) {
+    if (pool == NULL) return;
+
+    pthread_mutex_lock(&pool->lock);
+    pool->shutting_down = true;
+    pthread_cond_broadcast(&pool->start_cond);
+    pthread_mutex_unlock(&pool->lock);
+    for (int i = 1; i < pool->workers; i++) {
+        pthread_join(pool->threads[i], NULL);
+    }
+
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->start_cond);
+    pthread_cond_destroy(&pool->done_cond);
+    free(pool->threads);
+    free(pool->ranges);
+    free(pool);
+}
+
+/**
+ * Get the number of workers, including the calling thread
+ * @param pool Pool to query
+ * @return Worker count (0 for NULL)
+ */
+int chip_worker_pool_size(const chip_worker_pool_t* pool) {
+    return pool != NULL ? pool->workers : 0;
+}
+
+/**
+ * Get the number of chunks taken from another worker's range so far
+ * @param pool Pool to query
+ * @return Steal count
+ */
+uint64_t chip_worker_pool_steals(const chip_worker_pool_t* pool) {
+    return pool != NULL ? __atomic_load_n(&pool->steals, __ATOMIC_RELAXED) : 0;
+}
+
+/**
+ * Run fn over [0, count) in chunks, spread across the pool; returns when done
+ * Each worker starts with an equal share of contiguous chunks and steals
+ * single chunks from the back of other workers' shares when it runs out.
+ * Not reentrant: one job at a time per pool.
+ * @param pool Pool to run on (NULL runs everything on the calling thread)
+ * @param count Number of items
+ * @param chunk Items per chunk (0 = spread evenly, 8 chunks per worker)
+ * @param fn Called as fn(context, begin, end, worker) for each chunk
+ * @param context Passed through to fn
+ * @return 1 if successful, 0 if failed
+ */
+int chip_parallel_for(chip_worker_pool_t* pool, size_t count, size_t chunk,
+                      chip_parallel_fn_t fn, void* context) {
+    if (fn == NULL) {
+        printf("Error: Invalid parameters for parallel for\n");
+        return 0;
+    }
+    if (count == 0) return 1;
+    if (pool == NULL || pool->workers == 1) {
+        fn(context, 0, count, 0);
+        return 1;
+    }
+
+    if (chunk == 0) {
+        chunk = (count + (size_t)pool->workers * 8 - 1) / ((size_t)pool->workers * 8);
+    }
+    size_t chunks = (count + chunk - 1) / chunk;
+    if (chunks > CHIP_WORKER_MAX_CHUNKS) {
+        printf("Error: Parallel for with %zu chunks exceeds limit\n", chunks);
+        return 0;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool->fn = fn;
+    pool->context = context;
+    pool->count = count;
+    pool->chunk = chunk;
+    for (int w = 0; w < pool->workers; w++) {
+        uint32_t begin = (uint32_t)(chunks * (size_t)w / (size_t)pool->workers);
+        uint32_t end = (uint32_t)(chunks * (size_t)(w + 1) / (size_t)pool->workers);
+        __atomic_store_n(&pool->ranges[w].range, pack_range(begin, end), __ATOMIC_RELAXED);
+    }
+    pool->running_helpers = pool->workers - 1;
+    pool->job_generation++;
+    pthread_cond_broadcast(&pool->start_cond);
+    pthread_mutex_unlock(&pool->lock);
+
+    run_worker_chunks(pool, 0);
+
+    pthread_mutex_lock(&pool->lock);
+    while (pool->running_helpers > 0) {
+        pthread_cond_wait(&pool->done_cond, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return 1;
+}
+
+// Context of one monitoring pass
+typedef struct {
+    chip_state_t* chips;
+    chip_health_fn_t health_fn;
+    int* health;
+    chip_worker_totals_t* partials;
+} chip_monitor_pass_t;
+
+/**
+ * Monitor one chunk of chips into the worker's partial aggregate
+ * @param context chip_monitor_pass_t
+ * @param begin First chip
+ * @param end One past the last chip
+ * @param worker Worker index
+ */
+static void monitor_chip_chunk(void* context, size_t begin, size_t end, int worker) {
+    chip_monitor_pass_t* pass = (chip_monitor_pass_t*)context;
+    chip_monitor_totals_t local = { 0, 0, 0, 0 };
+
+    for (size_t i = begin; i < end; i++) {
+        int health = pass->health_fn(&pass->chips[i]);
+        if (pass->health != NULL) pass->health[i] = health;
+
+        local.total_health += health;
+        local.chips++;
+        if (health < CHIP_HEALTH_CRITICAL) {
+            local.critical_chips++;
+        } else if (health < CHIP_HEALTH_WARNING) {
+            local.warning_chips++;
+        }
+    }
+
+    chip_monitor_totals_t* partial = &pass->partials[worker].totals;
+    partial->total_health += local.total_health;
+    partial->chips += local.chips;
+    partial->critical_chips += local.critical_chips;
+    partial->warning_chips += local.warning_chips;
+}
+
+/**
+ * Run a health function over every chip in parallel and aggregate the results
+ * Health scores land in health[i] (chip order), so the caller can report in a
+ * deterministic order whatever the scheduling was.
+ * @param pool Worker pool (NULL = calling thread only)
+ * @param chips Dense chip array
+ * @param count Number of chips
+ * @param health_fn Updates/scores one chip; must only touch that chip
+ * @param health Receives per-chip scores (may be NULL)
+ * @param totals Receives merged aggregates
+ * @return 1 if successful, 0 if failed
+ */
+int chip_monitor_pass(chip_worker_pool_t* pool, chip_state_t* chips, size_t count,
+                      chip_health_fn_t health_fn, int* health, chip_monitor_totals_t* totals) {
+    if ((chips == NULL && count != 0) || health_fn == NULL || totals == NULL) {
+        printf("Error: Invalid parameters for monitoring pass\n");
+        return 0;
+    }
+
+    int workers = pool != NULL ? pool->workers : 1;
+    chip_worker_totals_t* partials = NULL;
+    if (posix_memalign((void**)&partials, 64, (size_t)workers * sizeof(chip_worker_totals_t)) != 0) {
+        printf("Error: Failed to allocate monitoring aggregates\n");
+        return 0;
+    }
+    memset(partials, 0, (size_t)workers * sizeof(chip_worker_totals_t));
+
+    chip_monitor_pass_t pass = { chips, health_fn, health, partials };
+    int ok = chip_parallel_for(pool, count, 0, monitor_chip_chunk, &pass);
+
+    memset(totals, 0, sizeof(*totals));
+    for (int w = 0; w < workers; w++) {
+        totals->total_health += partials[w].totals.total_health;
+        totals->chips += partials[w].totals.chips;
+        totals->critical_chips += partials[w].totals.critical_chips;
+        totals->warning_chips += partials[w].totals.warning_chips;
+    }
+    free(partials);
+    return ok;
+}
@@ -1,9 +1,16 @@
+#define _POSIX_C_SOURCE 200809L
+#define _DEFAULT_SOURCE  // MAP_ANONYMOUS
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include <time.h>
+#include <math.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <unistd.h>
 
 // Forward declarations for macros
 void* safe_malloc(size_t size, const char* file, int line);
@@ -13,8 +20,32 @@ void safe_free(void* ptr, const char* file, int line);
 #define SAFE_MALLOC(size) safe_malloc(size, __FILE__, __LINE__)
 #define SAFE_FREE(ptr) do { safe_free(ptr, __FILE__, __LINE__); ptr = NULL; } while(0)
 
-// Maximum number of tracked allocations
-#define MAX_ALLOCATIONS 1000
+// Allocation diagnostics go through chip_log.c so tracked allocation on hot
+// paths can run quiet (levels and CHIP_LOG() must match chip_state.h)
+#define CHIP_LOG_ERROR 0
+#define CHIP_LOG_WARN  1
+#define CHIP_LOG_INFO  2
+#define CHIP_LOG_DEBUG 3
+#ifndef CHIP_LOG_COMPILE_LEVEL
+#define CHIP_LOG_COMPILE_LEVEL CHIP_LOG_DEBUG
+#endif
+extern int g_chip_log_level;
+void chip_log_write(int level, const char* format, ...) __attribute__((format(printf, 2, 3)));
+#define CHIP_LOG(level, ...) do { \
+    if ((level) <= CHIP_LOG_COMPILE_LEVEL && \
+        (level) <= __atomic_load_n(&g_chip_log_level, __ATOMIC_RELAXED)) \
+        chip_log_write((level), __VA_ARGS__); \
+} while (0)
+
+// Initial size of each shard's allocation hash table (power of two, grows on demand)
+#define INITIAL_ALLOCATION_TABLE_SIZE 1024
+
+// Rehash when live + tombstone slots exceed 70% of the table
+#define ALLOCATION_TABLE_MAX_LOAD_PERCENT 70
+
+// Number of independently locked tracker shards (power of two)
+#define MEMORY_TRACKER_SHARDS 64
+#define MEMORY_TRACKER_SHARD_BITS 6
 
 // Memory debugging utilities
 typedef struct {
@@ -26,62 +57,625 @@ typedef struct {
     time_t alloc_time;
     uint32_t magic_header;
     uint32_t magic_footer;
+    double sample_weight;   // Allocations this record stands for when sampling
+    void* guard_base;       // Page mapping in guard-page mode, NULL otherwise
+    size_t guard_size;      // Mapping length including the trailing guard page
 } memory_allocation_t;
 
+// Which allocations get full canary and callsite tracking (must match memory_sampling_mode_t in chip_state.h)
+typedef enum {
+    MEMORY_SAMPLING_ALL = 0,        // Track every allocation
+    MEMORY_SAMPLING_EVERY_N,        // Track 1 in N allocations per thread
+    MEMORY_SAMPLING_POISSON_BYTES   // Track on average once per N allocated bytes
+} memory_sampling_mode_t;
+
+// Snapshot of tracker statistics (must match memory_safety_stats_t in chip_state.h)
+typedef struct {
+    size_t malloc_calls;
+    size_t free_calls;
+    size_t live_allocations;
+    size_t current_bytes;
+    size_t peak_bytes;
+    size_t double_frees;
+    size_t corruptions;
+    size_t unsampled_malloc_calls;
+    size_t unsampled_free_calls;
+    double estimated_live_allocations;
+    double estimated_live_bytes;
+    size_t guard_mapped_bytes;
+    size_t quarantine_bytes;
+} memory_safety_stats_t;
+
 // Magic numbers for corruption detection
 #define MAGIC_HEADER 0xDEADBEEF
 #define MAGIC_FOOTER 0xBEEFDEAD
 #define FREED_MAGIC  0xFEEDFACE
+#define UNSAMPLED_MAGIC 0xFA57A110  // Header of a fast-path (untracked) block
+
+// Fast-path header size: keeps malloc's 16-byte alignment, tag in the last word
+#define UNSAMPLED_HEADER_SIZE 16
+
+// Guard-page mode: slack between the block end and the guard page is filled
+// with this byte (up to alignment - 1 bytes). User pointers get malloc's
+// alignment by default; C99 has no max_align_t, so its alignment is derived
+// from the widest fundamental types.
+#define GUARD_SLACK_BYTE 0xFD
+typedef union {
+    long long ll;
+    long double ld;
+    void* p;
+    void (*fn)(void);
+} guard_max_align_t;
+#define GUARD_DEFAULT_ALIGNMENT __alignof__(guard_max_align_t)
+#define GUARD_MAX_ALIGNMENT 4096
+#define DEFAULT_GUARD_QUARANTINE_BYTES (4 * 1024 * 1024)
+#define GUARD_QUARANTINE_MAX_ENTRIES 4096
+
+// Allocation tracking shard: open-addressing hash table keyed by user pointer.
+// Slot states: empty (ptr == NULL), live (!is_freed), tombstone (is_freed).
+// Tombstones keep the freed pointer so double frees are still detected until
+// the slot is reused or purged by a rehash. Tombstones of guarded blocks
+// (guard_base still set) are pinned while their mapping sits in quarantine.
+typedef struct {
+    pthread_mutex_t lock;
+    memory_allocation_t* table;
+    size_t capacity;
+    size_t used;         // Live + tombstone slots
+    size_t live;
+    size_t quarantined;  // Pinned tombstones of quarantined guarded blocks
+} __attribute__((aligned(64))) allocation_shard_t;
+
+// Per-thread statistics, written only by the owning thread and merged on report
+typedef struct thread_memory_stats {
+    size_t malloc_calls;
+    size_t free_calls;
+    size_t double_frees;
+    size_t corruptions;
+    size_t unsampled_malloc_calls;
+    size_t unsampled_free_calls;
+    struct thread_memory_stats* next;
+} __attribute__((aligned(64))) thread_memory_stats_t;
+
+// Global allocation tracking. A pointer's owning shard is derived from its
+// address, so a free from any thread goes straight to the right shard
+// without reading (possibly already freed) block memory.
+static allocation_shard_t g_shards[MEMORY_TRACKER_SHARDS];
+static pthread_once_t g_tracker_once = PTHREAD_ONCE_INIT;
+static size_t g_total_allocated = 0;      // Atomic
+static size_t g_peak_allocated = 0;       // Atomic
+static int g_allocation_id_counter = 0;   // Atomic
+
+// Statistics: per-thread blocks linked into a registry (never freed, so
+// counts from exited threads are still merged)
+static thread_memory_stats_t* g_thread_stats = NULL;
+static pthread_mutex_t g_thread_stats_lock = PTHREAD_MUTEX_INITIALIZER;
+static __thread thread_memory_stats_t* tl_stats = NULL;
+static int g_leak_count = 0;
 
-// Global allocation tracking
-static memory_allocation_t g_allocations[MAX_ALLOCATIONS];
-static int g_allocation_count = 0;
-static size_t g_total_allocated = 0;
-static size_t g_peak_allocated = 0;
-static int g_allocation_id_counter = 0;
+// Per-call MALLOC/FREE trace lines (errors are always reported)
+static bool g_trace_allocations = true;
 
-// Statistics
-static int g_malloc_calls = 0;
-static int g_free_calls = 0;
-static int g_leak_count = 0;
-static int g_double_free_count = 0;
-static int g_corruption_count = 0;
+// Sampling configuration. Threads re-seed their sampler when the generation changes.
+static memory_sampling_mode_t g_sampling_mode = MEMORY_SAMPLING_ALL;
+static size_t g_sampling_parameter = 1;
+static unsigned int g_sampling_generation = 0;
+static bool g_fast_path_used = false;  // Set once any unsampled block exists
+
+// Guard-page mode: tracked blocks end against a PROT_NONE page and freed
+// mappings stay PROT_NONE in a FIFO quarantine before being unmapped
+typedef struct {
+    void* base;
+    size_t size;
+    void* user_ptr;     // Key of the pinned tombstone to release on unmap
+} guard_mapping_t;
+
+static bool g_guard_pages_enabled = false;
+static bool g_guard_pages_used = false;     // Set once any guarded block exists
+static size_t g_guard_alignment = GUARD_DEFAULT_ALIGNMENT;  // 1 = byte-exact fit
+static size_t g_page_size = 0;
+static size_t g_guard_mapped_bytes = 0;     // Atomic; live guarded mappings
+static pthread_mutex_t g_quarantine_lock = PTHREAD_MUTEX_INITIALIZER;
+static guard_mapping_t g_quarantine[GUARD_QUARANTINE_MAX_ENTRIES];
+static size_t g_quarantine_head = 0;
+static size_t g_quarantine_count = 0;
+static size_t g_quarantine_bytes = 0;
+static size_t g_quarantine_limit = DEFAULT_GUARD_QUARANTINE_BYTES;
+
+// Per-thread sampler state
+static __thread unsigned int tl_sampling_generation = 0;
+static __thread size_t tl_sample_countdown = 0;
+static __thread double tl_bytes_until_sample = 0.0;
+static __thread uint64_t tl_sampler_rng = 0;
+
+/**
+ * One-time initialization of the shard locks
+ */
+static void init_tracker_shards(void) {
+    for (int i = 0; i < MEMORY_TRACKER_SHARDS; i++) {
+        pthread_mutex_init(&g_shards[i].lock, NULL);
+        g_shards[i].table = NULL;
+        g_shards[i].capacity = 0;
+        g_shards[i].used = 0;
+        g_shards[i].live = 0;
+        g_shards[i].quarantined = 0;
+    }
+}
+
+/**
+ * Get (and on first use register) the calling thread's statistics block
+ * @return Statistics block or NULL if out of memory
+ */
+static thread_memory_stats_t* get_thread_stats(void) {
+    if (tl_stats != NULL) return tl_stats;
+
+    thread_memory_stats_t* stats = calloc(1, sizeof(thread_memory_stats_t));
+    if (stats == NULL) return NULL;
+
+    pthread_mutex_lock(&g_thread_stats_lock);
+    stats->next = g_thread_stats;
+    g_thread_stats = stats;
+    pthread_mutex_unlock(&g_thread_stats_lock);
+
+    tl_stats = stats;
+    return stats;
+}
+
+// Owner-only increment; readers use relaxed atomic loads when merging
+#define STAT_ADD(field, amount) do { \
+        thread_memory_stats_t* s_ = get_thread_stats(); \
+        if (s_ != NULL) { \
+            __atomic_store_n(&s_->field, __atomic_load_n(&s_->field, __ATOMIC_RELAXED) + (amount), \
+                             __ATOMIC_RELAXED); \
+        } \
+    } while (0)
+
+/**
+ * Lock every shard in index order for a consistent global view
+ */
+static void lock_all_shards(void) {
+    pthread_once(&g_tracker_once, init_tracker_shards);
+    for (int i = 0; i < MEMORY_TRACKER_SHARDS; i++) {
+        pthread_mutex_lock(&g_shards[i].lock);
+    }
+}
+
+/**
+ * Release all shard locks taken by lock_all_shards()
+ */
+static void unlock_all_shards(void) {
+    for (int i = MEMORY_TRACKER_SHARDS - 1; i >= 0; i--) {
+        pthread_mutex_unlock(&g_shards[i].lock);
+    }
+}
 
 /**
  * Initialize memory safety system
+ * Must not race with concurrent safe_malloc()/safe_free() calls.
  */
 void init_memory_safety(void) {
     printf("=== Initializing Memory Safety System ===\n");
 
-    memset(g_allocations, 0, sizeof(g_allocations));
-    g_allocation_count = 0;
-    g_total_allocated = 0;
-    g_peak_allocated = 0;
-    g_allocation_id_counter = 0;
-
-    g_malloc_calls = 0;
-    g_free_calls = 0;
+    lock_all_shards();
+    for (int i = 0; i < MEMORY_TRACKER_SHARDS; i++) {
+        free(g_shards[i].table);
+        g_shards[i].table = NULL;
+        g_shards[i].capacity = 0;
+        g_shards[i].used = 0;
+        g_shards[i].live = 0;
+        g_shards[i].quarantined = 0;
+    }
+    unlock_all_shards();
+
+    __atomic_store_n(&g_total_allocated, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&g_peak_allocated, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&g_allocation_id_counter, 0, __ATOMIC_RELAXED);
+
+    pthread_mutex_lock(&g_thread_stats_lock);
+    for (thread_memory_stats_t* s = g_thread_stats; s != NULL; s = s->next) {
+        __atomic_store_n(&s->malloc_calls, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&s->free_calls, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&s->double_frees, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&s->corruptions, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&s->unsampled_malloc_calls, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&s->unsampled_free_calls, 0, __ATOMIC_RELAXED);
+    }
+    pthread_mutex_unlock(&g_thread_stats_lock);
     g_leak_count = 0;
-    g_double_free_count = 0;
-    g_corruption_count = 0;
 
     printf("Memory safety system initialized\n");
 }
 
 /**
- * Find allocation record by pointer
+ * Enable or disable the per-call MALLOC/FREE trace lines
+ * @param enabled true to print every allocation and free
+ */
+void set_memory_safety_tracing(bool enabled) {
+    g_trace_allocations = enabled;
+}
+
+/**
+ * Select which allocations get full tracking
+ * Blocks allocated under an earlier mode are still freed correctly.
+ * @param mode Sampling mode
+ * @param parameter N for MEMORY_SAMPLING_EVERY_N, mean bytes between samples
+ *                  for MEMORY_SAMPLING_POISSON_BYTES, ignored for MEMORY_SAMPLING_ALL
+ * @return 1 if successful, 0 if invalid
+ */
+int set_memory_sampling(memory_sampling_mode_t mode, size_t parameter) {
+    if ((int)mode < 0 || mode > MEMORY_SAMPLING_POISSON_BYTES) {
+        printf("ERROR: Invalid memory sampling mode %d\n", (int)mode);
+        return 0;
+    }
+    if (mode != MEMORY_SAMPLING_ALL && parameter == 0) {
+        printf("ERROR: Memory sampling parameter must be non-zero\n");
+        return 0;
+    }
+
+    __atomic_store_n(&g_sampling_parameter, mode == MEMORY_SAMPLING_ALL ? 1 : parameter,
+                     __ATOMIC_RELAXED);
+    __atomic_store_n(&g_sampling_mode, mode, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&g_sampling_generation, 1, __ATOMIC_RELEASE);
+    return 1;
+}
+
+/**
+ * Get the current sampling mode
+ * @param parameter Receives the mode parameter (may be NULL)
+ * @return Current sampling mode
+ */
+memory_sampling_mode_t get_memory_sampling(size_t* parameter) {
+    if (parameter != NULL) {
+        *parameter = __atomic_load_n(&g_sampling_parameter, __ATOMIC_RELAXED);
+    }
+    return __atomic_load_n(&g_sampling_mode, __ATOMIC_RELAXED);
+}
+
+/**
+ * Per-thread xorshift64 generator for the sampler
+ * @return Next pseudo-random value
+ */
+static inline uint64_t sampler_next_random(void) {
+    uint64_t x = tl_sampler_rng;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    tl_sampler_rng = x;
+    return x;
+}
+
+/**
+ * Draw the byte distance to the next sample (exponential with the given mean)
+ * @param mean_bytes Mean bytes between samples
+ * @return Bytes until the next sampled allocation
+ */
+static double sampler_next_interval(size_t mean_bytes) {
+    // 53 random bits -> uniform in (0, 1]
+    double u = ((double)(sampler_next_random() >> 11) + 1.0) * (1.0 / 9007199254740992.0);
+    return -log(u) * (double)mean_bytes;
+}
+
+/**
+ * Decide whether an allocation gets full tracking
+ * @param size Requested size
+ * @param weight Receives how many allocations a sampled record stands for
+ * @return true to track, false to take the fast path
+ */
+static inline bool should_sample_allocation(size_t size, double* weight) {
+    memory_sampling_mode_t mode = __atomic_load_n(&g_sampling_mode, __ATOMIC_RELAXED);
+    if (mode == MEMORY_SAMPLING_ALL) {
+        *weight = 1.0;
+        return true;
+    }
+
+    size_t parameter = __atomic_load_n(&g_sampling_parameter, __ATOMIC_RELAXED);
+    unsigned int generation = __atomic_load_n(&g_sampling_generation, __ATOMIC_ACQUIRE);
+    if (tl_sampling_generation != generation) {
+        // (Re)seed this thread and start at a random phase so threads do not sample in lockstep
+        tl_sampling_generation = generation;
+        tl_sampler_rng = ((uint64_t)(uintptr_t)&tl_sampler_rng ^ (uint64_t)time(NULL) ^
+                          ((uint64_t)generation << 32)) | 1;
+        tl_sample_countdown = (size_t)(sampler_next_random() % parameter) + 1;
+        tl_bytes_until_sample = sampler_next_interval(parameter);
+    }
+
+    if (mode == MEMORY_SAMPLING_EVERY_N) {
+        if (--tl_sample_countdown != 0) return false;
+        tl_sample_countdown = parameter;
+        *weight = (double)parameter;
+        return true;
+    }
+
+    // Poisson byte sampling: P(sample) = 1 - exp(-size / mean), weight = 1 / P
+    tl_bytes_until_sample -= (double)size;
+    if (tl_bytes_until_sample > 0.0) return false;
+
+    tl_bytes_until_sample = sampler_next_interval(parameter);
+    double probability = -expm1(-(double)size / (double)parameter);
+    *weight = probability > 0.0 ? 1.0 / probability : 1.0;
+    return true;
+}
+
+/**
+ * Hash a user pointer into the allocation table
+ * @param ptr Pointer to hash
+ * @return Mixed 64-bit hash
+ */
+static inline uint64_t hash_pointer(const void* ptr) {
+    uint64_t h = (uint64_t)(uintptr_t)ptr;
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    return h;
+}
+
+/**
+ * Find the shard that owns a pointer (high hash bits; low bits index the table)
+ * @param ptr User pointer
+ * @return Owning shard
+ */
+static inline allocation_shard_t* shard_for_pointer(const void* ptr) {
+    pthread_once(&g_tracker_once, init_tracker_shards);
+    return &g_shards[hash_pointer(ptr) >> (64 - MEMORY_TRACKER_SHARD_BITS)];
+}
+
+/**
+ * Find allocation record by pointer (caller holds the shard lock)
+ * @param shard Shard owning ptr
  * @param ptr Pointer to find
- * @return Index of allocation or -1 if not found
+ * @return Live or freed record for ptr, or NULL if not found
+ */
+static memory_allocation_t* find_allocation(allocation_shard_t* shard, void* ptr) {
+    if (ptr == NULL || shard->table == NULL) return NULL;
+
+    size_t mask = shard->capacity - 1;
+    for (size_t i = hash_pointer(ptr) & mask; ; i = (i + 1) & mask) {
+        memory_allocation_t* slot = &shard->table[i];
+        if (slot->ptr == NULL) return NULL;
+        if (slot->ptr == ptr) return slot;
+    }
+}
+
+/**
+ * Rebuild a shard's table with only live and pinned records (caller holds the shard lock)
+ * @param shard Shard to rehash
+ * @param new_capacity New table size (power of two)
+ * @return 1 if successful, 0 if out of memory
+ */
+static int rehash_allocation_table(allocation_shard_t* shard, size_t new_capacity) {
+    memory_allocation_t* new_table = calloc(new_capacity, sizeof(memory_allocation_t));
+    if (new_table == NULL) {
+        CHIP_LOG(CHIP_LOG_ERROR, "ERROR: Failed to grow allocation table to %zu entries\n", new_capacity);
+        return 0;
+    }
+
+    size_t mask = new_capacity - 1;
+    for (size_t i = 0; i < shard->capacity; i++) {
+        memory_allocation_t* old = &shard->table[i];
+        if (old->ptr == NULL || (old->is_freed && old->guard_base == NULL)) continue;
+
+        size_t j = hash_pointer(old->ptr) & mask;
+        while (new_table[j].ptr != NULL) {
+            j = (j + 1) & mask;
+        }
+        new_table[j] = *old;
+    }
+
+    free(shard->table);
+    shard->table = new_table;
+    shard->capacity = new_capacity;
+    shard->used = shard->live + shard->quarantined;
+    return 1;
+}
+
+/**
+ * Claim a table slot for a new allocation (caller holds the shard lock)
+ * Reuses the tombstone left by an earlier free of the same address, or the
+ * first tombstone on the probe path; grows the table when it gets too full.
+ * @param shard Shard owning ptr
+ * @param ptr User pointer being recorded
+ * @return Slot to fill in, or NULL if out of memory
  */
-static int find_allocation(void* ptr) {
-    if (ptr == NULL) return -1;
+static memory_allocation_t* insert_allocation(allocation_shard_t* shard, void* ptr) {
+    if (shard->table == NULL) {
+        shard->table = calloc(INITIAL_ALLOCATION_TABLE_SIZE, sizeof(memory_allocation_t));
+        if (shard->table == NULL) return NULL;
+        shard->capacity = INITIAL_ALLOCATION_TABLE_SIZE;
+    }
+
+    if ((shard->used + 1) * 100 > shard->capacity * ALLOCATION_TABLE_MAX_LOAD_PERCENT) {
+        // Grow so kept records stay under half the table; otherwise just purge tombstones
+        size_t new_capacity = shard->capacity;
+        while ((shard->live + shard->quarantined + 1) * 2 > new_capacity) {
+            new_capacity *= 2;
+        }
+        if (!rehash_allocation_table(shard, new_capacity)) return NULL;
+    }
 
-    for (int i = 0; i < g_allocation_count; i++) {
-        if (g_allocations[i].ptr == ptr) {
-            return i;
+    size_t mask = shard->capacity - 1;
+    memory_allocation_t* tombstone = NULL;
+    for (size_t i = hash_pointer(ptr) & mask; ; i = (i + 1) & mask) {
+        memory_allocation_t* slot = &shard->table[i];
+        if (slot->ptr == ptr) {
+            return slot;  // Address reused after free
+        }
+        if (slot->ptr == NULL) {
+            if (tombstone != NULL) return tombstone;
+            shard->used++;
+            return slot;
+        }
+        if (slot->is_freed && slot->guard_base == NULL && tombstone == NULL) {
+            tombstone = slot;
         }
     }
-    return -1;
+}
+
+/**
+ * Unmap a quarantined mapping and unpin its tombstone so the slot can be reused
+ * Lock order is g_quarantine_lock before a shard lock; safe_free never holds
+ * a shard lock while taking the quarantine lock.
+ * @param mapping Quarantined mapping
+ */
+static void unmap_quarantined(const guard_mapping_t* mapping) {
+    munmap(mapping->base, mapping->size);
+
+    allocation_shard_t* shard = shard_for_pointer(mapping->user_ptr);
+    pthread_mutex_lock(&shard->lock);
+    memory_allocation_t* alloc = find_allocation(shard, mapping->user_ptr);
+    if (alloc != NULL && alloc->is_freed && alloc->guard_base == mapping->base) {
+        alloc->guard_base = NULL;
+        shard->quarantined--;
+    }
+    pthread_mutex_unlock(&shard->lock);
+}
+
+/**
+ * Find the quarantined mapping containing an address (caller holds g_quarantine_lock)
+ * @param addr Address to look up
+ * @return Quarantined mapping, or NULL if addr is not quarantined
+ */
+static const guard_mapping_t* find_quarantined(const void* addr) {
+    uintptr_t a = (uintptr_t)addr;
+    for (size_t i = 0; i < g_quarantine_count; i++) {
+        const guard_mapping_t* m = &g_quarantine[(g_quarantine_head + i) % GUARD_QUARANTINE_MAX_ENTRIES];
+        if (a >= (uintptr_t)m->base && a - (uintptr_t)m->base < m->size) return m;
+    }
+    return NULL;
+}
+
+/**
+ * Unmap the oldest quarantined mappings until within limits (caller holds g_quarantine_lock)
+ * @param byte_limit Maximum quarantined bytes to keep
+ * @param entry_limit Maximum quarantined mappings to keep
+ */
+static void evict_quarantine(size_t byte_limit, size_t entry_limit) {
+    while (g_quarantine_count > 0 &&
+           (g_quarantine_bytes > byte_limit || g_quarantine_count > entry_limit)) {
+        guard_mapping_t* oldest = &g_quarantine[g_quarantine_head];
+        unmap_quarantined(oldest);
+        g_quarantine_bytes -= oldest->size;
+        g_quarantine_head = (g_quarantine_head + 1) % GUARD_QUARANTINE_MAX_ENTRIES;
+        g_quarantine_count--;
+    }
+}
+
+/**
+ * Enable or disable guard-page mode for tracked allocations
+ * Each tracked block is placed so that it ends against a PROT_NONE page (up to
+ * set_memory_guard_alignment() - 1 bytes of checked slack in between), and
+ * freed blocks are kept PROT_NONE in a bounded quarantine, so overflows and
+ * use-after-free fault at the offending access. Disabling releases the quarantine.
+ * Combine with set_memory_sampling() to guard only a sample of allocations.
+ * @param enabled true to place new tracked blocks on guarded pages
+ * @param quarantine_bytes Quarantine size limit (0 for the default)
+ * @return 1 if successful, 0 if page size is unavailable
+ */
+int set_memory_guard_pages(bool enabled, size_t quarantine_bytes) {
+    if (g_page_size == 0) {
+        long page = sysconf(_SC_PAGESIZE);
+        if (page <= 0) {
+            CHIP_LOG(CHIP_LOG_ERROR, "ERROR: Cannot determine page size for guard pages\n");
+            return 0;
+        }
+        g_page_size = (size_t)page;
+    }
+
+    pthread_mutex_lock(&g_quarantine_lock);
+    g_quarantine_limit = quarantine_bytes != 0 ? quarantine_bytes : DEFAULT_GUARD_QUARANTINE_BYTES;
+    evict_quarantine(enabled ? g_quarantine_limit : 0, enabled ? GUARD_QUARANTINE_MAX_ENTRIES : 0);
+    pthread_mutex_unlock(&g_quarantine_lock);
+
+    __atomic_store_n(&g_guard_pages_enabled, enabled, __ATOMIC_RELEASE);
+    return 1;
+}
+
+/**
+ * Set the user-pointer alignment of new guarded blocks
+ * The default is malloc's alignment, which leaves up to alignment - 1 bytes of
+ * slack before the guard page (overflows into it are caught on free). Pass 1
+ * to opt into byte-exact placement, where the first overflowing byte faults
+ * but pointers may be unaligned.
+ * @param alignment Power of two up to 4096, or 0 for the default
+ * @return 1 if successful, 0 if invalid
+ */
+int set_memory_guard_alignment(size_t alignment) {
+    if (alignment == 0) alignment = GUARD_DEFAULT_ALIGNMENT;
+    if (alignment > GUARD_MAX_ALIGNMENT || (alignment & (alignment - 1)) != 0) {
+        printf("ERROR: Guard alignment must be a power of two up to %d, got %zu\n",
+               GUARD_MAX_ALIGNMENT, alignment);
+        return 0;
+    }
+    __atomic_store_n(&g_guard_alignment, alignment, __ATOMIC_RELAXED);
+    return 1;
+}
+
+/**
+ * Check whether guard-page mode is active
+ * @return true if new tracked blocks get guard pages
+ */
+bool memory_guard_pages_enabled(void) {
+    return __atomic_load_n(&g_guard_pages_enabled, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * Map pages for a guarded block: data pages followed by one PROT_NONE page
+ * @param size Requested user size
+ * @param base Receives the mapping base
+ * @param mapping_size Receives the mapping length
+ * @return User pointer (aligned per set_memory_guard_alignment(), ending within
+ *         alignment - 1 bytes of the guard page) or NULL
+ */
+static void* guarded_block_alloc(size_t size, void** base, size_t* mapping_size) {
+    size_t page = g_page_size;
+    size_t alignment = __atomic_load_n(&g_guard_alignment, __ATOMIC_RELAXED);
+    // Room for the header magic and up to alignment - 1 bytes of slack
+    size_t data_bytes = (size + sizeof(uint32_t) + alignment - 1 + page - 1) / page * page;
+    size_t total = data_bytes + page;
+
+    char* mapping = mmap(NULL, total, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED) return NULL;
+
+    if (mprotect(mapping + data_bytes, page, PROT_NONE) != 0) {
+        munmap(mapping, total);
+        return NULL;
+    }
+
+    char* guard = mapping + data_bytes;
+    char* user_ptr = (char*)((uintptr_t)(guard - size) & ~(uintptr_t)(alignment - 1));
+
+    // The header may be unaligned in byte-exact mode
+    uint32_t header = MAGIC_HEADER;
+    memcpy(user_ptr - sizeof(uint32_t), &header, sizeof(header));
+    memset(user_ptr + size, GUARD_SLACK_BYTE, (size_t)(guard - (user_ptr + size)));
+
+    *base = mapping;
+    *mapping_size = total;
+    __atomic_add_fetch(&g_guard_mapped_bytes, total, __ATOMIC_RELAXED);
+    return user_ptr;
+}
+
+/**
+ * Make a freed guarded block inaccessible and move it into the quarantine
+ * @param user_ptr User pointer of the freed block (its tombstone is pinned)
+ * @param base Mapping base
+ * @param mapping_size Mapping length
+ */
+static void guarded_block_release(void* user_ptr, void* base, size_t mapping_size) {
+    mprotect(base, mapping_size, PROT_NONE);
+    __atomic_sub_fetch(&g_guard_mapped_bytes, mapping_size, __ATOMIC_RELAXED);
+
+    guard_mapping_t mapping = { base, mapping_size, user_ptr };
+    pthread_mutex_lock(&g_quarantine_lock);
+    if (g_quarantine_limit == 0) {
+        unmap_quarantined(&mapping);
+    } else {
+        evict_quarantine(g_quarantine_limit > mapping_size ? g_quarantine_limit - mapping_size : 0,
+                         GUARD_QUARANTINE_MAX_ENTRIES - 1);
+        size_t tail = (g_quarantine_head + g_quarantine_count) % GUARD_QUARANTINE_MAX_ENTRIES;
+        g_quarantine[tail] = mapping;
+        g_quarantine_count++;
+        g_quarantine_bytes += mapping_size;
+    }
+    pthread_mutex_unlock(&g_quarantine_lock);
 }
 
 /**
@@ -92,27 +686,58 @@ static int find_allocation(void* ptr) {
 static int check_corruption(memory_allocation_t* alloc) {
     if (alloc == NULL || alloc->ptr == NULL) return 1;
 
-    // Check header magic
-    uint32_t* header = (uint32_t*)((char*)alloc->ptr - sizeof(uint32_t));
-    if (*header != MAGIC_HEADER) {
-        printf("CORRUPTION: Header magic corrupted at %p (expected 0x%08X, got 0x%08X)\n",
-               alloc->ptr, MAGIC_HEADER, *header);
+    // Check header magic (unaligned for byte-exact guarded blocks)
+    uint32_t header;
+    memcpy(&header, (char*)alloc->ptr - sizeof(uint32_t), sizeof(header));
+    if (header != MAGIC_HEADER) {
+        CHIP_LOG(CHIP_LOG_ERROR, "CORRUPTION: Header magic corrupted at %p (expected 0x%08X, got 0x%08X)\n",
+                 alloc->ptr, MAGIC_HEADER, header);
         return 1;
     }
 
+    // Guarded blocks: the guard page traps overflows, only the alignment slack is checked
+    if (alloc->guard_base != NULL) {
+        const uint8_t* slack = (const uint8_t*)alloc->ptr + alloc->size;
+        const uint8_t* guard = (const uint8_t*)alloc->guard_base + alloc->guard_size - g_page_size;
+        for (; slack < guard; slack++) {
+            if (*slack != GUARD_SLACK_BYTE) {
+                CHIP_LOG(CHIP_LOG_ERROR, "CORRUPTION: Overflow into guard slack at %p (block %p)\n",
+                         (const void*)slack, alloc->ptr);
+                return 1;
+            }
+        }
+        return 0;
+    }
+
     // Check footer magic
     uint32_t* footer = (uint32_t*)((char*)alloc->ptr + alloc->size);
     if (*footer != MAGIC_FOOTER) {
-        printf("CORRUPTION: Footer magic corrupted at %p (expected 0x%08X, got 0x%08X)\n",
-               alloc->ptr, MAGIC_FOOTER, *footer);
+        CHIP_LOG(CHIP_LOG_ERROR, "CORRUPTION: Footer magic corrupted at %p (expected 0x%08X, got 0x%08X)\n",
+                 alloc->ptr, MAGIC_FOOTER, *footer);
         return 1;
     }
 
     return 0;
 }
 
+/**
+ * Add to the global byte counter and update the peak
+ * @param size Bytes newly allocated
+ */
+static void account_allocated_bytes(size_t size) {
+    size_t total = __atomic_add_fetch(&g_total_allocated, size, __ATOMIC_RELAXED);
+    size_t peak = __atomic_load_n(&g_peak_allocated, __ATOMIC_RELAXED);
+
+    while (total > peak &&
+           !__atomic_compare_exchange_n(&g_peak_allocated, &peak, total, true,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+        // peak reloaded by the failed exchange
+    }
+}
+
 /**
  * Safe malloc with tracking and corruption detection
+ * Thread-safe: only the owning shard is locked.
  * @param size Size to allocate
  * @param file Source file name
  * @param line Source line number
@@ -120,36 +745,78 @@ static int check_corruption(memory_allocation_t* alloc) {
  */
 void* safe_malloc(size_t size, const char* file, int line) {
     if (size == 0) {
-        printf("WARNING: Attempting to allocate 0 bytes at %s:%d\n", file, line);
+        CHIP_LOG(CHIP_LOG_WARN, "WARNING: Attempting to allocate 0 bytes at %s:%d\n", file, line);
         return NULL;
     }
 
-    if (g_allocation_count >= MAX_ALLOCATIONS) {
-        printf("ERROR: Maximum allocations (%d) reached at %s:%d\n",
-               MAX_ALLOCATIONS, file, line);
-        return NULL;
+    double weight = 1.0;
+    if (!should_sample_allocation(size, &weight)) {
+        // Fast path: a header tag only, no canary footer, table entry or trace line
+        char* raw = malloc(size + UNSAMPLED_HEADER_SIZE);
+        if (raw == NULL) {
+            CHIP_LOG(CHIP_LOG_ERROR, "ERROR: malloc failed for %zu bytes at %s:%d\n", size, file, line);
+            return NULL;
+        }
+        void* fast_ptr = raw + UNSAMPLED_HEADER_SIZE;
+        ((uint32_t*)fast_ptr)[-1] = UNSAMPLED_MAGIC;
+        if (!__atomic_load_n(&g_fast_path_used, __ATOMIC_RELAXED)) {
+            __atomic_store_n(&g_fast_path_used, true, __ATOMIC_RELAXED);
+        }
+        STAT_ADD(unsampled_malloc_calls, 1);
+        return fast_ptr;
     }
 
-    // Allocate extra space for magic numbers
-    size_t total_size = size + 2 * sizeof(uint32_t);
-    void* raw_ptr = malloc(total_size);
+    void* raw_ptr = NULL;
+    void* user_ptr = NULL;
+    void* guard_base = NULL;
+    size_t guard_size = 0;
 
-    if (raw_ptr == NULL) {
-        printf("ERROR: malloc failed for %zu bytes at %s:%d\n", size, file, line);
-        return NULL;
-    }
+    if (__atomic_load_n(&g_guard_pages_enabled, __ATOMIC_ACQUIRE)) {
+        user_ptr = guarded_block_alloc(size, &guard_base, &guard_size);
+        if (user_ptr == NULL) {
+            CHIP_LOG(CHIP_LOG_ERROR, "ERROR: guard page mapping failed for %zu bytes at %s:%d\n", size, file, line);
+            return NULL;
+        }
+        if (!__atomic_load_n(&g_guard_pages_used, __ATOMIC_RELAXED)) {
+            __atomic_store_n(&g_guard_pages_used, true, __ATOMIC_RELAXED);
+        }
+    } else {
+        // Allocate extra space for magic numbers
+        size_t total_size = size + 2 * sizeof(uint32_t);
+        raw_ptr = malloc(total_size);
+
+        if (raw_ptr == NULL) {
+            CHIP_LOG(CHIP_LOG_ERROR, "ERROR: malloc failed for %zu bytes at %s:%d\n", size, file, line);
+            return NULL;
+        }
 
-    // Set up magic numbers
-    uint32_t* header = (uint32_t*)raw_ptr;
-    *header = MAGIC_HEADER;
+        // Set up magic numbers
+        uint32_t* header = (uint32_t*)raw_ptr;
+        *header = MAGIC_HEADER;
 
-    void* user_ptr = (char*)raw_ptr + sizeof(uint32_t);
+        user_ptr = (char*)raw_ptr + sizeof(uint32_t);
 
-    uint32_t* footer = (uint32_t*)((char*)user_ptr + size);
-    *footer = MAGIC_FOOTER;
+        uint32_t* footer = (uint32_t*)((char*)user_ptr + size);
+        *footer = MAGIC_FOOTER;
+    }
+
+    // Record allocation in the owning shard
+    allocation_shard_t* shard = shard_for_pointer(user_ptr);
+    pthread_mutex_lock(&shard->lock);
+
+    memory_allocation_t* alloc = insert_allocation(shard, user_ptr);
+    if (alloc == NULL) {
+        pthread_mutex_unlock(&shard->lock);
+        CHIP_LOG(CHIP_LOG_ERROR, "ERROR: Cannot track allocation at %s:%d\n", file, line);
+        if (guard_base != NULL) {
+            munmap(guard_base, guard_size);
+            __atomic_sub_fetch(&g_guard_mapped_bytes, guard_size, __ATOMIC_RELAXED);
+        } else {
+            free(raw_ptr);
+        }
+        return NULL;
+    }
 
-    // Record allocation
-    memory_allocation_t* alloc = &g_allocations[g_allocation_count];
     alloc->ptr = user_ptr;
     alloc->size = size;
     alloc->file = file;
@@ -158,102 +825,247 @@ void* safe_malloc(size_t size, const char* file, int line) {
     alloc->alloc_time = time(NULL);
     alloc->magic_header = MAGIC_HEADER;
     alloc->magic_footer = MAGIC_FOOTER;
+    alloc->sample_weight = weight;
+    alloc->guard_base = guard_base;
+    alloc->guard_size = guard_size;
+    shard->live++;
 
-    g_allocation_count++;
-    g_malloc_calls++;
-    g_total_allocated += size;
+    pthread_mutex_unlock(&shard->lock);
 
-    if (g_total_allocated > g_peak_allocated) {
-        g_peak_allocated = g_total_allocated;
-    }
+    STAT_ADD(malloc_calls, 1);
+    account_allocated_bytes(size);
 
-    printf("MALLOC: %zu bytes at %p (%s:%d) [ID: %d]\n",
-           size, user_ptr, file, line, g_allocation_id_counter++);
+    int id = __atomic_fetch_add(&g_allocation_id_counter, 1, __ATOMIC_RELAXED);
+    if (g_trace_allocations) {
+        CHIP_LOG(CHIP_LOG_INFO, "MALLOC: %zu bytes at %p (%s:%d) [ID: %d]\n",
+                 size, user_ptr, file, line, id);
+    }
 
     return user_ptr;
 }
 
 /**
  * Safe free with tracking and corruption detection
+ * Thread-safe: frees from any thread are routed to the owning shard.
  * @param ptr Pointer to free
  * @param file Source file name
  * @param line Source line number
  */
 void safe_free(void* ptr, const char* file, int line) {
     if (ptr == NULL) {
-        printf("WARNING: Attempting to free NULL pointer at %s:%d\n", file, line);
+        CHIP_LOG(CHIP_LOG_WARN, "WARNING: Attempting to free NULL pointer at %s:%d\n", file, line);
         return;
     }
 
-    int alloc_index = find_allocation(ptr);
-    if (alloc_index == -1) {
-        printf("ERROR: Attempting to free untracked pointer %p at %s:%d\n",
-               ptr, file, line);
-        return;
+    // Fast path for unsampled blocks (only possible once sampling has been enabled).
+    // With guard pages in use the table is consulted first: the tag word of a
+    // quarantined block is PROT_NONE, and a double free must not fault here.
+    // Freed guarded records stay pinned until unmapped, and any other address
+    // is checked against the quarantine before its tag is read.
+    bool fast_path_used = __atomic_load_n(&g_fast_path_used, __ATOMIC_RELAXED);
+    bool tag_first = fast_path_used && !__atomic_load_n(&g_guard_pages_used, __ATOMIC_RELAXED);
+    if (tag_first) {
+        uint32_t* tag = (uint32_t*)ptr - 1;
+        if (*tag == UNSAMPLED_MAGIC) {
+            *tag = FREED_MAGIC;
+            free((char*)ptr - UNSAMPLED_HEADER_SIZE);
+            STAT_ADD(unsampled_free_calls, 1);
+            return;
+        }
     }
 
-    memory_allocation_t* alloc = &g_allocations[alloc_index];
+    allocation_shard_t* shard = shard_for_pointer(ptr);
+    pthread_mutex_lock(&shard->lock);
+
+    memory_allocation_t* alloc = find_allocation(shard, ptr);
+    if (alloc == NULL) {
+        pthread_mutex_unlock(&shard->lock);
+        if (__atomic_load_n(&g_guard_pages_used, __ATOMIC_RELAXED)) {
+            pthread_mutex_lock(&g_quarantine_lock);
+            bool quarantined = find_quarantined(ptr) != NULL;
+            pthread_mutex_unlock(&g_quarantine_lock);
+            if (quarantined) {
+                CHIP_LOG(CHIP_LOG_ERROR, "ERROR: Attempting to free %p inside a freed (quarantined) block at %s:%d\n",
+                         ptr, file, line);
+                STAT_ADD(double_frees, 1);
+                return;
+            }
+        }
+        if (fast_path_used && !tag_first) {
+            uint32_t* tag = (uint32_t*)ptr - 1;
+            if (*tag == UNSAMPLED_MAGIC) {
+                *tag = FREED_MAGIC;
+                free((char*)ptr - UNSAMPLED_HEADER_SIZE);
+                STAT_ADD(unsampled_free_calls, 1);
+                return;
+            }
+        }
+        CHIP_LOG(CHIP_LOG_ERROR, "ERROR: Attempting to free untracked pointer %p at %s:%d\n",
+                 ptr, file, line);
+        return;
+    }
 
     if (alloc->is_freed) {
-        printf("ERROR: Double free detected for pointer %p at %s:%d\n",
-               ptr, file, line);
-        printf("  Originally allocated at %s:%d\n", alloc->file, alloc->line);
-        g_double_free_count++;
+        const char* alloc_file = alloc->file;
+        int alloc_line = alloc->line;
+        pthread_mutex_unlock(&shard->lock);
+
+        CHIP_LOG(CHIP_LOG_ERROR, "ERROR: Double free detected for pointer %p at %s:%d\n",
+                 ptr, file, line);
+        CHIP_LOG(CHIP_LOG_ERROR, "  Originally allocated at %s:%d\n", alloc_file, alloc_line);
+        STAT_ADD(double_frees, 1);
         return;
     }
 
     // Check for corruption before freeing
     if (check_corruption(alloc)) {
-        printf("ERROR: Memory corruption detected before free at %s:%d\n", file, line);
-        printf("  Originally allocated at %s:%d\n", alloc->file, alloc->line);
-        g_corruption_count++;
+        CHIP_LOG(CHIP_LOG_ERROR, "ERROR: Memory corruption detected before free at %s:%d\n", file, line);
+        CHIP_LOG(CHIP_LOG_ERROR, "  Originally allocated at %s:%d\n", alloc->file, alloc->line);
+        STAT_ADD(corruptions, 1);
+        if (alloc->sample_weight > 1.0) {
+            CHIP_LOG(CHIP_LOG_ERROR, "  (sampled allocation, represents ~%.0f allocations)\n", alloc->sample_weight);
+        }
         // Continue with free to avoid leaks, but mark as corrupted
     }
 
-    // Mark as freed
+    // Mark as freed (the slot becomes a tombstone, pinned while a guarded
+    // block is quarantined)
+    size_t size = alloc->size;
+    void* guard_base = alloc->guard_base;
+    size_t guard_size = alloc->guard_size;
     alloc->is_freed = true;
-    g_total_allocated -= alloc->size;
-    g_free_calls++;
+    shard->live--;
+    if (guard_base != NULL) {
+        shard->quarantined++;
+    }
 
     // Fill freed memory with pattern to detect use-after-free
-    memset(ptr, 0xDD, alloc->size);
+    // (guarded blocks become PROT_NONE instead)
+    if (guard_base == NULL) {
+        memset(ptr, 0xDD, size);
+    }
 
-    // Free the actual memory (including magic numbers)
-    void* raw_ptr = (char*)ptr - sizeof(uint32_t);
-    free(raw_ptr);
+    pthread_mutex_unlock(&shard->lock);
 
-    printf("FREE: %zu bytes at %p (%s:%d)\n", alloc->size, ptr, file, line);
+    __atomic_sub_fetch(&g_total_allocated, size, __ATOMIC_RELAXED);
+    STAT_ADD(free_calls, 1);
+
+    if (guard_base != NULL) {
+        guarded_block_release(ptr, guard_base, guard_size);
+    } else {
+        // Free the actual memory (including magic numbers)
+        void* raw_ptr = (char*)ptr - sizeof(uint32_t);
+        free(raw_ptr);
+    }
+
+    if (g_trace_allocations) {
+        CHIP_LOG(CHIP_LOG_INFO, "FREE: %zu bytes at %p (%s:%d)\n", size, ptr, file, line);
+    }
 }
 
 /**
- * Check for memory leaks
+ * Get a merged snapshot of tracker statistics across all threads and shards
+ * @param stats Output snapshot
  */
-void check_memory_leaks(void) {
-    printf("\n=== Memory Leak Check ===\n");
+void get_memory_safety_stats(memory_safety_stats_t* stats) {
+    if (stats == NULL) return;
+
+    memset(stats, 0, sizeof(*stats));
+
+    pthread_mutex_lock(&g_thread_stats_lock);
+    for (thread_memory_stats_t* s = g_thread_stats; s != NULL; s = s->next) {
+        stats->malloc_calls += __atomic_load_n(&s->malloc_calls, __ATOMIC_RELAXED);
+        stats->free_calls += __atomic_load_n(&s->free_calls, __ATOMIC_RELAXED);
+        stats->double_frees += __atomic_load_n(&s->double_frees, __ATOMIC_RELAXED);
+        stats->corruptions += __atomic_load_n(&s->corruptions, __ATOMIC_RELAXED);
+        stats->unsampled_malloc_calls += __atomic_load_n(&s->unsampled_malloc_calls, __ATOMIC_RELAXED);
+        stats->unsampled_free_calls += __atomic_load_n(&s->unsampled_free_calls, __ATOMIC_RELAXED);
+    }
+    pthread_mutex_unlock(&g_thread_stats_lock);
+
+    lock_all_shards();
+    for (int i = 0; i < MEMORY_TRACKER_SHARDS; i++) {
+        allocation_shard_t* shard = &g_shards[i];
+        stats->live_allocations += shard->live;
+        for (size_t j = 0; j < shard->capacity && shard->live > 0; j++) {
+            memory_allocation_t* alloc = &shard->table[j];
+            if (alloc->ptr != NULL && !alloc->is_freed) {
+                stats->estimated_live_allocations += alloc->sample_weight;
+                stats->estimated_live_bytes += alloc->sample_weight * (double)alloc->size;
+            }
+        }
+    }
+    unlock_all_shards();
 
-    g_leak_count = 0;
-    size_t leaked_bytes = 0;
+    pthread_mutex_lock(&g_quarantine_lock);
+    stats->quarantine_bytes = g_quarantine_bytes;
+    pthread_mutex_unlock(&g_quarantine_lock);
 
-    for (int i = 0; i < g_allocation_count; i++) {
-        memory_allocation_t* alloc = &g_allocations[i];
+    stats->guard_mapped_bytes = __atomic_load_n(&g_guard_mapped_bytes, __ATOMIC_RELAXED);
+    stats->current_bytes = __atomic_load_n(&g_total_allocated, __ATOMIC_RELAXED);
+    stats->peak_bytes = __atomic_load_n(&g_peak_allocated, __ATOMIC_RELAXED);
+}
 
-        if (!alloc->is_freed) {
-            printf("LEAK: %zu bytes at %p allocated at %s:%d\n",
-                   alloc->size, alloc->ptr, alloc->file, alloc->line);
+/**
+ * Get the number of live tracked allocations
+ * @return Allocations made with safe_malloc() and not yet freed
+ */
+size_t get_active_allocation_count(void) {
+    memory_safety_stats_t stats;
+    get_memory_safety_stats(&stats);
+    return stats.live_allocations;
+}
 
-            time_t current_time = time(NULL);
-            double age = difftime(current_time, alloc->alloc_time);
-            printf("  Age: %.0f seconds\n", age);
+/**
+ * Check for memory leaks
+ */
+void check_memory_leaks(void) {
+    printf("\n=== Memory Leak Check ===\n");
 
-            g_leak_count++;
-            leaked_bytes += alloc->size;
+    int leak_count = 0;
+    size_t leaked_bytes = 0;
+    double estimated_leaks = 0.0;
+    double estimated_bytes = 0.0;
+    time_t current_time = time(NULL);
+
+    lock_all_shards();
+    for (int s = 0; s < MEMORY_TRACKER_SHARDS; s++) {
+        for (size_t i = 0; i < g_shards[s].capacity; i++) {
+            memory_allocation_t* alloc = &g_shards[s].table[i];
+
+            if (alloc->ptr != NULL && !alloc->is_freed) {
+                printf("LEAK: %zu bytes at %p allocated at %s:%d\n",
+                       alloc->size, alloc->ptr, alloc->file, alloc->line);
+
+                double age = difftime(current_time, alloc->alloc_time);
+                printf("  Age: %.0f seconds\n", age);
+
+                leak_count++;
+                leaked_bytes += alloc->size;
+                estimated_leaks += alloc->sample_weight;
+                estimated_bytes += alloc->sample_weight * (double)alloc->size;
+            }
         }
     }
+    unlock_all_shards();
+
+    g_leak_count = leak_count;
 
-    if (g_leak_count == 0) {
+    if (leak_count == 0) {
         printf("No memory leaks detected!\n");
     } else {
-        printf("Found %d leaks totaling %zu bytes\n", g_leak_count, leaked_bytes);
+        printf("Found %d leaks totaling %zu bytes\n", leak_count, leaked_bytes);
+        if (estimated_leaks > (double)leak_count) {
+            printf("Sampling active: estimated ~%.0f leaks totaling ~%.0f bytes\n",
+                   estimated_leaks, estimated_bytes);
+        }
+    }
+
+    memory_safety_stats_t stats;
+    get_memory_safety_stats(&stats);
+    if (stats.unsampled_malloc_calls > stats.unsampled_free_calls) {
+        printf("Untracked (unsampled) blocks outstanding: %zu\n",
+               stats.unsampled_malloc_calls - stats.unsampled_free_calls);
     }
 }
 
@@ -263,38 +1075,80 @@ void check_memory_leaks(void) {
 void print_memory_usage_report(void) {
     printf("\n=== Memory Usage Report ===\n");
 
+    memory_safety_stats_t stats;
+    get_memory_safety_stats(&stats);
+
+    size_t table_slots = 0;
+    size_t table_used = 0;
+    lock_all_shards();
+    for (int s = 0; s < MEMORY_TRACKER_SHARDS; s++) {
+        table_slots += g_shards[s].capacity;
+        table_used += g_shards[s].used;
+    }
+    unlock_all_shards();
+
     printf("Allocation Statistics:\n");
-    printf("  Total malloc calls: %d\n", g_malloc_calls);
-    printf("  Total free calls: %d\n", g_free_calls);
-    printf("  Current allocations: %d\n", g_allocation_count - g_free_calls);
-    printf("  Peak memory usage: %zu bytes\n", g_peak_allocated);
-    printf("  Current memory usage: %zu bytes\n", g_total_allocated);
+    printf("  Total malloc calls: %zu\n", stats.malloc_calls);
+    printf("  Total free calls: %zu\n", stats.free_calls);
+    printf("  Current allocations: %zu\n", stats.live_allocations);
+    printf("  Tracking table: %zu slots (%zu in use) across %d shards\n",
+           table_slots, table_used, MEMORY_TRACKER_SHARDS);
+    printf("  Peak memory usage: %zu bytes\n", stats.peak_bytes);
+    printf("  Current memory usage: %zu bytes\n", stats.current_bytes);
+
+    size_t sampling_parameter = 0;
+    memory_sampling_mode_t mode = get_memory_sampling(&sampling_parameter);
+    if (mode != MEMORY_SAMPLING_ALL || stats.unsampled_malloc_calls > 0) {
+        printf("\nSampling:\n");
+        if (mode == MEMORY_SAMPLING_EVERY_N) {
+            printf("  Mode: 1 in %zu allocations\n", sampling_parameter);
+        } else if (mode == MEMORY_SAMPLING_POISSON_BYTES) {
+            printf("  Mode: Poisson, mean %zu bytes between samples\n", sampling_parameter);
+        } else {
+            printf("  Mode: all allocations tracked\n");
+        }
+        printf("  Fast-path mallocs: %zu, frees: %zu\n",
+               stats.unsampled_malloc_calls, stats.unsampled_free_calls);
+        printf("  Estimated live allocations: ~%.0f (~%.0f bytes)\n",
+               stats.estimated_live_allocations, stats.estimated_live_bytes);
+    }
+
+    if (stats.guard_mapped_bytes > 0 || stats.quarantine_bytes > 0) {
+        printf("\nGuard Pages:\n");
+        printf("  Mode: %s\n", memory_guard_pages_enabled() ? "enabled" : "disabled");
+        printf("  Mapped for live blocks: %zu bytes\n", stats.guard_mapped_bytes);
+        printf("  Quarantined (PROT_NONE): %zu bytes\n", stats.quarantine_bytes);
+    }
 
     printf("\nError Statistics:\n");
     printf("  Memory leaks: %d\n", g_leak_count);
-    printf("  Double frees: %d\n", g_double_free_count);
-    printf("  Corruptions: %d\n", g_corruption_count);
+    printf("  Double frees: %zu\n", stats.double_frees);
+    printf("  Corruptions: %zu\n", stats.corruptions);
 
     printf("\nActive Allocations:\n");
     int active_count = 0;
-    for (int i = 0; i < g_allocation_count; i++) {
-        memory_allocation_t* alloc = &g_allocations[i];
-        if (!alloc->is_freed) {
-            printf("  [%d] %zu bytes at %p (%s:%d)\n",
-                   active_count++, alloc->size, alloc->ptr, alloc->file, alloc->line);
+    lock_all_shards();
+    for (int s = 0; s < MEMORY_TRACKER_SHARDS; s++) {
+        for (size_t i = 0; i < g_shards[s].capacity; i++) {
+            memory_allocation_t* alloc = &g_shards[s].table[i];
+            if (alloc->ptr != NULL && !alloc->is_freed) {
+                printf("  [%d] %zu bytes at %p (%s:%d)\n",
+                       active_count++, alloc->size, alloc->ptr, alloc->file, alloc->line);
+            }
         }
     }
+    unlock_all_shards();
 
     if (active_count == 0) {
         printf("  No active allocations\n");
     }
 
     printf("\nMemory Health: ");
-    if (g_leak_count == 0 && g_double_free_count == 0 && g_corruption_count == 0) {
+    if (g_leak_count == 0 && stats.double_frees == 0 && stats.corruptions == 0) {
         printf("EXCELLENT\n");
-    } else if (g_corruption_count == 0 && g_double_free_count == 0) {
+    } else if (stats.corruptions == 0 && stats.double_frees == 0) {
         printf("GOOD (minor leaks)\n");
-    } else if (g_corruption_count == 0) {
+    } else if (stats.corruptions == 0) {
         printf("FAIR (leaks and double frees)\n");
     } else {
         printf("POOR (memory corruption detected)\n");
@@ -309,26 +1163,35 @@ void validate_all_allocations(void) {
 
     int corrupted_count = 0;
     int validated_count = 0;
-
-    for (int i = 0; i < g_allocation_count; i++) {
-        memory_allocation_t* alloc = &g_allocations[i];
-
-        if (!alloc->is_freed) {
-            validated_count++;
-            if (check_corruption(alloc)) {
-                corrupted_count++;
-                printf("CORRUPTION found in allocation at %p (%s:%d)\n",
-                       alloc->ptr, alloc->file, alloc->line);
+    double estimated_corrupted = 0.0;
+
+    lock_all_shards();
+    for (int s = 0; s < MEMORY_TRACKER_SHARDS; s++) {
+        for (size_t i = 0; i < g_shards[s].capacity; i++) {
+            memory_allocation_t* alloc = &g_shards[s].table[i];
+
+            if (alloc->ptr != NULL && !alloc->is_freed) {
+                validated_count++;
+                if (check_corruption(alloc)) {
+                    corrupted_count++;
+                    estimated_corrupted += alloc->sample_weight;
+                    printf("CORRUPTION found in allocation at %p (%s:%d)\n",
+                           alloc->ptr, alloc->file, alloc->line);
+                }
             }
         }
     }
+    unlock_all_shards();
 
     printf("Validated %d allocations\n", validated_count);
     if (corrupted_count == 0) {
         printf("All allocations are intact!\n");
     } else {
         printf("Found %d corrupted allocations\n", corrupted_count);
-        g_corruption_count += corrupted_count;
+        if (estimated_corrupted > (double)corrupted_count) {
+            printf("Sampling active: estimated ~%.0f corrupted allocations\n", estimated_corrupted);
+        }
+        STAT_ADD(corruptions, (size_t)corrupted_count);
     }
 }
 
@@ -341,19 +1204,30 @@ void simulate_corruption(void* ptr) {
 
     printf("Simulating memory corruption at %p\n", ptr);
 
-    int alloc_index = find_allocation(ptr);
-    if (alloc_index == -1) {
+    allocation_shard_t* shard = shard_for_pointer(ptr);
+    pthread_mutex_lock(&shard->lock);
+
+    memory_allocation_t* alloc = find_allocation(shard, ptr);
+    if (alloc == NULL || alloc->is_freed) {
+        pthread_mutex_unlock(&shard->lock);
         printf("Cannot corrupt untracked pointer\n");
         return;
     }
 
-    memory_allocation_t* alloc = &g_allocations[alloc_index];
+    // Guarded blocks have no footer (it would be the guard page): corrupt the header
+    bool guarded = alloc->guard_base != NULL;
+    if (guarded) {
+        uint32_t bad = 0xBADC0DE;
+        memcpy((char*)ptr - sizeof(uint32_t), &bad, sizeof(bad));
+    } else {
+        // Corrupt the footer magic number
+        uint32_t* footer = (uint32_t*)((char*)ptr + alloc->size);
+        *footer = 0xBADC0DE;
+    }
 
-    // Corrupt the footer magic number
-    uint32_t* footer = (uint32_t*)((char*)ptr + alloc->size);
-    *footer = 0xBADC0DE;
+    pthread_mutex_unlock(&shard->lock);
 
-    printf("Corrupted footer magic at %p\n", ptr);
+    printf("Corrupted %s magic at %p\n", guarded ? "header" : "footer", ptr);
 }
 
 /**
@@ -578,5 +1452,372 @@ void stress_test_memory_system(void) {
     check_memory_leaks();
 }
 
+// Per-thread work for benchmark_memory_tracker_scaling()
+#define TRACKER_BENCH_OPS_PER_THREAD 200000
+#define TRACKER_BENCH_LIVE_BLOCKS    256
+
+typedef struct {
+    int thread_index;
+    unsigned int seed;
+    void* blocks[TRACKER_BENCH_LIVE_BLOCKS];
+    void** foreign_blocks;   // Blocks left by another thread, freed here
+    size_t ops;
+} tracker_bench_worker_t;
+
+/**
+ * Benchmark phase 1: random alloc/free churn on a private working set
+ * @param arg Worker state
+ * @return NULL
+ */
+static void* tracker_bench_churn(void* arg) {
+    tracker_bench_worker_t* w = (tracker_bench_worker_t*)arg;
+
+    for (int op = 0; op < TRACKER_BENCH_OPS_PER_THREAD; op++) {
+        w->seed = w->seed * 1103515245u + 12345u;
+        int index = (int)((w->seed >> 16) % TRACKER_BENCH_LIVE_BLOCKS);
+
+        if (w->blocks[index] == NULL) {
+            size_t size = ((w->seed >> 8) & 0xFF) + 1;
+            w->blocks[index] = SAFE_MALLOC(size);
+        } else {
+            SAFE_FREE(w->blocks[index]);
+        }
+        w->ops++;
+    }
+    return NULL;
+}
+
+/**
+ * Benchmark phase 2: free the blocks another thread left behind
+ * @param arg Worker state
+ * @return NULL
+ */
+static void* tracker_bench_cross_free(void* arg) {
+    tracker_bench_worker_t* w = (tracker_bench_worker_t*)arg;
+
+    for (int i = 0; i < TRACKER_BENCH_LIVE_BLOCKS; i++) {
+        if (w->foreign_blocks[i] != NULL) {
+            SAFE_FREE(w->foreign_blocks[i]);
+            w->ops++;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Run one scaling point of the tracker benchmark
+ * @param num_threads Number of worker threads
+ * @param ops_out Total tracked operations performed
+ * @return Wall-clock seconds, or -1.0 on failure
+ */
+static double run_tracker_bench(int num_threads, size_t* ops_out) {
+    tracker_bench_worker_t* workers = calloc((size_t)num_threads, sizeof(tracker_bench_worker_t));
+    pthread_t* threads = calloc((size_t)num_threads, sizeof(pthread_t));
+    if (workers == NULL || threads == NULL) {
+        printf("ERROR: Failed to allocate benchmark workers\n");
+        free(workers);
+        free(threads);
+        return -1.0;
+    }
+
+    for (int t = 0; t < num_threads; t++) {
+        workers[t].thread_index = t;
+        workers[t].seed = 0x9E3779B9u * (unsigned int)(t + 1);
+        workers[t].foreign_blocks = workers[(t + 1) % num_threads].blocks;
+    }
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    int started = 0;
+    for (int t = 0; t < num_threads; t++) {
+        if (pthread_create(&threads[t], NULL, tracker_bench_churn, &workers[t]) != 0) break;
+        started++;
+    }
+    for (int t = 0; t < started; t++) {
+        pthread_join(threads[t], NULL);
+    }
+
+    // Each thread frees its neighbour's surviving blocks
+    int freeing = 0;
+    if (started == num_threads) {
+        for (int t = 0; t < num_threads; t++) {
+            if (pthread_create(&threads[t], NULL, tracker_bench_cross_free, &workers[t]) != 0) break;
+            freeing++;
+        }
+        for (int t = 0; t < freeing; t++) {
+            pthread_join(threads[t], NULL);
+        }
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    // Release anything a failed thread start left behind
+    size_t ops = 0;
+    for (int t = 0; t < num_threads; t++) {
+        for (int i = 0; i < TRACKER_BENCH_LIVE_BLOCKS; i++) {
+            if (workers[t].blocks[i] != NULL) {
+                SAFE_FREE(workers[t].blocks[i]);
+            }
+        }
+        ops += workers[t].ops;
+    }
+
+    free(workers);
+    free(threads);
+
+    if (started != num_threads || freeing != num_threads) {
+        printf("ERROR: Failed to start %d benchmark threads\n", num_threads);
+        return -1.0;
+    }
+
+    *ops_out = ops;
+    return (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+/**
+ * Benchmark tracker throughput as the number of allocating threads grows
+ * Each point runs random churn per thread followed by cross-thread frees.
+ * Per-call tracing is disabled for the run so stdout does not serialize threads.
+ * @param max_threads Largest thread count to measure (1, 2, 4, ... up to this)
+ */
+void benchmark_memory_tracker_scaling(int max_threads) {
+    printf("\n=== Memory Tracker Scaling Benchmark ===\n");
+
+    if (max_threads < 1) {
+        printf("ERROR: Invalid thread count %d\n", max_threads);
+        return;
+    }
+
+    bool saved_tracing = g_trace_allocations;
+    set_memory_safety_tracing(false);
+
+    printf("%d shards, %d ops/thread, %d live blocks/thread\n",
+           MEMORY_TRACKER_SHARDS, TRACKER_BENCH_OPS_PER_THREAD, TRACKER_BENCH_LIVE_BLOCKS);
+    printf("%8s %12s %14s %10s\n", "Threads", "Time (ms)", "Ops/sec", "Speedup");
+
+    double base_rate = 0.0;
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        size_t ops = 0;
+        double seconds = run_tracker_bench(threads, &ops);
+        if (seconds < 0.0) break;
+
+        double rate = seconds > 0.0 ? (double)ops / seconds : 0.0;
+        if (threads == 1) base_rate = rate;
+
+        printf("%8d %12.2f %14.0f %9.2fx\n", threads, seconds * 1000.0, rate,
+               base_rate > 0.0 ? rate / base_rate : 0.0);
+    }
+
+    set_memory_safety_tracing(saved_tracing);
+
+    printf("Live allocations after benchmark: %zu\n", get_active_allocation_count());
+}
+
+// Working set for benchmark_memory_sampling_overhead()
+#define SAMPLING_BENCH_LIVE_BLOCKS 1024
+
+/**
+ * Run the sampling benchmark workload: allocate, touch and free blocks in a ring
+ * @param iterations Allocations to perform
+ * @param tracked true to use SAFE_MALLOC/SAFE_FREE, false for plain malloc/free
+ * @return Wall-clock seconds
+ */
+static double run_sampling_bench(int iterations, bool tracked) {
+    void* ring[SAMPLING_BENCH_LIVE_BLOCKS] = {0};
+    uint32_t seed = 12345;
+    volatile uint8_t sink = 0;
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (int i = 0; i < iterations; i++) {
+        int slot = i % SAMPLING_BENCH_LIVE_BLOCKS;
+        if (ring[slot] != NULL) {
+            if (tracked) {
+                SAFE_FREE(ring[slot]);
+            } else {
+                free(ring[slot]);
+            }
+        }
+
+        seed = seed * 1103515245u + 12345u;
+        size_t size = 16 + ((seed >> 16) & 0xFF);
+        ring[slot] = tracked ? SAFE_MALLOC(size) : malloc(size);
+        if (ring[slot] != NULL) {
+            memset(ring[slot], (int)(i & 0xFF), size);
+            sink ^= ((uint8_t*)ring[slot])[size - 1];
+        }
+    }
+
+    for (int i = 0; i < SAMPLING_BENCH_LIVE_BLOCKS; i++) {
+        if (ring[i] == NULL) continue;
+        if (tracked) {
+            SAFE_FREE(ring[i]);
+        } else {
+            free(ring[i]);
+        }
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    (void)sink;
+    return (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+/**
+ * Benchmark SAFE_MALLOC overhead against plain malloc for each sampling mode
+ * Reports the extra time per allocation and the allocation rate a core can
+ * sustain while keeping tracking within a 2% CPU budget.
+ * @param iterations Allocations per measurement
+ */
+void benchmark_memory_sampling_overhead(int iterations) {
+    printf("\n=== Memory Sampling Overhead Benchmark ===\n");
+
+    if (iterations <= 0) {
+        printf("ERROR: Invalid iteration count %d\n", iterations);
+        return;
+    }
+
+    static const struct {
+        memory_sampling_mode_t mode;
+        size_t parameter;
+        const char* name;
+    } configs[] = {
+        { MEMORY_SAMPLING_ALL, 1, "Track all" },
+        { MEMORY_SAMPLING_EVERY_N, 100, "1 in 100" },
+        { MEMORY_SAMPLING_EVERY_N, 1000, "1 in 1000" },
+        { MEMORY_SAMPLING_POISSON_BYTES, 64 * 1024, "Poisson 64 KiB" },
+        { MEMORY_SAMPLING_POISSON_BYTES, 512 * 1024, "Poisson 512 KiB" },
+    };
+
+    bool saved_tracing = g_trace_allocations;
+    size_t saved_parameter = 0;
+    memory_sampling_mode_t saved_mode = get_memory_sampling(&saved_parameter);
+    set_memory_safety_tracing(false);
+
+    run_sampling_bench(iterations, false);  // Warm up the allocator
+
+    printf("%-18s %10s %10s %8s %10s %16s\n",
+           "Mode", "malloc ns", "ns/alloc", "+ns", "vs malloc", "Allocs/s @ 2%");
+
+    for (size_t c = 0; c < sizeof(configs) / sizeof(configs[0]); c++) {
+        set_memory_sampling(configs[c].mode, configs[c].parameter);
+
+        // Alternate baseline and tracked runs, keeping the best of each
+        double baseline = 0.0;
+        double best = 0.0;
+        for (int r = 0; r < 3; r++) {
+            double t = run_sampling_bench(iterations, false);
+            if (r == 0 || t < baseline) baseline = t;
+            t = run_sampling_bench(iterations, true);
+            if (r == 0 || t < best) best = t;
+        }
+
+        double added_ns = (best - baseline) * 1e9 / iterations;
+        double overhead = baseline > 0.0 ? (best - baseline) / baseline * 100.0 : 0.0;
+        char budget_rate[32];
+        if (added_ns > 0.0) {
+            snprintf(budget_rate, sizeof(budget_rate), "%.2e", 0.02 / (added_ns * 1e-9));
+        } else {
+            snprintf(budget_rate, sizeof(budget_rate), "unbounded");
+        }
+        printf("%-18s %10.1f %10.1f %8.1f %9.1f%% %16s\n", configs[c].name,
+               baseline * 1e9 / iterations, best * 1e9 / iterations, added_ns, overhead, budget_rate);
+    }
+
+    set_memory_sampling(saved_mode, saved_parameter);
+    set_memory_safety_tracing(saved_tracing);
+}
+
+/**
+ * Time allocating and freeing a batch of tracked blocks in the current mode
+ * @param ptrs Scratch pointer array
+ * @param count Blocks to allocate
+ * @param reserved_bytes Receives bytes reserved per requested byte
+ * @return Wall-clock seconds
+ */
+static double run_guard_bench(void** ptrs, int count, double* reserved_bytes) {
+    struct timespec start, end;
+    uint32_t seed = 4242;
+    size_t requested = 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < count; i++) {
+        seed = seed * 1103515245u + 12345u;
+        size_t size = 16 + ((seed >> 16) % 2048);
+        requested += size;
+        ptrs[i] = SAFE_MALLOC(size);
+        if (ptrs[i] != NULL) {
+            memset(ptrs[i], 0x5A, size);
+        }
+    }
+
+    memory_safety_stats_t stats;
+    get_memory_safety_stats(&stats);
+    *reserved_bytes = stats.guard_mapped_bytes > 0 ?
+        (double)stats.guard_mapped_bytes :
+        (double)(requested + (size_t)count * 2 * sizeof(uint32_t));
+    *reserved_bytes /= (double)requested;
+
+    for (int i = 0; i < count; i++) {
+        if (ptrs[i] != NULL) {
+            SAFE_FREE(ptrs[i]);
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    return (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+/**
+ * Compare guard-page mode with canary mode: time per block and memory reserved
+ * Uses 16-2063 byte blocks; memory is reported as reserved bytes per requested byte.
+ * @param count Blocks allocated and freed per measurement
+ */
+void benchmark_guard_page_overhead(int count) {
+    printf("\n=== Guard Page Overhead Benchmark ===\n");
+
+    if (count <= 0) {
+        printf("ERROR: Invalid block count %d\n", count);
+        return;
+    }
+
+    void** ptrs = malloc((size_t)count * sizeof(void*));
+    if (ptrs == NULL) {
+        printf("ERROR: Failed to allocate benchmark pointer array\n");
+        return;
+    }
+
+    bool saved_tracing = g_trace_allocations;
+    bool saved_guard = memory_guard_pages_enabled();
+    size_t saved_quarantine = g_quarantine_limit;
+    size_t saved_parameter = 0;
+    memory_sampling_mode_t saved_mode = get_memory_sampling(&saved_parameter);
+    set_memory_safety_tracing(false);
+    set_memory_sampling(MEMORY_SAMPLING_ALL, 0);
+
+    double canary_mem = 0.0, guard_mem = 0.0;
+    set_memory_guard_pages(false, 0);
+    run_guard_bench(ptrs, count, &canary_mem);  // Warm up
+    double canary_time = run_guard_bench(ptrs, count, &canary_mem);
+
+    set_memory_guard_pages(true, saved_quarantine);
+    double guard_time = run_guard_bench(ptrs, count, &guard_mem);
+
+    printf("%-12s %14s %18s\n", "Mode", "ns/block", "Reserved/requested");
+    printf("%-12s %14.1f %17.2fx\n", "Canary", canary_time * 1e9 / count, canary_mem);
+    printf("%-12s %14.1f %17.2fx\n", "Guard page", guard_time * 1e9 / count, guard_mem);
+    if (canary_time > 0.0 && canary_mem > 0.0) {
+        printf("Guard pages cost %.1fx the time and %.1fx the memory of canaries "
+               "(page size %zu, quarantine limit %zu bytes)\n",
+               guard_time / canary_time, guard_mem / canary_mem, g_page_size, saved_quarantine);
+    }
+
+    set_memory_guard_pages(saved_guard, saved_quarantine);
+    set_memory_sampling(saved_mode, saved_parameter);
+    set_memory_safety_tracing(saved_tracing);
+    free(ptrs);
+}
+
 // Macros moved to top of file
 
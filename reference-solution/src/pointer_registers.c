@@ -1,13 +1,147 @@
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdio.h>
 #include <stdint.h>
+#include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HAVE_X86_REGISTER_KERNELS 1
+#endif
 
 #define REGISTER_BANK_SIZE 256
 #define BASE_REGISTER_ADDR 0x40000000
 
-// Simulated register bank (in real hardware, this would be memory-mapped)
-static uint32_t register_bank[REGISTER_BANK_SIZE];
+// Simulated register bank (in real hardware, this would be memory-mapped).
+// Every access goes through __atomic builtins so pollers and writers on
+// different threads can share it without a lock. By default the bank is
+// this process-private array; register_bank_attach_file()/_shm() repoint
+// it at a shared mapping so several processes see one register image.
+static uint32_t register_bank_storage[REGISTER_BANK_SIZE] __attribute__((aligned(64)));
+static uint32_t* register_bank = register_bank_storage;
+static uint32_t register_bank_words = REGISTER_BANK_SIZE;
+
+// Register access tracing lives in register_trace.c; while it is off each
+// access pays one relaxed load (REGISTER_TRACE_* must match chip_state.h)
+#define REGISTER_TRACE_READ  0
+#define REGISTER_TRACE_WRITE 1
+#define REGISTER_TRACE_RMW   2
+extern int g_register_trace_active;
+void register_trace_record(int op, uint32_t address, uint32_t old_value, uint32_t new_value);
+
+/**
+ * Check whether register accesses are being traced
+ * @return true while a trace is recording
+ */
+static inline bool register_tracing(void) {
+    return __builtin_expect(__atomic_load_n(&g_register_trace_active, __ATOMIC_RELAXED) != 0, 0);
+}
+
+// Copy-on-write snapshots live in state_snapshot.c; with none taken each
+// write pays one relaxed load (must match SNAPSHOT_REGION_REGISTERS in chip_state.h)
+#define SNAPSHOT_REGION_REGISTERS 0
+extern int g_snapshot_active;
+void snapshot_before_write(int region, const void* address, size_t length);
+
+/**
+ * Let live snapshots preserve registers before they are modified
+ * @param reg_ptr First register about to change
+ * @param count Number of consecutive registers
+ */
+static inline void register_before_write(const uint32_t* reg_ptr, size_t count) {
+    if (__builtin_expect(__atomic_load_n(&g_snapshot_active, __ATOMIC_RELAXED) != 0, 0)) {
+        snapshot_before_write(SNAPSHOT_REGION_REGISTERS, reg_ptr, count * sizeof(uint32_t));
+    }
+}
+
+// Diagnostics go through chip_log.c so hot paths can run quiet or deferred
+// (levels and CHIP_LOG() must match chip_state.h)
+#define CHIP_LOG_ERROR 0
+#define CHIP_LOG_INFO  2
+#define CHIP_LOG_DEBUG 3
+#ifndef CHIP_LOG_COMPILE_LEVEL
+#define CHIP_LOG_COMPILE_LEVEL CHIP_LOG_DEBUG
+#endif
+extern int g_chip_log_level;
+void chip_log_write(int level, const char* format, ...) __attribute__((format(printf, 2, 3)));
+#define CHIP_LOG(level, ...) do { \
+    if ((level) <= CHIP_LOG_COMPILE_LEVEL && \
+        (level) <= __atomic_load_n(&g_chip_log_level, __ATOMIC_RELAXED)) \
+        chip_log_write((level), __VA_ARGS__); \
+} while (0)
+
+// Watchpoints live in register_watch.c; with none set each write pays one
+// relaxed load, and unwatched registers one more (must match chip_state.h)
+typedef struct {
+    uint32_t words;
+    uint32_t masks[];
+} register_watch_table_t;
+extern register_watch_table_t* g_register_watch_table;
+int register_watch_fire(uint32_t index, uint32_t old_value, uint32_t new_value);
+
+/**
+ * Look up the watched bits of a register
+ * @param reg_ptr Register in the bank
+ * @return Bits some watch depends on (0 if unwatched)
+ */
+static inline uint32_t register_watch_mask(const uint32_t* reg_ptr) {
+    const register_watch_table_t* table = __atomic_load_n(&g_register_watch_table, __ATOMIC_ACQUIRE);
+    if (__builtin_expect(table == NULL, 1)) return 0;
+
+    size_t index = (size_t)(reg_ptr - register_bank);
+    return index < table->words ? __atomic_load_n(&table->masks[index], __ATOMIC_RELAXED) : 0;
+}
+
+/**
+ * Notify watchpoints if a write flipped any watched bit
+ * @param reg_ptr Register in the bank
+ * @param old_value Value before the write
+ * @param new_value Value after the write
+ */
+static inline void register_watch_check(const uint32_t* reg_ptr, uint32_t old_value, uint32_t new_value) {
+    if (__builtin_expect((register_watch_mask(reg_ptr) & (old_value ^ new_value)) != 0, 0)) {
+        register_watch_fire((uint32_t)(reg_ptr - register_bank), old_value, new_value);
+    }
+}
+
+/**
+ * Store a register, preserving it for snapshots; when tracing or watched the
+ * old value is exchanged out so the trace and watchpoints see the transition
+ * @param reg_ptr Register in the bank
+ * @param address Register address (for the trace)
+ * @param value Value to store
+ * @param memorder Atomic memory order of the store
+ */
+static inline void traced_register_store(uint32_t* reg_ptr, uint32_t address, uint32_t value, int memorder) {
+    register_before_write(reg_ptr, 1);
+    uint32_t watched = register_watch_mask(reg_ptr);
+    if (register_tracing() || watched != 0) {
+        uint32_t old_value = __atomic_exchange_n(reg_ptr, value, memorder);
+        if (register_tracing()) register_trace_record(REGISTER_TRACE_WRITE, address, old_value, value);
+        if ((old_value ^ value) & watched) register_watch_fire((uint32_t)(reg_ptr - register_bank), old_value, value);
+    } else {
+        __atomic_store_n(reg_ptr, value, memorder);
+    }
+}
+
+/**
+ * Record a read when tracing
+ * @param address Register address
+ * @param value Value read
+ * @return value, so reads can return through it
+ */
+static inline uint32_t traced_register_read(uint32_t address, uint32_t value) {
+    if (register_tracing()) register_trace_record(REGISTER_TRACE_READ, address, value, value);
+    return value;
+}
 
 /**
  * Get a pointer to a register based on its address
@@ -19,8 +153,8 @@ uint32_t* get_register_pointer(uint32_t address) {
     uint32_t offset = (address - BASE_REGISTER_ADDR) / sizeof(uint32_t);
 
     // Validate address range
-    if (offset >= REGISTER_BANK_SIZE) {
-        printf("Error: Register address 0x%08X out of range\n", address);
+    if (offset >= register_bank_words) {
+        CHIP_LOG(CHIP_LOG_ERROR, "Error: Register address 0x%08X out of range\n", address);
         return NULL;
     }
 
@@ -36,11 +170,11 @@ uint32_t read_register_via_pointer(uint32_t address) {
     uint32_t* reg_ptr = get_register_pointer(address);
 
     if (reg_ptr == NULL) {
-        printf("Error: Cannot read from invalid register address 0x%08X\n", address);
+        CHIP_LOG(CHIP_LOG_ERROR, "Error: Cannot read from invalid register address 0x%08X\n", address);
         return 0;
     }
 
-    return *reg_ptr;
+    return traced_register_read(address, __atomic_load_n(reg_ptr, __ATOMIC_ACQUIRE));
 }
 
 /**
@@ -52,12 +186,12 @@ void write_register_via_pointer(uint32_t address, uint32_t value) {
     uint32_t* reg_ptr = get_register_pointer(address);
 
     if (reg_ptr == NULL) {
-        printf("Error: Cannot write to invalid register address 0x%08X\n", address);
+        CHIP_LOG(CHIP_LOG_ERROR, "Error: Cannot write to invalid register address 0x%08X\n", address);
         return;
     }
 
-    *reg_ptr = value;
-    printf("Register 0x%08X = 0x%08X\n", address, value);
+    traced_register_store(reg_ptr, address, value, __ATOMIC_RELEASE);
+    CHIP_LOG(CHIP_LOG_DEBUG, "Register 0x%08X = 0x%08X\n", address, value);
 }
 
 /**
@@ -71,13 +205,141 @@ int validate_register_pointer(uint32_t* reg_ptr) {
     }
 
     // Check if pointer is within register bank bounds
-    if (reg_ptr < register_bank || reg_ptr >= (register_bank + REGISTER_BANK_SIZE)) {
+    if (reg_ptr < register_bank || reg_ptr >= (register_bank + register_bank_words)) {
         return 0;
     }
 
     return 1;
 }
 
+/**
+ * Atomically read a register (acquire ordering)
+ * @param address The register address
+ * @return Register value or 0 if invalid address
+ */
+uint32_t register_atomic_load(uint32_t address) {
+    uint32_t* reg_ptr = get_register_pointer(address);
+    if (reg_ptr == NULL) return 0;
+
+    return traced_register_read(address, __atomic_load_n(reg_ptr, __ATOMIC_ACQUIRE));
+}
+
+/**
+ * Atomically write a register (release ordering)
+ * @param address The register address
+ * @param value The value to write
+ * @return 1 if successful, 0 if invalid address
+ */
+int register_atomic_store(uint32_t address, uint32_t value) {
+    uint32_t* reg_ptr = get_register_pointer(address);
+    if (reg_ptr == NULL) return 0;
+
+    traced_register_store(reg_ptr, address, value, __ATOMIC_RELEASE);
+    return 1;
+}
+
+/**
+ * Atomically set the bits in mask
+ * @param address The register address
+ * @param mask Bits to set
+ * @return Register value before the update, or 0 if invalid address
+ */
+uint32_t register_atomic_set_bits(uint32_t address, uint32_t mask) {
+    uint32_t* reg_ptr = get_register_pointer(address);
+    if (reg_ptr == NULL) return 0;
+
+    register_before_write(reg_ptr, 1);
+    uint32_t previous = __atomic_fetch_or(reg_ptr, mask, __ATOMIC_ACQ_REL);
+    if (register_tracing()) register_trace_record(REGISTER_TRACE_RMW, address, previous, previous | mask);
+    register_watch_check(reg_ptr, previous, previous | mask);
+    return previous;
+}
+
+/**
+ * Atomically clear the bits in mask
+ * @param address The register address
+ * @param mask Bits to clear
+ * @return Register value before the update, or 0 if invalid address
+ */
+uint32_t register_atomic_clear_bits(uint32_t address, uint32_t mask) {
+    uint32_t* reg_ptr = get_register_pointer(address);
+    if (reg_ptr == NULL) return 0;
+
+    register_before_write(reg_ptr, 1);
+    uint32_t previous = __atomic_fetch_and(reg_ptr, ~mask, __ATOMIC_ACQ_REL);
+    if (register_tracing()) register_trace_record(REGISTER_TRACE_RMW, address, previous, previous & ~mask);
+    register_watch_check(reg_ptr, previous, previous & ~mask);
+    return previous;
+}
+
+/**
+ * Atomically toggle the bits in mask
+ * @param address The register address
+ * @param mask Bits to toggle
+ * @return Register value before the update, or 0 if invalid address
+ */
+uint32_t register_atomic_toggle_bits(uint32_t address, uint32_t mask) {
+    uint32_t* reg_ptr = get_register_pointer(address);
+    if (reg_ptr == NULL) return 0;
+
+    register_before_write(reg_ptr, 1);
+    uint32_t previous = __atomic_fetch_xor(reg_ptr, mask, __ATOMIC_ACQ_REL);
+    if (register_tracing()) register_trace_record(REGISTER_TRACE_RMW, address, previous, previous ^ mask);
+    register_watch_check(reg_ptr, previous, previous ^ mask);
+    return previous;
+}
+
+/**
+ * Atomically replace a register value if it still holds the expected value
+ * @param address The register address
+ * @param expected In: value expected; out: value actually found on failure
+ * @param desired Value to store on success
+ * @return 1 if swapped, 0 if the register changed or address is invalid
+ */
+int register_atomic_compare_exchange(uint32_t address, uint32_t* expected, uint32_t desired) {
+    uint32_t* reg_ptr = get_register_pointer(address);
+    if (reg_ptr == NULL || expected == NULL) return 0;
+
+    register_before_write(reg_ptr, 1);
+    bool swapped = __atomic_compare_exchange_n(reg_ptr, expected, desired, false,
+                                               __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+    if (register_tracing()) {
+        // On failure *expected holds the value observed, which is just a read
+        register_trace_record(swapped ? REGISTER_TRACE_RMW : REGISTER_TRACE_READ,
+                              address, *expected, swapped ? desired : *expected);
+    }
+    if (swapped) register_watch_check(reg_ptr, *expected, desired);
+    return swapped ? 1 : 0;
+}
+
+/**
+ * Atomically update a bit field, leaving other bits untouched (CAS loop)
+ * @param address The register address
+ * @param mask Field mask within the register
+ * @param shift Field position
+ * @param value New field value (unshifted)
+ * @param previous Receives the register value before the update (may be NULL)
+ * @return 1 if successful, 0 if invalid address
+ */
+int register_atomic_update_field(uint32_t address, uint32_t mask, int shift,
+                                 uint32_t value, uint32_t* previous) {
+    uint32_t* reg_ptr = get_register_pointer(address);
+    if (reg_ptr == NULL) return 0;
+
+    register_before_write(reg_ptr, 1);
+    uint32_t old_value = __atomic_load_n(reg_ptr, __ATOMIC_RELAXED);
+    uint32_t new_value;
+    do {
+        new_value = (old_value & ~mask) | ((value << shift) & mask);
+    } while (!__atomic_compare_exchange_n(reg_ptr, &old_value, new_value, true,
+                                          __ATOMIC_ACQ_REL, __ATOMIC_RELAXED));
+
+    if (register_tracing()) register_trace_record(REGISTER_TRACE_RMW, address, old_value, new_value);
+    register_watch_check(reg_ptr, old_value, new_value);
+    if (previous != NULL) *previous = old_value;
+    return 1;
+}
+
 /**
  * Write multiple values to consecutive registers
  * @param start_addr Starting register address
@@ -86,7 +348,7 @@ int validate_register_pointer(uint32_t* reg_ptr) {
  */
 void bulk_register_write(uint32_t start_addr, uint32_t* values, int count) {
     if (values == NULL || count <= 0) {
-        printf("Error: Invalid parameters for bulk write\n");
+        CHIP_LOG(CHIP_LOG_ERROR, "Error: Invalid parameters for bulk write\n");
         return;
     }
 
@@ -97,16 +359,16 @@ void bulk_register_write(uint32_t start_addr, uint32_t* values, int count) {
 
     // Check if all registers in range are valid
     uint32_t end_offset = ((start_addr - BASE_REGISTER_ADDR) / sizeof(uint32_t)) + count - 1;
-    if (end_offset >= REGISTER_BANK_SIZE) {
-        printf("Error: Bulk write would exceed register bank bounds\n");
+    if (end_offset >= register_bank_words) {
+        CHIP_LOG(CHIP_LOG_ERROR, "Error: Bulk write would exceed register bank bounds\n");
         return;
     }
 
     // Perform bulk write using pointer arithmetic
     for (int i = 0; i < count; i++) {
-        *(start_ptr + i) = values[i];
-        printf("Register 0x%08X = 0x%08X\n",
-               start_addr + (i * sizeof(uint32_t)), values[i]);
+        traced_register_store(start_ptr + i, start_addr + (i * sizeof(uint32_t)), values[i], __ATOMIC_RELAXED);
+        CHIP_LOG(CHIP_LOG_DEBUG, "Register 0x%08X = 0x%08X\n",
+                 start_addr + (i * sizeof(uint32_t)), values[i]);
     }
 }
 
@@ -118,7 +380,7 @@ void bulk_register_write(uint32_t start_addr, uint32_t* values, int count) {
  */
 void bulk_register_read(uint32_t start_addr, uint32_t* buffer, int count) {
     if (buffer == NULL || count <= 0) {
-        printf("Error: Invalid parameters for bulk read\n");
+        CHIP_LOG(CHIP_LOG_ERROR, "Error: Invalid parameters for bulk read\n");
         return;
     }
 
@@ -129,17 +391,692 @@ void bulk_register_read(uint32_t start_addr, uint32_t* buffer, int count) {
 
     // Check if all registers in range are valid
     uint32_t end_offset = ((start_addr - BASE_REGISTER_ADDR) / sizeof(uint32_t)) + count - 1;
-    if (end_offset >= REGISTER_BANK_SIZE) {
-        printf("Error: Bulk read would exceed register bank bounds\n");
+    if (end_offset >= register_bank_words) {
+        CHIP_LOG(CHIP_LOG_ERROR, "Error: Bulk read would exceed register bank bounds\n");
         return;
     }
 
-    // Perform bulk read using pointer arithmetic
+    // Relaxed loads then one acquire fence, as in register_readv(): each word is
+    // read exactly once, and later reads see writes published before them
+    for (int i = 0; i < count; i++) {
+        buffer[i] = __atomic_load_n(&start_ptr[i], __ATOMIC_RELAXED);
+    }
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+    for (int i = 0; i < count; i++) {
+        buffer[i] = traced_register_read(start_addr + (i * sizeof(uint32_t)), buffer[i]);
+        CHIP_LOG(CHIP_LOG_DEBUG, "Read Register 0x%08X = 0x%08X\n",
+                 start_addr + (i * sizeof(uint32_t)), buffer[i]);
+    }
+}
+
+// One contiguous run of registers for register_readv()/register_writev()
+// (must match register_segment_t in chip_state.h)
+typedef struct {
+    uint32_t address;
+    int count;
+} register_segment_t;
+
+// Vector kernels available on this CPU: 0 scalar, 1 AVX2 gather, 2 AVX2 + AVX-512F scatter
+static int g_register_simd_level = -1;
+
+/**
+ * Detect which register gather/scatter kernels can run
+ * @return SIMD level (0 scalar, 1 AVX2, 2 AVX-512F)
+ */
+static int register_simd_level(void) {
+    if (g_register_simd_level < 0) {
+        int level = 0;
+#ifdef HAVE_X86_REGISTER_KERNELS
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) level = 1;
+        if (level == 1 && __builtin_cpu_supports("avx512f")) level = 2;
+#endif
+        g_register_simd_level = level;
+    }
+    return g_register_simd_level;
+}
+
+/**
+ * Convert a register address to a bank offset without printing
+ * @param address Register address
+ * @return Offset, or register_bank_words or more if out of range
+ */
+static inline uint32_t register_offset(uint32_t address) {
+    return (address - BASE_REGISTER_ADDR) / sizeof(uint32_t);
+}
+
+
+/**
+ * Check every segment before any register is touched
+ * @param segments Segment list
+ * @param segment_count Number of segments
+ * @return Total registers covered, or -1 if any segment is invalid
+ */
+static int validate_register_segments(const register_segment_t* segments, int segment_count) {
+    int total = 0;
+    for (int i = 0; i < segment_count; i++) {
+        uint32_t offset = register_offset(segments[i].address);
+        if (segments[i].count <= 0 || offset >= register_bank_words ||
+            (uint32_t)segments[i].count > register_bank_words - offset) {
+            CHIP_LOG(CHIP_LOG_ERROR, "Error: Register segment %d (0x%08X, %d registers) out of range\n",
+                     i, segments[i].address, segments[i].count);
+            return -1;
+        }
+        total += segments[i].count;
+    }
+    return total;
+}
+
+#ifdef HAVE_X86_REGISTER_KERNELS
+/**
+ * AVX2 gather of 8 registers per instruction, validating offsets in-register
+ * Each 32-bit register is read with one aligned access, so values never tear.
+ * Stops at the first vector holding an invalid address (nothing out of
+ * range is read) and leaves it to the scalar loop to pinpoint.
+ * @param addresses Register addresses
+ * @param count Number of addresses
+ * @param buffer Output values
+ * @return Number of addresses handled (multiple of 8)
+ */
+__attribute__((target("avx2")))
+static int gather_registers_avx2(const uint32_t* addresses, int count, uint32_t* buffer) {
+    const __m256i base = _mm256_set1_epi32((int)BASE_REGISTER_ADDR);
+    const __m256i last = _mm256_set1_epi32((int)register_bank_words - 1);
+    int vector_end = count / 8 * 8;
+
+    for (int i = 0; i < vector_end; i += 8) {
+        __m256i addr = _mm256_loadu_si256((const __m256i*)(addresses + i));
+        // Logical shift keeps offsets below 2^30, so a signed compare is safe
+        __m256i offset = _mm256_srli_epi32(_mm256_sub_epi32(addr, base), 2);
+        if (_mm256_movemask_epi8(_mm256_cmpgt_epi32(offset, last)) != 0) {
+            return i;
+        }
+        __m256i values = _mm256_i32gather_epi32((const int*)register_bank, offset, 4);
+        _mm256_storeu_si256((__m256i*)(buffer + i), values);
+    }
+    return vector_end;
+}
+
+/**
+ * AVX2 range check of 8 addresses per iteration
+ * @param addresses Register addresses
+ * @param count Number of addresses
+ * @return Number of leading addresses known valid (multiple of 8)
+ */
+__attribute__((target("avx2")))
+static int validate_registers_avx2(const uint32_t* addresses, int count) {
+    const __m256i base = _mm256_set1_epi32((int)BASE_REGISTER_ADDR);
+    const __m256i last = _mm256_set1_epi32((int)register_bank_words - 1);
+    int vector_end = count / 8 * 8;
+    __m256i invalid = _mm256_setzero_si256();
+
+    for (int i = 0; i < vector_end; i += 8) {
+        __m256i addr = _mm256_loadu_si256((const __m256i*)(addresses + i));
+        __m256i offset = _mm256_srli_epi32(_mm256_sub_epi32(addr, base), 2);
+        invalid = _mm256_or_si256(invalid, _mm256_cmpgt_epi32(offset, last));
+    }
+
+    // Rare failure case: let the scalar loop find the exact index
+    return _mm256_testz_si256(invalid, invalid) ? vector_end : 0;
+}
+
+/**
+ * AVX-512F scatter of 16 registers per instruction, masked tail included
+ * Overlapping addresses are written in element order, like the scalar loop.
+ * @param addresses Register addresses (already validated)
+ * @param count Number of addresses
+ * @param values Values to write
+ */
+__attribute__((target("avx512f")))
+static void scatter_registers_avx512(const uint32_t* addresses, int count, const uint32_t* values) {
+    const __m512i base = _mm512_set1_epi32((int)BASE_REGISTER_ADDR);
+
+    for (int i = 0; i < count; i += 16) {
+        int remaining = count - i;
+        __mmask16 mask = remaining >= 16 ? (__mmask16)0xFFFF : (__mmask16)((1u << remaining) - 1);
+        __m512i addr = _mm512_maskz_loadu_epi32(mask, addresses + i);
+        __m512i offset = _mm512_srli_epi32(_mm512_sub_epi32(addr, base), 2);
+        __m512i data = _mm512_maskz_loadu_epi32(mask, values + i);
+        _mm512_mask_i32scatter_epi32(register_bank, mask, offset, data, 4);
+    }
+}
+#endif
+
+/**
+ * Check every address in an index list before any register is touched
+ * @param addresses Register addresses
+ * @param count Number of addresses
+ * @return Index of the first invalid address, or -1 if all are valid
+ */
+static int find_invalid_register_address(const uint32_t* addresses, int count) {
+    int done = 0;
+#ifdef HAVE_X86_REGISTER_KERNELS
+    if (register_simd_level() >= 1) {
+        done = validate_registers_avx2(addresses, count);
+    }
+#endif
+    for (int i = done; i < count; i++) {
+        if (register_offset(addresses[i]) >= register_bank_words) return i;
+    }
+    return -1;
+}
+
+/**
+ * Gather registers by address, validating as it goes (no I/O)
+ * Reads have no side effects, so validation is fused into the copy; an
+ * invalid address is never dereferenced.
+ * @param addresses Register addresses
+ * @param count Number of addresses
+ * @param buffer Output values
+ * @param use_simd Allow the vector kernel
+ * @return Index of the first invalid address, or -1 if all were read
+ */
+static int gather_registers(const uint32_t* addresses, int count, uint32_t* buffer, bool use_simd) {
+    int done = 0;
+#ifdef HAVE_X86_REGISTER_KERNELS
+    if (use_simd && register_simd_level() >= 1) {
+        done = gather_registers_avx2(addresses, count, buffer);
+    }
+#else
+    (void)use_simd;
+#endif
+    for (int i = done; i < count; i++) {
+        uint32_t offset = register_offset(addresses[i]);
+        if (offset >= register_bank_words) return i;
+        buffer[i] = __atomic_load_n(&register_bank[offset], __ATOMIC_RELAXED);
+    }
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return -1;
+}
+
+/**
+ * Scatter values to registers by address (validated list, no I/O)
+ * @param addresses Register addresses
+ * @param count Number of addresses
+ * @param values Values to write
+ * @param use_simd Allow the vector kernel
+ */
+static void scatter_registers(const uint32_t* addresses, int count, const uint32_t* values, bool use_simd) {
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    if (register_tracing() || __atomic_load_n(&g_register_watch_table, __ATOMIC_RELAXED) != NULL) {
+        // The trace and watchpoints need each old value, so go element by element
+        for (int i = 0; i < count; i++) {
+            traced_register_store(&register_bank[register_offset(addresses[i])], addresses[i],
+                                  values[i], __ATOMIC_RELAXED);
+        }
+        return;
+    }
+    for (int i = 0; i < count && __atomic_load_n(&g_snapshot_active, __ATOMIC_RELAXED); i++) {
+        register_before_write(&register_bank[register_offset(addresses[i])], 1);
+    }
+#ifdef HAVE_X86_REGISTER_KERNELS
+    if (use_simd && register_simd_level() >= 2) {
+        scatter_registers_avx512(addresses, count, values);
+        return;
+    }
+#else
+    (void)use_simd;
+#endif
     for (int i = 0; i < count; i++) {
-        buffer[i] = *(start_ptr + i);
-        printf("Read Register 0x%08X = 0x%08X\n",
-               start_addr + (i * sizeof(uint32_t)), buffer[i]);
+        __atomic_store_n(&register_bank[register_offset(addresses[i])], values[i], __ATOMIC_RELAXED);
+    }
+}
+
+/**
+ * Read a list of scattered registers in one call
+ * Every address is validated (in the same pass as the copy); no per-register output.
+ * @param addresses Register addresses
+ * @param count Number of addresses
+ * @param buffer Output values (count entries)
+ * @return Number of registers read, or -1 if any address is invalid
+ */
+int register_gather(const uint32_t* addresses, int count, uint32_t* buffer) {
+    if (addresses == NULL || buffer == NULL || count <= 0) {
+        CHIP_LOG(CHIP_LOG_ERROR, "Error: Invalid parameters for register gather\n");
+        return -1;
+    }
+
+    int bad = gather_registers(addresses, count, buffer, true);
+    if (bad >= 0) {
+        CHIP_LOG(CHIP_LOG_ERROR, "Error: Gather address [%d] 0x%08X out of range\n", bad, addresses[bad]);
+        return -1;
+    }
+    if (register_tracing()) {
+        for (int i = 0; i < count; i++) traced_register_read(addresses[i], buffer[i]);
+    }
+    return count;
+}
+
+/**
+ * Write a list of scattered registers in one call
+ * All addresses are validated before anything is written, so an invalid
+ * entry leaves the bank untouched. Later entries win for repeated addresses.
+ * @param addresses Register addresses
+ * @param count Number of addresses
+ * @param values Values to write (count entries)
+ * @return Number of registers written, or -1 if any address is invalid
+ */
+int register_scatter(const uint32_t* addresses, int count, const uint32_t* values) {
+    if (addresses == NULL || values == NULL || count <= 0) {
+        CHIP_LOG(CHIP_LOG_ERROR, "Error: Invalid parameters for register scatter\n");
+        return -1;
+    }
+
+    int bad = find_invalid_register_address(addresses, count);
+    if (bad >= 0) {
+        CHIP_LOG(CHIP_LOG_ERROR, "Error: Scatter address [%d] 0x%08X out of range\n", bad, addresses[bad]);
+        return -1;
+    }
+
+    scatter_registers(addresses, count, values, true);
+    return count;
+}
+
+/**
+ * Read several contiguous register ranges into one buffer (readv style)
+ * @param segments Segment list
+ * @param segment_count Number of segments
+ * @param buffer Output values, segments packed back to back
+ * @return Total registers read, or -1 if any segment is invalid
+ */
+int register_readv(const register_segment_t* segments, int segment_count, uint32_t* buffer) {
+    if (segments == NULL || buffer == NULL || segment_count <= 0) {
+        CHIP_LOG(CHIP_LOG_ERROR, "Error: Invalid parameters for vectored register read\n");
+        return -1;
+    }
+
+    int total = validate_register_segments(segments, segment_count);
+    if (total < 0) return -1;
+
+    uint32_t* out = buffer;
+    for (int s = 0; s < segment_count; s++) {
+        const uint32_t* src = &register_bank[register_offset(segments[s].address)];
+        for (int i = 0; i < segments[s].count; i++) {
+            out[i] = traced_register_read(segments[s].address + i * sizeof(uint32_t),
+                                          __atomic_load_n(&src[i], __ATOMIC_RELAXED));
+        }
+        out += segments[s].count;
     }
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return total;
+}
+
+/**
+ * Write several contiguous register ranges from one buffer (writev style)
+ * @param segments Segment list
+ * @param segment_count Number of segments
+ * @param values Input values, segments packed back to back
+ * @return Total registers written, or -1 if any segment is invalid
+ */
+int register_writev(const register_segment_t* segments, int segment_count, const uint32_t* values) {
+    if (segments == NULL || values == NULL || segment_count <= 0) {
+        CHIP_LOG(CHIP_LOG_ERROR, "Error: Invalid parameters for vectored register write\n");
+        return -1;
+    }
+
+    int total = validate_register_segments(segments, segment_count);
+    if (total < 0) return -1;
+
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    const uint32_t* in = values;
+    for (int s = 0; s < segment_count; s++) {
+        uint32_t* dst = &register_bank[register_offset(segments[s].address)];
+        for (int i = 0; i < segments[s].count; i++) {
+            traced_register_store(&dst[i], segments[s].address + i * sizeof(uint32_t), in[i], __ATOMIC_RELAXED);
+        }
+        in += segments[s].count;
+    }
+    return total;
+}
+
+/**
+ * Compare per-register access with the vectored gather/scatter API
+ * Each step touches 48 scattered control/status registers.
+ */
+void benchmark_register_vectored_access(void) {
+    printf("\n--- Vectored Register Access (48 scattered registers/step) ---\n");
+
+    enum { STEP_REGISTERS = 48, STEPS = 200000 };
+    uint32_t addresses[STEP_REGISTERS];
+    uint32_t values[STEP_REGISTERS];
+    uint32_t buffer[STEP_REGISTERS];
+
+    for (int i = 0; i < STEP_REGISTERS; i++) {
+        addresses[i] = BASE_REGISTER_ADDR + ((uint32_t)(i * 37) % register_bank_words) * sizeof(uint32_t);
+        values[i] = 0x1000u + (uint32_t)i;
+    }
+
+    struct timespec start, end;
+    uint32_t checksum = 0;
+    double ns[5];
+
+    // Per-register reads (validation per call)
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int step = 0; step < STEPS; step++) {
+        for (int i = 0; i < STEP_REGISTERS; i++) {
+            buffer[i] = register_atomic_load(addresses[i]);
+        }
+        checksum += buffer[step % STEP_REGISTERS];
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    ns[0] = ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / STEPS;
+
+    for (int simd = 0; simd <= 1; simd++) {
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (int step = 0; step < STEPS; step++) {
+            gather_registers(addresses, STEP_REGISTERS, buffer, simd == 1);
+            checksum += buffer[step % STEP_REGISTERS];
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        ns[1 + simd] = ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / STEPS;
+    }
+
+    // Per-register writes versus scatter
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int step = 0; step < STEPS; step++) {
+        for (int i = 0; i < STEP_REGISTERS; i++) {
+            register_atomic_store(addresses[i], values[i] + (uint32_t)step);
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    ns[3] = ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / STEPS;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int step = 0; step < STEPS; step++) {
+        values[step % STEP_REGISTERS] += 1;
+        register_scatter(addresses, STEP_REGISTERS, values);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    ns[4] = ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / STEPS;
+
+    int level = register_simd_level();
+    printf("Per-register reads:      %8.1f ns/step\n", ns[0]);
+    printf("Gather (scalar):         %8.1f ns/step\n", ns[1]);
+    printf("Gather (%s):          %8.1f ns/step\n", level >= 1 ? "AVX2" : "none", ns[2]);
+    printf("Per-register writes:     %8.1f ns/step\n", ns[3]);
+    printf("Scatter (%s):     %8.1f ns/step\n", level >= 2 ? "AVX-512F" : "scalar  ", ns[4]);
+    printf("(checksum 0x%08X)\n", checksum);
+}
+
+// Most candidate values one pattern search compares in a single pass
+// (must match REGISTER_MATCH_MAX_VALUES in chip_state.h)
+#define REGISTER_MATCH_MAX_VALUES 8
+
+// Words scanned per local bitmap when only the first match or an index list is wanted
+#define REGISTER_SCAN_CHUNK 512
+
+// Pattern scan kernels: 0 scalar, 1 SSE2 (4 words/step), 2 AVX2 (8 words/step)
+static int g_register_scan_level = -1;
+
+/**
+ * Detect the widest pattern scan kernel this CPU can run
+ * @return Scan level (0 scalar, 1 SSE2, 2 AVX2)
+ */
+static int register_scan_level(void) {
+    if (g_register_scan_level < 0) {
+        int level = 0;
+#ifdef HAVE_X86_REGISTER_KERNELS
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("sse2")) level = 1;
+        if (__builtin_cpu_supports("avx2")) level = 2;
+#endif
+        g_register_scan_level = level;
+    }
+    return g_register_scan_level;
+}
+
+/**
+ * Check a candidate value list for a pattern search
+ * @param values Candidate values
+ * @param value_count Number of candidates
+ * @return 1 if usable, 0 otherwise
+ */
+static int validate_register_pattern(const uint32_t* values, int value_count) {
+    if (values == NULL || value_count <= 0 || value_count > REGISTER_MATCH_MAX_VALUES) {
+        CHIP_LOG(CHIP_LOG_ERROR, "Error: Pattern search needs 1 to %d candidate values\n", REGISTER_MATCH_MAX_VALUES);
+        return 0;
+    }
+    return 1;
+}
+
+#ifdef HAVE_X86_REGISTER_KERNELS
+/**
+ * AVX2 pattern match of 8 words per step: (word & mask) == any candidate
+ * @param image Words to scan
+ * @param count Number of words
+ * @param mask Mask applied to each word before comparing
+ * @param values Candidate values
+ * @param value_count Number of candidates (1..REGISTER_MATCH_MAX_VALUES)
+ * @param bitmap Match bits, ORed in (one bit per word)
+ * @return Number of words handled (multiple of 8)
+ */
+__attribute__((target("avx2")))
+static int match_register_words_avx2(const uint32_t* image, int count, uint32_t mask,
+                                     const uint32_t* values, int value_count, uint64_t* bitmap) {
+    const __m256i vmask = _mm256_set1_epi32((int)mask);
+    __m256i candidates[REGISTER_MATCH_MAX_VALUES];
+    for (int k = 0; k < value_count; k++) {
+        candidates[k] = _mm256_set1_epi32((int)values[k]);
+    }
+
+    int vector_end = count / 8 * 8;
+    for (int i = 0; i < vector_end; i += 8) {
+        __m256i words = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(image + i)), vmask);
+        __m256i hit = _mm256_cmpeq_epi32(words, candidates[0]);
+        for (int k = 1; k < value_count; k++) {
+            hit = _mm256_or_si256(hit, _mm256_cmpeq_epi32(words, candidates[k]));
+        }
+        // One sign bit per lane; 8 | 64, so a step never straddles bitmap words
+        uint32_t bits = (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(hit));
+        bitmap[i >> 6] |= (uint64_t)bits << (i & 63);
+    }
+    return vector_end;
+}
+
+/**
+ * SSE2 pattern match of 4 words per step, for CPUs without AVX2
+ * @param image Words to scan
+ * @param count Number of words
+ * @param mask Mask applied to each word before comparing
+ * @param values Candidate values
+ * @param value_count Number of candidates (1..REGISTER_MATCH_MAX_VALUES)
+ * @param bitmap Match bits, ORed in (one bit per word)
+ * @return Number of words handled (multiple of 4)
+ */
+__attribute__((target("sse2")))
+static int match_register_words_sse2(const uint32_t* image, int count, uint32_t mask,
+                                     const uint32_t* values, int value_count, uint64_t* bitmap) {
+    const __m128i vmask = _mm_set1_epi32((int)mask);
+    __m128i candidates[REGISTER_MATCH_MAX_VALUES];
+    for (int k = 0; k < value_count; k++) {
+        candidates[k] = _mm_set1_epi32((int)values[k]);
+    }
+
+    int vector_end = count / 4 * 4;
+    for (int i = 0; i < vector_end; i += 4) {
+        __m128i words = _mm_and_si128(_mm_loadu_si128((const __m128i*)(image + i)), vmask);
+        __m128i hit = _mm_cmpeq_epi32(words, candidates[0]);
+        for (int k = 1; k < value_count; k++) {
+            hit = _mm_or_si128(hit, _mm_cmpeq_epi32(words, candidates[k]));
+        }
+        uint32_t bits = (uint32_t)_mm_movemask_ps(_mm_castsi128_ps(hit));
+        bitmap[i >> 6] |= (uint64_t)bits << (i & 63);
+    }
+    return vector_end;
+}
+#endif
+
+/**
+ * Build the match bitmap for a word range (no I/O)
+ * @param image Words to scan
+ * @param count Number of words
+ * @param mask Mask applied to each word before comparing
+ * @param values Candidate values (already validated)
+ * @param value_count Number of candidates
+ * @param bitmap Output, (count + 63) / 64 words, fully overwritten
+ * @param level Kernel to use (see register_scan_level())
+ */
+static void match_register_words(const uint32_t* image, int count, uint32_t mask,
+                                 const uint32_t* values, int value_count,
+                                 uint64_t* bitmap, int level) {
+    memset(bitmap, 0, (size_t)((count + 63) / 64) * sizeof(uint64_t));
+
+    int done = 0;
+#ifdef HAVE_X86_REGISTER_KERNELS
+    if (level >= 2) {
+        done = match_register_words_avx2(image, count, mask, values, value_count, bitmap);
+    } else if (level == 1) {
+        done = match_register_words_sse2(image, count, mask, values, value_count, bitmap);
+    }
+#else
+    (void)level;
+#endif
+    for (int i = done; i < count; i++) {
+        uint32_t word = image[i] & mask;
+        for (int k = 0; k < value_count; k++) {
+            if (word == values[k]) {
+                bitmap[i >> 6] |= 1ULL << (i & 63);
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * Index of the first match in a word range, scanning chunk by chunk
+ * @param image Words to scan
+ * @param count Number of words
+ * @param mask Mask applied to each word before comparing
+ * @param values Candidate values (already validated)
+ * @param value_count Number of candidates
+ * @return Index of the first matching word, or -1 if none
+ */
+static int find_first_register_word(const uint32_t* image, int count, uint32_t mask,
+                                    const uint32_t* values, int value_count) {
+    uint64_t chunk_bits[REGISTER_SCAN_CHUNK / 64];
+    int level = register_scan_level();
+
+    for (int base = 0; base < count; base += REGISTER_SCAN_CHUNK) {
+        int n = count - base < REGISTER_SCAN_CHUNK ? count - base : REGISTER_SCAN_CHUNK;
+        match_register_words(image + base, n, mask, values, value_count, chunk_bits, level);
+        for (int w = 0; w < (n + 63) / 64; w++) {
+            if (chunk_bits[w] != 0) {
+                return base + w * 64 + __builtin_ctzll(chunk_bits[w]);
+            }
+        }
+    }
+    return -1;
+}
+
+/**
+ * Mark every word of a register image matching any candidate under a mask
+ * Word i matches when (image[i] & mask) equals one of the candidates.
+ * @param image Register image to scan
+ * @param count Number of words
+ * @param mask Mask applied to each word before comparing (0xFFFFFFFF for exact)
+ * @param values Candidate values
+ * @param value_count Number of candidates (1..REGISTER_MATCH_MAX_VALUES)
+ * @param bitmap Output bitmap, (count + 63) / 64 words, bit i set for a match
+ * @return Number of matching words, or -1 on invalid parameters
+ */
+int register_image_match_bitmap(const uint32_t* image, int count, uint32_t mask,
+                                const uint32_t* values, int value_count, uint64_t* bitmap) {
+    if (image == NULL || bitmap == NULL || count <= 0) {
+        CHIP_LOG(CHIP_LOG_ERROR, "Error: Invalid parameters for register image scan\n");
+        return -1;
+    }
+    if (!validate_register_pattern(values, value_count)) return -1;
+
+    match_register_words(image, count, mask, values, value_count, bitmap, register_scan_level());
+
+    int matches = 0;
+    for (int w = 0; w < (count + 63) / 64; w++) {
+        matches += __builtin_popcountll(bitmap[w]);
+    }
+    return matches;
+}
+
+/**
+ * List the indices of every word of a register image matching any candidate
+ * @param image Register image to scan
+ * @param count Number of words
+ * @param mask Mask applied to each word before comparing (0xFFFFFFFF for exact)
+ * @param values Candidate values
+ * @param value_count Number of candidates (1..REGISTER_MATCH_MAX_VALUES)
+ * @param indices Output indices in ascending order
+ * @param max_indices Capacity of indices; further matches are counted only
+ * @return Total number of matches (may exceed max_indices), or -1 on invalid parameters
+ */
+int register_image_match_indices(const uint32_t* image, int count, uint32_t mask,
+                                 const uint32_t* values, int value_count,
+                                 int* indices, int max_indices) {
+    if (image == NULL || count <= 0 || (indices == NULL && max_indices > 0)) {
+        CHIP_LOG(CHIP_LOG_ERROR, "Error: Invalid parameters for register image scan\n");
+        return -1;
+    }
+    if (!validate_register_pattern(values, value_count)) return -1;
+
+    uint64_t chunk_bits[REGISTER_SCAN_CHUNK / 64];
+    int level = register_scan_level();
+    int matches = 0;
+
+    for (int base = 0; base < count; base += REGISTER_SCAN_CHUNK) {
+        int n = count - base < REGISTER_SCAN_CHUNK ? count - base : REGISTER_SCAN_CHUNK;
+        match_register_words(image + base, n, mask, values, value_count, chunk_bits, level);
+        for (int w = 0; w < (n + 63) / 64; w++) {
+            uint64_t bits = chunk_bits[w];
+            while (bits != 0) {
+                if (matches < max_indices) {
+                    indices[matches] = base + w * 64 + __builtin_ctzll(bits);
+                }
+                matches++;
+                bits &= bits - 1;
+            }
+        }
+    }
+    return matches;
+}
+
+/**
+ * Find the first word of a register image matching any candidate under a mask
+ * @param image Register image to scan
+ * @param count Number of words
+ * @param mask Mask applied to each word before comparing (0xFFFFFFFF for exact)
+ * @param values Candidate values
+ * @param value_count Number of candidates (1..REGISTER_MATCH_MAX_VALUES)
+ * @return Index of the first match, or -1 if none or on invalid parameters
+ */
+int register_image_find_first(const uint32_t* image, int count, uint32_t mask,
+                              const uint32_t* values, int value_count) {
+    if (image == NULL || count <= 0) {
+        CHIP_LOG(CHIP_LOG_ERROR, "Error: Invalid parameters for register image scan\n");
+        return -1;
+    }
+    if (!validate_register_pattern(values, value_count)) return -1;
+
+    return find_first_register_word(image, count, mask, values, value_count);
+}
+
+/**
+ * Resolve a register search range to its first bank entry
+ * @param start_addr Starting address for search
+ * @param range Number of registers to search
+ * @return Pointer to the first register, or NULL if the range is invalid
+ */
+static uint32_t* register_search_range(uint32_t start_addr, int range) {
+    if (range <= 0) {
+        CHIP_LOG(CHIP_LOG_ERROR, "Error: Invalid search range\n");
+        return NULL;
+    }
+
+    uint32_t offset = register_offset(start_addr);
+    if (offset >= register_bank_words || (uint32_t)range > register_bank_words - offset) {
+        CHIP_LOG(CHIP_LOG_ERROR, "Error: Search range 0x%08X + %d registers exceeds register bank bounds\n",
+                 start_addr, range);
+        return NULL;
+    }
+    return &register_bank[offset];
 }
 
 /**
@@ -150,34 +1087,434 @@ void bulk_register_read(uint32_t start_addr, uint32_t* buffer, int count) {
  * @return Pointer to first matching register or NULL if not found
  */
 uint32_t* find_register_by_value(uint32_t value, uint32_t start_addr, int range) {
-    if (range <= 0) {
-        printf("Error: Invalid search range\n");
+    uint32_t* start_ptr = register_search_range(start_addr, range);
+    if (start_ptr == NULL) {
         return NULL;
     }
 
-    uint32_t* start_ptr = get_register_pointer(start_addr);
-    if (start_ptr == NULL) {
+    // Vectorized exact-match scan over the range
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    int index = find_first_register_word(start_ptr, range, 0xFFFFFFFFu, &value, 1);
+    if (index >= 0) {
+        uint32_t found_addr = start_addr + (index * sizeof(uint32_t));
+        CHIP_LOG(CHIP_LOG_DEBUG, "Found value 0x%08X at register 0x%08X\n", value, found_addr);
+        return start_ptr + index;
+    }
+
+    CHIP_LOG(CHIP_LOG_DEBUG, "Value 0x%08X not found in specified range\n", value);
+    return NULL;
+}
+
+/**
+ * Find the first register whose masked bits equal a value (no per-call output)
+ * @param value Value to search for, compared against (register & mask)
+ * @param mask Bits of each register that take part in the comparison
+ * @param start_addr Starting address for search
+ * @param range Number of registers to search
+ * @return Pointer to the first matching register or NULL if not found
+ */
+uint32_t* find_register_by_masked_value(uint32_t value, uint32_t mask, uint32_t start_addr, int range) {
+    uint32_t* start_ptr = register_search_range(start_addr, range);
+    if (start_ptr == NULL) return NULL;
+
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    int index = find_first_register_word(start_ptr, range, mask, &value, 1);
+    return index >= 0 ? start_ptr + index : NULL;
+}
+
+/**
+ * Mark every register in a range matching any of up to 8 candidate values
+ * @param start_addr Starting address for search
+ * @param range Number of registers to search
+ * @param mask Mask applied to each register before comparing (0xFFFFFFFF for exact)
+ * @param values Candidate values
+ * @param value_count Number of candidates (1..REGISTER_MATCH_MAX_VALUES)
+ * @param bitmap Output bitmap, (range + 63) / 64 words, bit i set for start_addr + 4*i
+ * @return Number of matching registers, or -1 on invalid parameters
+ */
+int find_registers_matching(uint32_t start_addr, int range, uint32_t mask,
+                            const uint32_t* values, int value_count, uint64_t* bitmap) {
+    uint32_t* start_ptr = register_search_range(start_addr, range);
+    if (start_ptr == NULL) return -1;
+
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return register_image_match_bitmap(start_ptr, range, mask, values, value_count, bitmap);
+}
+
+/**
+ * Compare one-value-at-a-time scanning with the multi-value SIMD scan
+ * Scans a 4 MiB register image for 4 sticky error signatures under a mask.
+ */
+void benchmark_register_pattern_scan(void) {
+    printf("\n--- Register Image Pattern Scan (1M words, 4 signatures) ---\n");
+
+    enum { IMAGE_WORDS = 1 << 20, SIGNATURES = 4, PASSES = 20 };
+    uint32_t* image = malloc(IMAGE_WORDS * sizeof(uint32_t));
+    uint64_t* bitmap = malloc((IMAGE_WORDS / 64) * sizeof(uint64_t));
+    if (image == NULL || bitmap == NULL) {
+        printf("Error: Failed to allocate register image\n");
+        free(image);
+        free(bitmap);
+        return;
+    }
+
+    // Error signatures live in the top byte; the low bits carry a unit id
+    const uint32_t mask = 0xFF00FFFFu;
+    const uint32_t signatures[SIGNATURES] = { 0xE1000BAD, 0xE2000BAD, 0xE4000BAD, 0xE8000BAD };
+    uint32_t seed = 12345;
+    for (int i = 0; i < IMAGE_WORDS; i++) {
+        seed = seed * 1103515245u + 12345u;
+        image[i] = seed & 0x7FFFFFFFu;
+    }
+    for (int i = 4099; i < IMAGE_WORDS; i += 4099) {
+        image[i] = signatures[i % SIGNATURES] | ((uint32_t)(i & 0xFF) << 16);
+    }
+
+    struct timespec start, end;
+    double ns[4];
+    int found[4] = {0};
+
+    // One pass per signature, exact compare per word (the find_register_by_value pattern)
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int pass = 0; pass < PASSES; pass++) {
+        memset(bitmap, 0, (IMAGE_WORDS / 64) * sizeof(uint64_t));
+        for (int s = 0; s < SIGNATURES; s++) {
+            for (int i = 0; i < IMAGE_WORDS; i++) {
+                if ((image[i] & mask) == signatures[s]) bitmap[i >> 6] |= 1ULL << (i & 63);
+            }
+        }
+        __asm__ __volatile__("" : : "r"(bitmap) : "memory");
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    ns[0] = ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / PASSES;
+    for (int w = 0; w < IMAGE_WORDS / 64; w++) found[0] += __builtin_popcountll(bitmap[w]);
+
+    int level = register_scan_level();
+    for (int k = 0; k <= 2; k++) {
+        int use_level = k < level ? k : level;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (int pass = 0; pass < PASSES; pass++) {
+            match_register_words(image, IMAGE_WORDS, mask, signatures, SIGNATURES, bitmap, use_level);
+            __asm__ __volatile__("" : : "r"(bitmap) : "memory");
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        ns[1 + k] = ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / PASSES;
+        for (int w = 0; w < IMAGE_WORDS / 64; w++) found[1 + k] += __builtin_popcountll(bitmap[w]);
+    }
+
+    const char* labels[4] = { "Per-signature passes:", "Multi-value (scalar):",
+                              "Multi-value (SSE2):  ", "Multi-value (AVX2):  " };
+    double bytes = (double)IMAGE_WORDS * sizeof(uint32_t);
+    for (int k = 0; k < 4; k++) {
+        if (k >= 2 && k - 1 > level) {
+            printf("%s      n/a (not supported on this CPU)\n", labels[k]);
+            continue;
+        }
+        printf("%s %8.2f ms  %6.2f GB/s  (%d matches)\n",
+               labels[k], ns[k] / 1e6, bytes / ns[k], found[k]);
+    }
+
+    free(image);
+    free(bitmap);
+}
+
+// Layout header at the start of a file- or shm-backed register bank
+// (must match register_bank_header_t in chip_state.h)
+#define REGISTER_BANK_MAGIC 0x4B4E4252u         // "RBNK"
+#define REGISTER_BANK_VERSION_MAJOR 1
+#define REGISTER_BANK_VERSION_MINOR 0
+#define REGISTER_BANK_BYTE_ORDER 0x01020304u
+#define REGISTER_BANK_HEADER_BYTES 4096u        // Registers start page aligned
+#define REGISTER_BANK_MAX_WORDS (1u << 26)      // 256 MiB; keeps offsets below 2^30
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version_major;
+    uint16_t version_minor;
+    uint32_t header_size;
+    uint32_t byte_order;
+    uint32_t base_address;
+    uint32_t register_stride;
+    uint32_t register_count;
+    uint32_t attach_count;
+    uint64_t total_size;
+} register_bank_header_t;
+
+// Active shared mapping (NULL while the private bank is in use)
+static register_bank_header_t* g_register_mapping = NULL;
+static size_t g_register_mapping_size = 0;
+static pid_t g_register_mapping_pid = 0;
+
+/**
+ * Unmap a shared register bank and return to the process-private bank
+ * The private bank keeps whatever it held before the attach.
+ */
+void register_bank_detach(void) {
+    if (g_register_mapping == NULL) return;
+
+    // A forked child inherits the mapping but never counted itself as attached
+    if (g_register_mapping_pid == getpid()) {
+        __atomic_sub_fetch(&g_register_mapping->attach_count, 1, __ATOMIC_ACQ_REL);
+    }
+    munmap(g_register_mapping, g_register_mapping_size);
+    g_register_mapping = NULL;
+    g_register_mapping_size = 0;
+    register_bank = register_bank_storage;
+    register_bank_words = REGISTER_BANK_SIZE;
+}
+
+/**
+ * Lock or unlock a whole backing object (POSIX record lock, blocks)
+ * @param fd Backing file descriptor
+ * @param type F_WRLCK or F_UNLCK
+ * @return 0 on success, -1 on failure
+ */
+static int lock_register_backing(int fd, short type) {
+    struct flock lock;
+    memset(&lock, 0, sizeof(lock));
+    lock.l_type = type;
+    lock.l_whence = SEEK_SET;
+    return fcntl(fd, F_SETLKW, &lock);
+}
+
+/**
+ * Check an existing backing object's header against this build's layout
+ * @param header Mapped header
+ * @param size Size of the backing object in bytes
+ * @param register_count Required register count, or 0 to accept any
+ * @param name Backing name for messages
+ * @return 1 if compatible, 0 otherwise
+ */
+static int validate_register_header(const register_bank_header_t* header, size_t size,
+                                    uint32_t register_count, const char* name) {
+    if (__atomic_load_n(&header->magic, __ATOMIC_ACQUIRE) != REGISTER_BANK_MAGIC) {
+        printf("Error: %s is not a register bank image\n", name);
+        return 0;
+    }
+    if (header->version_major != REGISTER_BANK_VERSION_MAJOR ||
+        header->byte_order != REGISTER_BANK_BYTE_ORDER) {
+        printf("Error: %s has incompatible layout version %u.%u\n",
+               name, header->version_major, header->version_minor);
+        return 0;
+    }
+    if (header->base_address != BASE_REGISTER_ADDR ||
+        header->register_stride != sizeof(uint32_t) ||
+        header->header_size < sizeof(register_bank_header_t) || header->header_size % 64 != 0 ||
+        header->register_count == 0 || header->register_count > REGISTER_BANK_MAX_WORDS ||
+        header->total_size != (uint64_t)header->header_size + (uint64_t)header->register_count * sizeof(uint32_t) ||
+        header->total_size > size) {
+        printf("Error: %s has an invalid register layout descriptor\n", name);
+        return 0;
+    }
+    if (register_count != 0 && header->register_count != register_count) {
+        printf("Error: %s holds %u registers, %u requested\n",
+               name, header->register_count, register_count);
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * Size a new backing object and publish its header, magic last
+ * @param fd Backing file descriptor (locked)
+ * @param register_count Registers to create (0 selects REGISTER_BANK_SIZE)
+ * @param name Backing name for messages
+ * @param size Output: mapped size in bytes
+ * @return Mapped header, or NULL on failure
+ */
+static register_bank_header_t* create_register_image(int fd, uint32_t register_count,
+                                                     const char* name, size_t* size) {
+    uint32_t count = register_count != 0 ? register_count : REGISTER_BANK_SIZE;
+    *size = REGISTER_BANK_HEADER_BYTES + (size_t)count * sizeof(uint32_t);
+    if (ftruncate(fd, (off_t)*size) != 0) {
+        printf("Error: Cannot size register backing %s to %zu bytes\n", name, *size);
         return NULL;
     }
 
-    // Check if search range is valid
-    uint32_t end_offset = ((start_addr - BASE_REGISTER_ADDR) / sizeof(uint32_t)) + range - 1;
-    if (end_offset >= REGISTER_BANK_SIZE) {
-        printf("Error: Search range would exceed register bank bounds\n");
+    register_bank_header_t* header = mmap(NULL, *size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (header == MAP_FAILED) {
+        printf("Error: Cannot map register backing %s\n", name);
         return NULL;
     }
 
-    // Search for value using pointer arithmetic
-    for (int i = 0; i < range; i++) {
-        if (*(start_ptr + i) == value) {
-            uint32_t found_addr = start_addr + (i * sizeof(uint32_t));
-            printf("Found value 0x%08X at register 0x%08X\n", value, found_addr);
-            return start_ptr + i;
-        }
+    // ftruncate zero-fills, so every register starts at 0
+    header->version_major = REGISTER_BANK_VERSION_MAJOR;
+    header->version_minor = REGISTER_BANK_VERSION_MINOR;
+    header->header_size = REGISTER_BANK_HEADER_BYTES;
+    header->byte_order = REGISTER_BANK_BYTE_ORDER;
+    header->base_address = BASE_REGISTER_ADDR;
+    header->register_stride = sizeof(uint32_t);
+    header->register_count = count;
+    header->attach_count = 0;
+    header->total_size = *size;
+    __atomic_store_n(&header->magic, REGISTER_BANK_MAGIC, __ATOMIC_RELEASE);
+    return header;
+}
+
+/**
+ * Map an existing backing object and check its header
+ * @param fd Backing file descriptor (locked)
+ * @param file_size Size of the object in bytes
+ * @param register_count Required register count, or 0 to accept any
+ * @param name Backing name for messages
+ * @return Mapped header, or NULL if unmappable or incompatible
+ */
+static register_bank_header_t* open_register_image(int fd, size_t file_size, uint32_t register_count,
+                                                   const char* name) {
+    if (file_size < sizeof(register_bank_header_t)) {
+        printf("Error: %s is too small for a register bank header\n", name);
+        return NULL;
     }
 
-    printf("Value 0x%08X not found in specified range\n", value);
-    return NULL;
+    register_bank_header_t* header = mmap(NULL, file_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (header == MAP_FAILED) {
+        printf("Error: Cannot map register backing %s\n", name);
+        return NULL;
+    }
+    if (!validate_register_header(header, file_size, register_count, name)) {
+        munmap(header, file_size);
+        return NULL;
+    }
+    return header;
+}
+
+/**
+ * Map a backing object, creating its layout if empty, and make it the active bank
+ * The whole object is locked while the header is created or checked, so
+ * concurrent attachers never see a half-written header.
+ * @param fd Backing file descriptor (closed by this function)
+ * @param register_count Registers to create, or 0 to use the existing image
+ * @param name Backing name for messages
+ * @return Number of registers in the bank, or -1 on failure
+ */
+static int attach_register_backing(int fd, uint32_t register_count, const char* name) {
+    if (lock_register_backing(fd, F_WRLCK) != 0) {
+        printf("Error: Cannot lock register backing %s\n", name);
+        close(fd);
+        return -1;
+    }
+
+    register_bank_header_t* header = NULL;
+    size_t size = 0;
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        printf("Error: Cannot stat register backing %s\n", name);
+    } else if (st.st_size == 0) {
+        header = create_register_image(fd, register_count, name, &size);
+    } else {
+        size = (size_t)st.st_size;
+        header = open_register_image(fd, size, register_count, name);
+    }
+
+    if (header != NULL) {
+        __atomic_add_fetch(&header->attach_count, 1, __ATOMIC_ACQ_REL);
+    }
+    lock_register_backing(fd, F_UNLCK);
+    close(fd);  // The mapping stays valid
+    if (header == NULL) return -1;
+
+    // Only swap once the new image is known good
+    register_bank_detach();
+    g_register_mapping = header;
+    g_register_mapping_size = size;
+    g_register_mapping_pid = getpid();
+    register_bank = (uint32_t*)((char*)header + header->header_size);
+    register_bank_words = header->register_count;
+    return (int)register_bank_words;
+}
+
+/**
+ * Check a requested register count against the mapped bank limits
+ * @param register_count Requested count (0 means use the existing image)
+ * @return 1 if acceptable, 0 otherwise
+ */
+static int validate_register_count(uint32_t register_count) {
+    if (register_count > REGISTER_BANK_MAX_WORDS) {
+        printf("Error: Register bank of %u registers exceeds limit of %u\n",
+               register_count, REGISTER_BANK_MAX_WORDS);
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * Back the register bank with a memory-mapped file
+ * Creates the file with a fresh (zeroed) image if it does not exist or is
+ * empty; otherwise validates its header and maps the existing registers.
+ * Call before other threads touch the bank: the switch itself is not atomic.
+ * @param path File path
+ * @param register_count Registers to create, or 0 to open an existing image
+ *                       (a new image defaults to REGISTER_BANK_SIZE registers)
+ * @return Number of registers in the bank, or -1 on failure
+ */
+int register_bank_attach_file(const char* path, uint32_t register_count) {
+    if (path == NULL || path[0] == '\0') {
+        printf("Error: Invalid register bank file path\n");
+        return -1;
+    }
+    if (!validate_register_count(register_count)) return -1;
+
+    int fd = open(path, O_RDWR | O_CREAT, 0660);
+    if (fd < 0) {
+        printf("Error: Cannot open register bank file %s\n", path);
+        return -1;
+    }
+    return attach_register_backing(fd, register_count, path);
+}
+
+/**
+ * Back the register bank with a POSIX shared memory object
+ * Same semantics as register_bank_attach_file(); a missing leading '/' is added.
+ * @param name Shared memory object name
+ * @param register_count Registers to create, or 0 to open an existing image
+ * @return Number of registers in the bank, or -1 on failure
+ */
+int register_bank_attach_shm(const char* name, uint32_t register_count) {
+    char shm_name[256];
+    if (name == NULL || name[0] == '\0' ||
+        snprintf(shm_name, sizeof(shm_name), "%s%s", name[0] == '/' ? "" : "/", name) >= (int)sizeof(shm_name)) {
+        printf("Error: Invalid register bank shared memory name\n");
+        return -1;
+    }
+    if (!validate_register_count(register_count)) return -1;
+
+    int fd = shm_open(shm_name, O_RDWR | O_CREAT, 0660);
+    if (fd < 0) {
+        printf("Error: Cannot open shared memory object %s\n", shm_name);
+        return -1;
+    }
+    return attach_register_backing(fd, register_count, shm_name);
+}
+
+/**
+ * Remove a POSIX shared memory register bank (attached processes keep their mapping)
+ * @param name Shared memory object name
+ * @return 0 on success, -1 on failure
+ */
+int register_bank_unlink_shm(const char* name) {
+    char shm_name[256];
+    if (name == NULL || name[0] == '\0' ||
+        snprintf(shm_name, sizeof(shm_name), "%s%s", name[0] == '/' ? "" : "/", name) >= (int)sizeof(shm_name)) {
+        printf("Error: Invalid register bank shared memory name\n");
+        return -1;
+    }
+    return shm_unlink(shm_name);
+}
+
+/**
+ * Number of registers in the active bank
+ * @return Register count (REGISTER_BANK_SIZE for the private bank)
+ */
+uint32_t register_bank_size(void) {
+    return register_bank_words;
+}
+
+/**
+ * Layout header of the active shared bank
+ * @return Mapped header, or NULL while the private bank is in use
+ */
+const register_bank_header_t* register_bank_mapped_header(void) {
+    return g_register_mapping;
 }
 
 /**
@@ -185,10 +1522,12 @@ uint32_t* find_register_by_value(uint32_t value, uint32_t start_addr, int range)
  */
 void init_register_bank(void) {
     // Initialize with a test pattern
-    for (int i = 0; i < REGISTER_BANK_SIZE; i++) {
-        register_bank[i] = 0xDEADBEEF + i;
+    register_before_write(register_bank, register_bank_words);
+    for (uint32_t i = 0; i < register_bank_words; i++) {
+        __atomic_store_n(&register_bank[i], 0xDEADBEEF + i, __ATOMIC_RELAXED);
     }
-    printf("Register bank initialized with test pattern\n");
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    CHIP_LOG(CHIP_LOG_INFO, "Register bank initialized with test pattern\n");
 }
 
 /**
@@ -255,3 +1594,140 @@ void test_pointer_validation(void) {
            validate_register_pointer(invalid_ptr) ? "FAIL" : "PASS");
 }
 
+
+// Register bank stress test layout (word offsets from BASE_REGISTER_ADDR)
+#define STRESS_TOGGLE_REG   (BASE_REGISTER_ADDR + 0x80)  // One toggle bit per writer
+#define STRESS_COUNTER_REG  (BASE_REGISTER_ADDR + 0x84)  // Low 24 bits: CAS counter
+#define STRESS_COUNTER_MASK 0x00FFFFFFu
+
+typedef struct {
+    int index;
+    int ops;
+    bool writer;
+    const int* start_flag;
+    long long reads;
+    int monotonic_violations;
+} register_stress_worker_t;
+
+/**
+ * Stress worker: writers toggle their own bit and bump a shared counter field,
+ * readers poll the counter and check it never goes backwards
+ * @param arg Worker state
+ * @return NULL
+ */
+static void* register_stress_worker(void* arg) {
+    register_stress_worker_t* w = (register_stress_worker_t*)arg;
+
+    while (__atomic_load_n(w->start_flag, __ATOMIC_ACQUIRE) == 0) {
+        // Spin until every thread is created
+    }
+
+    if (w->writer) {
+        uint32_t bit = 1u << (w->index % 8);
+        for (int i = 0; i < w->ops; i++) {
+            register_atomic_toggle_bits(STRESS_TOGGLE_REG, bit);
+
+            // Counter increment through a field CAS (other bits are preserved)
+            uint32_t current = register_atomic_load(STRESS_COUNTER_REG);
+            uint32_t next;
+            do {
+                next = (current & ~STRESS_COUNTER_MASK) | ((current + 1) & STRESS_COUNTER_MASK);
+            } while (!register_atomic_compare_exchange(STRESS_COUNTER_REG, &current, next));
+        }
+    } else {
+        uint32_t last = 0;
+        for (int i = 0; i < w->ops; i++) {
+            uint32_t now = register_atomic_load(STRESS_COUNTER_REG) & STRESS_COUNTER_MASK;
+            if (now < last) w->monotonic_violations++;
+            last = now;
+            w->reads++;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Run concurrent pollers and writers against the shared register bank
+ * Writers use toggle RMWs and CAS field updates; the final register state
+ * must account for every operation with no lost updates.
+ * @param readers Number of polling threads
+ * @param writers Number of writer threads (at most 8)
+ * @param ops Operations per thread
+ * @return 1 if the final state is consistent, 0 otherwise
+ */
+int stress_test_register_bank(int readers, int writers, int ops) {
+    printf("\n=== Register Bank Concurrency Stress Test ===\n");
+
+    if (readers < 0 || writers <= 0 || writers > 8 || ops <= 0) {
+        printf("Error: Invalid stress parameters (%d readers, %d writers, %d ops)\n",
+               readers, writers, ops);
+        return 0;
+    }
+
+    int total = readers + writers;
+    pthread_t* threads = calloc((size_t)total, sizeof(pthread_t));
+    register_stress_worker_t* workers = calloc((size_t)total, sizeof(register_stress_worker_t));
+    if (threads == NULL || workers == NULL) {
+        printf("Error: Failed to allocate stress workers\n");
+        free(threads);
+        free(workers);
+        return 0;
+    }
+
+    register_atomic_store(STRESS_TOGGLE_REG, 0);
+    register_atomic_store(STRESS_COUNTER_REG, 0xA5000000u);  // High byte must survive
+
+    int start_flag = 0;
+    int created = 0;
+    for (int t = 0; t < total; t++) {
+        workers[t].index = t < writers ? t : t - writers;
+        workers[t].ops = ops;
+        workers[t].writer = t < writers;
+        workers[t].start_flag = &start_flag;
+        if (pthread_create(&threads[t], NULL, register_stress_worker, &workers[t]) != 0) break;
+        created++;
+    }
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    __atomic_store_n(&start_flag, 1, __ATOMIC_RELEASE);
+    for (int t = 0; t < created; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    double seconds = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+
+    uint32_t toggles = register_atomic_load(STRESS_TOGGLE_REG);
+    uint32_t counter = register_atomic_load(STRESS_COUNTER_REG);
+    uint32_t expected_toggles = 0;
+    if (ops % 2 != 0) {
+        for (int w = 0; w < writers; w++) expected_toggles ^= 1u << (w % 8);
+    }
+    uint32_t expected_counter = 0xA5000000u |
+        ((uint32_t)((long long)writers * ops) & STRESS_COUNTER_MASK);
+
+    long long reads = 0;
+    int violations = 0;
+    for (int t = 0; t < total; t++) {
+        reads += workers[t].reads;
+        violations += workers[t].monotonic_violations;
+    }
+
+    bool consistent = created == total && toggles == expected_toggles &&
+                      counter == expected_counter && violations == 0;
+
+    printf("Threads: %d readers, %d writers, %d ops each\n", readers, writers, ops);
+    printf("Toggle register: 0x%08X (expected 0x%08X)\n", toggles, expected_toggles);
+    printf("Counter register: 0x%08X (expected 0x%08X)\n", counter, expected_counter);
+    printf("Reader polls: %lld, ordering violations: %d\n", reads, violations);
+    if (seconds > 0.0) {
+        printf("Throughput: %.0f register ops/sec\n",
+               ((double)writers * ops * 3 + (double)reads) / seconds);
+    }
+    printf("Result: %s\n", consistent ? "CONSISTENT" : "LOST UPDATES");
+
+    free(threads);
+    free(workers);
+    return consistent ? 1 : 0;
+}
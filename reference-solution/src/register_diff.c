@@ -0,0 +1,339 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "chip_state.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HAVE_X86_DIFF_KERNELS 1
+#endif
+
+// Rows compared per vector step (8 x 32-bit words)
+#define DIFF_LANES 8
+
+/**
+ * Check whether the AVX2 diff kernel can run on this CPU
+ * @return true if AVX2 is available
+ */
+static bool register_diff_simd_available(void) {
+#ifdef HAVE_X86_DIFF_KERNELS
+    static int has_avx2 = -1;
+    if (has_avx2 < 0) {
+        __builtin_cpu_init();
+        has_avx2 = __builtin_cpu_supports("avx2") ? 1 : 0;
+    }
+    return has_avx2 == 1;
+#else
+    return false;
+#endif
+}
+
+/**
+ * Append one delta if there is room; the total keeps counting past max_deltas
+ * @param deltas Output array
+ * @param max_deltas Capacity of deltas
+ * @param total Changes found so far (incremented)
+ * @param index Delta index (row * columns + column)
+ * @param changed_bits old ^ new
+ */
+static inline void emit_register_delta(register_delta_t* deltas, size_t max_deltas, size_t* total,
+                                       uint32_t index, uint32_t changed_bits) {
+    if (*total < max_deltas) {
+        deltas[*total].index = index;
+        deltas[*total].changed_bits = changed_bits;
+    }
+    (*total)++;
+}
+
+/**
+ * Scalar diff of rows [start, rows) across parallel word columns
+ * @param before Column arrays before
+ * @param after Column arrays after
+ * @param columns Number of columns (1..REGISTER_DELTA_MAX_COLUMNS)
+ * @param start First row
+ * @param rows Row count
+ * @param deltas Output deltas in row-major order
+ * @param max_deltas Capacity of deltas
+ * @param total Running change count
+ */
+static void diff_columns_scalar(const uint32_t* const* before, const uint32_t* const* after, int columns,
+                                size_t start, size_t rows, register_delta_t* deltas, size_t max_deltas,
+                                size_t* total) {
+    for (size_t row = start; row < rows; row++) {
+        for (int c = 0; c < columns; c++) {
+            uint32_t changed = before[c][row] ^ after[c][row];
+            if (changed != 0) {
+                emit_register_delta(deltas, max_deltas, total, (uint32_t)(row * columns + c), changed);
+            }
+        }
+    }
+}
+
+#ifdef HAVE_X86_DIFF_KERNELS
+/**
+ * AVX2 diff: XOR 8 rows of every column and test once; only blocks with a
+ * change are unpacked into deltas
+ * @return First row not processed (a multiple of DIFF_LANES)
+ */
+__attribute__((target("avx2")))
+static size_t diff_columns_avx2(const uint32_t* const* before, const uint32_t* const* after, int columns,
+                                size_t rows, register_delta_t* deltas, size_t max_deltas, size_t* total) {
+    size_t vector_end = rows / DIFF_LANES * DIFF_LANES;
+    uint32_t changed[REGISTER_DELTA_MAX_COLUMNS][DIFF_LANES];
+
+    for (size_t row = 0; row < vector_end; row += DIFF_LANES) {
+        __m256i any = _mm256_setzero_si256();
+        __m256i x[REGISTER_DELTA_MAX_COLUMNS];
+        for (int c = 0; c < columns; c++) {
+            x[c] = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(before[c] + row)),
+                                    _mm256_loadu_si256((const __m256i*)(after[c] + row)));
+            any = _mm256_or_si256(any, x[c]);
+        }
+        if (_mm256_testz_si256(any, any)) continue;
+
+        for (int c = 0; c < columns; c++) {
+            _mm256_storeu_si256((__m256i*)changed[c], x[c]);
+        }
+        for (int lane = 0; lane < DIFF_LANES; lane++) {
+            for (int c = 0; c < columns; c++) {
+                if (changed[c][lane] != 0) {
+                    emit_register_delta(deltas, max_deltas, total,
+                                        (uint32_t)((row + lane) * columns + c), changed[c][lane]);
+                }
+            }
+        }
+    }
+    return vector_end;
+}
+#endif
+
+/**
+ * Diff parallel word columns, vectorized when allowed
+ * @return Total number of changed words
+ */
+static size_t diff_columns(const uint32_t* const* before, const uint32_t* const* after, int columns,
+                           size_t rows, register_delta_t* deltas, size_t max_deltas, bool use_simd) {
+    size_t total = 0;
+    size_t start = 0;
+
+#ifdef HAVE_X86_DIFF_KERNELS
+    if (use_simd && register_diff_simd_available()) {
+        start = diff_columns_avx2(before, after, columns, rows, deltas, max_deltas, &total);
+    }
+#else
+    (void)use_simd;
+#endif
+
+    diff_columns_scalar(before, after, columns, start, rows, deltas, max_deltas, &total);
+    return total;
+}
+
+/**
+ * Compare two register images and emit (index, changed bits) deltas
+ * An array of register_set_t can be passed as 4 * n words; delta indices
+ * then decode with REGISTER_DELTA_CHIP() / REGISTER_DELTA_REGISTER().
+ * @param before Image before
+ * @param after Image after
+ * @param count Number of 32-bit registers in each image
+ * @param deltas Output deltas in index order (may be NULL if max_deltas is 0)
+ * @param max_deltas Capacity of deltas
+ * @param use_simd Allow the AVX2 kernel
+ * @return Total number of changed registers (may exceed max_deltas) or -1 if invalid
+ */
+long register_image_diff(const uint32_t* before, const uint32_t* after, size_t count,
+                         register_delta_t* deltas, size_t max_deltas, bool use_simd) {
+    if (before == NULL || after == NULL || (deltas == NULL && max_deltas > 0) || count > UINT32_MAX) {
+        printf("Error: Invalid parameters for register image diff\n");
+        return -1;
+    }
+
+    const uint32_t* before_columns[1] = { before };
+    const uint32_t* after_columns[1] = { after };
+    return (long)diff_columns(before_columns, after_columns, 1, count, deltas, max_deltas, use_simd);
+}
+
+/**
+ * Apply deltas to a register image (XOR of the changed bits)
+ * All indices are checked before anything is modified.
+ * @param image Image to update
+ * @param count Number of registers in the image
+ * @param deltas Deltas from register_image_diff()
+ * @param delta_count Number of deltas
+ * @return Number of deltas applied or -1 if any index is out of range
+ */
+long register_image_apply_delta(uint32_t* image, size_t count,
+                                const register_delta_t* deltas, size_t delta_count) {
+    if (image == NULL || (deltas == NULL && delta_count > 0)) {
+        printf("Error: Invalid parameters for register delta apply\n");
+        return -1;
+    }
+
+    for (size_t i = 0; i < delta_count; i++) {
+        if (deltas[i].index >= count) {
+            printf("Error: Register delta index %u out of range\n", deltas[i].index);
+            return -1;
+        }
+    }
+    for (size_t i = 0; i < delta_count; i++) {
+        image[deltas[i].index] ^= deltas[i].changed_bits;
+    }
+    return (long)delta_count;
+}
+
+/**
+ * Register arrays of a fleet in register_set_t field order
+ * @param fleet Fleet
+ * @param columns Receives REGISTER_DELTA_MAX_COLUMNS array pointers
+ */
+static void fleet_register_columns(const chip_fleet_t* fleet, uint32_t** columns) {
+    columns[0] = fleet->control_registers;
+    columns[1] = fleet->status_registers;
+    columns[2] = fleet->error_registers;
+    columns[3] = fleet->config_registers;
+}
+
+/**
+ * Compare the registers of two fleets chip by chip
+ * @param before Fleet before
+ * @param after Fleet after (same chip count)
+ * @param deltas Output deltas in chip order; decode with REGISTER_DELTA_CHIP() / _REGISTER()
+ * @param max_deltas Capacity of deltas
+ * @param use_simd Allow the AVX2 kernel
+ * @return Total number of changed registers (may exceed max_deltas) or -1 if invalid
+ */
+long chip_fleet_diff(const chip_fleet_t* before, const chip_fleet_t* after,
+                     register_delta_t* deltas, size_t max_deltas, bool use_simd) {
+    if (before == NULL || after == NULL || (deltas == NULL && max_deltas > 0)) {
+        printf("Error: Invalid parameters for fleet diff\n");
+        return -1;
+    }
+    if (before->count != after->count) {
+        printf("Error: Fleet sizes differ (%d vs %d chips)\n", before->count, after->count);
+        return -1;
+    }
+
+    uint32_t* before_columns[REGISTER_DELTA_MAX_COLUMNS];
+    uint32_t* after_columns[REGISTER_DELTA_MAX_COLUMNS];
+    fleet_register_columns(before, before_columns);
+    fleet_register_columns(after, after_columns);
+    return (long)diff_columns((const uint32_t* const*)before_columns, (const uint32_t* const*)after_columns,
+                              REGISTER_DELTA_MAX_COLUMNS, (size_t)before->count, deltas, max_deltas, use_simd);
+}
+
+/**
+ * Apply fleet deltas to a fleet's registers
+ * All indices are checked before anything is modified.
+ * @param fleet Fleet to update
+ * @param deltas Deltas from chip_fleet_diff()
+ * @param delta_count Number of deltas
+ * @return Number of deltas applied or -1 if any chip is out of range
+ */
+long chip_fleet_apply_delta(chip_fleet_t* fleet, const register_delta_t* deltas, size_t delta_count) {
+    if (fleet == NULL || (deltas == NULL && delta_count > 0)) {
+        printf("Error: Invalid parameters for fleet delta apply\n");
+        return -1;
+    }
+
+    for (size_t i = 0; i < delta_count; i++) {
+        if (REGISTER_DELTA_CHIP(deltas[i]) >= (uint32_t)fleet->count) {
+            printf("Error: Fleet delta chip %u out of range\n", REGISTER_DELTA_CHIP(deltas[i]));
+            return -1;
+        }
+    }
+
+    uint32_t* columns[REGISTER_DELTA_MAX_COLUMNS];
+    fleet_register_columns(fleet, columns);
+    for (size_t i = 0; i < delta_count; i++) {
+        columns[REGISTER_DELTA_REGISTER(deltas[i])][REGISTER_DELTA_CHIP(deltas[i])] ^= deltas[i].changed_bits;
+    }
+    return (long)delta_count;
+}
+
+/**
+ * Compare formatting every register (as update_chip_registers() did) with
+ * scalar and AVX2 delta extraction over a fleet where 1% of chips change
+ * @param chip_count Number of chips
+ */
+void benchmark_register_diff(int chip_count) {
+    printf("\n--- Register Diff (%d chips, 1%% changed) ---\n", chip_count);
+
+    chip_fleet_t* before = create_chip_fleet(chip_count);
+    chip_fleet_t* after = create_chip_fleet(chip_count);
+    register_delta_t* deltas = malloc((size_t)(chip_count > 0 ? chip_count : 1) * 4 * sizeof(register_delta_t));
+    if (before == NULL || after == NULL || deltas == NULL) {
+        printf("Failed to allocate benchmark fleets\n");
+        destroy_chip_fleet(before);
+        destroy_chip_fleet(after);
+        free(deltas);
+        return;
+    }
+
+    chip_state_t chip;
+    memset(&chip, 0, sizeof(chip));
+    for (int i = 0; i < chip_count; i++) {
+        chip.registers.control_register = 0x1000u + (uint32_t)i;
+        chip.registers.status_register = 0x2000u + (uint32_t)i;
+        chip.registers.config_register = (uint32_t)i * 2654435761u;
+        chip_fleet_add(before, &chip);
+        if (i % 100 == 0) chip.registers.status_register |= 0x80000000u;
+        chip_fleet_add(after, &chip);
+    }
+
+    const int iterations = 50;
+    char line[96];
+    struct timespec start, end;
+
+    // Format old -> new for all four registers of every chip
+    size_t formatted = 0;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int it = 0; it < iterations; it++) {
+        uint32_t* old_columns[REGISTER_DELTA_MAX_COLUMNS];
+        uint32_t* new_columns[REGISTER_DELTA_MAX_COLUMNS];
+        fleet_register_columns(before, old_columns);
+        fleet_register_columns(after, new_columns);
+        formatted = 0;
+        for (int i = 0; i < chip_count; i++) {
+            for (int c = 0; c < REGISTER_DELTA_MAX_COLUMNS; c++) {
+                formatted += (size_t)snprintf(line, sizeof(line), "  0x%08X -> 0x%08X\n",
+                                              old_columns[c][i], new_columns[c][i]);
+            }
+        }
+        __asm__ __volatile__("" : : "r"(line) : "memory");
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double format_us = ((end.tv_sec - start.tv_sec) * 1e6 + (end.tv_nsec - start.tv_nsec) / 1e3) / iterations;
+
+    double diff_us[2];
+    long changes[2];
+    for (int simd = 0; simd < 2; simd++) {
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (int it = 0; it < iterations; it++) {
+            changes[simd] = chip_fleet_diff(before, after, deltas, (size_t)chip_count * 4, simd == 1);
+            __asm__ __volatile__("" : : "r"(deltas) : "memory");
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        diff_us[simd] = ((end.tv_sec - start.tv_sec) * 1e6 + (end.tv_nsec - start.tv_nsec) / 1e3) / iterations;
+    }
+
+    // Round trip: applying the deltas to the old fleet reproduces the new one
+    chip_fleet_apply_delta(before, deltas, (size_t)changes[1]);
+    long remaining = chip_fleet_diff(before, after, NULL, 0, true);
+
+    printf("Format all registers: %10.1f us (%zu bytes of text)\n", format_us, formatted);
+    printf("Scalar delta:         %10.1f us (%ld changes)\n", diff_us[0], changes[0]);
+    printf("%s delta:           %10.1f us (%ld changes, %zu bytes)\n",
+           register_diff_simd_available() ? "AVX2" : "Scalar", diff_us[1], changes[1],
+           (size_t)changes[1] * sizeof(register_delta_t));
+    printf("Delta round trip:     %s\n", remaining == 0 ? "EXACT" : "MISMATCH");
+    if (diff_us[1] > 0.0) printf("Speedup over formatting: %.0fx\n", format_us / diff_us[1]);
+
+    destroy_chip_fleet(before);
+    destroy_chip_fleet(after);
+    free(deltas);
+}
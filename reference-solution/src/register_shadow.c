@@ -0,0 +1,324 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "chip_state.h"
+
+// Bus address of register 0 (must match BASE_REGISTER_ADDR in pointer_registers.c)
+#define SHADOW_BASE_ADDR 0x40000000u
+
+/**
+ * Monotonic clock in nanoseconds
+ * @return Current time
+ */
+static uint64_t shadow_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * Translate a register address to a shadow index
+ * @param shadow Shadow to index
+ * @param address Register address
+ * @param index Output index
+ * @return 1 if the address is covered by the shadow, 0 otherwise
+ */
+static int shadow_index(const register_shadow_t* shadow, uint32_t address, uint32_t* index) {
+    uint32_t offset = (address - SHADOW_BASE_ADDR) / sizeof(uint32_t);
+    if (offset >= shadow->register_count) {
+        printf("Error: Shadow register address 0x%08X out of range\n", address);
+        return 0;
+    }
+    *index = offset;
+    return 1;
+}
+
+/**
+ * Store a value in the shadow and mark it dirty, coalescing repeat writes
+ * @param shadow Shadow to update
+ * @param index Register index
+ * @param value New value
+ */
+static void shadow_mark_dirty(register_shadow_t* shadow, uint32_t index, uint32_t value) {
+    uint64_t bit = 1ULL << (index & 63);
+
+    shadow->shadow[index] = value;
+    shadow->writes++;
+    if (shadow->dirty[index >> 6] & bit) {
+        shadow->coalesced_writes++;
+        return;
+    }
+
+    shadow->dirty[index >> 6] |= bit;
+    if (shadow->dirty_count++ == 0 && shadow->flush_interval_ms != 0) {
+        shadow->first_dirty_ns = shadow_now_ns();
+    }
+}
+
+/**
+ * Commit if the batch size or age threshold has been reached
+ * @param shadow Shadow to check
+ * @return Registers written back, 0 if no threshold was hit, -1 on failure
+ */
+static int shadow_auto_commit(register_shadow_t* shadow) {
+    if (shadow->dirty_count == 0) return 0;
+
+    if (shadow->batch_limit != 0 && shadow->dirty_count >= shadow->batch_limit) {
+        return register_shadow_commit(shadow);
+    }
+    if (shadow->flush_interval_ms != 0 &&
+        shadow_now_ns() - shadow->first_dirty_ns >= (uint64_t)shadow->flush_interval_ms * 1000000ull) {
+        return register_shadow_commit(shadow);
+    }
+    return 0;
+}
+
+/**
+ * Create a write-back shadow over the current register bank
+ * The shadow starts as a copy of the bank (sized to register_bank_size()).
+ * Writes stay in the shadow until commit or until a threshold is reached;
+ * reads are served from the shadow.
+ * @param batch_limit Auto-commit once this many registers are dirty (0 = off)
+ * @param flush_interval_ms Auto-commit once the oldest dirty write is this old (0 = off)
+ * @return New shadow or NULL if failed
+ */
+register_shadow_t* create_register_shadow(uint32_t batch_limit, uint32_t flush_interval_ms) {
+    register_shadow_t* shadow = calloc(1, sizeof(register_shadow_t));
+    if (shadow == NULL) {
+        printf("Error: Failed to allocate register shadow\n");
+        return NULL;
+    }
+
+    uint32_t count = register_bank_size();
+    shadow->register_count = count;
+    shadow->batch_limit = batch_limit;
+    shadow->flush_interval_ms = flush_interval_ms;
+    shadow->shadow = malloc((size_t)count * sizeof(uint32_t));
+    shadow->dirty = calloc((count + 63) / 64, sizeof(uint64_t));
+    // Worst case alternates dirty and clean registers
+    shadow->runs = malloc((size_t)(count / 2 + 1) * sizeof(register_segment_t));
+    shadow->packed = malloc((size_t)count * sizeof(uint32_t));
+    if (shadow->shadow == NULL || shadow->dirty == NULL ||
+        shadow->runs == NULL || shadow->packed == NULL) {
+        printf("Error: Failed to allocate register shadow for %u registers\n", count);
+        destroy_register_shadow(shadow);
+        return NULL;
+    }
+
+    register_segment_t whole = { SHADOW_BASE_ADDR, (int)count };
+    if (register_readv(&whole, 1, shadow->shadow) < 0) {
+        destroy_register_shadow(shadow);
+        return NULL;
+    }
+    return shadow;
+}
+
+/**
+ * Write back any dirty registers and release the shadow
+ * @param shadow Shadow to destroy
+ */
+void destroy_register_shadow(register_shadow_t* shadow) {
+    if (shadow == NULL) return;
+
+    if (shadow->dirty != NULL && shadow->dirty_count != 0) {
+        register_shadow_commit(shadow);
+    }
+    free(shadow->shadow);
+    free(shadow->dirty);
+    free(shadow->runs);
+    free(shadow->packed);
+    free(shadow);
+}
+
+/**
+ * Read a register from the shadow (no bank access)
+ * @param shadow Shadow to read
+ * @param address Register address
+ * @return Register value or 0 if invalid address
+ */
+uint32_t register_shadow_read(const register_shadow_t* shadow, uint32_t address) {
+    uint32_t index;
+    if (shadow == NULL || !shadow_index(shadow, address, &index)) return 0;
+
+    return shadow->shadow[index];
+}
+
+/**
+ * Write a register through the shadow
+ * Repeated writes to a dirty register only update the shadow copy.
+ * @param shadow Shadow to write
+ * @param address Register address
+ * @param value Value to write
+ * @return 1 if successful, 0 if invalid address or failed auto-commit
+ */
+int register_shadow_write(register_shadow_t* shadow, uint32_t address, uint32_t value) {
+    uint32_t index;
+    if (shadow == NULL || !shadow_index(shadow, address, &index)) return 0;
+
+    shadow_mark_dirty(shadow, index, value);
+    return shadow_auto_commit(shadow) >= 0 ? 1 : 0;
+}
+
+/**
+ * Update a bit field of a register through the shadow
+ * @param shadow Shadow to write
+ * @param address Register address
+ * @param mask Field mask within the register
+ * @param shift Field position
+ * @param value New field value (unshifted)
+ * @return 1 if successful, 0 if invalid address or failed auto-commit
+ */
+int register_shadow_update_field(register_shadow_t* shadow, uint32_t address,
+                                 uint32_t mask, int shift, uint32_t value) {
+    uint32_t index;
+    if (shadow == NULL || !shadow_index(shadow, address, &index)) return 0;
+
+    uint32_t updated = (shadow->shadow[index] & ~mask) | ((value << shift) & mask);
+    shadow_mark_dirty(shadow, index, updated);
+    return shadow_auto_commit(shadow) >= 0 ? 1 : 0;
+}
+
+/**
+ * Write every dirty register back to the bank in address order
+ * Adjacent dirty registers are merged into runs and written with one
+ * register_writev() call, so each register is written once per commit.
+ * @param shadow Shadow to commit
+ * @return Registers written back, or -1 on failure (dirty state is kept)
+ */
+int register_shadow_commit(register_shadow_t* shadow) {
+    if (shadow == NULL) return -1;
+    if (shadow->dirty_count == 0) return 0;
+
+    uint32_t words = (shadow->register_count + 63) / 64;
+    uint32_t run_count = 0;
+    uint32_t packed_count = 0;
+    uint32_t run_end = 0;
+
+    for (uint32_t w = 0; w < words; w++) {
+        uint64_t bits = shadow->dirty[w];
+        while (bits != 0) {
+            uint32_t index = w * 64 + (uint32_t)__builtin_ctzll(bits);
+            bits &= bits - 1;
+            if (run_count > 0 && index == run_end) {
+                shadow->runs[run_count - 1].count++;
+            } else {
+                shadow->runs[run_count].address = SHADOW_BASE_ADDR + index * sizeof(uint32_t);
+                shadow->runs[run_count].count = 1;
+                run_count++;
+            }
+            run_end = index + 1;
+            shadow->packed[packed_count++] = shadow->shadow[index];
+        }
+    }
+
+    if (register_writev(shadow->runs, (int)run_count, shadow->packed) < 0) {
+        printf("Error: Shadow commit of %u registers failed\n", packed_count);
+        return -1;
+    }
+
+    memset(shadow->dirty, 0, words * sizeof(uint64_t));
+    shadow->dirty_count = 0;
+    shadow->flushed_registers += packed_count;
+    shadow->flush_runs += run_count;
+    shadow->commits++;
+    return (int)packed_count;
+}
+
+/**
+ * Commit if the age threshold has passed (for callers with no writes due)
+ * @param shadow Shadow to check
+ * @return Registers written back, or -1 on failure
+ */
+int register_shadow_poll(register_shadow_t* shadow) {
+    if (shadow == NULL) return -1;
+
+    return shadow_auto_commit(shadow);
+}
+
+/**
+ * Reload clean registers from the bank (picks up hardware-side changes)
+ * Dirty registers keep their pending values.
+ * @param shadow Shadow to refresh
+ * @return Registers reloaded, or -1 on failure
+ */
+int register_shadow_refresh(register_shadow_t* shadow) {
+    if (shadow == NULL) return -1;
+
+    register_segment_t whole = { SHADOW_BASE_ADDR, (int)shadow->register_count };
+    if (register_readv(&whole, 1, shadow->packed) < 0) return -1;
+
+    int reloaded = 0;
+    for (uint32_t i = 0; i < shadow->register_count; i++) {
+        if (!(shadow->dirty[i >> 6] & (1ULL << (i & 63)))) {
+            shadow->shadow[i] = shadow->packed[i];
+            reloaded++;
+        }
+    }
+    return reloaded;
+}
+
+/**
+ * Compare direct register writes with the write-back shadow
+ * Models a configuration sequence: 64 consecutive registers, each built up
+ * from eight 4-bit field writes.
+ * @param sequences Number of configuration sequences to run
+ */
+void benchmark_register_shadow(int sequences) {
+    printf("\n--- Register Shadow Write-Back (%d config sequences) ---\n", sequences);
+
+    enum { CONFIG_REGISTERS = 64, FIELDS = 8, FIRST_REGISTER = 16 };
+    if (sequences <= 0 || register_bank_size() < FIRST_REGISTER + CONFIG_REGISTERS) {
+        printf("Error: Invalid register shadow benchmark parameters\n");
+        return;
+    }
+
+    struct timespec start, end;
+    uint64_t direct_writes = 0;
+
+    // Direct: every field update is a read-modify-write on the bank
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int s = 0; s < sequences; s++) {
+        for (int f = 0; f < FIELDS; f++) {
+            for (int r = 0; r < CONFIG_REGISTERS; r++) {
+                uint32_t address = SHADOW_BASE_ADDR + (uint32_t)(FIRST_REGISTER + r) * sizeof(uint32_t);
+                register_atomic_update_field(address, 0xFu << (f * 4), f * 4, (uint32_t)(s + r + f), NULL);
+                direct_writes++;
+            }
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double direct_ms = (end.tv_sec - start.tv_sec) * 1e3 + (end.tv_nsec - start.tv_nsec) / 1e6;
+
+    register_shadow_t* shadow = create_register_shadow(0, 0);
+    if (shadow == NULL) return;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int s = 0; s < sequences; s++) {
+        for (int f = 0; f < FIELDS; f++) {
+            for (int r = 0; r < CONFIG_REGISTERS; r++) {
+                uint32_t address = SHADOW_BASE_ADDR + (uint32_t)(FIRST_REGISTER + r) * sizeof(uint32_t);
+                register_shadow_update_field(shadow, address, 0xFu << (f * 4), f * 4, (uint32_t)(s + r + f));
+            }
+        }
+        register_shadow_commit(shadow);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double shadow_ms = (end.tv_sec - start.tv_sec) * 1e3 + (end.tv_nsec - start.tv_nsec) / 1e6;
+
+    printf("Direct field writes:  %8.2f ms, %llu bank writes\n",
+           direct_ms, (unsigned long long)direct_writes);
+    printf("Shadow + commit:      %8.2f ms, %llu bank writes in %llu runs (%llu coalesced)\n",
+           shadow_ms, (unsigned long long)shadow->flushed_registers,
+           (unsigned long long)shadow->flush_runs, (unsigned long long)shadow->coalesced_writes);
+    if (shadow->flushed_registers > 0) {
+        printf("Bank write traffic reduced %.1fx\n",
+               (double)direct_writes / (double)shadow->flushed_registers);
+    }
+    destroy_register_shadow(shadow);
+}
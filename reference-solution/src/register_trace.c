@@ -0,0 +1,680 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "chip_state.h"
+
+// Bus address of register 0 (must match BASE_REGISTER_ADDR in pointer_registers.c)
+#define TRACE_BASE_ADDR 0x40000000u
+
+// Trace file header
+#define REGISTER_TRACE_MAGIC 0x43525452u       // "RTRC"
+#define REGISTER_TRACE_VERSION 1
+#define REGISTER_TRACE_BYTE_ORDER 0x01020304u
+
+#define REGISTER_TRACE_DEFAULT_ENTRIES 65536
+#define REGISTER_TRACE_FILE_BUFFER 65536
+#define REGISTER_TRACE_MAX_RECORD 32           // Tag + time (10) + index (10) + old (5) + xor (5)
+
+// Record tag bits (low two bits hold the REGISTER_TRACE_* op)
+#define TRACE_TAG_NEXT_INDEX 0x04   // Register follows the previous one
+#define TRACE_TAG_SAME_INDEX 0x08   // Same register as the previous record
+#define TRACE_TAG_OLD_KNOWN  0x10   // Old value equals the last value seen for the register
+#define TRACE_TAG_UNCHANGED  0x20   // New value equals old value
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t header_size;
+    uint32_t byte_order;
+    uint32_t base_address;
+    uint32_t table_size;        // Registers covered by the last-value table
+    uint32_t reserved;
+} register_trace_header_t;
+
+// One ring slot; sequence implements the bounded MPMC queue protocol
+typedef struct {
+    uint64_t sequence;
+    uint64_t timestamp_ns;
+    uint32_t address;
+    uint32_t old_value;
+    uint32_t new_value;
+    uint32_t op;
+} register_trace_slot_t;
+
+// Encoder/decoder state shared by the file writer and the replayer
+typedef struct {
+    uint32_t* last_value;
+    uint32_t table_size;
+    uint32_t prev_index;
+    uint64_t prev_timestamp;
+} register_trace_codec_t;
+
+typedef struct {
+    register_trace_slot_t* ring;
+    uint64_t mask;
+    uint64_t enqueue_pos __attribute__((aligned(64)));
+    uint64_t dequeue_pos __attribute__((aligned(64)));
+    uint64_t dropped __attribute__((aligned(64)));
+    uint64_t recorded;
+    uint64_t start_ns;
+    FILE* file;
+    unsigned char* buffer;
+    size_t buffered;
+    uint64_t bytes_written;
+    register_trace_codec_t codec;
+    pthread_t drain_thread;
+    int running;
+} register_trace_t;
+
+// Checked by every register access in pointer_registers.c
+int g_register_trace_active = 0;
+static register_trace_t* g_trace = NULL;
+// Producers between loading g_trace and publishing their slot; stop waits for zero
+static int g_trace_inflight = 0;
+
+/**
+ * Monotonic clock in nanoseconds
+ * @return Current time
+ */
+static uint64_t trace_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * Append an unsigned LEB128 varint
+ * @param out Output buffer
+ * @param value Value to encode
+ * @return Bytes written
+ */
+static size_t put_varint(unsigned char* out, uint64_t value) {
+    size_t n = 0;
+    while (value >= 0x80) {
+        out[n++] = (unsigned char)(value | 0x80);
+        value >>= 7;
+    }
+    out[n++] = (unsigned char)value;
+    return n;
+}
+
+/**
+ * Read an unsigned LEB128 varint
+ * @param in Input cursor (advanced)
+ * @param end End of input
+ * @param value Decoded value
+ * @return 1 if successful, 0 if truncated or overlong
+ */
+static int get_varint(const unsigned char** in, const unsigned char* end, uint64_t* value) {
+    uint64_t result = 0;
+    for (int shift = 0; shift < 64 && *in < end; shift += 7) {
+        unsigned char byte = *(*in)++;
+        result |= (uint64_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            *value = result;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Zigzag-map a signed delta so small magnitudes encode in one byte
+ * @param v Signed value
+ * @return Mapped value
+ */
+static uint64_t zigzag(int64_t v) {
+    return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63);
+}
+
+/**
+ * Inverse of zigzag()
+ * @param v Mapped value
+ * @return Signed value
+ */
+static int64_t unzigzag(uint64_t v) {
+    return (int64_t)(v >> 1) ^ -(int64_t)(v & 1);
+}
+
+/**
+ * Set up codec state (both sides start with an all-zero last-value table)
+ * @param codec Codec to initialize
+ * @param table_size Registers covered by the table
+ * @return 1 if successful, 0 if allocation failed
+ */
+static int trace_codec_init(register_trace_codec_t* codec, uint32_t table_size) {
+    memset(codec, 0, sizeof(*codec));
+    codec->table_size = table_size;
+    codec->last_value = calloc(table_size != 0 ? table_size : 1, sizeof(uint32_t));
+    return codec->last_value != NULL;
+}
+
+/**
+ * Encode one access as a compact record
+ * Timestamps and register indices are delta coded; the old value is
+ * omitted when it matches the last value traced for that register, and
+ * the new value is stored as an XOR against the old value.
+ * @param codec Encoder state
+ * @param slot Access to encode
+ * @param out Output (at least REGISTER_TRACE_MAX_RECORD bytes)
+ * @return Bytes written
+ */
+static size_t trace_encode(register_trace_codec_t* codec, const register_trace_slot_t* slot, unsigned char* out) {
+    uint32_t index = (slot->address - TRACE_BASE_ADDR) / sizeof(uint32_t);
+    unsigned char tag = (unsigned char)slot->op;
+    size_t n = 1;
+
+    if (index == codec->prev_index + 1) tag |= TRACE_TAG_NEXT_INDEX;
+    else if (index == codec->prev_index) tag |= TRACE_TAG_SAME_INDEX;
+    bool in_table = index < codec->table_size;
+    if (in_table && codec->last_value[index] == slot->old_value) tag |= TRACE_TAG_OLD_KNOWN;
+    if (slot->new_value == slot->old_value) tag |= TRACE_TAG_UNCHANGED;
+
+    // Producers on different threads can land slightly out of timestamp order
+    n += put_varint(out + n, zigzag((int64_t)(slot->timestamp_ns - codec->prev_timestamp)));
+    if (!(tag & (TRACE_TAG_NEXT_INDEX | TRACE_TAG_SAME_INDEX))) {
+        n += put_varint(out + n, zigzag((int64_t)index - (int64_t)codec->prev_index));
+    }
+    if (!(tag & TRACE_TAG_OLD_KNOWN)) n += put_varint(out + n, slot->old_value);
+    if (!(tag & TRACE_TAG_UNCHANGED)) n += put_varint(out + n, slot->new_value ^ slot->old_value);
+    out[0] = tag;
+
+    codec->prev_index = index;
+    codec->prev_timestamp = slot->timestamp_ns;
+    if (in_table) codec->last_value[index] = slot->new_value;
+    return n;
+}
+
+/**
+ * Decode one record produced by trace_encode()
+ * @param codec Decoder state
+ * @param in Input cursor (advanced)
+ * @param end End of input
+ * @param slot Decoded access (address is register aligned)
+ * @return 1 if successful, 0 if the record is truncated or corrupt
+ */
+static int trace_decode(register_trace_codec_t* codec, const unsigned char** in, const unsigned char* end,
+                        register_trace_slot_t* slot) {
+    if (*in >= end) return 0;
+    unsigned char tag = *(*in)++;
+    uint64_t value;
+
+    slot->op = tag & 0x03;
+    if (slot->op > REGISTER_TRACE_RMW || !get_varint(in, end, &value)) return 0;
+    slot->timestamp_ns = codec->prev_timestamp + (uint64_t)unzigzag(value);
+
+    uint32_t index;
+    if (tag & TRACE_TAG_NEXT_INDEX) {
+        index = codec->prev_index + 1;
+    } else if (tag & TRACE_TAG_SAME_INDEX) {
+        index = codec->prev_index;
+    } else {
+        if (!get_varint(in, end, &value)) return 0;
+        index = (uint32_t)((int64_t)codec->prev_index + unzigzag(value));
+    }
+    bool in_table = index < codec->table_size;
+
+    if (tag & TRACE_TAG_OLD_KNOWN) {
+        if (!in_table) return 0;
+        slot->old_value = codec->last_value[index];
+    } else {
+        if (!get_varint(in, end, &value)) return 0;
+        slot->old_value = (uint32_t)value;
+    }
+    if (tag & TRACE_TAG_UNCHANGED) {
+        slot->new_value = slot->old_value;
+    } else {
+        if (!get_varint(in, end, &value)) return 0;
+        slot->new_value = slot->old_value ^ (uint32_t)value;
+    }
+
+    slot->address = TRACE_BASE_ADDR + index * sizeof(uint32_t);
+    codec->prev_index = index;
+    codec->prev_timestamp = slot->timestamp_ns;
+    if (in_table) codec->last_value[index] = slot->new_value;
+    return 1;
+}
+
+/**
+ * Record one register access (called from the pointer_registers.c access paths)
+ * Lock-free multi-producer enqueue; when the ring is full the record is
+ * dropped and counted rather than stalling the register access.
+ * @param op REGISTER_TRACE_READ, REGISTER_TRACE_WRITE or REGISTER_TRACE_RMW
+ * @param address Register address
+ * @param old_value Register value before the access
+ * @param new_value Register value after the access
+ */
+void register_trace_record(int op, uint32_t address, uint32_t old_value, uint32_t new_value) {
+    __atomic_add_fetch(&g_trace_inflight, 1, __ATOMIC_SEQ_CST);
+    register_trace_t* trace = __atomic_load_n(&g_trace, __ATOMIC_SEQ_CST);
+    if (trace == NULL) {
+        __atomic_sub_fetch(&g_trace_inflight, 1, __ATOMIC_RELEASE);
+        return;
+    }
+
+    uint64_t now = trace_now_ns();
+    uint64_t pos = __atomic_load_n(&trace->enqueue_pos, __ATOMIC_RELAXED);
+    register_trace_slot_t* slot;
+    for (;;) {
+        slot = &trace->ring[pos & trace->mask];
+        uint64_t seq = __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE);
+        int64_t diff = (int64_t)(seq - pos);
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&trace->enqueue_pos, &pos, pos + 1, true,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if (diff < 0) {
+            __atomic_add_fetch(&trace->dropped, 1, __ATOMIC_RELAXED);
+            __atomic_sub_fetch(&g_trace_inflight, 1, __ATOMIC_RELEASE);
+            return;
+        } else {
+            pos = __atomic_load_n(&trace->enqueue_pos, __ATOMIC_RELAXED);
+        }
+    }
+
+    slot->timestamp_ns = now - trace->start_ns;
+    slot->address = address;
+    slot->old_value = old_value;
+    slot->new_value = new_value;
+    slot->op = (uint32_t)op;
+    __atomic_store_n(&slot->sequence, pos + 1, __ATOMIC_RELEASE);
+    __atomic_sub_fetch(&g_trace_inflight, 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * Write buffered records to the trace file
+ * @param trace Active trace
+ */
+static void trace_flush_buffer(register_trace_t* trace) {
+    if (trace->buffered == 0) return;
+
+    fwrite(trace->buffer, 1, trace->buffered, trace->file);
+    trace->bytes_written += trace->buffered;
+    trace->buffered = 0;
+}
+
+/**
+ * Move every published ring entry into the file buffer (single consumer)
+ * @param trace Active trace
+ * @return Records drained
+ */
+static size_t trace_drain(register_trace_t* trace) {
+    size_t drained = 0;
+    uint64_t pos = trace->dequeue_pos;
+
+    for (;;) {
+        register_trace_slot_t* slot = &trace->ring[pos & trace->mask];
+        if (__atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE) != pos + 1) break;
+
+        if (trace->buffered + REGISTER_TRACE_MAX_RECORD > REGISTER_TRACE_FILE_BUFFER) {
+            trace_flush_buffer(trace);
+        }
+        trace->buffered += trace_encode(&trace->codec, slot, trace->buffer + trace->buffered);
+        __atomic_store_n(&slot->sequence, pos + trace->mask + 1, __ATOMIC_RELEASE);
+        pos++;
+        drained++;
+    }
+
+    trace->dequeue_pos = pos;
+    trace->recorded += drained;
+    return drained;
+}
+
+/**
+ * Background drain loop: empty the ring, sleep briefly when idle
+ * @param arg Active trace
+ * @return NULL
+ */
+static void* trace_drain_worker(void* arg) {
+    register_trace_t* trace = (register_trace_t*)arg;
+    struct timespec idle = { 0, 200000 };
+
+    while (__atomic_load_n(&trace->running, __ATOMIC_ACQUIRE)) {
+        if (trace_drain(trace) == 0) nanosleep(&idle, NULL);
+    }
+    return NULL;
+}
+
+/**
+ * Release a trace and everything it owns
+ * @param trace Trace to free (may be partially constructed)
+ */
+static void free_register_trace(register_trace_t* trace) {
+    if (trace == NULL) return;
+
+    if (trace->file != NULL) fclose(trace->file);
+    free(trace->codec.last_value);
+    free(trace->buffer);
+    free(trace->ring);
+    free(trace);
+}
+
+/**
+ * Start recording every register access to a compact binary trace file
+ * Records go into a lock-free ring drained by a background thread.
+ * @param path Output file (truncated)
+ * @param ring_entries Ring capacity, rounded up to a power of two (0 = 65536)
+ * @return 1 if recording started, 0 otherwise
+ */
+int register_trace_start(const char* path, size_t ring_entries) {
+    if (path == NULL) {
+        printf("Error: Invalid register trace path\n");
+        return 0;
+    }
+    if (g_trace != NULL) {
+        printf("Error: Register trace already running\n");
+        return 0;
+    }
+
+    size_t capacity = 1;
+    size_t wanted = ring_entries != 0 ? ring_entries : REGISTER_TRACE_DEFAULT_ENTRIES;
+    while (capacity < wanted) capacity <<= 1;
+
+    register_trace_t* trace = calloc(1, sizeof(register_trace_t));
+    if (trace == NULL) {
+        printf("Error: Failed to allocate register trace\n");
+        return 0;
+    }
+    trace->ring = calloc(capacity, sizeof(register_trace_slot_t));
+    trace->buffer = malloc(REGISTER_TRACE_FILE_BUFFER);
+    trace->file = fopen(path, "wb");
+    if (trace->ring == NULL || trace->buffer == NULL || trace->file == NULL ||
+        !trace_codec_init(&trace->codec, register_bank_size())) {
+        printf("Error: Failed to set up register trace %s\n", path);
+        free_register_trace(trace);
+        return 0;
+    }
+    trace->mask = capacity - 1;
+    for (size_t i = 0; i < capacity; i++) {
+        trace->ring[i].sequence = i;
+    }
+
+    register_trace_header_t header;
+    memset(&header, 0, sizeof(header));
+    header.magic = REGISTER_TRACE_MAGIC;
+    header.version = REGISTER_TRACE_VERSION;
+    header.header_size = sizeof(header);
+    header.byte_order = REGISTER_TRACE_BYTE_ORDER;
+    header.base_address = TRACE_BASE_ADDR;
+    header.table_size = trace->codec.table_size;
+    if (fwrite(&header, sizeof(header), 1, trace->file) != 1) {
+        printf("Error: Failed to write register trace header\n");
+        free_register_trace(trace);
+        return 0;
+    }
+    trace->bytes_written = sizeof(header);
+
+    trace->start_ns = trace_now_ns();
+    trace->running = 1;
+    if (pthread_create(&trace->drain_thread, NULL, trace_drain_worker, trace) != 0) {
+        printf("Error: Failed to start register trace drain thread\n");
+        free_register_trace(trace);
+        return 0;
+    }
+
+    __atomic_store_n(&g_trace, trace, __ATOMIC_RELEASE);
+    __atomic_store_n(&g_register_trace_active, 1, __ATOMIC_RELEASE);
+    return 1;
+}
+
+/**
+ * Stop recording, drain the ring and close the trace file
+ * Waits for accesses already being recorded on other threads to land.
+ * @param stats Receives final counters (may be NULL)
+ * @return 1 if a trace was stopped, 0 if none was running
+ */
+int register_trace_stop(register_trace_stats_t* stats) {
+    register_trace_t* trace = g_trace;
+    if (trace == NULL) return 0;
+
+    __atomic_store_n(&g_register_trace_active, 0, __ATOMIC_RELEASE);
+    __atomic_store_n(&g_trace, NULL, __ATOMIC_SEQ_CST);
+    while (__atomic_load_n(&g_trace_inflight, __ATOMIC_SEQ_CST) != 0) {
+        // Spin until in-flight producers have published or dropped their record
+    }
+    __atomic_store_n(&trace->running, 0, __ATOMIC_RELEASE);
+    pthread_join(trace->drain_thread, NULL);
+
+    trace_drain(trace);
+    trace_flush_buffer(trace);
+
+    if (stats != NULL) {
+        stats->recorded = trace->recorded;
+        stats->dropped = __atomic_load_n(&trace->dropped, __ATOMIC_RELAXED);
+        stats->bytes_written = trace->bytes_written;
+    }
+    free_register_trace(trace);
+    return 1;
+}
+
+/**
+ * Check whether register accesses are being traced
+ * @return true while a trace is recording
+ */
+bool register_trace_active(void) {
+    return __atomic_load_n(&g_register_trace_active, __ATOMIC_ACQUIRE) != 0;
+}
+
+/**
+ * Load a whole trace file and validate its header
+ * @param path Trace file
+ * @param size Output: file size in bytes
+ * @return File contents (caller frees) or NULL on failure
+ */
+static unsigned char* load_register_trace(const char* path, size_t* size) {
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        printf("Error: Cannot open register trace %s\n", path);
+        return NULL;
+    }
+
+    unsigned char* data = NULL;
+    long length = -1;
+    if (fseek(file, 0, SEEK_END) == 0) length = ftell(file);
+    if (length >= (long)sizeof(register_trace_header_t) && fseek(file, 0, SEEK_SET) == 0) {
+        data = malloc((size_t)length);
+        if (data != NULL && fread(data, 1, (size_t)length, file) != (size_t)length) {
+            free(data);
+            data = NULL;
+        }
+    }
+    fclose(file);
+
+    if (data == NULL) {
+        printf("Error: Cannot read register trace %s\n", path);
+        return NULL;
+    }
+
+    register_trace_header_t header;
+    memcpy(&header, data, sizeof(header));
+    if (header.magic != REGISTER_TRACE_MAGIC || header.version != REGISTER_TRACE_VERSION ||
+        header.byte_order != REGISTER_TRACE_BYTE_ORDER || header.base_address != TRACE_BASE_ADDR ||
+        header.header_size < sizeof(header) || header.header_size > (size_t)length) {
+        printf("Error: %s is not a compatible register trace\n", path);
+        free(data);
+        return NULL;
+    }
+
+    *size = (size_t)length;
+    return data;
+}
+
+/**
+ * Sleep or spin until a replay deadline
+ * @param deadline_ns Monotonic time to wait for
+ */
+static void replay_wait_until(uint64_t deadline_ns) {
+    for (;;) {
+        uint64_t now = trace_now_ns();
+        if (now >= deadline_ns) return;
+        if (deadline_ns - now > 100000) {
+            // Sleep most of the gap, spin the last stretch for accuracy
+            uint64_t nap = deadline_ns - now - 50000;
+            struct timespec ts = { (time_t)(nap / 1000000000ull), (long)(nap % 1000000000ull) };
+            nanosleep(&ts, NULL);
+        }
+    }
+}
+
+/**
+ * Re-apply a register trace to the current bank
+ * The first access to each register seeds it with the recorded old value,
+ * so a fresh bank reaches the traced state; later accesses whose recorded
+ * old value disagrees with the bank are counted as mismatches. Racing
+ * writers on different threads are ordered as they entered the ring, which
+ * can differ from the order they hit the bank; that also shows up as a mismatch.
+ * @param path Trace file from register_trace_start()
+ * @param paced Reproduce the original inter-access timing (false = full speed)
+ * @param stats Receives replay counters (may be NULL)
+ * @return Records replayed, or -1 on failure
+ */
+long long register_trace_replay(const char* path, bool paced, register_replay_stats_t* stats) {
+    if (path == NULL) {
+        printf("Error: Invalid register trace path\n");
+        return -1;
+    }
+    if (register_trace_active()) {
+        printf("Error: Cannot replay a register trace while recording one\n");
+        return -1;
+    }
+
+    size_t size = 0;
+    unsigned char* data = load_register_trace(path, &size);
+    if (data == NULL) return -1;
+
+    register_trace_header_t header;
+    memcpy(&header, data, sizeof(header));
+    register_trace_codec_t codec;
+    uint32_t bank_size = register_bank_size();
+    uint8_t* seen = calloc(bank_size, 1);
+    if (seen == NULL || !trace_codec_init(&codec, header.table_size)) {
+        printf("Error: Failed to allocate register replay state\n");
+        free(seen);
+        free(data);
+        return -1;
+    }
+
+    register_replay_stats_t local;
+    memset(&local, 0, sizeof(local));
+    const unsigned char* in = data + header.header_size;
+    const unsigned char* end = data + size;
+    uint64_t start = trace_now_ns();
+    register_trace_slot_t slot;
+    bool corrupt = false;
+
+    while (in < end) {
+        if (!trace_decode(&codec, &in, end, &slot)) {
+            corrupt = true;
+            break;
+        }
+        if (paced) replay_wait_until(start + slot.timestamp_ns);
+
+        uint32_t index = (slot.address - TRACE_BASE_ADDR) / sizeof(uint32_t);
+        if (index >= bank_size) {
+            local.out_of_range++;
+            continue;
+        }
+        if (!seen[index]) {
+            seen[index] = 1;
+            register_atomic_store(slot.address, slot.old_value);
+        } else if (register_atomic_load(slot.address) != slot.old_value) {
+            local.mismatches++;
+        }
+
+        if (slot.op == REGISTER_TRACE_READ) {
+            local.reads++;
+        } else {
+            register_atomic_store(slot.address, slot.new_value);
+            local.writes++;
+        }
+        local.records++;
+        local.trace_span_ns = slot.timestamp_ns;
+    }
+    local.elapsed_ns = trace_now_ns() - start;
+
+    free(codec.last_value);
+    free(seen);
+    free(data);
+
+    if (corrupt) {
+        printf("Error: Register trace %s is truncated or corrupt after %llu records\n",
+               path, (unsigned long long)local.records);
+    }
+    if (stats != NULL) *stats = local;
+    return corrupt ? -1 : (long long)local.records;
+}
+
+/**
+ * Measure tracing overhead, trace size versus printf logging, and replay speed
+ * @param accesses Register accesses to trace
+ */
+void benchmark_register_trace(int accesses) {
+    printf("\n--- Register Access Trace (%d accesses) ---\n", accesses);
+
+    if (accesses <= 0 || register_trace_active()) {
+        printf("Error: Invalid register trace benchmark parameters\n");
+        return;
+    }
+
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/register_trace_%d.bin", (int)getpid());
+    uint32_t registers = register_bank_size() < 64 ? register_bank_size() : 64;
+    struct timespec start, end;
+    size_t printf_bytes = 0;
+    char line[64];
+
+    // Untraced baseline: poll status registers, update a few control registers
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < accesses; i++) {
+        uint32_t address = TRACE_BASE_ADDR + (uint32_t)(i % registers) * sizeof(uint32_t);
+        if (i % 4 == 0) register_atomic_store(address, (uint32_t)i);
+        else register_atomic_load(address);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double off_ns = ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / accesses;
+
+    register_trace_stats_t stats;
+    if (!register_trace_start(path, 0)) return;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < accesses; i++) {
+        uint32_t address = TRACE_BASE_ADDR + (uint32_t)(i % registers) * sizeof(uint32_t);
+        if (i % 4 == 0) register_atomic_store(address, (uint32_t)i);
+        else register_atomic_load(address);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double on_ns = ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / accesses;
+    register_trace_stop(&stats);
+
+    // Size of the equivalent write_register_via_pointer()/bulk read printf log
+    for (int i = 0; i < accesses; i++) {
+        uint32_t address = TRACE_BASE_ADDR + (uint32_t)(i % registers) * sizeof(uint32_t);
+        int n = i % 4 == 0 ? snprintf(line, sizeof(line), "Register 0x%08X = 0x%08X\n", address, (uint32_t)i)
+                           : snprintf(line, sizeof(line), "Read Register 0x%08X = 0x%08X\n", address, (uint32_t)i);
+        printf_bytes += (size_t)n;
+    }
+
+    register_replay_stats_t replay;
+    long long replayed = register_trace_replay(path, false, &replay);
+    remove(path);
+
+    printf("Untraced access:   %8.1f ns\n", off_ns);
+    printf("Traced access:     %8.1f ns (%llu recorded, %llu dropped)\n", on_ns,
+           (unsigned long long)stats.recorded, (unsigned long long)stats.dropped);
+    printf("Trace file:        %8llu bytes (%.2f bytes/access)\n", (unsigned long long)stats.bytes_written,
+           (double)stats.bytes_written / (double)(stats.recorded != 0 ? stats.recorded : 1));
+    printf("printf log:        %8zu bytes (%.1fx larger)\n", printf_bytes,
+           (double)printf_bytes / (double)(stats.bytes_written != 0 ? stats.bytes_written : 1));
+    if (replayed > 0 && replay.elapsed_ns > 0) {
+        printf("Replay:            %8.1f M records/s (%llu mismatches)\n",
+               (double)replayed * 1e3 / (double)replay.elapsed_ns, (unsigned long long)replay.mismatches);
+    }
+}
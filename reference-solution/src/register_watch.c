@@ -0,0 +1,397 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "chip_state.h"
+
+// Bus address of register 0 (must match BASE_REGISTER_ADDR in pointer_registers.c)
+#define WATCH_BASE_ADDR 0x40000000u
+
+#define MAX_REGISTER_WATCHES 64
+
+// Watch kinds
+#define WATCH_KIND_BIT   1
+#define WATCH_KIND_RANGE 2
+
+typedef struct {
+    bool in_use;
+    int kind;
+    uint32_t index;            // Register index in the bank
+    uint32_t mask;             // Bit or field mask
+    int shift;                 // Field position
+    int edges;                 // REGISTER_WATCH_RISING / _FALLING (bit watches)
+    uint32_t min_value;        // Allowed field range (range watches)
+    uint32_t max_value;
+    chip_event_callback_t callback;
+    chip_state_t* chip;
+    int event_type;
+    uint64_t hits;
+} register_watch_t;
+
+// Pending notification, delivered after the watch lock is dropped
+typedef struct {
+    chip_event_callback_t callback;
+    chip_state_t* chip;
+    int event_type;
+} register_watch_event_t;
+
+// Published mask table read by the register write path; NULL while no watch is set
+register_watch_table_t* g_register_watch_table = NULL;
+
+static register_watch_t g_watches[MAX_REGISTER_WATCHES];
+static int g_watch_count = 0;
+static register_watch_table_t* g_watch_storage = NULL;   // Kept allocated while unpublished
+static pthread_mutex_t g_watch_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * Combined mask of every watch on one register (lock held)
+ * @param index Register index
+ * @return Bits any watch on the register depends on
+ */
+static uint32_t watch_mask_for(uint32_t index) {
+    uint32_t mask = 0;
+    for (int i = 0; i < MAX_REGISTER_WATCHES; i++) {
+        if (g_watches[i].in_use && g_watches[i].index == index) mask |= g_watches[i].mask;
+    }
+    return mask;
+}
+
+/**
+ * Make sure the mask table covers the current bank (lock held)
+ * Growing replaces the table, so writers must not race with a bank resize
+ * while watches are being added.
+ * @return 1 if successful, 0 if allocation failed
+ */
+static int ensure_watch_table(void) {
+    uint32_t words = register_bank_size();
+    if (g_watch_storage != NULL && g_watch_storage->words == words) return 1;
+
+    register_watch_table_t* table = calloc(1, sizeof(register_watch_table_t) + (size_t)words * sizeof(uint32_t));
+    if (table == NULL) {
+        printf("Error: Failed to allocate register watch table\n");
+        return 0;
+    }
+    table->words = words;
+    for (int i = 0; i < MAX_REGISTER_WATCHES; i++) {
+        if (g_watches[i].in_use && g_watches[i].index < words) {
+            table->masks[g_watches[i].index] |= g_watches[i].mask;
+        }
+    }
+
+    register_watch_table_t* old = g_watch_storage;
+    if (__atomic_load_n(&g_register_watch_table, __ATOMIC_RELAXED) != NULL) {
+        __atomic_store_n(&g_register_watch_table, table, __ATOMIC_RELEASE);
+    }
+    g_watch_storage = table;
+    free(old);
+    return 1;
+}
+
+/**
+ * Install a watch and publish its mask (lock held)
+ * @param watch Fully described watch
+ * @return Watch id or -1 if the table is full
+ */
+static int install_watch(const register_watch_t* watch) {
+    if (!ensure_watch_table()) return -1;
+
+    for (int id = 0; id < MAX_REGISTER_WATCHES; id++) {
+        if (g_watches[id].in_use) continue;
+
+        g_watches[id] = *watch;
+        g_watches[id].in_use = true;
+        g_watch_count++;
+        __atomic_fetch_or(&g_watch_storage->masks[watch->index], watch->mask, __ATOMIC_RELEASE);
+        __atomic_store_n(&g_register_watch_table, g_watch_storage, __ATOMIC_RELEASE);
+        return id;
+    }
+    printf("Error: Register watch table full (%d watches)\n", MAX_REGISTER_WATCHES);
+    return -1;
+}
+
+/**
+ * Convert a register address to a bank index
+ * @param address Register address
+ * @param index Receives the index
+ * @return 1 if the address is a valid register, 0 otherwise
+ */
+static int watch_register_index(uint32_t address, uint32_t* index) {
+    if ((address - WATCH_BASE_ADDR) % sizeof(uint32_t) != 0 || get_register_pointer(address) == NULL) {
+        printf("Error: Cannot watch invalid register address 0x%08X\n", address);
+        return 0;
+    }
+    *index = (address - WATCH_BASE_ADDR) / sizeof(uint32_t);
+    return 1;
+}
+
+/**
+ * Watch one bit of a register for transitions
+ * @param address Register address
+ * @param bit Bit number (0-31)
+ * @param edges REGISTER_WATCH_RISING, REGISTER_WATCH_FALLING or both
+ * @param callback Notification (trigger_chip_callbacks fans out to registered callbacks)
+ * @param chip Chip passed to the callback
+ * @param event_type Event passed to the callback (EVENT_*)
+ * @return Watch id or -1 if failed
+ */
+int register_watch_bit(uint32_t address, int bit, int edges,
+                       chip_event_callback_t callback, chip_state_t* chip, int event_type) {
+    if (bit < 0 || bit > 31 || (edges & REGISTER_WATCH_BOTH) == 0 || callback == NULL) {
+        printf("Error: Invalid parameters for bit watch\n");
+        return -1;
+    }
+
+    register_watch_t watch = { 0 };
+    if (!watch_register_index(address, &watch.index)) return -1;
+    watch.kind = WATCH_KIND_BIT;
+    watch.mask = 1U << bit;
+    watch.shift = bit;
+    watch.edges = edges & REGISTER_WATCH_BOTH;
+    watch.callback = callback;
+    watch.chip = chip;
+    watch.event_type = event_type;
+
+    pthread_mutex_lock(&g_watch_lock);
+    int id = install_watch(&watch);
+    pthread_mutex_unlock(&g_watch_lock);
+    return id;
+}
+
+/**
+ * Watch a register field for leaving an allowed range
+ * Fires on each write that moves the field from inside [min_value, max_value] to outside.
+ * @param address Register address
+ * @param position Field position
+ * @param width Field width in bits (1-32)
+ * @param min_value Lowest allowed field value
+ * @param max_value Highest allowed field value
+ * @param callback Notification (trigger_chip_callbacks fans out to registered callbacks)
+ * @param chip Chip passed to the callback
+ * @param event_type Event passed to the callback (EVENT_*)
+ * @return Watch id or -1 if failed
+ */
+int register_watch_field(uint32_t address, int position, int width, uint32_t min_value, uint32_t max_value,
+                         chip_event_callback_t callback, chip_state_t* chip, int event_type) {
+    if (position < 0 || width < 1 || position + width > 32 || min_value > max_value || callback == NULL) {
+        printf("Error: Invalid parameters for field watch\n");
+        return -1;
+    }
+
+    register_watch_t watch = { 0 };
+    if (!watch_register_index(address, &watch.index)) return -1;
+    watch.kind = WATCH_KIND_RANGE;
+    watch.mask = (width == 32 ? 0xFFFFFFFFu : ((1U << width) - 1)) << position;
+    watch.shift = position;
+    watch.min_value = min_value;
+    watch.max_value = max_value;
+    watch.callback = callback;
+    watch.chip = chip;
+    watch.event_type = event_type;
+
+    pthread_mutex_lock(&g_watch_lock);
+    int id = install_watch(&watch);
+    pthread_mutex_unlock(&g_watch_lock);
+    return id;
+}
+
+/**
+ * Remove a watch
+ * @param watch_id Id from register_watch_bit() / register_watch_field()
+ * @return 1 if removed, 0 if no such watch
+ */
+int register_watch_remove(int watch_id) {
+    if (watch_id < 0 || watch_id >= MAX_REGISTER_WATCHES) return 0;
+
+    pthread_mutex_lock(&g_watch_lock);
+    if (!g_watches[watch_id].in_use) {
+        pthread_mutex_unlock(&g_watch_lock);
+        return 0;
+    }
+
+    uint32_t index = g_watches[watch_id].index;
+    g_watches[watch_id].in_use = false;
+    g_watch_count--;
+    if (index < g_watch_storage->words) {
+        __atomic_store_n(&g_watch_storage->masks[index], watch_mask_for(index), __ATOMIC_RELEASE);
+    }
+    if (g_watch_count == 0) __atomic_store_n(&g_register_watch_table, NULL, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&g_watch_lock);
+    return 1;
+}
+
+/**
+ * Remove every watch
+ */
+void register_watch_clear(void) {
+    for (int id = 0; id < MAX_REGISTER_WATCHES; id++) {
+        register_watch_remove(id);
+    }
+}
+
+/**
+ * Number of notifications a watch has produced
+ * @param watch_id Watch id
+ * @return Hit count, or 0 if no such watch
+ */
+uint64_t register_watch_hits(int watch_id) {
+    if (watch_id < 0 || watch_id >= MAX_REGISTER_WATCHES) return 0;
+
+    pthread_mutex_lock(&g_watch_lock);
+    uint64_t hits = g_watches[watch_id].in_use ? g_watches[watch_id].hits : 0;
+    pthread_mutex_unlock(&g_watch_lock);
+    return hits;
+}
+
+/**
+ * Check whether a write triggers a watch
+ * @param watch Watch
+ * @param old_value Register value before the write
+ * @param new_value Register value after the write
+ * @return true if the watch fires
+ */
+static bool watch_triggered(const register_watch_t* watch, uint32_t old_value, uint32_t new_value) {
+    if (watch->kind == WATCH_KIND_BIT) {
+        bool was_set = (old_value & watch->mask) != 0;
+        bool is_set = (new_value & watch->mask) != 0;
+        return (!was_set && is_set && (watch->edges & REGISTER_WATCH_RISING)) ||
+               (was_set && !is_set && (watch->edges & REGISTER_WATCH_FALLING));
+    }
+
+    uint32_t old_field = (old_value & watch->mask) >> watch->shift;
+    uint32_t new_field = (new_value & watch->mask) >> watch->shift;
+    bool was_inside = old_field >= watch->min_value && old_field <= watch->max_value;
+    bool is_inside = new_field >= watch->min_value && new_field <= watch->max_value;
+    return was_inside && !is_inside;
+}
+
+/**
+ * Slow path of the write hook: a watched bit of this register changed
+ * Callbacks run on the writing thread after the watch lock is released.
+ * @param index Register index
+ * @param old_value Register value before the write
+ * @param new_value Register value after the write
+ * @return Number of notifications delivered
+ */
+int register_watch_fire(uint32_t index, uint32_t old_value, uint32_t new_value) {
+    register_watch_event_t events[MAX_REGISTER_WATCHES];
+    int count = 0;
+
+    pthread_mutex_lock(&g_watch_lock);
+    for (int i = 0; i < MAX_REGISTER_WATCHES; i++) {
+        register_watch_t* watch = &g_watches[i];
+        if (!watch->in_use || watch->index != index) continue;
+        if (!watch_triggered(watch, old_value, new_value)) continue;
+
+        watch->hits++;
+        events[count].callback = watch->callback;
+        events[count].chip = watch->chip;
+        events[count].event_type = watch->event_type;
+        count++;
+    }
+    pthread_mutex_unlock(&g_watch_lock);
+
+    for (int i = 0; i < count; i++) {
+        events[i].callback(events[i].chip, events[i].event_type);
+    }
+    return count;
+}
+
+// Benchmark notification sink
+static volatile int g_benchmark_watch_events = 0;
+
+/**
+ * Count benchmark notifications
+ * @param chip Unused
+ * @param event_type Unused
+ */
+static void count_watch_event(chip_state_t* chip, int event_type) {
+    (void)chip;
+    (void)event_type;
+    g_benchmark_watch_events++;
+}
+
+/**
+ * Zero the benchmark status registers
+ * @param count Number of registers from the start of the bank
+ */
+static void clear_status_registers(int count) {
+    for (int r = 0; r < count; r++) {
+        register_atomic_store(WATCH_BASE_ADDR + r * sizeof(uint32_t), 0);
+    }
+}
+
+/**
+ * Compare polling status registers for error-bit transitions with watchpoints
+ * on the write path. 64 status registers are written round robin, raising the
+ * error bit on one pass in 32.
+ * @param writes Number of register writes
+ */
+void benchmark_register_watch(int writes) {
+    printf("\n--- Register Watchpoints (%d writes, 64 status registers) ---\n", writes);
+
+    enum { STATUS_REGISTERS = 64, ERROR_BIT = 2 };
+    if (writes <= 0 || __atomic_load_n(&g_register_watch_table, __ATOMIC_RELAXED) != NULL) {
+        printf("Error: Invalid watch benchmark parameters\n");
+        return;
+    }
+
+    uint32_t last_seen[STATUS_REGISTERS] = { 0 };
+    struct timespec start, end;
+    clear_status_registers(STATUS_REGISTERS);
+
+    // Polling: write, then rescan every status register for a rising error bit
+    int polled_events = 0;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < writes; i++) {
+        int r = i % STATUS_REGISTERS;
+        uint32_t value = ((i / STATUS_REGISTERS) % 32 == 31) ? (1U << ERROR_BIT) : 0;
+        register_atomic_store(WATCH_BASE_ADDR + r * sizeof(uint32_t), value);
+        for (int p = 0; p < STATUS_REGISTERS; p++) {
+            uint32_t now = register_atomic_load(WATCH_BASE_ADDR + p * sizeof(uint32_t));
+            if ((now & ~last_seen[p]) & (1U << ERROR_BIT)) polled_events++;
+            last_seen[p] = now;
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double poll_ns = ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / writes;
+
+    // Unwatched: the same writes with no watch installed
+    clear_status_registers(STATUS_REGISTERS);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < writes; i++) {
+        uint32_t value = ((i / STATUS_REGISTERS) % 32 == 31) ? (1U << ERROR_BIT) : 0;
+        register_atomic_store(WATCH_BASE_ADDR + (i % STATUS_REGISTERS) * sizeof(uint32_t), value);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double plain_ns = ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / writes;
+
+    // Watched: a rising-edge watch on every status register's error bit
+    int ids[STATUS_REGISTERS];
+    for (int r = 0; r < STATUS_REGISTERS; r++) {
+        ids[r] = register_watch_bit(WATCH_BASE_ADDR + r * sizeof(uint32_t), ERROR_BIT,
+                                    REGISTER_WATCH_RISING, count_watch_event, NULL, EVENT_ERROR);
+    }
+    clear_status_registers(STATUS_REGISTERS);
+    g_benchmark_watch_events = 0;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < writes; i++) {
+        uint32_t value = ((i / STATUS_REGISTERS) % 32 == 31) ? (1U << ERROR_BIT) : 0;
+        register_atomic_store(WATCH_BASE_ADDR + (i % STATUS_REGISTERS) * sizeof(uint32_t), value);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double watch_ns = ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / writes;
+    for (int r = 0; r < STATUS_REGISTERS; r++) {
+        register_watch_remove(ids[r]);
+    }
+
+    printf("Write + poll all:     %8.1f ns/write (%d events)\n", poll_ns, polled_events);
+    printf("Write, no watches:    %8.1f ns/write\n", plain_ns);
+    printf("Write, watched:       %8.1f ns/write (%d events)\n", watch_ns, g_benchmark_watch_events);
+    if (watch_ns > 0.0) printf("Speedup over polling: %.1fx\n", poll_ns / watch_ns);
+}
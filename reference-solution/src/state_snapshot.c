@@ -0,0 +1,553 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "chip_state.h"
+
+// Bus address of register 0 (must match BASE_REGISTER_ADDR in pointer_registers.c)
+#define SNAPSHOT_BASE_ADDR 0x40000000u
+
+// Copy-on-write granularity: one cache line (16 registers)
+#define SNAPSHOT_BLOCK_SIZE 64
+#define SNAPSHOT_REGION_COUNT 2
+
+// Live memory covered by snapshots (written back through snapshot_write_block())
+typedef struct {
+    const unsigned char* base;
+    size_t size;
+    size_t block_count;
+    uint64_t* block_epoch;     // Newest snapshot epoch whose copy of the block is taken
+} snapshot_region_t;
+
+// A snapshot keeps the pre-write copy of each block first written after it
+// was taken; blocks it never saved are found in newer snapshots or live.
+struct state_snapshot {
+    uint64_t epoch;
+    struct state_snapshot* older;
+    struct state_snapshot* newer;
+    unsigned char** saved[SNAPSHOT_REGION_COUNT];   // Per block, NULL until preserved
+    size_t* saved_list[SNAPSHOT_REGION_COUNT];      // Indices of preserved blocks
+    size_t saved_count[SNAPSHOT_REGION_COUNT];
+    size_t saved_capacity[SNAPSHOT_REGION_COUNT];
+};
+
+// Checked by every register and system state write
+int g_snapshot_active = 0;
+
+static snapshot_region_t g_regions[SNAPSHOT_REGION_COUNT];
+static state_snapshot_t* g_newest_snapshot = NULL;
+static uint64_t g_snapshot_epoch_counter = 0;
+static uint64_t g_current_epoch = 0;
+static pthread_mutex_t g_snapshot_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * Bytes of a block actually covered by its region (the last block may be short)
+ * @param region Region
+ * @param block Block index
+ * @return Block length in bytes
+ */
+static size_t snapshot_block_length(const snapshot_region_t* region, size_t block) {
+    size_t offset = block * SNAPSHOT_BLOCK_SIZE;
+    return region->size - offset < SNAPSHOT_BLOCK_SIZE ? region->size - offset : SNAPSHOT_BLOCK_SIZE;
+}
+
+/**
+ * Copy a block, using whole-word atomic accesses for the register bank
+ * @param region_id Region the block belongs to
+ * @param dst Destination
+ * @param src Source
+ * @param length Bytes (a multiple of 4 for registers)
+ */
+static void snapshot_copy_block(int region_id, void* dst, const void* src, size_t length) {
+    if (region_id == SNAPSHOT_REGION_REGISTERS) {
+        uint32_t* d = dst;
+        const uint32_t* s = src;
+        for (size_t i = 0; i < length / sizeof(uint32_t); i++) {
+            __atomic_store_n(&d[i], __atomic_load_n(&s[i], __ATOMIC_RELAXED), __ATOMIC_RELAXED);
+        }
+    } else {
+        memcpy(dst, src, length);
+    }
+}
+
+/**
+ * Point the regions at the current register bank and system state
+ * Block epoch tables are kept across snapshots (epochs only grow) and are
+ * rebuilt only when the bank has been attached or detached.
+ * @return 1 if successful, 0 if the bank changed under live snapshots or allocation failed
+ */
+static int snapshot_prepare_regions(void) {
+    const unsigned char* bases[SNAPSHOT_REGION_COUNT] = {
+        (const unsigned char*)get_register_pointer(SNAPSHOT_BASE_ADDR),
+        (const unsigned char*)get_system_state()
+    };
+    size_t sizes[SNAPSHOT_REGION_COUNT] = {
+        (size_t)register_bank_size() * sizeof(uint32_t),
+        sizeof(system_state_t)
+    };
+
+    for (int r = 0; r < SNAPSHOT_REGION_COUNT; r++) {
+        snapshot_region_t* region = &g_regions[r];
+        if (region->base == bases[r] && region->size == sizes[r]) continue;
+
+        if (g_newest_snapshot != NULL) {
+            printf("Error: Register bank changed while snapshots are live\n");
+            return 0;
+        }
+        size_t blocks = (sizes[r] + SNAPSHOT_BLOCK_SIZE - 1) / SNAPSHOT_BLOCK_SIZE;
+        uint64_t* epochs = calloc(blocks, sizeof(uint64_t));
+        if (epochs == NULL) {
+            printf("Error: Failed to allocate snapshot block table\n");
+            return 0;
+        }
+        free(region->block_epoch);
+        region->base = bases[r];
+        region->size = sizes[r];
+        region->block_count = blocks;
+        region->block_epoch = epochs;
+    }
+    return 1;
+}
+
+/**
+ * Attach a preserved block copy to a snapshot (lock held)
+ * @param snapshot Snapshot to hold the copy
+ * @param region_id Region
+ * @param block Block index
+ * @param copy Block contents, owned by the snapshot on success
+ * @return 1 if successful, 0 if allocation failed
+ */
+static int snapshot_keep_block(state_snapshot_t* snapshot, int region_id, size_t block, unsigned char* copy) {
+    if (snapshot->saved[region_id] == NULL) {
+        snapshot->saved[region_id] = calloc(g_regions[region_id].block_count, sizeof(unsigned char*));
+        if (snapshot->saved[region_id] == NULL) return 0;
+    }
+    if (snapshot->saved_count[region_id] == snapshot->saved_capacity[region_id]) {
+        size_t capacity = snapshot->saved_capacity[region_id] ? snapshot->saved_capacity[region_id] * 2 : 64;
+        size_t* list = realloc(snapshot->saved_list[region_id], capacity * sizeof(size_t));
+        if (list == NULL) return 0;
+        snapshot->saved_list[region_id] = list;
+        snapshot->saved_capacity[region_id] = capacity;
+    }
+    snapshot->saved[region_id][block] = copy;
+    snapshot->saved_list[region_id][snapshot->saved_count[region_id]++] = block;
+    return 1;
+}
+
+/**
+ * Save the live copy of a block into the newest snapshot (lock held)
+ * @param region_id Region
+ * @param block Block index
+ * @return 1 if the block is preserved, 0 if allocation failed
+ */
+static int snapshot_preserve_block(int region_id, size_t block) {
+    snapshot_region_t* region = &g_regions[region_id];
+    state_snapshot_t* newest = g_newest_snapshot;
+
+    if (newest == NULL || region->block_epoch[block] >= newest->epoch) return 1;
+
+    if (newest->saved[region_id] == NULL || newest->saved[region_id][block] == NULL) {
+        unsigned char* copy = malloc(SNAPSHOT_BLOCK_SIZE);
+        if (copy == NULL) return 0;
+        snapshot_copy_block(region_id, copy, region->base + block * SNAPSHOT_BLOCK_SIZE,
+                            snapshot_block_length(region, block));
+        if (!snapshot_keep_block(newest, region_id, block, copy)) {
+            free(copy);
+            return 0;
+        }
+    }
+    __atomic_store_n(&region->block_epoch[block], newest->epoch, __ATOMIC_RELEASE);
+    return 1;
+}
+
+/**
+ * Write a saved block back to live memory (the block is already preserved)
+ * @param region_id Region the block belongs to
+ * @param block Block index
+ * @param data Saved block contents
+ */
+static void snapshot_write_block(int region_id, size_t block, const unsigned char* data) {
+    const snapshot_region_t* region = &g_regions[region_id];
+    size_t offset = block * SNAPSHOT_BLOCK_SIZE;
+    size_t length = snapshot_block_length(region, block);
+
+    if (region_id == SNAPSHOT_REGION_REGISTERS) {
+        unsigned char* bank = (unsigned char*)get_register_pointer(SNAPSHOT_BASE_ADDR);
+        snapshot_copy_block(region_id, bank + offset, data, length);
+    } else {
+        restore_system_state_bytes(offset, data, length);
+    }
+}
+
+/**
+ * Copy-on-write hook: call before modifying live register or system memory
+ * Blocks already preserved for the newest snapshot cost one load each.
+ * @param region_id SNAPSHOT_REGION_REGISTERS or SNAPSHOT_REGION_SYSTEM
+ * @param address First byte about to change
+ * @param length Bytes about to change
+ */
+void snapshot_before_write(int region_id, const void* address, size_t length) {
+    if (region_id < 0 || region_id >= SNAPSHOT_REGION_COUNT || length == 0) return;
+
+    snapshot_region_t* region = &g_regions[region_id];
+    const unsigned char* p = address;
+    if (region->base == NULL || p < region->base || p >= region->base + region->size) return;
+
+    size_t first = (size_t)(p - region->base) / SNAPSHOT_BLOCK_SIZE;
+    size_t end = (size_t)(p - region->base) + length;
+    if (end > region->size) end = region->size;
+    size_t last = (end - 1) / SNAPSHOT_BLOCK_SIZE;
+    uint64_t epoch = __atomic_load_n(&g_current_epoch, __ATOMIC_ACQUIRE);
+
+    for (size_t block = first; block <= last; block++) {
+        if (__atomic_load_n(&region->block_epoch[block], __ATOMIC_ACQUIRE) >= epoch) continue;
+
+        pthread_mutex_lock(&g_snapshot_lock);
+        if (!snapshot_preserve_block(region_id, block)) {
+            printf("Error: Snapshot copy-on-write allocation failed; snapshot may be incomplete\n");
+        }
+        pthread_mutex_unlock(&g_snapshot_lock);
+    }
+}
+
+/**
+ * Take a point-in-time snapshot of the register bank and system state
+ * O(1): nothing is copied until a block is first written afterwards.
+ * Writers racing with this call may land on either side of the snapshot.
+ * @return New snapshot or NULL if failed
+ */
+state_snapshot_t* snapshot_take(void) {
+    state_snapshot_t* snapshot = calloc(1, sizeof(state_snapshot_t));
+    if (snapshot == NULL) {
+        printf("Error: Failed to allocate snapshot\n");
+        return NULL;
+    }
+
+    pthread_mutex_lock(&g_snapshot_lock);
+    if (!snapshot_prepare_regions()) {
+        pthread_mutex_unlock(&g_snapshot_lock);
+        free(snapshot);
+        return NULL;
+    }
+
+    snapshot->epoch = ++g_snapshot_epoch_counter;
+    snapshot->older = g_newest_snapshot;
+    if (g_newest_snapshot != NULL) g_newest_snapshot->newer = snapshot;
+    g_newest_snapshot = snapshot;
+    __atomic_store_n(&g_current_epoch, snapshot->epoch, __ATOMIC_RELEASE);
+    __atomic_store_n(&g_snapshot_active, 1, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&g_snapshot_lock);
+    return snapshot;
+}
+
+/**
+ * Release a snapshot; blocks it holds that an older snapshot still needs move there
+ * @param snapshot Snapshot to release
+ */
+void snapshot_release(state_snapshot_t* snapshot) {
+    if (snapshot == NULL) return;
+
+    pthread_mutex_lock(&g_snapshot_lock);
+    state_snapshot_t* older = snapshot->older;
+
+    for (int r = 0; r < SNAPSHOT_REGION_COUNT; r++) {
+        for (size_t i = 0; i < snapshot->saved_count[r]; i++) {
+            size_t b = snapshot->saved_list[r][i];
+            unsigned char* copy = snapshot->saved[r][b];
+
+            // Unwritten between the two snapshots, so this copy is also the older state
+            bool needed = older != NULL && (older->saved[r] == NULL || older->saved[r][b] == NULL);
+            if (!needed || !snapshot_keep_block(older, r, b, copy)) free(copy);
+        }
+        free(snapshot->saved[r]);
+        free(snapshot->saved_list[r]);
+    }
+
+    if (older != NULL) older->newer = snapshot->newer;
+    if (snapshot->newer != NULL) {
+        snapshot->newer->older = older;
+    } else {
+        g_newest_snapshot = older;
+        __atomic_store_n(&g_current_epoch, older != NULL ? older->epoch : 0, __ATOMIC_RELEASE);
+        if (older == NULL) __atomic_store_n(&g_snapshot_active, 0, __ATOMIC_RELEASE);
+    }
+    pthread_mutex_unlock(&g_snapshot_lock);
+    free(snapshot);
+}
+
+/**
+ * Find a block's contents as of a snapshot (lock held)
+ * @param snapshot Snapshot, or NULL for live memory
+ * @param region_id Region
+ * @param block Block index
+ * @return Saved copy, or the live block if unchanged since the snapshot
+ */
+static const unsigned char* snapshot_block_at(const state_snapshot_t* snapshot, int region_id, size_t block) {
+    for (const state_snapshot_t* s = snapshot; s != NULL; s = s->newer) {
+        if (s->saved[region_id] != NULL && s->saved[region_id][block] != NULL) {
+            return s->saved[region_id][block];
+        }
+    }
+    return g_regions[region_id].base + block * SNAPSHOT_BLOCK_SIZE;
+}
+
+/**
+ * Check whether a block may differ between a snapshot and a later point (lock held)
+ * Only blocks preserved by a snapshot in [older, newer) were written in between.
+ * @param older Earlier snapshot
+ * @param newer Later snapshot, or NULL for live memory
+ * @param region_id Region
+ * @param block Block index
+ * @return true if the block was written after older was taken
+ */
+static bool snapshot_block_touched(const state_snapshot_t* older, const state_snapshot_t* newer,
+                                   int region_id, size_t block) {
+    for (const state_snapshot_t* s = older; s != NULL && s != newer; s = s->newer) {
+        if (s->saved[region_id] != NULL && s->saved[region_id][block] != NULL) return true;
+    }
+    return false;
+}
+
+/**
+ * Check the bank has not been swapped since the regions were set up (lock held)
+ * @return 1 if snapshots still describe the live bank, 0 otherwise
+ */
+static int snapshot_regions_current(void) {
+    if (g_regions[SNAPSHOT_REGION_REGISTERS].base != (unsigned char*)get_register_pointer(SNAPSHOT_BASE_ADDR) ||
+        g_regions[SNAPSHOT_REGION_REGISTERS].size != (size_t)register_bank_size() * sizeof(uint32_t)) {
+        printf("Error: Register bank changed since the snapshot was taken\n");
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * Roll the register bank and system state back to a snapshot
+ * Only blocks written since the snapshot are copied. The restore is itself
+ * a write, so newer snapshots stay valid and can be restored afterwards.
+ * @param snapshot Snapshot to restore
+ * @return Blocks restored, or -1 on failure
+ */
+int snapshot_restore(const state_snapshot_t* snapshot) {
+    if (snapshot == NULL) {
+        printf("Error: Cannot restore NULL snapshot\n");
+        return -1;
+    }
+
+    pthread_mutex_lock(&g_snapshot_lock);
+    if (!snapshot_regions_current()) {
+        pthread_mutex_unlock(&g_snapshot_lock);
+        return -1;
+    }
+
+    // Blocks written since the snapshot are exactly those saved from it onwards;
+    // a block saved by several snapshots is restored once, at its oldest entry
+    int restored = 0;
+    for (int r = 0; r < SNAPSHOT_REGION_COUNT; r++) {
+        for (const state_snapshot_t* s = snapshot; s != NULL; s = s->newer) {
+            for (size_t i = 0; i < s->saved_count[r]; i++) {
+                size_t b = s->saved_list[r][i];
+                if (snapshot_block_touched(snapshot, s, r, b)) continue;
+
+                const unsigned char* version = snapshot_block_at(snapshot, r, b);
+                if (!snapshot_preserve_block(r, b)) {
+                    printf("Error: Snapshot copy-on-write allocation failed during restore\n");
+                    pthread_mutex_unlock(&g_snapshot_lock);
+                    return -1;
+                }
+                snapshot_write_block(r, b, version);
+                restored++;
+            }
+        }
+    }
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    pthread_mutex_unlock(&g_snapshot_lock);
+    return restored;
+}
+
+/**
+ * Compare two snapshots, or a snapshot with live state
+ * Only blocks written in between are examined.
+ * @param older Earlier snapshot
+ * @param newer Later snapshot, or NULL for live state
+ * @param diff Receives change counts
+ * @param register_bitmap Optional, (register_bank_size() + 63) / 64 words; bit i set if register i changed
+ * @return Number of changed registers plus changed chips, or -1 on failure
+ */
+int snapshot_diff(const state_snapshot_t* older, const state_snapshot_t* newer,
+                  snapshot_diff_t* diff, uint64_t* register_bitmap) {
+    if (older == NULL || diff == NULL || (newer != NULL && newer->epoch <= older->epoch)) {
+        printf("Error: Invalid parameters for snapshot diff\n");
+        return -1;
+    }
+
+    memset(diff, 0, sizeof(*diff));
+    pthread_mutex_lock(&g_snapshot_lock);
+    if (!snapshot_regions_current()) {
+        pthread_mutex_unlock(&g_snapshot_lock);
+        return -1;
+    }
+
+    // Registers: compare word by word within touched blocks
+    snapshot_region_t* bank = &g_regions[SNAPSHOT_REGION_REGISTERS];
+    if (register_bitmap != NULL) {
+        memset(register_bitmap, 0, (bank->size / sizeof(uint32_t) + 63) / 64 * sizeof(uint64_t));
+    }
+    for (const state_snapshot_t* s = older; s != NULL && s != newer; s = s->newer) {
+        for (size_t n = 0; n < s->saved_count[SNAPSHOT_REGION_REGISTERS]; n++) {
+            size_t b = s->saved_list[SNAPSHOT_REGION_REGISTERS][n];
+            if (snapshot_block_touched(older, s, SNAPSHOT_REGION_REGISTERS, b)) continue;
+
+            const uint32_t* before = (const uint32_t*)snapshot_block_at(older, SNAPSHOT_REGION_REGISTERS, b);
+            const uint32_t* after = (const uint32_t*)snapshot_block_at(newer, SNAPSHOT_REGION_REGISTERS, b);
+            size_t words = snapshot_block_length(bank, b) / sizeof(uint32_t);
+            diff->blocks_compared++;
+            for (size_t i = 0; i < words; i++) {
+                if (__atomic_load_n(&before[i], __ATOMIC_RELAXED) == __atomic_load_n(&after[i], __ATOMIC_RELAXED)) continue;
+                size_t index = b * (SNAPSHOT_BLOCK_SIZE / sizeof(uint32_t)) + i;
+                diff->changed_registers++;
+                if (register_bitmap != NULL) register_bitmap[index >> 6] |= 1ULL << (index & 63);
+            }
+        }
+    }
+
+    // System state: rebuild both images from touched blocks, then compare per chip
+    system_state_t before_state;
+    system_state_t after_state;
+    snapshot_region_t* system = &g_regions[SNAPSHOT_REGION_SYSTEM];
+    memcpy(&before_state, system->base, sizeof(system_state_t));
+    memcpy(&after_state, system->base, sizeof(system_state_t));
+    for (size_t b = 0; b < system->block_count; b++) {
+        if (!snapshot_block_touched(older, newer, SNAPSHOT_REGION_SYSTEM, b)) continue;
+
+        size_t length = snapshot_block_length(system, b);
+        memcpy((unsigned char*)&before_state + b * SNAPSHOT_BLOCK_SIZE,
+               snapshot_block_at(older, SNAPSHOT_REGION_SYSTEM, b), length);
+        memcpy((unsigned char*)&after_state + b * SNAPSHOT_BLOCK_SIZE,
+               snapshot_block_at(newer, SNAPSHOT_REGION_SYSTEM, b), length);
+        diff->blocks_compared++;
+    }
+    pthread_mutex_unlock(&g_snapshot_lock);
+
+    for (int i = 0; i < MAX_CHIPS; i++) {
+        if (memcmp(&before_state.chips[i], &after_state.chips[i], sizeof(chip_state_t)) != 0) {
+            diff->changed_chips++;
+        }
+    }
+    size_t summary = offsetof(system_state_t, active_chip_count);
+    diff->summary_changed = memcmp((unsigned char*)&before_state + summary,
+                                   (unsigned char*)&after_state + summary,
+                                   sizeof(system_state_t) - summary) != 0;
+
+    return diff->changed_registers + diff->changed_chips;
+}
+
+/**
+ * Read a register's value as of a snapshot
+ * @param snapshot Snapshot to read
+ * @param address Register address
+ * @param value Receives the value
+ * @return 1 if successful, 0 if invalid address or the bank changed
+ */
+int snapshot_read_register(const state_snapshot_t* snapshot, uint32_t address, uint32_t* value) {
+    if (snapshot == NULL || value == NULL) return 0;
+
+    pthread_mutex_lock(&g_snapshot_lock);
+    snapshot_region_t* bank = &g_regions[SNAPSHOT_REGION_REGISTERS];
+    size_t offset = (size_t)((address - SNAPSHOT_BASE_ADDR) / sizeof(uint32_t)) * sizeof(uint32_t);
+    if (!snapshot_regions_current() || offset >= bank->size) {
+        pthread_mutex_unlock(&g_snapshot_lock);
+        printf("Error: Snapshot register address 0x%08X out of range\n", address);
+        return 0;
+    }
+
+    size_t block = offset / SNAPSHOT_BLOCK_SIZE;
+    const uint32_t* words = (const uint32_t*)snapshot_block_at(snapshot, SNAPSHOT_REGION_REGISTERS, block);
+    *value = __atomic_load_n(&words[(offset % SNAPSHOT_BLOCK_SIZE) / sizeof(uint32_t)], __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&g_snapshot_lock);
+    return 1;
+}
+
+/**
+ * Compare full-copy checkpoints with copy-on-write snapshots
+ * Uses a 4 MiB shared-memory bank; each checkpoint is followed by a risky
+ * sequence of 64 register writes and a rollback.
+ * @param checkpoints Number of checkpoint/rollback cycles
+ */
+void benchmark_state_snapshot(int checkpoints) {
+    printf("\n--- State Snapshots (%d checkpoints, 4 MiB register bank) ---\n", checkpoints);
+
+    enum { BANK_REGISTERS = 1 << 20, WRITES = 64 };
+    char name[64];
+    snprintf(name, sizeof(name), "/day3_snapshot_bench_%d", (int)getpid());
+    if (checkpoints <= 0 || g_newest_snapshot != NULL || register_bank_mapped_header() != NULL) {
+        printf("Error: Invalid snapshot benchmark parameters\n");
+        return;
+    }
+    register_bank_unlink_shm(name);
+    if (register_bank_attach_shm(name, BANK_REGISTERS) != BANK_REGISTERS) return;
+
+    size_t bank_bytes = (size_t)BANK_REGISTERS * sizeof(uint32_t);
+    uint32_t* checkpoint = malloc(bank_bytes);
+    system_state_t* system_checkpoint = malloc(sizeof(system_state_t));
+    if (checkpoint == NULL || system_checkpoint == NULL) {
+        printf("Error: Failed to allocate checkpoint buffers\n");
+        free(checkpoint);
+        free(system_checkpoint);
+        register_bank_detach();
+        register_bank_unlink_shm(name);
+        return;
+    }
+    uint32_t* bank = get_register_pointer(SNAPSHOT_BASE_ADDR);
+    struct timespec start, end;
+
+    // Full memcpy checkpoint and rollback
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int c = 0; c < checkpoints; c++) {
+        memcpy(checkpoint, bank, bank_bytes);
+        memcpy(system_checkpoint, get_system_state(), sizeof(system_state_t));
+        for (int w = 0; w < WRITES; w++) {
+            uint32_t index = (uint32_t)((c * 7919 + w * 104729) % BANK_REGISTERS);
+            register_atomic_store(SNAPSHOT_BASE_ADDR + index * sizeof(uint32_t), (uint32_t)(c + w));
+        }
+        memcpy(bank, checkpoint, bank_bytes);
+        restore_system_state(system_checkpoint);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double copy_us = ((end.tv_sec - start.tv_sec) * 1e6 + (end.tv_nsec - start.tv_nsec) / 1e3) / checkpoints;
+
+    // Copy-on-write snapshot and rollback
+    long long restored_blocks = 0;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int c = 0; c < checkpoints; c++) {
+        state_snapshot_t* snapshot = snapshot_take();
+        if (snapshot == NULL) break;
+        for (int w = 0; w < WRITES; w++) {
+            uint32_t index = (uint32_t)((c * 7919 + w * 104729) % BANK_REGISTERS);
+            register_atomic_store(SNAPSHOT_BASE_ADDR + index * sizeof(uint32_t), (uint32_t)(c + w));
+        }
+        restored_blocks += snapshot_restore(snapshot);
+        snapshot_release(snapshot);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double cow_us = ((end.tv_sec - start.tv_sec) * 1e6 + (end.tv_nsec - start.tv_nsec) / 1e3) / checkpoints;
+
+    printf("Full copy checkpoint:  %10.1f us/cycle (%zu bytes copied twice)\n",
+           copy_us, bank_bytes + sizeof(system_state_t));
+    printf("Copy-on-write:         %10.1f us/cycle (%.1f blocks of %d bytes restored)\n",
+           cow_us, (double)restored_blocks / checkpoints, SNAPSHOT_BLOCK_SIZE);
+    if (cow_us > 0.0) printf("Speedup: %.0fx\n", copy_us / cow_us);
+
+    free(checkpoint);
+    free(system_checkpoint);
+    register_bank_detach();
+    register_bank_unlink_shm(name);
+}
@@ -1,9 +1,15 @@
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include <time.h>
+#include <pthread.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/wait.h>
 
 // Simple test framework
 static int tests_run = 0;
@@ -163,6 +169,693 @@ void test_pointer_operations(void) {
     TEST_ASSERT_NULL(invalid_ptr, "Invalid address returns NULL pointer");
 }
 
+/**
+ * Test atomic register bank operations
+ */
+void test_atomic_registers(void) {
+    printf("\n--- Testing Atomic Register Bank ---\n");
+
+    uint32_t addr = 0x40000010;
+    TEST_ASSERT(register_atomic_store(addr, 0x000000F0), "Atomic store succeeds");
+    TEST_ASSERT_EQUAL(0x000000F0, register_atomic_load(addr), "Atomic load sees store");
+
+    uint32_t before = register_atomic_set_bits(addr, 0x00000003);
+    TEST_ASSERT_EQUAL(0x000000F0, before, "Set bits returns previous value");
+    register_atomic_clear_bits(addr, 0x00000030);
+    register_atomic_toggle_bits(addr, 0x00000101);
+    TEST_ASSERT_EQUAL(0x000001C2, register_atomic_load(addr), "Set/clear/toggle RMW result");
+
+    uint32_t expected = 0x12345678;
+    TEST_ASSERT(!register_atomic_compare_exchange(addr, &expected, 0), "CAS fails on stale value");
+    TEST_ASSERT_EQUAL(0x000001C2, expected, "Failed CAS reports current value");
+    TEST_ASSERT(register_atomic_compare_exchange(addr, &expected, 0xCAFE0000), "CAS succeeds");
+
+    uint32_t previous = 0;
+    register_atomic_update_field(addr, 0x00000F00, 8, 0x7, &previous);
+    TEST_ASSERT_EQUAL(0xCAFE0700, register_atomic_load(addr), "Field update preserves other bits");
+    TEST_ASSERT_EQUAL(0xCAFE0000, previous, "Field update returns previous value");
+
+    TEST_ASSERT(!register_atomic_store(0x40001000, 1), "Out-of-range store rejected");
+
+    TEST_ASSERT(stress_test_register_bank(2, 2, 20000), "Concurrent writers lose no updates");
+}
+
+/**
+ * Test vectored scatter/gather register access
+ */
+void test_vectored_registers(void) {
+    printf("\n--- Testing Vectored Register Access ---\n");
+
+    // Two segments written and read back in one call each
+    register_segment_t segments[2] = { { 0x40000040, 3 }, { 0x40000200, 2 } };
+    uint32_t values[5] = { 0x11, 0x22, 0x33, 0x44, 0x55 };
+    uint32_t readback[5] = {0};
+    TEST_ASSERT_EQUAL(5, register_writev(segments, 2, values), "writev covers both segments");
+    TEST_ASSERT_EQUAL(5, register_readv(segments, 2, readback), "readv covers both segments");
+    TEST_ASSERT(memcmp(values, readback, sizeof(values)) == 0, "readv returns written values");
+    TEST_ASSERT_EQUAL(0x44, read_register_via_pointer(0x40000200), "Second segment lands at its address");
+
+    register_segment_t bad_segment[2] = { { 0x40000000, 1 }, { 0x400003F8, 4 } };
+    TEST_ASSERT_EQUAL(-1, register_readv(bad_segment, 2, readback), "Segment past bank end rejected");
+
+    // Scattered index list longer than one vector, with a repeated address
+    uint32_t addresses[20];
+    uint32_t scatter_values[20];
+    uint32_t gathered[20];
+    for (int i = 0; i < 20; i++) {
+        addresses[i] = 0x40000000 + (uint32_t)((i * 37) % 256) * 4;
+        scatter_values[i] = 0xA000u + (uint32_t)i;
+    }
+    addresses[19] = addresses[3];
+    TEST_ASSERT_EQUAL(20, register_scatter(addresses, 20, scatter_values), "Scatter 20 registers");
+    TEST_ASSERT_EQUAL(20, register_gather(addresses, 20, gathered), "Gather 20 registers");
+    int matches = 1;
+    for (int i = 0; i < 19; i++) {
+        if (i != 3 && gathered[i] != scatter_values[i]) matches = 0;
+    }
+    TEST_ASSERT(matches, "Gathered values match scattered values");
+    TEST_ASSERT_EQUAL(0xA013, gathered[3], "Later entry wins for repeated address");
+
+    // Invalid entry: nothing is written
+    uint32_t before = read_register_via_pointer(addresses[0]);
+    addresses[12] = 0x40001000;
+    scatter_values[0] = 0xDEAD;
+    TEST_ASSERT_EQUAL(-1, register_scatter(addresses, 20, scatter_values), "Scatter with bad address rejected");
+    TEST_ASSERT_EQUAL(before, read_register_via_pointer(addresses[0]), "Rejected scatter writes nothing");
+    TEST_ASSERT_EQUAL(-1, register_gather(addresses, 20, gathered), "Gather with bad address rejected");
+}
+
+/**
+ * Test multi-value, masked register pattern search
+ */
+void test_register_pattern_search(void) {
+    printf("\n--- Testing Register Pattern Search ---\n");
+
+    // Image long enough for full chunks plus a ragged tail
+    enum { WORDS = 1203 };
+    static uint32_t image[WORDS];
+    uint64_t bitmap[(WORDS + 63) / 64];
+    int indices[64];
+    for (int i = 0; i < WORDS; i++) {
+        image[i] = 0x00010000u + (uint32_t)i;
+    }
+    const uint32_t signatures[3] = { 0xE1000BAD, 0xE2000BAD, 0xE4000BAD };
+    const int planted[6] = { 5, 63, 64, 511, 512, 1202 };
+    for (int i = 0; i < 6; i++) {
+        image[planted[i]] = signatures[i % 3] | ((uint32_t)i << 16);  // unit id in bits 16-23
+    }
+
+    int matches = register_image_match_bitmap(image, WORDS, 0xFF00FFFFu, signatures, 3, bitmap);
+    TEST_ASSERT_EQUAL(6, matches, "Masked multi-value bitmap finds every signature");
+    int bits_ok = 1;
+    for (int i = 0; i < 6; i++) {
+        if (!(bitmap[planted[i] >> 6] & (1ULL << (planted[i] & 63)))) bits_ok = 0;
+    }
+    TEST_ASSERT(bits_ok, "Bitmap bits set at planted indices");
+
+    int exact = register_image_match_bitmap(image, WORDS, 0xFFFFFFFFu, signatures, 3, bitmap);
+    TEST_ASSERT_EQUAL(1, exact, "Exact compare only matches unit id 0");
+
+    int listed = register_image_match_indices(image, WORDS, 0xFF00FFFFu, signatures, 3, indices, 64);
+    TEST_ASSERT_EQUAL(6, listed, "Index list counts every match");
+    TEST_ASSERT(memcmp(indices, planted, sizeof(planted)) == 0, "Index list in ascending order");
+    int capped = register_image_match_indices(image, WORDS, 0xFF00FFFFu, signatures, 3, indices, 2);
+    TEST_ASSERT_EQUAL(6, capped, "Capped index list still reports total");
+
+    int first = register_image_find_first(image, WORDS, 0xFF00FFFFu, &signatures[2], 1);
+    TEST_ASSERT_EQUAL(64, first, "First masked match of a single signature");
+    uint32_t missing = 0xDEADDEAD;
+    int none = register_image_find_first(image, WORDS, 0xFFFFFFFFu, &missing, 1);
+    TEST_ASSERT_EQUAL(-1, none, "No match returns -1");
+
+    uint32_t too_many[9] = {0};
+    int rejected = register_image_match_bitmap(image, WORDS, 0xFFFFFFFFu, too_many, 9, bitmap);
+    TEST_ASSERT_EQUAL(-1, rejected, "More than 8 candidates rejected");
+
+    // Register bank wrappers: init pattern is 0xDEADBEEF + offset
+    init_register_bank();
+    uint32_t* reg = find_register_by_masked_value(0x000000F9, 0x000000FF, 0x40000000, 256);
+    TEST_ASSERT(reg != NULL && (*reg & 0xFF) == 0xF9, "Masked bank search finds low byte");
+    TEST_ASSERT(reg == get_register_pointer(0x40000028), "Masked bank search returns first match");
+
+    const uint32_t bank_values[2] = { 0xDEADBEEF + 3, 0xDEADBEEF + 200 };
+    uint64_t bank_bitmap[4];
+    int bank_matches = find_registers_matching(0x40000000, 256, 0xFFFFFFFFu, bank_values, 2, bank_bitmap);
+    TEST_ASSERT_EQUAL(2, bank_matches, "Bank multi-value search finds both registers");
+    TEST_ASSERT((bank_bitmap[0] & (1ULL << 3)) && (bank_bitmap[3] & (1ULL << 8)), "Bank bitmap marks offsets 3 and 200");
+    int bank_bad = find_registers_matching(0x400003F0, 8, 0xFFFFFFFFu, bank_values, 2, bank_bitmap);
+    TEST_ASSERT_EQUAL(-1, bank_bad, "Bank search past end rejected");
+}
+
+/**
+ * Test file- and shm-backed register banks shared across processes
+ */
+void test_shared_register_bank(void) {
+    printf("\n--- Testing Shared Register Bank ---\n");
+
+    char name[64];
+    snprintf(name, sizeof(name), "/day3_regs_%d", (int)getpid());
+    register_bank_unlink_shm(name);
+
+    int attached = register_bank_attach_shm(name, 1024);
+    TEST_ASSERT_EQUAL(1024, attached, "Shared bank created beyond 256 registers");
+    TEST_ASSERT_EQUAL(1024, register_bank_size(), "Active bank reports mapped size");
+    const register_bank_header_t* header = register_bank_mapped_header();
+    TEST_ASSERT(header != NULL && header->magic == REGISTER_BANK_MAGIC &&
+                header->version_major == REGISTER_BANK_VERSION_MAJOR, "Header carries magic and version");
+    TEST_ASSERT(header != NULL && header->base_address == 0x40000000 &&
+                header->register_stride == 4 && header->register_count == 1024, "Header carries layout descriptor");
+
+    // Address translation covers the larger bank
+    int stored = register_atomic_store(0x40000000 + 1000 * 4, 0x5A5A0001);
+    TEST_ASSERT_EQUAL(1, stored, "Store to register 1000 via BASE_REGISTER_ADDR");
+    TEST_ASSERT(get_register_pointer(0x40001000) == NULL, "Address past mapped bank rejected");
+
+    // Another process attaches by name and sees the same image
+    pid_t pid = fork();
+    if (pid == 0) {
+        register_bank_detach();
+        int ok = register_bank_attach_shm(name, 0) == 1024 &&
+                 register_atomic_load(0x40000000 + 1000 * 4) == 0x5A5A0001 &&
+                 register_bank_mapped_header()->attach_count == 2;
+        register_atomic_store(0x40000000 + 1001 * 4, 0x00C0FFEE);
+        register_bank_detach();
+        _exit(ok ? 0 : 1);
+    }
+    int status = -1;
+    if (pid > 0) waitpid(pid, &status, 0);
+    TEST_ASSERT(pid > 0 && WIFEXITED(status) && WEXITSTATUS(status) == 0, "Second process attaches to same image");
+    TEST_ASSERT_EQUAL(0x00C0FFEE, register_atomic_load(0x40000000 + 1001 * 4), "Write from other process visible");
+    TEST_ASSERT_EQUAL(1, header->attach_count, "Attach count back to one process");
+
+    int mismatch = register_bank_attach_shm(name, 512);
+    TEST_ASSERT_EQUAL(-1, mismatch, "Size mismatch with existing image rejected");
+    TEST_ASSERT_EQUAL(1024, register_bank_size(), "Failed attach keeps current bank");
+
+    register_bank_detach();
+    TEST_ASSERT_EQUAL(256, register_bank_size(), "Detach returns to private bank");
+    TEST_ASSERT_EQUAL(0, register_bank_unlink_shm(name), "Shared memory object removed");
+
+    // File-backed image persists across attaches
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/day3_regs_%d.img", (int)getpid());
+    unlink(path);
+    int file_regs = register_bank_attach_file(path, 300);
+    TEST_ASSERT_EQUAL(300, file_regs, "File-backed bank created");
+    register_atomic_store(0x40000000 + 299 * 4, 0x12345678);
+    register_bank_detach();
+    int reopened = register_bank_attach_file(path, 0);
+    TEST_ASSERT_EQUAL(300, reopened, "Existing file reopened with its own size");
+    TEST_ASSERT_EQUAL(0x12345678, register_atomic_load(0x40000000 + 299 * 4), "Register value persisted in file");
+    register_bank_detach();
+
+    // Corrupt magic: attach must refuse the image
+    FILE* image = fopen(path, "r+b");
+    if (image != NULL) {
+        uint32_t bad_magic = 0;
+        fwrite(&bad_magic, sizeof(bad_magic), 1, image);
+        fclose(image);
+    }
+    int corrupt = register_bank_attach_file(path, 0);
+    TEST_ASSERT_EQUAL(-1, corrupt, "Image with bad magic rejected");
+    TEST_ASSERT_EQUAL(256, register_bank_size(), "Private bank still active");
+    unlink(path);
+}
+
+/**
+ * Test the write-back register shadow
+ */
+void test_register_shadow(void) {
+    printf("\n--- Testing Register Shadow ---\n");
+
+    const uint32_t base = 0x40000000;
+    register_atomic_store(base + 0x20, 0x11111111);
+    register_atomic_store(base + 0x24, 0x22222222);
+
+    register_shadow_t* shadow = create_register_shadow(0, 0);
+    TEST_ASSERT_NOT_NULL(shadow, "Register shadow created");
+    if (shadow == NULL) return;
+    TEST_ASSERT_EQUAL(0x11111111, register_shadow_read(shadow, base + 0x20), "Shadow starts as bank copy");
+
+    // Repeated writes coalesce; the bank is untouched until commit
+    register_shadow_write(shadow, base + 0x20, 0xA);
+    register_shadow_write(shadow, base + 0x20, 0xB);
+    register_shadow_update_field(shadow, base + 0x24, 0x0000FF00, 8, 0x5A);
+    register_shadow_write(shadow, base + 0x40, 0xC);
+    TEST_ASSERT_EQUAL(0xB, register_shadow_read(shadow, base + 0x20), "Read served from shadow");
+    TEST_ASSERT_EQUAL(0x11111111, register_atomic_load(base + 0x20), "Bank unchanged before commit");
+    TEST_ASSERT_EQUAL(3, shadow->dirty_count, "Three distinct dirty registers");
+    TEST_ASSERT_EQUAL(1, shadow->coalesced_writes, "Repeated write coalesced");
+
+    int flushed = register_shadow_commit(shadow);
+    TEST_ASSERT_EQUAL(3, flushed, "Commit writes each dirty register once");
+    TEST_ASSERT_EQUAL(2, shadow->flush_runs, "Adjacent dirty registers merged into one run");
+    TEST_ASSERT_EQUAL(0xB, register_atomic_load(base + 0x20), "Committed value reaches bank");
+    TEST_ASSERT_EQUAL(0x22225A22, register_atomic_load(base + 0x24), "Field update preserves other bits");
+    int nothing = register_shadow_commit(shadow);
+    TEST_ASSERT_EQUAL(0, nothing, "Clean shadow commits nothing");
+
+    // Refresh picks up bank-side changes but keeps pending writes
+    register_shadow_write(shadow, base + 0x44, 0xD);
+    register_atomic_store(base + 0x48, 0xFEEDF00D);
+    register_atomic_store(base + 0x44, 0x0BADBEEF);
+    register_shadow_refresh(shadow);
+    TEST_ASSERT_EQUAL(0xFEEDF00D, register_shadow_read(shadow, base + 0x48), "Refresh reloads clean register");
+    TEST_ASSERT_EQUAL(0xD, register_shadow_read(shadow, base + 0x44), "Refresh keeps dirty register");
+    int bad_write = register_shadow_write(shadow, 0x40001000, 1);
+    TEST_ASSERT_EQUAL(0, bad_write, "Out-of-range shadow write rejected");
+    destroy_register_shadow(shadow);
+    TEST_ASSERT_EQUAL(0xD, register_atomic_load(base + 0x44), "Destroy writes back pending registers");
+
+    // Batch threshold commits automatically
+    register_shadow_t* batched = create_register_shadow(4, 0);
+    TEST_ASSERT_NOT_NULL(batched, "Batched shadow created");
+    if (batched == NULL) return;
+    for (uint32_t i = 0; i < 4; i++) {
+        register_shadow_write(batched, base + 0x80 + i * 4, 0x100 + i);
+    }
+    TEST_ASSERT_EQUAL(0, batched->dirty_count, "Batch limit triggers commit");
+    TEST_ASSERT_EQUAL(0x103, register_atomic_load(base + 0x8C), "Batch commit reached bank");
+    destroy_register_shadow(batched);
+
+    // Age threshold commits on poll
+    register_shadow_t* timed = create_register_shadow(0, 1);
+    TEST_ASSERT_NOT_NULL(timed, "Timed shadow created");
+    if (timed == NULL) return;
+    register_shadow_write(timed, base + 0x90, 0x777);
+    struct timespec pause = { 0, 2000000 };
+    nanosleep(&pause, NULL);
+    int aged = register_shadow_poll(timed);
+    TEST_ASSERT_EQUAL(1, aged, "Poll commits after flush interval");
+    TEST_ASSERT_EQUAL(0x777, register_atomic_load(base + 0x90), "Timed commit reached bank");
+    destroy_register_shadow(timed);
+}
+
+/**
+ * Toggle one register repeatedly while a trace is recording
+ * @param arg Unused
+ * @return NULL
+ */
+static void* register_trace_toggle_worker(void* arg) {
+    (void)arg;
+    for (int i = 0; i < 1000; i++) {
+        register_atomic_toggle_bits(0x40000100, 1u << (i % 4));
+    }
+    return NULL;
+}
+
+/**
+ * Test register access tracing and replay
+ */
+void test_register_trace(void) {
+    printf("\n--- Testing Register Trace ---\n");
+
+    const uint32_t base = 0x40000000;
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/day3_trace_%d.bin", (int)getpid());
+
+    register_atomic_store(base + 0xC4, 0x0000000F);
+    int started = register_trace_start(path, 1024);
+    TEST_ASSERT_EQUAL(1, started, "Trace recording started");
+    TEST_ASSERT(register_trace_active(), "Trace reports active");
+
+    // 14 accesses of every kind, with a pause for paced replay
+    register_atomic_store(base + 0xC0, 0x1234);
+    register_atomic_load(base + 0xC0);
+    register_atomic_set_bits(base + 0xC4, 0xF0);
+    register_atomic_update_field(base + 0xC4, 0xFF00, 8, 0x12, NULL);
+    uint32_t expected = 0xBAD;
+    register_atomic_compare_exchange(base + 0xC4, &expected, 0);
+    struct timespec pause = { 0, 5000000 };
+    nanosleep(&pause, NULL);
+    register_segment_t segments[2] = { { base + 0xC8, 3 }, { base + 0xE0, 2 } };
+    uint32_t values[5] = { 1, 2, 3, 4, 5 };
+    register_writev(segments, 2, values);
+    uint32_t addresses[4] = { base + 0xC0, base + 0xC4, base + 0xCC, base + 0xE4 };
+    uint32_t gathered[4];
+    register_gather(addresses, 4, gathered);
+
+    register_trace_stats_t stats;
+    register_trace_stop(&stats);
+    TEST_ASSERT(!register_trace_active(), "Trace reports stopped");
+    TEST_ASSERT_EQUAL(14, stats.recorded, "Every access recorded");
+    TEST_ASSERT_EQUAL(0, stats.dropped, "No records dropped");
+    TEST_ASSERT(stats.bytes_written < 24 + 14 * 12, "Trace is compact");
+
+    // Clobber the traced registers, then replay onto them
+    uint32_t final_c4 = register_atomic_load(base + 0xC4);
+    for (uint32_t offset = 0xC0; offset <= 0xE4; offset += 4) {
+        register_atomic_store(base + offset, 0xFFFFFFFF);
+    }
+    register_replay_stats_t replay;
+    long long replayed = register_trace_replay(path, false, &replay);
+    TEST_ASSERT_EQUAL(14, replayed, "Replay applies every record");
+    TEST_ASSERT_EQUAL(0, replay.mismatches, "Replay consistent with recorded old values");
+    TEST_ASSERT_EQUAL(8, replay.writes, "Replay counts writes and RMWs");
+    TEST_ASSERT_EQUAL(final_c4, register_atomic_load(base + 0xC4), "Replay reproduces field updates");
+    TEST_ASSERT_EQUAL(5, register_atomic_load(base + 0xE4), "Replay reproduces vectored writes");
+    TEST_ASSERT(replay.elapsed_ns < 4000000, "Full-speed replay skips recorded pauses");
+
+    long long paced = register_trace_replay(path, true, &replay);
+    TEST_ASSERT_EQUAL(14, paced, "Paced replay applies every record");
+    TEST_ASSERT(replay.elapsed_ns >= 4000000, "Paced replay keeps recorded timing");
+
+    // Concurrent producers through the lock-free ring
+    register_trace_start(path, 0);
+    pthread_t threads[2];
+    int created = 0;
+    for (int t = 0; t < 2; t++) {
+        if (pthread_create(&threads[t], NULL, register_trace_toggle_worker, NULL) == 0) created++;
+    }
+    for (int t = 0; t < created; t++) pthread_join(threads[t], NULL);
+    register_trace_stop(&stats);
+    TEST_ASSERT_EQUAL((uint64_t)created * 1000, stats.recorded + stats.dropped, "Concurrent accesses all accounted for");
+    TEST_ASSERT_EQUAL(0, stats.dropped, "Ring kept up with concurrent producers");
+
+    FILE* trace = fopen(path, "r+b");
+    if (trace != NULL) {
+        fputc(0, trace);
+        fclose(trace);
+    }
+    long long corrupt = register_trace_replay(path, false, NULL);
+    TEST_ASSERT_EQUAL(-1, corrupt, "Trace with bad header rejected");
+    remove(path);
+}
+
+/**
+ * Test copy-on-write snapshots of registers and system state
+ */
+void test_state_snapshot(void) {
+    printf("\n--- Testing State Snapshots ---\n");
+
+    const uint32_t base = 0x40000000;
+    chip_state_t chip;
+    init_system_state();
+    init_chip_state(&chip, "SNAP_A", "PN-SNAP");
+    add_chip_to_system(&chip);
+    register_atomic_store(base + 0x100, 0x100);
+    register_atomic_store(base + 0x104, 0x104);
+    register_atomic_store(base + 0x200, 0x200);
+
+    state_snapshot_t* first = snapshot_take();
+    TEST_ASSERT_NOT_NULL(first, "Snapshot taken");
+
+    // Two registers in one block, one in another, plus a new chip
+    register_atomic_store(base + 0x100, 0xA);
+    register_atomic_set_bits(base + 0x104, 0xF000);
+    register_atomic_store(base + 0x200, 0xB);
+    register_atomic_store(base + 0x200, 0x200);
+    init_chip_state(&chip, "SNAP_B", "PN-SNAP");
+    add_chip_to_system(&chip);
+
+    state_snapshot_t* second = snapshot_take();
+    TEST_ASSERT_NOT_NULL(second, "Second snapshot taken");
+    register_atomic_store(base + 0x100, 0xC);
+    uint32_t addresses[2] = { base + 0x300, base + 0x304 };
+    uint32_t values[2] = { 7, 8 };
+    uint32_t before_scatter = register_atomic_load(base + 0x300);
+    register_scatter(addresses, 2, values);
+
+    uint32_t value = 0;
+    snapshot_read_register(first, base + 0x100, &value);
+    TEST_ASSERT_EQUAL(0x100, value, "First snapshot keeps pre-write value");
+    snapshot_read_register(second, base + 0x100, &value);
+    TEST_ASSERT_EQUAL(0xA, value, "Second snapshot keeps intermediate value");
+    snapshot_read_register(second, base + 0x200, &value);
+    TEST_ASSERT_EQUAL(0x200, value, "Untouched register read through to live bank");
+
+    snapshot_diff_t diff;
+    uint64_t bitmap[4];
+    int changes = snapshot_diff(first, second, &diff, bitmap);
+    TEST_ASSERT_EQUAL(3, changes, "Diff counts changed registers and chips");
+    TEST_ASSERT_EQUAL(2, diff.changed_registers, "Rewritten register not reported");
+    TEST_ASSERT_EQUAL(1, diff.changed_chips, "Added chip reported");
+    TEST_ASSERT(diff.summary_changed, "System summary change reported");
+    TEST_ASSERT((bitmap[1] >> 1) & 1, "Bitmap marks changed register");
+    TEST_ASSERT(diff.blocks_compared < 10, "Diff only visits written blocks");
+
+    snapshot_diff(second, NULL, &diff, NULL);
+    TEST_ASSERT_EQUAL(3, diff.changed_registers, "Diff against live state");
+    TEST_ASSERT_EQUAL(0, diff.changed_chips, "No chip changes since second snapshot");
+
+    int restored = snapshot_restore(first);
+    TEST_ASSERT(restored > 0, "Rolled back to first snapshot");
+    TEST_ASSERT_EQUAL(0x100, register_atomic_load(base + 0x100), "Register rolled back");
+    TEST_ASSERT_EQUAL(0x104, register_atomic_load(base + 0x104), "RMW rolled back");
+    TEST_ASSERT_EQUAL(1, get_system_state()->active_chip_count, "System state rolled back");
+
+    // Newer snapshots survive a rollback to an older one
+    snapshot_restore(second);
+    TEST_ASSERT_EQUAL(0xA, register_atomic_load(base + 0x100), "Rolled forward to second snapshot");
+    TEST_ASSERT_EQUAL(2, get_system_state()->active_chip_count, "Chip count rolled forward");
+    TEST_ASSERT_EQUAL(before_scatter, register_atomic_load(base + 0x300), "Scattered register rolled back");
+
+    snapshot_release(first);
+    snapshot_read_register(second, base + 0x104, &value);
+    TEST_ASSERT_EQUAL(0xF104, value, "Snapshot valid after releasing an older one");
+    register_atomic_store(base + 0x100, 0xD);
+    snapshot_restore(second);
+    TEST_ASSERT_EQUAL(0xA, register_atomic_load(base + 0x100), "Restore after release");
+
+    // A full-copy restore is a write like any other: snapshots still see the old state
+    system_state_t saved = *get_system_state();
+    state_snapshot_t* third = snapshot_take();
+    saved.active_chip_count = 5;
+    restore_system_state(&saved);
+    TEST_ASSERT_EQUAL(5, get_system_state()->active_chip_count, "Full system state restored");
+    TEST_ASSERT(!restore_system_state_bytes(sizeof(system_state_t), &saved, 1), "Out-of-range raw write rejected");
+    snapshot_restore(third);
+    TEST_ASSERT_EQUAL(2, get_system_state()->active_chip_count, "Full restore undone by snapshot");
+    snapshot_release(third);
+    snapshot_release(second);
+}
+
+/**
+ * Test register image and fleet diff/apply
+ */
+void test_register_diff(void) {
+    printf("\n--- Testing Register Diff ---\n");
+
+    // 37 words: four full vector blocks plus a scalar tail
+    uint32_t before[37];
+    uint32_t after[37];
+    for (int i = 0; i < 37; i++) before[i] = after[i] = 0x1000u + (uint32_t)i;
+    after[3] ^= 0x10;
+    after[17] = 0;
+    after[36] |= 0x80000000u;
+
+    register_delta_t deltas[8];
+    for (int simd = 0; simd < 2; simd++) {
+        long changes = register_image_diff(before, after, 37, deltas, 8, simd == 1);
+        TEST_ASSERT_EQUAL(3, changes, simd ? "Vector image diff finds changes" : "Scalar image diff finds changes");
+        TEST_ASSERT(deltas[0].index == 3 && deltas[0].changed_bits == 0x10, "Delta holds index and flipped bits");
+        TEST_ASSERT_EQUAL(36, deltas[2].index, "Tail change reported in order");
+    }
+    long none = register_image_diff(before, before, 37, NULL, 0, true);
+    TEST_ASSERT_EQUAL(0, none, "Identical images produce no deltas");
+    long capped = register_image_diff(before, after, 37, deltas, 1, true);
+    TEST_ASSERT_EQUAL(3, capped, "Total counted past output capacity");
+
+    long applied = register_image_apply_delta(before, 37, deltas, 3);
+    TEST_ASSERT_EQUAL(3, applied, "Deltas applied");
+    TEST_ASSERT(memcmp(before, after, sizeof(before)) == 0, "Applied deltas reproduce new image");
+    register_delta_t bad = { 37, 1 };
+    long rejected = register_image_apply_delta(before, 37, &bad, 1);
+    TEST_ASSERT_EQUAL(-1, rejected, "Out-of-range delta rejected");
+
+    // Fleets: deltas are (chip, register) pairs
+    chip_fleet_t* old_fleet = create_chip_fleet(20);
+    chip_fleet_t* new_fleet = create_chip_fleet(20);
+    TEST_ASSERT(old_fleet != NULL && new_fleet != NULL, "Diff fleets created");
+    if (old_fleet == NULL || new_fleet == NULL) {
+        destroy_chip_fleet(old_fleet);
+        destroy_chip_fleet(new_fleet);
+        return;
+    }
+    chip_state_t chip;
+    memset(&chip, 0, sizeof(chip));
+    for (int i = 0; i < 20; i++) {
+        chip.registers.control_register = (uint32_t)i;
+        chip_fleet_add(old_fleet, &chip);
+        chip_fleet_add(new_fleet, &chip);
+    }
+    new_fleet->error_registers[5] = 0x4;
+    new_fleet->config_registers[19] = 0xABCD;
+
+    long fleet_changes = chip_fleet_diff(old_fleet, new_fleet, deltas, 8, true);
+    TEST_ASSERT_EQUAL(2, fleet_changes, "Fleet diff finds changed registers");
+    TEST_ASSERT(REGISTER_DELTA_CHIP(deltas[0]) == 5 && REGISTER_DELTA_REGISTER(deltas[0]) == 2,
+                "Delta decodes to chip and error register");
+    TEST_ASSERT(REGISTER_DELTA_CHIP(deltas[1]) == 19 && REGISTER_DELTA_REGISTER(deltas[1]) == 3,
+                "Tail chip config change found");
+    chip_fleet_apply_delta(old_fleet, deltas, 2);
+    long remaining = chip_fleet_diff(old_fleet, new_fleet, NULL, 0, false);
+    TEST_ASSERT_EQUAL(0, remaining, "Fleet deltas round trip");
+
+    old_fleet->count--;
+    long mismatched = chip_fleet_diff(old_fleet, new_fleet, deltas, 8, true);
+    TEST_ASSERT_EQUAL(-1, mismatched, "Fleets of different size rejected");
+    destroy_chip_fleet(old_fleet);
+    destroy_chip_fleet(new_fleet);
+}
+
+// Notifications received by test_register_watch
+static int g_watch_events = 0;
+static int g_watch_last_event = 0;
+static chip_state_t* g_watch_last_chip = NULL;
+
+static void record_watch_event(chip_state_t* chip, int event_type) {
+    g_watch_events++;
+    g_watch_last_event = event_type;
+    g_watch_last_chip = chip;
+}
+
+/**
+ * Test register watchpoints on the write path
+ */
+void test_register_watch(void) {
+    printf("\n--- Testing Register Watchpoints ---\n");
+
+    const uint32_t base = 0x40000000;
+    const uint32_t status = base + 0x140;
+    chip_state_t chip;
+    memset(&chip, 0, sizeof(chip));
+    register_atomic_store(status, 0x00001900);   // Temperature code 25 in bits 15-8
+
+    int error_watch = register_watch_bit(status, 2, REGISTER_WATCH_RISING, record_watch_event, &chip, EVENT_ERROR);
+    int temp_watch = register_watch_field(status, 8, 8, 0, 110, record_watch_event, &chip, EVENT_TEMPERATURE);
+    TEST_ASSERT(error_watch >= 0 && temp_watch >= 0, "Watches installed");
+    int bad_watch = register_watch_bit(base + 0x2, 2, REGISTER_WATCH_RISING, record_watch_event, &chip, EVENT_ERROR);
+    TEST_ASSERT_EQUAL(-1, bad_watch, "Unaligned address rejected");
+
+    g_watch_events = 0;
+    register_atomic_set_bits(status, 1U << 2);
+    TEST_ASSERT_EQUAL(1, g_watch_events, "Rising error bit notifies");
+    TEST_ASSERT(g_watch_last_event == EVENT_ERROR && g_watch_last_chip == &chip, "Notification carries chip and event");
+    register_atomic_set_bits(status, 1U << 2);
+    register_atomic_set_bits(status, 1U << 3);
+    TEST_ASSERT_EQUAL(1, g_watch_events, "No notification without a transition");
+    register_atomic_clear_bits(status, 1U << 2);
+    TEST_ASSERT_EQUAL(1, g_watch_events, "Falling edge ignored by rising watch");
+
+    register_atomic_update_field(status, 0xFF00, 8, 100, NULL);
+    TEST_ASSERT_EQUAL(1, g_watch_events, "Field change within range ignored");
+    register_atomic_update_field(status, 0xFF00, 8, 130, NULL);
+    TEST_ASSERT_EQUAL(2, g_watch_events, "Field leaving range notifies");
+    TEST_ASSERT_EQUAL(EVENT_TEMPERATURE, g_watch_last_event, "Range watch reports its event");
+    register_atomic_update_field(status, 0xFF00, 8, 140, NULL);
+    TEST_ASSERT_EQUAL(2, g_watch_events, "Staying out of range does not repeat");
+
+    // Plain writes, scatter and vectored writes go through the same hook
+    write_register_via_pointer(status, 0x00001904);
+    TEST_ASSERT_EQUAL(3, g_watch_events, "Pointer write notifies");
+    uint32_t addresses[2] = { base + 0x144, status };
+    uint32_t values[2] = { 0xFFFFFFFF, 0x00001900 };
+    register_scatter(addresses, 2, values);
+    values[1] = 0x00001904;
+    register_scatter(addresses, 2, values);
+    TEST_ASSERT_EQUAL(4, g_watch_events, "Scatter notifies; unwatched neighbour does not");
+    TEST_ASSERT_EQUAL(3, register_watch_hits(error_watch), "Hits counted per watch");
+
+    int both = register_watch_bit(base + 0x144, 0, REGISTER_WATCH_BOTH, record_watch_event, NULL, EVENT_POWER_OFF);
+    register_atomic_toggle_bits(base + 0x144, 1);
+    register_atomic_toggle_bits(base + 0x144, 1);
+    TEST_ASSERT_EQUAL(2, register_watch_hits(both), "Both edges watched");
+
+    int removed = register_watch_remove(error_watch);
+    TEST_ASSERT_EQUAL(1, removed, "Watch removed");
+    g_watch_events = 0;
+    register_atomic_clear_bits(status, 1U << 2);
+    register_atomic_set_bits(status, 1U << 2);
+    TEST_ASSERT_EQUAL(0, g_watch_events, "Removed watch stays silent");
+    register_watch_clear();
+    register_atomic_update_field(status, 0xFF00, 8, 25, NULL);
+    register_atomic_update_field(status, 0xFF00, 8, 200, NULL);
+    TEST_ASSERT_EQUAL(0, g_watch_events, "Cleared watches stay silent");
+}
+
+/**
+ * Test leveled and deferred logging
+ */
+void test_chip_log(void) {
+    printf("\n--- Testing Chip Logging ---\n");
+
+    int saved_level = chip_log_get_level();
+    chip_log_set_level(9);
+    TEST_ASSERT_EQUAL(CHIP_LOG_DEBUG, chip_log_get_level(), "Log level clamped to DEBUG");
+
+    FILE* sink = tmpfile();
+    TEST_ASSERT_NOT_NULL(sink, "Log sink created");
+    if (sink == NULL) return;
+
+    int started = chip_log_start(sink, 64);
+    TEST_ASSERT_EQUAL(1, started, "Deferred logging started");
+    int restarted = chip_log_start(sink, 64);
+    TEST_ASSERT_EQUAL(0, restarted, "Second start rejected");
+
+    // Hot-path diagnostics become deferred records
+    char name[16];
+    strcpy(name, "CHIP_7");
+    write_register_via_pointer(0x40000010, 0xABCD);
+    CHIP_LOG(CHIP_LOG_INFO, "%s: %.2f C, %zu regs, %d%%\n", name, 45.25, (size_t)12, 5);
+    strcpy(name, "CHANGED");           // String arguments are copied at log time
+    CHIP_LOG(CHIP_LOG_WARN, "[%*d]\n", 4, 7);
+
+    // Text longer than a record is kept whole, not cut to the string area
+    char long_name[101];
+    memset(long_name, 'x', 100);
+    long_name[100] = '\0';
+    CHIP_LOG(CHIP_LOG_WARN, "<%*s>\n", 100, long_name);
+    CHIP_LOG(CHIP_LOG_WARN, "{%s}\n", long_name);
+
+    chip_log_set_level(CHIP_LOG_WARN);
+    CHIP_LOG(CHIP_LOG_DEBUG, "filtered %d\n", 1);
+    write_register_via_pointer(0x40000014, 1);
+    uint32_t invalid = read_register_via_pointer(0x50000000);
+    TEST_ASSERT_EQUAL(0, invalid, "Invalid read returns 0");
+    chip_log_set_level(CHIP_LOG_DEBUG);
+
+    chip_log_flush();
+    chip_log_stats_t stats;
+    int stopped = chip_log_stop(&stats);
+    TEST_ASSERT_EQUAL(1, stopped, "Deferred logging stopped");
+    int stopped_again = chip_log_stop(NULL);
+    TEST_ASSERT_EQUAL(0, stopped_again, "Stop without start rejected");
+    TEST_ASSERT_EQUAL(0, stats.dropped, "No records dropped");
+    TEST_ASSERT_EQUAL(3, stats.inline_formatted, "Star width and oversized strings formatted inline");
+    TEST_ASSERT_EQUAL(0, stats.truncated, "No record truncated");
+
+    char text[1024];
+    rewind(sink);
+    size_t length = fread(text, 1, sizeof(text) - 1, sink);
+    text[length] = '\0';
+    const char* expected_head =
+        "Register 0x40000010 = 0x0000ABCD\n"
+        "CHIP_7: 45.25 C, 12 regs, 5%\n"
+        "[   7]\n";
+    TEST_ASSERT(strncmp(text, expected_head, strlen(expected_head)) == 0, "Deferred records formatted in order");
+    char expected_long[256];
+    snprintf(expected_long, sizeof(expected_long), "<%s>\n{%s}\n", long_name, long_name);
+    TEST_ASSERT(strstr(text, expected_long) != NULL, "Long inline and string records written in full");
+    TEST_ASSERT(strstr(text, "filtered") == NULL, "Messages above the level filtered");
+    TEST_ASSERT(strstr(text, "0x40000014") == NULL, "Register debug output filtered at WARN");
+    TEST_ASSERT(strstr(text, "0x50000000") != NULL, "Errors logged at WARN");
+    TEST_ASSERT_EQUAL(7, stats.logged, "Every unfiltered record written");
+    fclose(sink);
+
+    // A tiny ring never blocks the producer: overflow is counted instead
+    sink = tmpfile();
+    if (sink != NULL && chip_log_start(sink, 2)) {
+        for (int i = 0; i < 200; i++) {
+            CHIP_LOG(CHIP_LOG_INFO, "burst %d\n", i);
+        }
+        chip_log_stop(&stats);
+        TEST_ASSERT_EQUAL(200, stats.logged + stats.dropped, "Burst records written or counted as dropped");
+        fclose(sink);
+    }
+    chip_log_set_level(saved_level);
+}
+
 /**
  * Test chip structure operations
  */
@@ -308,6 +1001,292 @@ void test_memory_safety(void) {
     check_memory_leaks();
 }
 
+/**
+ * Test the hash-indexed allocation tracker beyond the old 1000-entry limit
+ */
+void test_allocation_tracker_scaling(void) {
+    printf("\n--- Testing Allocation Tracker Scaling ---\n");
+
+    init_memory_safety();
+
+    const int alloc_count = 3000;
+    void** ptrs = malloc(alloc_count * sizeof(void*));
+    if (ptrs == NULL) return;
+
+    // Several rounds of allocate-all/free-all reuse freed slots
+    int failed = 0;
+    for (int round = 0; round < 2; round++) {
+        for (int i = 0; i < alloc_count; i++) {
+            ptrs[i] = safe_malloc(16 + (i % 64), __FILE__, __LINE__);
+            if (ptrs[i] == NULL) failed++;
+        }
+        if (round == 0) {
+            TEST_ASSERT_EQUAL(alloc_count, (int)get_active_allocation_count(),
+                              "Tracker holds more than 1000 live allocations");
+        }
+        for (int i = 0; i < alloc_count; i++) {
+            safe_free(ptrs[i], __FILE__, __LINE__);
+        }
+    }
+    TEST_ASSERT_EQUAL(0, failed, "No tracked allocation failed across reuse rounds");
+    TEST_ASSERT_EQUAL(0, (int)get_active_allocation_count(), "All tracked allocations freed");
+
+    // Double free is still detected and does not disturb the live count
+    void* ptr = safe_malloc(32, __FILE__, __LINE__);
+    safe_free(ptr, __FILE__, __LINE__);
+    safe_free(ptr, __FILE__, __LINE__);
+    TEST_ASSERT_EQUAL(0, (int)get_active_allocation_count(), "Double free leaves live count intact");
+
+    free(ptrs);
+}
+
+#define CONCURRENT_TRACKER_THREADS 4
+#define CONCURRENT_TRACKER_BLOCKS  500
+
+static void* concurrent_tracker_worker(void* arg) {
+    void** blocks = (void**)arg;
+    for (int i = 0; i < CONCURRENT_TRACKER_BLOCKS; i++) {
+        blocks[i] = safe_malloc(8 + (size_t)(i % 100), __FILE__, __LINE__);
+    }
+    // Free every other block here; the rest are freed by another thread
+    for (int i = 0; i < CONCURRENT_TRACKER_BLOCKS; i += 2) {
+        safe_free(blocks[i], __FILE__, __LINE__);
+        blocks[i] = NULL;
+    }
+    return NULL;
+}
+
+static void* concurrent_tracker_cross_free(void* arg) {
+    void** blocks = (void**)arg;
+    for (int i = 1; i < CONCURRENT_TRACKER_BLOCKS; i += 2) {
+        safe_free(blocks[i], __FILE__, __LINE__);
+        blocks[i] = NULL;
+    }
+    return NULL;
+}
+
+/**
+ * Test the sharded tracker under concurrent and cross-thread use
+ */
+void test_concurrent_memory_tracker(void) {
+    printf("\n--- Testing Concurrent Memory Tracker ---\n");
+
+    init_memory_safety();
+    set_memory_safety_tracing(false);
+
+    static void* blocks[CONCURRENT_TRACKER_THREADS][CONCURRENT_TRACKER_BLOCKS];
+    pthread_t threads[CONCURRENT_TRACKER_THREADS];
+
+    int created = 0;
+    for (int t = 0; t < CONCURRENT_TRACKER_THREADS; t++) {
+        if (pthread_create(&threads[t], NULL, concurrent_tracker_worker, blocks[t]) == 0) created++;
+    }
+    for (int t = 0; t < created; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    TEST_ASSERT_EQUAL(CONCURRENT_TRACKER_THREADS, created, "All allocating threads started");
+    TEST_ASSERT_EQUAL(CONCURRENT_TRACKER_THREADS * CONCURRENT_TRACKER_BLOCKS / 2,
+                      (int)get_active_allocation_count(), "Live count correct after concurrent churn");
+
+    // Each thread frees the survivors of its neighbour
+    created = 0;
+    for (int t = 0; t < CONCURRENT_TRACKER_THREADS; t++) {
+        void** foreign = blocks[(t + 1) % CONCURRENT_TRACKER_THREADS];
+        if (pthread_create(&threads[t], NULL, concurrent_tracker_cross_free, foreign) == 0) created++;
+    }
+    for (int t = 0; t < created; t++) {
+        pthread_join(threads[t], NULL);
+    }
+
+    memory_safety_stats_t stats;
+    get_memory_safety_stats(&stats);
+    TEST_ASSERT_EQUAL(0, (int)stats.live_allocations, "Cross-thread frees release every block");
+    TEST_ASSERT_EQUAL(CONCURRENT_TRACKER_THREADS * CONCURRENT_TRACKER_BLOCKS, (int)stats.malloc_calls,
+                      "Per-thread malloc counts merge");
+    TEST_ASSERT_EQUAL((int)stats.malloc_calls, (int)stats.free_calls, "Per-thread free counts merge");
+    TEST_ASSERT_EQUAL(0, (int)stats.current_bytes, "Byte accounting returns to zero");
+    TEST_ASSERT(stats.peak_bytes > 0, "Peak usage recorded");
+    TEST_ASSERT_EQUAL(0, (int)stats.double_frees, "No double frees reported");
+
+    set_memory_safety_tracing(true);
+}
+
+/**
+ * Test sampled tracking and scaled estimates
+ */
+void test_memory_sampling(void) {
+    printf("\n--- Testing Memory Sampling ---\n");
+
+    init_memory_safety();
+    set_memory_safety_tracing(false);
+
+    const int count = 1000;
+    void** ptrs = malloc(count * sizeof(void*));
+    if (ptrs == NULL) return;
+
+    TEST_ASSERT(!set_memory_sampling(MEMORY_SAMPLING_EVERY_N, 0), "Zero sampling interval rejected");
+    TEST_ASSERT(set_memory_sampling(MEMORY_SAMPLING_EVERY_N, 10), "1-in-10 sampling enabled");
+
+    for (int i = 0; i < count; i++) {
+        ptrs[i] = safe_malloc(64, __FILE__, __LINE__);
+    }
+    memory_safety_stats_t stats;
+    get_memory_safety_stats(&stats);
+    TEST_ASSERT_EQUAL(count / 10, (int)stats.live_allocations, "Exactly 1 in 10 allocations tracked");
+    TEST_ASSERT_EQUAL(count - count / 10, (int)stats.unsampled_malloc_calls, "Others take the fast path");
+    TEST_ASSERT_EQUAL(count, (int)(stats.estimated_live_allocations + 0.5), "Live estimate scaled by N");
+    TEST_ASSERT_EQUAL(count * 64, (int)(stats.estimated_live_bytes + 0.5), "Byte estimate scaled by N");
+
+    // Mode changes do not affect how existing blocks are freed
+    set_memory_sampling(MEMORY_SAMPLING_ALL, 0);
+    for (int i = 0; i < count; i++) {
+        safe_free(ptrs[i], __FILE__, __LINE__);
+    }
+    get_memory_safety_stats(&stats);
+    TEST_ASSERT_EQUAL(0, (int)stats.live_allocations, "Tracked blocks freed");
+    TEST_ASSERT_EQUAL((int)stats.unsampled_malloc_calls, (int)stats.unsampled_free_calls,
+                      "Fast-path blocks freed");
+
+    // Poisson byte sampling: mean 4096 bytes between samples, 1 KiB blocks
+    set_memory_sampling(MEMORY_SAMPLING_POISSON_BYTES, 4096);
+    for (int i = 0; i < count; i++) {
+        ptrs[i] = safe_malloc(1024, __FILE__, __LINE__);
+    }
+    get_memory_safety_stats(&stats);
+    TEST_ASSERT(stats.live_allocations > 0 && stats.live_allocations < (size_t)count,
+                "Poisson sampler tracks a subset");
+    TEST_ASSERT(stats.estimated_live_allocations > count * 0.7 &&
+                stats.estimated_live_allocations < count * 1.3,
+                "Poisson estimate within 30% of true count");
+
+    // Blocks much larger than the mean are almost always sampled
+    void* big = safe_malloc(256 * 1024, __FILE__, __LINE__);
+    size_t before = stats.live_allocations;
+    get_memory_safety_stats(&stats);
+    TEST_ASSERT_EQUAL((int)before + 1, (int)stats.live_allocations, "Large allocation sampled");
+    safe_free(big, __FILE__, __LINE__);
+
+    for (int i = 0; i < count; i++) {
+        safe_free(ptrs[i], __FILE__, __LINE__);
+    }
+    TEST_ASSERT_EQUAL(0, (int)get_active_allocation_count(), "Poisson-sampled blocks freed");
+
+    set_memory_sampling(MEMORY_SAMPLING_ALL, 0);
+    set_memory_safety_tracing(true);
+    free(ptrs);
+}
+
+/**
+ * Run an access in a child process and report whether it died with SIGSEGV
+ * @param target Address to access
+ * @param write true to write a byte, false to read one
+ * @return true if the access faulted
+ */
+static bool access_faults(volatile uint8_t* target, bool write) {
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid < 0) return false;
+    if (pid == 0) {
+        if (write) {
+            *target = 0x42;
+        } else {
+            (void)*target;
+        }
+        _exit(0);
+    }
+
+    int status = 0;
+    if (waitpid(pid, &status, 0) != pid) return false;
+    return WIFSIGNALED(status) && WTERMSIG(status) == SIGSEGV;
+}
+
+/**
+ * Test guard-page mode: immediate faults on overflow and use-after-free
+ */
+void test_guard_pages(void) {
+    printf("\n--- Testing Guard Pages ---\n");
+
+    init_memory_safety();
+    set_memory_safety_tracing(false);
+    TEST_ASSERT(set_memory_guard_pages(true, 0), "Guard-page mode enabled");
+
+    long page = sysconf(_SC_PAGESIZE);
+    uint8_t* block = safe_malloc(100, __FILE__, __LINE__);
+    TEST_ASSERT_NOT_NULL(block, "Guarded allocation succeeds");
+    if (block == NULL) return;
+
+    // Default placement keeps malloc's alignment, leaving a little checked slack
+    uintptr_t block_end = (uintptr_t)block + 100;
+    uintptr_t guard_start = (block_end + (uintptr_t)page - 1) / (uintptr_t)page * (uintptr_t)page;
+    TEST_ASSERT((uintptr_t)block % __alignof__(long double) == 0 &&
+                (uintptr_t)block % __alignof__(long long) == 0,
+                "Guarded block aligned for any fundamental type");
+    TEST_ASSERT(guard_start - block_end < 16, "Block ends within one alignment unit of the guard page");
+    memset(block, 0xAB, 100);
+    TEST_ASSERT(!access_faults(block + 99, true), "In-bounds write succeeds");
+    TEST_ASSERT(access_faults((uint8_t*)guard_start, true), "Write past the slack faults immediately");
+
+    // Byte-exact placement is an explicit opt-in
+    TEST_ASSERT(!set_memory_guard_alignment(3), "Non-power-of-two alignment rejected");
+    TEST_ASSERT(set_memory_guard_alignment(1), "Byte-exact guard placement enabled");
+    uint8_t* exact = safe_malloc(100, __FILE__, __LINE__);
+    TEST_ASSERT_NOT_NULL(exact, "Byte-exact guarded allocation succeeds");
+    if (exact != NULL) {
+        TEST_ASSERT_EQUAL(0, (int)(((uintptr_t)exact + 100) % (uintptr_t)page),
+                          "Byte-exact block ends exactly at the guard page");
+        TEST_ASSERT(access_faults(exact + 100, true), "One-byte overflow faults immediately");
+        safe_free(exact, __FILE__, __LINE__);
+    }
+    set_memory_guard_alignment(0);
+
+    safe_free(block, __FILE__, __LINE__);
+    TEST_ASSERT(access_faults(block, false), "Use-after-free read faults");
+
+    memory_safety_stats_t stats;
+    get_memory_safety_stats(&stats);
+    TEST_ASSERT(stats.quarantine_bytes > 0, "Freed block held in quarantine");
+
+    safe_free(block, __FILE__, __LINE__);
+    get_memory_safety_stats(&stats);
+    TEST_ASSERT_EQUAL(1, (int)stats.double_frees, "Double free of quarantined block reported");
+
+    // Without a record the quarantine itself is checked, never the PROT_NONE tag word
+    safe_free(block + 16, __FILE__, __LINE__);
+    get_memory_safety_stats(&stats);
+    TEST_ASSERT_EQUAL(2, (int)stats.double_frees, "Free inside a quarantined block reported");
+
+    init_memory_safety();
+    set_memory_safety_tracing(false);
+    safe_free(block, __FILE__, __LINE__);
+    get_memory_safety_stats(&stats);
+    TEST_ASSERT_EQUAL(1, (int)stats.double_frees, "Double free reported after its record was dropped");
+
+    // Sizes that are not a multiple of 4 leave slack checked like a canary
+    uint8_t* odd = safe_malloc(10, __FILE__, __LINE__);
+    if (odd != NULL) {
+        odd[10] = 0;
+        safe_free(odd, __FILE__, __LINE__);
+    }
+    get_memory_safety_stats(&stats);
+    TEST_ASSERT_EQUAL(1, (int)stats.corruptions, "Overflow into alignment slack detected on free");
+
+    // Quarantine stays within its byte limit
+    set_memory_guard_pages(true, 64 * 1024);
+    for (int i = 0; i < 100; i++) {
+        void* p = safe_malloc(512, __FILE__, __LINE__);
+        safe_free(p, __FILE__, __LINE__);
+    }
+    get_memory_safety_stats(&stats);
+    TEST_ASSERT(stats.quarantine_bytes <= 64 * 1024, "Quarantine bounded by its limit");
+
+    set_memory_guard_pages(false, 0);
+    get_memory_safety_stats(&stats);
+    TEST_ASSERT_EQUAL(0, (int)stats.quarantine_bytes, "Disabling releases the quarantine");
+    TEST_ASSERT_EQUAL(0, (int)stats.guard_mapped_bytes, "No guarded mappings left");
+
+    set_memory_safety_tracing(true);
+}
+
 /**
  * Test AI optimization features
  */
@@ -340,6 +1319,799 @@ void test_ai_optimizations(void) {
     uint32_t crc_large_opt = calculate_crc32_optimized(large_data, 1000);
     uint32_t crc_large_naive = calculate_crc32_naive(large_data, 1000);
     TEST_ASSERT_EQUAL(crc_large_opt, crc_large_naive, "Large data CRC consistency");
+
+    // Standard check value for "123456789"
+    const uint8_t check_data[] = "123456789";
+    TEST_ASSERT(calculate_crc32_optimized(check_data, 9) == 0xCBF43926,
+                "CRC32 check value matches 0xCBF43926");
+
+    // Every engine must match the naive result for all lengths and alignments
+    for (int engine = 0; engine < CRC32_ENGINE_COUNT; engine++) {
+        int mismatches = 0;
+        for (size_t offset = 0; offset < 4; offset++) {
+            for (size_t len = 1; len <= 80; len++) {
+                uint32_t expected = calculate_crc32_naive(large_data + offset, len);
+                uint32_t actual = calculate_crc32_with_engine(large_data + offset, len,
+                                                              (crc32_engine_t)engine);
+                if (expected != actual) mismatches++;
+            }
+        }
+        TEST_ASSERT_EQUAL(0, mismatches, crc32_engine_name((crc32_engine_t)engine));
+    }
+
+    // Runtime engine selection is honoured and bit-for-bit compatible
+    crc32_engine_t saved_engine = get_crc32_engine();
+    set_crc32_engine(CRC32_ENGINE_SLICE_BY_8);
+    TEST_ASSERT(get_crc32_engine() == CRC32_ENGINE_SLICE_BY_8, "CRC32 engine selection works");
+    TEST_ASSERT(calculate_crc32_optimized(large_data, 1000) == crc_large_naive,
+                "Slice-by-8 engine matches naive CRC");
+    set_crc32_engine(saved_engine);
+}
+
+/**
+ * Test hardware CRC kernels against the table-driven implementations
+ */
+void test_hardware_crc(void) {
+    printf("\n--- Testing Hardware CRC Kernels ---\n");
+
+    const size_t max_len = 4096;
+    uint8_t* buffer = malloc(max_len);
+    TEST_ASSERT_NOT_NULL(buffer, "Random test buffer allocated");
+    if (buffer == NULL) return;
+
+    for (size_t i = 0; i < max_len; i++) {
+        buffer[i] = rand() & 0xFF;
+    }
+
+    // Every length from 0 to 4 KiB, fresh random content for each length
+    int crc32_mismatches = 0;
+    int crc32c_mismatches = 0;
+    for (size_t len = 0; len <= max_len; len++) {
+        if (len > 0) buffer[rand() % len] = rand() & 0xFF;
+
+        uint32_t table = calculate_crc32_with_engine(buffer, len, CRC32_ENGINE_BYTEWISE);
+        uint32_t fast = calculate_crc32_with_engine(buffer, len, CRC32_ENGINE_PCLMUL);
+        if (table != fast) crc32_mismatches++;
+
+        if (calculate_crc32c(buffer, len) != calculate_crc32c_software(buffer, len)) {
+            crc32c_mismatches++;
+        }
+    }
+
+    printf("  PCLMULQDQ engine: %s, CRC32C hardware: %s\n",
+           crc32_engine_supported(CRC32_ENGINE_PCLMUL) ? "available" : "fallback",
+           crc32c_hardware_available() ? "available" : "fallback");
+    TEST_ASSERT_EQUAL(0, crc32_mismatches, "PCLMULQDQ CRC32 matches table for lengths 0-4096");
+    TEST_ASSERT_EQUAL(0, crc32c_mismatches, "CRC32C dispatch matches software for lengths 0-4096");
+
+    // Unaligned start must not matter
+    TEST_ASSERT(calculate_crc32_with_engine(buffer + 3, 1000, CRC32_ENGINE_PCLMUL) ==
+                calculate_crc32_naive(buffer + 3, 1000), "PCLMULQDQ CRC32 handles unaligned data");
+
+    // Standard CRC32C check value for "123456789"
+    const uint8_t check_data[] = "123456789";
+    TEST_ASSERT(calculate_crc32c(check_data, 9) == 0xE3069283,
+                "CRC32C check value matches 0xE3069283");
+
+    free(buffer);
+}
+
+/**
+ * Test streaming CRC32 API and crc32_combine
+ */
+void test_streaming_crc(void) {
+    printf("\n--- Testing Streaming CRC32 ---\n");
+
+    uint8_t data[3000];
+    for (size_t i = 0; i < sizeof(data); i++) {
+        data[i] = rand() & 0xFF;
+    }
+    uint32_t expected = calculate_crc32_naive(data, sizeof(data));
+
+    // Empty stream finalizes to the CRC of an empty message
+    crc32_context_t ctx;
+    crc32_init(&ctx);
+    crc32_update(&ctx, NULL, 0);
+    TEST_ASSERT(crc32_final(&ctx) == 0, "Empty stream finalizes to zero");
+
+    // Random chunk sizes (including empty chunks) match the one-shot CRC
+    size_t offset = 0;
+    while (offset < sizeof(data)) {
+        size_t chunk = rand() % 97;
+        if (chunk > sizeof(data) - offset) chunk = sizeof(data) - offset;
+        crc32_update(&ctx, data + offset, chunk);
+        offset += chunk;
+    }
+    TEST_ASSERT(crc32_final(&ctx) == expected, "Chunked streaming CRC matches one-shot CRC");
+    TEST_ASSERT(ctx.length == sizeof(data), "Streaming context tracks total length");
+
+    // Splitting at any point and combining gives the whole-buffer CRC
+    int combine_mismatches = 0;
+    for (size_t split = 0; split <= sizeof(data); split += 37) {
+        uint32_t crc_a = calculate_crc32_naive(data, split);
+        uint32_t crc_b = calculate_crc32_naive(data + split, sizeof(data) - split);
+        if (crc32_combine(crc_a, crc_b, sizeof(data) - split) != expected) {
+            combine_mismatches++;
+        }
+    }
+    TEST_ASSERT_EQUAL(0, combine_mismatches, "crc32_combine merges split buffers");
+}
+
+/**
+ * Test vectorized memory copy against memcpy
+ */
+void test_memory_copy(void) {
+    printf("\n--- Testing Optimized Memory Copy ---\n");
+
+    const size_t buf_size = 4096;
+    uint8_t* src = malloc(buf_size);
+    uint8_t* dst = malloc(buf_size);
+    uint8_t* ref = malloc(buf_size);
+    TEST_ASSERT(src != NULL && dst != NULL && ref != NULL, "Copy test buffers allocated");
+    if (src == NULL || dst == NULL || ref == NULL) {
+        free(src);
+        free(dst);
+        free(ref);
+        return;
+    }
+
+    for (size_t i = 0; i < buf_size; i++) {
+        src[i] = rand() & 0xFF;
+    }
+
+    // All sizes up to 600 bytes at every source/destination misalignment
+    int mismatches = 0;
+    for (size_t src_off = 0; src_off < 8; src_off++) {
+        for (size_t dst_off = 0; dst_off < 8; dst_off++) {
+            for (size_t size = 0; size <= 600; size++) {
+                memset(dst, 0xEE, 700);
+                memset(ref, 0xEE, 700);
+                optimized_memory_copy(dst + dst_off, src + src_off, size);
+                memcpy(ref + dst_off, src + src_off, size);
+                if (memcmp(dst, ref, 700) != 0) mismatches++;
+            }
+        }
+    }
+    TEST_ASSERT_EQUAL(0, mismatches, "Copy matches memcpy for all sizes/alignments (no overrun)");
+
+    // Force the non-temporal streaming path with a low threshold
+    size_t saved_threshold = get_memory_copy_nt_threshold();
+    set_memory_copy_nt_threshold(1024);
+    TEST_ASSERT_EQUAL(1024, (int)get_memory_copy_nt_threshold(), "Non-temporal threshold is configurable");
+    memset(dst, 0, buf_size);
+    optimized_memory_copy(dst + 5, src + 3, buf_size - 16);
+    TEST_ASSERT(memcmp(dst + 5, src + 3, buf_size - 16) == 0, "Streaming-store copy is correct");
+    set_memory_copy_nt_threshold(saved_threshold);
+
+    free(src);
+    free(dst);
+    free(ref);
+}
+
+/**
+ * Test Structure-of-Arrays fleet scans against per-chip flags
+ */
+void test_chip_fleet(void) {
+    printf("\n--- Testing SoA Chip Fleet ---\n");
+
+    const int chip_count = 1003;  // Not a multiple of the vector width
+    chip_state_t* chips = calloc(chip_count, sizeof(chip_state_t));
+    chip_state_t** chip_ptrs = malloc(chip_count * sizeof(chip_state_t*));
+    chip_fleet_t* fleet = create_chip_fleet(chip_count);
+    uint8_t* flags = malloc(chip_count);
+    TEST_ASSERT(chips && chip_ptrs && fleet && flags, "Fleet test data allocated");
+    if (!chips || !chip_ptrs || !fleet || !flags) {
+        free(chips);
+        free(chip_ptrs);
+        destroy_chip_fleet(fleet);
+        free(flags);
+        return;
+    }
+
+    // Include exact boundary values for the thresholds
+    const float voltages[] = {2.99f, 3.0f, 3.3f, 3.6f, 3.61f};
+    const float temps[] = {69.9f, 70.0f, 70.1f, 25.0f};
+    for (int i = 0; i < chip_count; i++) {
+        chips[i].temperature = temps[rand() % 4];
+        chips[i].voltage = voltages[rand() % 5];
+        chips[i].error_count = (rand() % 7 == 0) ? rand() % 3 : 0;
+        chips[i].registers.error_register = (rand() % 9 == 0) ? 0x80000000 : 0;
+        chip_ptrs[i] = &chips[i];
+    }
+
+    TEST_ASSERT_EQUAL(chip_count, chip_fleet_load(fleet, chip_ptrs, chip_count),
+                      "All chips loaded into fleet");
+    TEST_ASSERT(((uintptr_t)fleet->temperatures % 64) == 0 &&
+                ((uintptr_t)fleet->error_registers % 64) == 0, "Fleet arrays are cache-line aligned");
+
+    int expected_issues = 0;
+    double expected_sum = 0.0;
+    for (int i = 0; i < chip_count; i++) {
+        expected_issues += compute_chip_issue_flags(&chips[i], 70.0f) != 0;
+        expected_sum += chips[i].temperature;
+    }
+    float expected_average = (float)(expected_sum / chip_count);
+
+    for (int simd = 0; simd <= 1; simd++) {
+        memset(flags, 0xFF, chip_count);
+        float average = 0.0f;
+        int issues = chip_fleet_scan_issues(fleet, 70.0f, flags, &average, simd == 1);
+        TEST_ASSERT(average == expected_average, simd ? "SIMD average temperature summed in double"
+                                                      : "Scalar average temperature summed in double");
+        int mismatches = 0;
+        for (int i = 0; i < chip_count; i++) {
+            if (flags[i] != compute_chip_issue_flags(&chips[i], 70.0f)) mismatches++;
+        }
+        TEST_ASSERT_EQUAL(0, mismatches, simd ? "SIMD fleet flags match per-chip flags"
+                                              : "Scalar fleet flags match per-chip flags");
+        TEST_ASSERT_EQUAL(expected_issues, issues, "Fleet scan issue count");
+    }
+
+    free(chips);
+    free(chip_ptrs);
+    destroy_chip_fleet(fleet);
+    free(flags);
+}
+
+/**
+ * Test the chip slab pool
+ */
+void test_chip_pool(void) {
+    printf("\n--- Testing Chip Slab Pool ---\n");
+
+    chip_pool_t* pool = create_chip_pool(8, false);
+    TEST_ASSERT_NOT_NULL(pool, "Chip pool creation");
+    if (pool == NULL) return;
+
+    chip_state_t* a = chip_pool_alloc(pool);
+    chip_state_t* b = chip_pool_alloc(pool);
+    TEST_ASSERT(a != NULL && b != NULL && a != b, "Single allocations succeed");
+    TEST_ASSERT_EQUAL(0, (int)((uintptr_t)a % 64), "Slots are cache-line aligned");
+    TEST_ASSERT(a->serial_number == 0 && !a->is_initialized, "Pooled chips start zeroed");
+
+    // O(1) reuse through the free list
+    chip_pool_free(pool, a);
+    TEST_ASSERT(chip_pool_alloc(pool) == a, "Freed slot reused first");
+
+    // Bulk allocation larger than a slab: free slots first, then one new slab
+    chip_state_t* chips[100];
+    size_t bulk = chip_pool_alloc_bulk(pool, chips, 100);
+    TEST_ASSERT_EQUAL(100, (int)bulk, "Bulk allocate 100 chips");
+    TEST_ASSERT_EQUAL(102, (int)pool->live_count, "Live count tracks bulk allocation");
+    int contiguous = 1;
+    for (int i = 7; i < 100; i++) {
+        if ((char*)chips[i] - (char*)chips[i - 1] != (char*)chips[7] - (char*)chips[6]) contiguous = 0;
+    }
+    TEST_ASSERT(contiguous && chips[7] > chips[6], "New-slab chips are contiguous");
+
+    chip_pool_free_bulk(pool, chips, 100);
+    TEST_ASSERT_EQUAL(2, (int)pool->live_count, "Bulk free returns chips");
+    size_t slabs = pool->slab_count;
+    chip_pool_alloc_bulk(pool, chips, 100);
+    TEST_ASSERT_EQUAL((int)slabs, (int)pool->slab_count, "Bulk reallocation reuses free slots");
+    destroy_chip_pool(pool);
+
+    // Tracker-backed pool: slabs are tracked allocations, bad frees are rejected
+    init_memory_safety();
+    set_memory_safety_tracing(false);
+    pool = create_chip_pool(16, true);
+    chip_state_t* tracked = chip_pool_alloc(pool);
+    TEST_ASSERT_EQUAL(1, (int)get_active_allocation_count(), "Tracked pool uses one tracked slab");
+    chip_pool_free(pool, tracked);
+    chip_pool_free(pool, tracked);
+    TEST_ASSERT_EQUAL(0, (int)pool->live_count, "Double free of pooled chip ignored");
+    chip_state_t outside;
+    chip_pool_free(pool, &outside);
+    TEST_ASSERT_EQUAL(0, (int)pool->live_count, "Foreign pointer rejected");
+    destroy_chip_pool(pool);
+    TEST_ASSERT_EQUAL(0, (int)get_active_allocation_count(), "Destroy releases tracked slabs");
+    set_memory_safety_tracing(true);
+}
+
+/**
+ * Test the generational slot map behind the chip monitor
+ */
+void test_chip_slot_map(void) {
+    printf("\n--- Testing Chip Slot Map ---\n");
+
+    chip_slot_map_t* map = create_chip_slot_map(2);
+    TEST_ASSERT_NOT_NULL(map, "Slot map creation");
+    if (map == NULL) return;
+
+    chip_state_t chip;
+    memset(&chip, 0, sizeof(chip));
+    chip_handle_t handles[3];
+    for (int i = 0; i < 3; i++) {
+        chip.serial_number = 100 + i;
+        handles[i] = chip_slot_map_insert(map, &chip);
+    }
+    TEST_ASSERT(handles[0] != CHIP_HANDLE_INVALID && handles[2] != CHIP_HANDLE_INVALID, "Inserts return handles");
+    TEST_ASSERT(map->capacity >= 3 && map->count == 3, "Map grows past initial capacity");
+    chip_state_t* found = chip_slot_map_get(map, handles[1]);
+    TEST_ASSERT(found != NULL && found->serial_number == 101, "Handle resolves to its chip");
+
+    // Removing from the middle keeps the other handles and the dense array intact
+    int removed = chip_slot_map_remove(map, handles[0]);
+    TEST_ASSERT_EQUAL(1, removed, "Remove by handle");
+    found = chip_slot_map_get(map, handles[2]);
+    TEST_ASSERT(found != NULL && found->serial_number == 102, "Other handles survive removal");
+    TEST_ASSERT(map->count == 2 && map->chips[0].serial_number == 102, "Last chip fills the hole");
+    TEST_ASSERT(chip_slot_map_handle_at(map, 0) == handles[2], "Dense position maps back to handle");
+    TEST_ASSERT_NULL(chip_slot_map_get(map, handles[0]), "Stale handle detected");
+    int removed_again = chip_slot_map_remove(map, handles[0]);
+    TEST_ASSERT_EQUAL(0, removed_again, "Stale handle cannot remove");
+
+    // The freed slot is reused under a new generation
+    chip.serial_number = 200;
+    chip_handle_t reused = chip_slot_map_insert(map, &chip);
+    TEST_ASSERT(CHIP_HANDLE_SLOT(reused) == CHIP_HANDLE_SLOT(handles[0]) && reused != handles[0],
+                "Reused slot gets a new generation");
+    TEST_ASSERT_NULL(chip_slot_map_get(map, handles[0]), "Old handle stays stale after reuse");
+    TEST_ASSERT_NULL(chip_slot_map_get(map, CHIP_HANDLE_INVALID), "Invalid handle rejected");
+
+    // Churn: every live handle keeps resolving to the chip it was issued for
+    chip_handle_t many[1000];
+    for (int i = 0; i < 1000; i++) {
+        chip.serial_number = (uint32_t)i;
+        many[i] = chip_slot_map_insert(map, &chip);
+    }
+    for (int i = 0; i < 1000; i += 3) chip_slot_map_remove(map, many[i]);
+    int consistent = 1;
+    for (int i = 0; i < 1000; i++) {
+        chip_state_t* c = chip_slot_map_get(map, many[i]);
+        if ((i % 3 == 0) != (c == NULL) || (c != NULL && c->serial_number != (uint32_t)i)) consistent = 0;
+    }
+    TEST_ASSERT(consistent, "Handles stay valid through churn");
+    TEST_ASSERT_EQUAL(3 + 666, (int)map->count, "Count tracks churn");
+
+    chip_slot_map_clear(map);
+    TEST_ASSERT_EQUAL(0, (int)map->count, "Clear empties the map");
+    TEST_ASSERT_NULL(chip_slot_map_get(map, many[1]), "Clear invalidates handles");
+    destroy_chip_slot_map(map);
+}
+
+// Parallel-for body for test_chip_worker_pool: count visits per item
+static void count_visits(void* context, size_t begin, size_t end, int worker) {
+    int* visits = (int*)context;
+    if (worker == 0 && begin == 0) {
+        // Hold worker 0 up so the others run out of work and steal its chunks
+        struct timespec pause = { 0, 20000000 };
+        nanosleep(&pause, NULL);
+    }
+    for (size_t i = begin; i < end; i++) {
+        __atomic_add_fetch(&visits[i], 1, __ATOMIC_RELAXED);
+    }
+}
+
+// Health function for test_chip_worker_pool: touches only its own chip
+static int tick_test_chip(chip_state_t* chip) {
+    chip->uptime_seconds++;
+    return (int)(chip->serial_number % 101);
+}
+
+/**
+ * Test the work-stealing pool and the parallel monitoring pass
+ */
+void test_chip_worker_pool(void) {
+    printf("\n--- Testing Chip Worker Pool ---\n");
+
+    chip_worker_pool_t* pool = create_chip_worker_pool(4);
+    TEST_ASSERT_NOT_NULL(pool, "Worker pool creation");
+    if (pool == NULL) return;
+    TEST_ASSERT_EQUAL(4, chip_worker_pool_size(pool), "Pool has requested workers");
+
+    static int visits[10000];
+    memset(visits, 0, sizeof(visits));
+    int ran = chip_parallel_for(pool, 10000, 7, count_visits, visits);
+    TEST_ASSERT_EQUAL(1, ran, "Parallel for completes");
+    int exactly_once = 1;
+    for (int i = 0; i < 10000; i++) {
+        if (visits[i] != 1) exactly_once = 0;
+    }
+    TEST_ASSERT(exactly_once, "Every item visited exactly once");
+    TEST_ASSERT(chip_worker_pool_steals(pool) > 0, "Idle workers steal from a busy one");
+
+    // Back-to-back jobs on the same pool
+    memset(visits, 0, sizeof(visits));
+    for (int job = 0; job < 50; job++) {
+        chip_parallel_for(pool, 1000, 0, count_visits, visits + 1000);
+    }
+    TEST_ASSERT(visits[1000] == 50 && visits[1999] == 50 && visits[0] == 0, "Pool reused across jobs");
+    int rejected = chip_parallel_for(pool, 10, 0, NULL, NULL);
+    TEST_ASSERT_EQUAL(0, rejected, "Missing body rejected");
+
+    // Parallel monitoring pass matches a serial one
+    const int count = 1000;
+    chip_state_t* fleet = calloc(count, sizeof(chip_state_t));
+    int* health = malloc(count * sizeof(int));
+    int* serial_health = malloc(count * sizeof(int));
+    if (fleet != NULL && health != NULL && serial_health != NULL) {
+        for (int i = 0; i < count; i++) fleet[i].serial_number = (uint32_t)(i * 37);
+
+        chip_monitor_totals_t parallel_totals, serial_totals;
+        chip_monitor_pass(pool, fleet, count, tick_test_chip, health, &parallel_totals);
+        chip_monitor_pass(NULL, fleet, count, tick_test_chip, serial_health, &serial_totals);
+        TEST_ASSERT(memcmp(health, serial_health, count * sizeof(int)) == 0, "Scores land in chip order");
+        TEST_ASSERT(parallel_totals.total_health == serial_totals.total_health &&
+                    parallel_totals.critical_chips == serial_totals.critical_chips &&
+                    parallel_totals.warning_chips == serial_totals.warning_chips,
+                    "Merged aggregates match serial pass");
+        TEST_ASSERT_EQUAL(count, parallel_totals.chips, "Every chip counted once");
+        int ticked_twice = 1;
+        for (int i = 0; i < count; i++) {
+            if (fleet[i].uptime_seconds != 2) ticked_twice = 0;
+        }
+        TEST_ASSERT(ticked_twice, "Each pass updates each chip once");
+    }
+    free(fleet);
+    free(health);
+    free(serial_health);
+    destroy_chip_worker_pool(pool);
+}
+
+// Timer callback state for test_chip_timer_wheel (virtual clock, no sleeping)
+typedef struct {
+    chip_timer_wheel_t* wheel;
+    int id;
+    int fires;
+    int cancel_after;           // Cancel itself on this firing (0 = never)
+    uint64_t first_ns;
+    uint64_t last_ns;
+    uint64_t max_gap_ns;
+} timer_test_ctx_t;
+
+static uint64_t timer_test_now_ns;
+
+static void record_timer_fire(void* context, uint64_t data) {
+    timer_test_ctx_t* ctx = (timer_test_ctx_t*)context;
+    (void)data;
+    if (ctx->fires == 0) ctx->first_ns = timer_test_now_ns;
+    if (ctx->fires > 0 && timer_test_now_ns - ctx->last_ns > ctx->max_gap_ns) {
+        ctx->max_gap_ns = timer_test_now_ns - ctx->last_ns;
+    }
+    ctx->last_ns = timer_test_now_ns;
+    ctx->fires++;
+    if (ctx->fires == ctx->cancel_after) chip_timer_cancel(ctx->wheel, ctx->id);
+}
+
+// Step the virtual clock one millisecond at a time
+static void advance_timer_test(chip_timer_wheel_t* wheel, uint64_t until_ms) {
+    while (timer_test_now_ns < until_ms * 1000000ull) {
+        timer_test_now_ns += 1000000ull;
+        chip_timer_wheel_advance(wheel, timer_test_now_ns);
+    }
+}
+
+/**
+ * Test the monitor scheduler's timer wheel
+ */
+void test_chip_timer_wheel(void) {
+    printf("\n--- Testing Chip Timer Wheel ---\n");
+
+    const uint64_t ms = 1000000ull;
+    timer_test_now_ns = 0;
+    chip_timer_wheel_t* wheel = create_chip_timer_wheel(ms, 0);
+    TEST_ASSERT_NOT_NULL(wheel, "Timer wheel creation");
+    if (wheel == NULL) return;
+
+    timer_test_ctx_t fast = { wheel, -1, 0, 0, 0, 0, 0 };
+    timer_test_ctx_t slow = { wheel, -1, 0, 0, 0, 0, 0 };
+    timer_test_ctx_t once = { wheel, -1, 0, 3, 0, 0, 0 };
+    fast.id = chip_timer_schedule(wheel, 0, 10 * ms, 0, record_timer_fire, &fast, 1);
+    slow.id = chip_timer_schedule(wheel, 0, 5000 * ms, 0, record_timer_fire, &slow, 2);
+    once.id = chip_timer_schedule(wheel, 0, 7 * ms, 0, record_timer_fire, &once, 3);
+    TEST_ASSERT(fast.id >= 0 && slow.id >= 0 && once.id >= 0, "Timers scheduled");
+    int too_fast = chip_timer_schedule(wheel, 0, ms / 2, 0, record_timer_fire, &fast, 4);
+    TEST_ASSERT_EQUAL(-1, too_fast, "Period below one tick rejected");
+
+    uint64_t next = chip_timer_wheel_next_expiry(wheel);
+    TEST_ASSERT(next <= 7 * ms, "Next expiry is never later than the first due timer");
+
+    // Periodic firing on exact multiples of the period
+    advance_timer_test(wheel, 9);
+    TEST_ASSERT_EQUAL(0, fast.fires, "Nothing fires before its period");
+    advance_timer_test(wheel, 100);
+    TEST_ASSERT_EQUAL(10, fast.fires, "10 ms timer fires 10 times in 100 ms");
+    TEST_ASSERT(fast.first_ns == 10 * ms && fast.last_ns == 100 * ms && fast.max_gap_ns == 10 * ms,
+                "Firings land on period multiples");
+
+    // Cancel from inside the callback
+    TEST_ASSERT_EQUAL(3, once.fires, "Timer cancelled itself on its third firing");
+    int cancelled_again = chip_timer_cancel(wheel, once.id);
+    TEST_ASSERT_EQUAL(0, cancelled_again, "Cancelled timer cannot be cancelled twice");
+
+    // Re-period: next expiry one new period after the last
+    int changed = chip_timer_set_period(wheel, fast.id, 20 * ms);
+    TEST_ASSERT_EQUAL(1, changed, "Period changed");
+    advance_timer_test(wheel, 200);
+    TEST_ASSERT(fast.fires == 15 && fast.last_ns == 200 * ms, "New period takes effect");
+
+    // Level-2 timer (5000 ticks) cascades down and fires on time
+    advance_timer_test(wheel, 4999);
+    TEST_ASSERT_EQUAL(0, slow.fires, "Slow timer not yet due");
+    advance_timer_test(wheel, 5000);
+    TEST_ASSERT(slow.fires == 1 && slow.first_ns == 5000 * ms, "Cascaded timer fires on its tick");
+
+    // A jump past several periods fires once and counts the skipped ones
+    int fires_before = fast.fires;
+    timer_test_now_ns = 5105 * ms;
+    chip_timer_wheel_advance(wheel, timer_test_now_ns);
+    chip_timer_stats_t stats;
+    chip_timer_wheel_stats(wheel, &stats);
+    TEST_ASSERT_EQUAL(fires_before + 1, fast.fires, "Late timer fires once, not once per period");
+    TEST_ASSERT(stats.missed >= 4, "Skipped periods counted as missed");
+    TEST_ASSERT(stats.max_lateness_ns >= 85 * ms, "Lateness recorded");
+    advance_timer_test(wheel, 5120);
+    TEST_ASSERT(fast.last_ns == 5120 * ms, "Timer keeps its original phase");
+
+    int cancelled = chip_timer_cancel(wheel, slow.id);
+    TEST_ASSERT_EQUAL(1, cancelled, "Timer cancelled");
+    chip_timer_wheel_stats(wheel, &stats);
+    TEST_ASSERT_EQUAL(1, stats.active_timers, "One timer left active");
+    destroy_chip_timer_wheel(wheel);
+
+    // Shortening an overdue timer's period fires it on the next tick, not a rotation later
+    timer_test_now_ns = 0;
+    wheel = create_chip_timer_wheel(ms, 0);
+    timer_test_ctx_t hot = { wheel, -1, 0, 0, 0, 0, 0 };
+    hot.id = chip_timer_schedule(wheel, 0, 1000 * ms, 0, record_timer_fire, &hot, 5);
+    advance_timer_test(wheel, 1500);
+    TEST_ASSERT(hot.fires == 1 && hot.last_ns == 1000 * ms, "Slow timer fired once");
+    uint64_t hot_next = 0;
+    if (chip_timer_set_period(wheel, hot.id, 100 * ms)) hot_next = chip_timer_wheel_next_expiry(wheel);
+    TEST_ASSERT(hot_next == 1501 * ms, "Next expiry of an overdue timer is the next tick");
+    advance_timer_test(wheel, 1501);
+    TEST_ASSERT(hot.fires == 2 && hot.last_ns == 1501 * ms, "Overdue timer fires on the next tick");
+    advance_timer_test(wheel, 1600);
+    TEST_ASSERT(hot.fires == 3 && hot.last_ns == 1600 * ms, "Then keeps its phase on the new period");
+    destroy_chip_timer_wheel(wheel);
+
+    // Jitter spreads timers scheduled together over the period
+    size_t bursts[2];
+    for (int spread = 0; spread < 2; spread++) {
+        timer_test_now_ns = 0;
+        wheel = create_chip_timer_wheel(ms, 0);
+        timer_test_ctx_t fleet = { wheel, -1, 0, 0, 0, 0, 0 };
+        for (int i = 0; i < 1000; i++) {
+            chip_timer_schedule(wheel, 0, 100 * ms, spread ? 100 * ms : 0, record_timer_fire, &fleet, (uint64_t)i);
+        }
+        advance_timer_test(wheel, 300);
+        chip_timer_wheel_stats(wheel, &stats);
+        bursts[spread] = stats.max_tick_fires;
+        destroy_chip_timer_wheel(wheel);
+    }
+    TEST_ASSERT_EQUAL(1000, (int)bursts[0], "Without jitter every timer fires on the same tick");
+    TEST_ASSERT(bursts[1] < 50, "Jitter spreads the burst");
+}
+
+/**
+ * Test the per-chip sample history and its windowed aggregates
+ */
+void test_chip_history(void) {
+    printf("\n--- Testing Chip History ---\n");
+
+    chip_history_t* history = create_chip_history(50);
+    TEST_ASSERT_NOT_NULL(history, "History creation");
+    if (history == NULL) return;
+    TEST_ASSERT_EQUAL(64, (int)chip_history_capacity(history), "Capacity rounded up to a power of two");
+
+    chip_window_stats_t stats;
+    int empty = chip_history_window(history, CHIP_METRIC_TEMPERATURE, 0, &stats);
+    TEST_ASSERT_EQUAL(0, empty, "Empty history has no window");
+
+    // 200 samples: the ring wraps three times
+    const int total = 200;
+    float temps[200];
+    float volts[200];
+    chip_state_t chip;
+    memset(&chip, 0, sizeof(chip));
+    unsigned int seed = 42;
+    for (int i = 0; i < total; i++) {
+        temps[i] = 30.0f + (float)(rand_r(&seed) % 600) / 10.0f;
+        volts[i] = 3.0f + (float)(rand_r(&seed) % 60) / 100.0f;
+        chip.temperature = temps[i];
+        chip.voltage = volts[i];
+        chip.registers.error_register = (i % 7 == 0) ? 1 : 0;
+        chip_history_record(history, (uint64_t)(i + 1) * 1000000000ull, &chip);
+    }
+    TEST_ASSERT_EQUAL(64, (int)chip_history_count(history), "Ring holds its capacity");
+    const chip_sample_t* newest = chip_history_sample(history, 0);
+    const chip_sample_t* oldest = chip_history_sample(history, 63);
+    TEST_ASSERT(newest != NULL && newest->temperature == temps[total - 1] &&
+                oldest != NULL && oldest->temperature == temps[total - 64],
+                "Samples addressed by age");
+    TEST_ASSERT_NULL(chip_history_sample(history, 64), "Overwritten samples are gone");
+
+    // Aggregates match a brute-force scan for every window length, wrapped or not
+    int matches = 1;
+    for (size_t n = 1; n <= 64; n++) {
+        chip_window_stats_t temp, volt;
+        chip_history_window(history, CHIP_METRIC_TEMPERATURE, n, &temp);
+        chip_history_window(history, CHIP_METRIC_VOLTAGE, n, &volt);
+        float tmin = temps[total - 1], tmax = temps[total - 1], vmin = volts[total - 1], vmax = volts[total - 1];
+        double tsum = 0.0;
+        uint64_t errors = 0;
+        for (int i = total - (int)n; i < total; i++) {
+            if (temps[i] < tmin) tmin = temps[i];
+            if (temps[i] > tmax) tmax = temps[i];
+            if (volts[i] < vmin) vmin = volts[i];
+            if (volts[i] > vmax) vmax = volts[i];
+            tsum += temps[i];
+            if (i % 7 == 0) errors++;
+        }
+        double mean_error = temp.mean - tsum / (double)n;
+        if (temp.samples != n || temp.min != tmin || temp.max != tmax || vmin != volt.min || vmax != volt.max ||
+            mean_error > 1e-3 || mean_error < -1e-3 || temp.error_samples != errors ||
+            temp.last_ns != (uint64_t)total * 1000000000ull) {
+            matches = 0;
+        }
+    }
+    TEST_ASSERT(matches, "Window min/max/mean/errors match a full scan");
+
+    int clamped = chip_history_window(history, CHIP_METRIC_TEMPERATURE, 1000, &stats);
+    TEST_ASSERT(clamped == 1 && stats.samples == 64, "Oversized window clamps to samples held");
+
+    // Time windows: samples taken in the last 10 s
+    size_t in_window = chip_history_samples_since(history, (uint64_t)(total - 9) * 1000000000ull);
+    TEST_ASSERT_EQUAL(10, (int)in_window, "Time window found by timestamp");
+    size_t all_held = chip_history_samples_since(history, 0);
+    TEST_ASSERT_EQUAL(64, (int)all_held, "Time window older than the ring covers every sample");
+
+    // Percentiles against a sorted copy of the window
+    float sorted[32];
+    for (int i = 0; i < 32; i++) sorted[i] = temps[total - 32 + i];
+    for (int i = 1; i < 32; i++) {
+        for (int j = i; j > 0 && sorted[j - 1] > sorted[j]; j--) {
+            float tmp = sorted[j];
+            sorted[j] = sorted[j - 1];
+            sorted[j - 1] = tmp;
+        }
+    }
+    float p50 = 0.0f, p100 = 0.0f, p0 = 0.0f;
+    chip_history_percentile(history, CHIP_METRIC_TEMPERATURE, 32, 50.0, &p50);
+    chip_history_percentile(history, CHIP_METRIC_TEMPERATURE, 32, 100.0, &p100);
+    chip_history_percentile(history, CHIP_METRIC_TEMPERATURE, 32, 0.0, &p0);
+    TEST_ASSERT(p50 == sorted[15] && p100 == sorted[31] && p0 == sorted[0], "Percentiles use nearest rank");
+    int bad_percentile = chip_history_percentile(history, CHIP_METRIC_TEMPERATURE, 32, 101.0, &p50);
+    TEST_ASSERT_EQUAL(0, bad_percentile, "Percentile above 100 rejected");
+
+    int backwards = chip_history_record(history, 1000000000ull, &chip);
+    TEST_ASSERT_EQUAL(0, backwards, "Out-of-order sample rejected");
+
+    chip_history_reset(history);
+    TEST_ASSERT_EQUAL(0, (int)chip_history_count(history), "Reset empties the history");
+    chip.temperature = 77.0f;
+    chip_history_record(history, 5, &chip);
+    chip_history_window(history, CHIP_METRIC_TEMPERATURE, 0, &stats);
+    TEST_ASSERT(stats.samples == 1 && stats.min == 77.0f && stats.max == 77.0f && stats.mean == 77.0f,
+                "Old samples do not leak into windows after reset");
+    destroy_chip_history(history);
+}
+
+/**
+ * Test the compressed telemetry codec and its block index
+ */
+void test_chip_telemetry(void) {
+    printf("\n--- Testing Chip Telemetry ---\n");
+
+    chip_telemetry_t* store = create_chip_telemetry(64);
+    TEST_ASSERT_NOT_NULL(store, "Telemetry store creation");
+    if (store == NULL) return;
+
+    // Awkward input: steady and irregular timestamps, a huge gap, sign flips,
+    // NaN and infinities, negative zero and random register words
+    const int count = 1000;
+    chip_sample_t* input = calloc(count, sizeof(chip_sample_t));
+    chip_sample_t* output = calloc(count, sizeof(chip_sample_t));
+    if (input == NULL || output == NULL) {
+        free(input);
+        free(output);
+        destroy_chip_telemetry(store);
+        return;
+    }
+    unsigned int seed = 7;
+    uint64_t timestamp = 5000000000ull;
+    for (int i = 0; i < count; i++) {
+        int r = rand_r(&seed);
+        if (i == 500) {
+            timestamp += 1ull << 62;
+        } else if (i % 3 == 0) {
+            timestamp += 1000000000ull;
+        } else {
+            timestamp += (uint64_t)(r % 5000);
+        }
+        input[i].timestamp_ns = timestamp;
+        input[i].temperature = (i % 100 == 0) ? -0.0f : 40.0f + (float)(r % 300) / 7.0f;
+        input[i].voltage = (i % 10 == 0) ? -3.3f : 3.3f;
+        input[i].registers.control_register = (uint32_t)r;
+        input[i].registers.status_register = i % 4 == 0 ? 0xFFFFFFFFu : 0x80000001u;
+        input[i].registers.error_register = 0;
+        input[i].registers.config_register = (uint32_t)i << 20;
+    }
+    uint32_t nan_bits = 0x7FC00001u;
+    uint32_t inf_bits = 0x7F800000u;
+    memcpy(&input[10].temperature, &nan_bits, sizeof(float));
+    memcpy(&input[11].voltage, &inf_bits, sizeof(float));
+
+    int appended = 1;
+    for (int i = 0; i < count; i++) {
+        if (!chip_telemetry_append(store, &input[i])) appended = 0;
+    }
+    TEST_ASSERT(appended, "Samples appended");
+    int backwards = chip_telemetry_append(store, &input[0]);
+    TEST_ASSERT_EQUAL(0, backwards, "Out-of-order sample rejected");
+
+    chip_telemetry_stats_t stats;
+    chip_telemetry_stats(store, &stats);
+    TEST_ASSERT(stats.blocks == 15 && stats.open_samples == 40, "Full blocks sealed, tail left open");
+
+    // Reads see the open tail before and after it is sealed
+    long read_open = chip_telemetry_read_range(store, 0, UINT64_MAX, output, count);
+    TEST_ASSERT(read_open == count && memcmp(input, output, count * sizeof(chip_sample_t)) == 0,
+                "Range read over sealed and open blocks is bit-exact");
+    int flushed = chip_telemetry_flush(store);
+    TEST_ASSERT_EQUAL(1, flushed, "Open block sealed");
+    memset(output, 0, count * sizeof(chip_sample_t));
+    long read_sealed = chip_telemetry_read_range(store, 0, UINT64_MAX, output, count);
+    TEST_ASSERT(read_sealed == count && memcmp(input, output, count * sizeof(chip_sample_t)) == 0,
+                "Round trip is bit-exact (NaN, infinity, -0.0, 64-bit gaps)");
+
+    chip_sample_t block[64];
+    long block_samples = chip_telemetry_decode_block(store, 15, block);
+    TEST_ASSERT(block_samples == 40 && memcmp(block, &input[960], 40 * sizeof(chip_sample_t)) == 0,
+                "Last block decodes on its own");
+    long missing_block = chip_telemetry_decode_block(store, 16, block);
+    TEST_ASSERT_EQUAL(-1, missing_block, "Nonexistent block rejected");
+
+    // Seeks through the block index
+    chip_sample_t found;
+    int exact = chip_telemetry_read_at(store, input[700].timestamp_ns, &found);
+    TEST_ASSERT(exact && memcmp(&found, &input[700], sizeof(found)) == 0, "Seek to an exact timestamp");
+    int between = chip_telemetry_read_at(store, input[500].timestamp_ns - 1, &found);
+    TEST_ASSERT(between && found.timestamp_ns == input[499].timestamp_ns, "Seek inside a gap returns the prior sample");
+    int before = chip_telemetry_read_at(store, input[0].timestamp_ns - 1, &found);
+    TEST_ASSERT_EQUAL(0, before, "Seek before the first sample finds nothing");
+    long window = chip_telemetry_read_range(store, input[120].timestamp_ns, input[329].timestamp_ns, output, count);
+    TEST_ASSERT(window == 210 && memcmp(output, &input[120], 210 * sizeof(chip_sample_t)) == 0,
+                "Range read across blocks");
+
+    // Retention keeps only the newest sealed blocks
+    chip_telemetry_reset(store);
+    int capped = chip_telemetry_set_retention(store, 4);
+    TEST_ASSERT_EQUAL(1, capped, "Retention limit set");
+    for (int i = 0; i < count; i++) {
+        chip_telemetry_append(store, &input[i]);
+    }
+    chip_telemetry_stats(store, &stats);
+    TEST_ASSERT(stats.blocks == 4 && stats.samples == 4 * 64 + 40 && stats.dropped_samples == 11 * 64,
+                "Oldest blocks discarded past the retention limit");
+    memset(output, 0, count * sizeof(chip_sample_t));
+    long retained = chip_telemetry_read_range(store, 0, UINT64_MAX, output, count);
+    TEST_ASSERT(retained == 4 * 64 + 40 && memcmp(output, &input[704], 296 * sizeof(chip_sample_t)) == 0,
+                "Retained blocks still decode bit-exact");
+    int expired = chip_telemetry_read_at(store, input[703].timestamp_ns, &found);
+    TEST_ASSERT_EQUAL(0, expired, "Discarded samples are gone");
+    chip_telemetry_set_retention(store, 0);
+
+    // Smooth 1 Hz telemetry compresses well
+    chip_telemetry_reset(store);
+    chip_sample_t sample;
+    memset(&sample, 0, sizeof(sample));
+    sample.voltage = 3.3f;
+    sample.registers.status_register = 0x80000001;
+    for (int i = 0; i < 4096; i++) {
+        sample.timestamp_ns = (uint64_t)(i + 1) * 1000000000ull;
+        sample.temperature = 45.0f + (float)(i / 64) / 10.0f;
+        chip_telemetry_append(store, &sample);
+    }
+    chip_telemetry_flush(store);
+    chip_telemetry_stats(store, &stats);
+    TEST_ASSERT(stats.samples == 4096 && stats.raw_bytes >= 10 * (stats.encoded_bytes + stats.index_bytes),
+                "Steady telemetry compresses at least 10x");
+
+    free(input);
+    free(output);
+    destroy_chip_telemetry(store);
 }
 
 /**
@@ -422,11 +2194,35 @@ int main(void) {
 
     // Run all test suites
     test_pointer_operations();
+    test_atomic_registers();
+    test_vectored_registers();
+    test_register_pattern_search();
+    test_shared_register_bank();
+    test_register_shadow();
+    test_register_trace();
+    test_state_snapshot();
+    test_register_diff();
+    test_register_watch();
+    test_chip_log();
     test_chip_structures();
     test_bit_operations();
     test_advanced_pointers();
     test_memory_safety();
+    test_allocation_tracker_scaling();
+    test_concurrent_memory_tracker();
+    test_memory_sampling();
+    test_guard_pages();
     test_ai_optimizations();
+    test_hardware_crc();
+    test_streaming_crc();
+    test_memory_copy();
+    test_chip_fleet();
+    test_chip_pool();
+    test_chip_slot_map();
+    test_chip_worker_pool();
+    test_chip_timer_wheel();
+    test_chip_history();
+    test_chip_telemetry();
     test_error_handling();
     test_integration();
 